@@ -270,19 +270,12 @@ def init_type(file, typ, key, mods):
     if mods:
         mods = mods[:]
 
-        if mods[0]["type"] == "nullable":
-            for n in range(len(mods)):
-                if mods[n]["type"] == "pointer":
-                    mods[n]["nullable"] = True
-                    mods = mods[1:]
-                    break
-
-        if mods[0]["type"] == "const":
-            for n in range(len(mods)):
-                if mods[n]["type"] == "pointer":
-                    mods[n]["const"] = True
-                    mods = mods[1:]
-                    break
+        # Leading qualifiers apply to the first pointer, eg. `ufbx_nullable const T *`
+        while mods and mods[0]["type"] in ("nullable", "const"):
+            n = find_index(mods, lambda m: m["type"] == "pointer")
+            if n < 0: break
+            mods[n][mods[0]["type"]] = True
+            mods = mods[1:]
 
     if mods:
         mod = mods[-1]
@@ -637,7 +630,8 @@ def layout_type(arch: Arch, file: File, typ: Type):
         typ.size[arch.name] = size
         typ.align[arch.name] = size
     elif typ.kind == "":
-        size = arch.sizes[typ.base_name]
+        # Opaque handles (eg. `ufbx_loader`) are only used through pointers
+        size = arch.sizes.get(typ.base_name, 0)
         typ.size[arch.name] = size
         typ.align[arch.name] = size
     elif typ.kind == "enum":
@@ -46,6 +46,9 @@ class ADecl(Ast):
 class ANamePointer(AName):
     inner: AName
 
+class ANameConst(AName):
+    inner: AName
+
 class ANameArray(AName):
     inner: AName
     length: Optional[Token]
@@ -218,6 +221,9 @@ class Parser(parsette.Parser):
         if self.accept("*"):
             inner = self.parse_name_non_array(ctx, allow_anonymous)
             return ANamePointer(inner)
+        if self.accept("const"):
+            inner = self.parse_name_non_array(ctx, allow_anonymous)
+            return ANameConst(inner)
         if allow_anonymous and not self.peek(TIdent):
             return ANameAnonymous()
         else:
@@ -453,6 +459,9 @@ def name_to_stype(base: SType, name: AName) -> SType:
     if isinstance(name, ANamePointer):
         st = name_to_stype(base, name.inner)
         return st._replace(mods=st.mods + [SModPointer()])
+    elif isinstance(name, ANameConst):
+        st = name_to_stype(base, name.inner)
+        return st._replace(mods=st.mods + [SModConst()])
     elif isinstance(name, ANameArray):
         st = name_to_stype(base, name.inner)
         mod = SModArray(name.length.text() if name.length else None)
@@ -475,6 +484,8 @@ def name_str(name: AName):
         return None
     elif isinstance(name, ANamePointer):
         return name_str(name.inner)
+    elif isinstance(name, ANameConst):
+        return name_str(name.inner)
     elif isinstance(name, ANameArray):
         return name_str(name.inner)
     elif isinstance(name, ANameFunction):
@@ -0,0 +1,155 @@
+// Throughput benchmark for loading ASCII FBX and .obj files.
+//
+// Usage: ascii_benchmark [-n runs] [-j threads] files...
+// eg.    cc -O2 misc/ascii_benchmark/ascii_benchmark.c ufbx.c -lm -lpthread -o ascii_benchmark
+//        ./ascii_benchmark -n 5 -j 8 data/*_ascii.fbx
+//
+// Files are read into memory once and loaded `runs` times, the fastest run is
+// reported. Binary files in the input list are skipped. With `-j` large arrays
+// and .obj vertices are parsed using a simple thread pool, see `ufbx_load_opts.thread_opts`.
+
+#define _CRT_SECURE_NO_WARNINGS
+
+#include "../../ufbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_t threads[64];
+	size_t num_threads;
+	size_t num_running;
+
+	ufbx_thread_pool_task_fn *task_fn;
+	void *task_user;
+	uint32_t next_index;
+	uint32_t count;
+} thread_pool;
+
+static void *pool_thread(void *user)
+{
+	thread_pool *pool = (thread_pool*)user;
+	for (;;) {
+		pthread_mutex_lock(&pool->mutex);
+		uint32_t index = pool->next_index;
+		if (index < pool->count) pool->next_index++;
+		pthread_mutex_unlock(&pool->mutex);
+		if (index >= pool->count) break;
+		pool->task_fn(pool->task_user, index);
+	}
+	return NULL;
+}
+
+static void pool_run(void *user, ufbx_thread_pool_task_fn *task_fn, void *task_user, uint32_t count)
+{
+	thread_pool *pool = (thread_pool*)user;
+	pool->task_fn = task_fn;
+	pool->task_user = task_user;
+	pool->next_index = 0;
+	pool->count = count;
+	pool->num_running = pool->num_threads < count ? pool->num_threads : count;
+	for (size_t i = 0; i < pool->num_running; i++) {
+		pthread_create(&pool->threads[i], NULL, &pool_thread, pool);
+	}
+}
+
+static void pool_wait(void *user)
+{
+	thread_pool *pool = (thread_pool*)user;
+	for (size_t i = 0; i < pool->num_running; i++) {
+		pthread_join(pool->threads[i], NULL);
+	}
+	pool->num_running = 0;
+}
+
+static void *read_file(const char *path, size_t *p_size)
+{
+	FILE *f = fopen(path, "rb");
+	if (!f) return NULL;
+	fseek(f, 0, SEEK_END);
+	size_t size = (size_t)ftell(f);
+	fseek(f, 0, SEEK_SET);
+	void *data = malloc(size + 1);
+	if (data && fread(data, 1, size, f) != size) {
+		free(data);
+		data = NULL;
+	}
+	fclose(f);
+	*p_size = size;
+	return data;
+}
+
+int main(int argc, char **argv)
+{
+	int runs = 3;
+	thread_pool pool = { 0 };
+	pthread_mutex_init(&pool.mutex, NULL);
+	double total_bytes = 0.0, total_time = 0.0, total_parse_time = 0.0, total_number_time = 0.0;
+	size_t num_files = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+			runs = atoi(argv[++i]);
+			continue;
+		} else if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+			pool.num_threads = (size_t)atoi(argv[++i]);
+			if (pool.num_threads > 64) pool.num_threads = 64;
+			continue;
+		}
+
+		const char *path = argv[i];
+		size_t size = 0;
+		void *data = read_file(path, &size);
+		if (!data) {
+			fprintf(stderr, "Failed to read %s\n", path);
+			continue;
+		}
+
+		ufbx_load_stats best = { 0 };
+		bool ascii = false;
+		for (int run = 0; run < runs; run++) {
+			ufbx_load_opts opts = { 0 };
+			opts.collect_stats = true;
+			if (pool.num_threads > 0) {
+				opts.thread_opts.pool.run_fn = &pool_run;
+				opts.thread_opts.pool.wait_fn = &pool_wait;
+				opts.thread_opts.pool.user = &pool;
+				opts.thread_opts.num_tasks = pool.num_threads;
+			}
+			ufbx_error error;
+			ufbx_scene *scene = ufbx_load_memory(data, size, &opts, &error);
+			if (!scene) {
+				fprintf(stderr, "Failed to load %s: %s\n", path, error.description.data);
+				break;
+			}
+			ascii = scene->metadata.ascii;
+			ufbx_load_stats stats = scene->metadata.load_stats;
+			if (run == 0 || stats.total_time < best.total_time) best = stats;
+			ufbx_free_scene(scene);
+			if (!ascii) break;
+		}
+		free(data);
+		if (!ascii || best.total_time <= 0.0) continue;
+
+		// Number parsing CPU time above its wall clock time shows the thread pool utilization
+		printf("%8.2f MB/s %8.3f ms (parse %8.3f ms, numbers %8.3f ms, %8.3f ms CPU) %s\n",
+			(double)size / best.total_time * 1e-6, best.total_time * 1e3,
+			best.parse_time * 1e3, best.ascii_number_time * 1e3, best.ascii_number_cpu_time * 1e3, path);
+
+		total_bytes += (double)size;
+		total_time += best.total_time;
+		total_parse_time += best.parse_time;
+		total_number_time += best.ascii_number_time;
+		num_files++;
+	}
+
+	if (num_files > 0) {
+		printf("\n%zu files, %.2f MB: %.2f MB/s total %.3f ms, parse %.3f ms, numbers %.3f ms\n",
+			num_files, total_bytes * 1e-6, total_bytes / total_time * 1e-6,
+			total_time * 1e3, total_parse_time * 1e3, total_number_time * 1e3);
+	}
+
+	return 0;
+}
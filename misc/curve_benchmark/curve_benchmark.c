@@ -0,0 +1,143 @@
+// Throughput benchmark for evaluating animation curves at many sample times.
+//
+// Usage: curve_benchmark [-n runs] [-s samples] [-c] files...
+// eg.    cc -O2 misc/curve_benchmark/curve_benchmark.c ufbx.c -lm -o curve_benchmark
+//        ./curve_benchmark data/maya_anim_interpolation_*.fbx data/maya_auto_clamp_*.fbx
+//
+// Every curve in the file is sampled at `samples` sorted times covering the keyframes
+// using `ufbx_evaluate_curve()`, `ufbx_evaluate_curve_cursor()` and `ufbx_evaluate_curve_batch()`.
+// The fastest of `runs` runs is reported as nanoseconds per sample.
+// With `-c` the curves are precompiled, see `ufbx_load_opts.compile_anim_curves`.
+
+#define _CRT_SECURE_NO_WARNINGS
+#define _POSIX_C_SOURCE 199309L
+
+#include "../../ufbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static double get_time(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+typedef enum {
+	METHOD_CURVE,
+	METHOD_CURSOR,
+	METHOD_BATCH,
+	METHOD_COUNT,
+} method;
+
+static const char *method_names[] = { "curve", "cursor", "batch" };
+
+static double run_method(const ufbx_scene *scene, method m, const double *times, ufbx_real *values, size_t num_samples)
+{
+	double begin = get_time();
+	for (size_t i = 0; i < scene->anim_curves.count; i++) {
+		const ufbx_anim_curve *curve = scene->anim_curves.data[i];
+		if (m == METHOD_CURVE) {
+			for (size_t j = 0; j < num_samples; j++) {
+				values[j] = ufbx_evaluate_curve(curve, times[j], 0.0f);
+			}
+		} else if (m == METHOD_CURSOR) {
+			ufbx_curve_cursor cursor;
+			ufbx_init_curve_cursor(&cursor, curve);
+			for (size_t j = 0; j < num_samples; j++) {
+				values[j] = ufbx_evaluate_curve_cursor(&cursor, times[j], 0.0f);
+			}
+		} else {
+			ufbx_evaluate_curve_batch(curve, times, num_samples, values, 0.0f);
+		}
+	}
+	return get_time() - begin;
+}
+
+int main(int argc, char **argv)
+{
+	int runs = 5;
+	size_t num_samples = 100000;
+	double total_time[METHOD_COUNT] = { 0 };
+	size_t total_samples = 0;
+	bool compile = false;
+
+	for (int i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+			runs = atoi(argv[++i]);
+			continue;
+		} else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+			num_samples = (size_t)atoi(argv[++i]);
+			continue;
+		} else if (!strcmp(argv[i], "-c")) {
+			compile = true;
+			continue;
+		}
+
+		const char *path = argv[i];
+		ufbx_load_opts opts = { 0 };
+		opts.compile_anim_curves = compile;
+
+		ufbx_error error;
+		ufbx_scene *scene = ufbx_load_file(path, &opts, &error);
+		if (!scene) {
+			fprintf(stderr, "Failed to load %s: %s\n", path, error.description.data);
+			continue;
+		}
+
+		double time_begin = 0.0, time_end = 0.0;
+		bool has_keys = false;
+		for (size_t j = 0; j < scene->anim_curves.count; j++) {
+			const ufbx_keyframe_list *keys = &scene->anim_curves.data[j]->keyframes;
+			if (keys->count == 0) continue;
+			double key_begin = keys->data[0].time, key_end = keys->data[keys->count - 1].time;
+			if (!has_keys || key_begin < time_begin) time_begin = key_begin;
+			if (!has_keys || key_end > time_end) time_end = key_end;
+			has_keys = true;
+		}
+		if (!has_keys || num_samples == 0) {
+			ufbx_free_scene(scene);
+			continue;
+		}
+
+		double *times = (double*)malloc(num_samples * sizeof(double));
+		ufbx_real *values = (ufbx_real*)malloc(num_samples * sizeof(ufbx_real));
+		if (!times || !values) return 1;
+		for (size_t j = 0; j < num_samples; j++) {
+			times[j] = time_begin + (time_end - time_begin) * (double)j / (double)num_samples;
+		}
+
+		double best[METHOD_COUNT];
+		for (int m = 0; m < METHOD_COUNT; m++) {
+			for (int run = 0; run < runs; run++) {
+				double time = run_method(scene, (method)m, times, values, num_samples);
+				if (run == 0 || time < best[m]) best[m] = time;
+			}
+		}
+
+		size_t samples = scene->anim_curves.count * num_samples;
+		printf("%zu curves", scene->anim_curves.count);
+		for (int m = 0; m < METHOD_COUNT; m++) {
+			printf(", %s %6.2f ns", method_names[m], best[m] / (double)samples * 1e9);
+			total_time[m] += best[m];
+		}
+		printf(": %s\n", path);
+		total_samples += samples;
+
+		free(values);
+		free(times);
+		ufbx_free_scene(scene);
+	}
+
+	if (total_samples > 0) {
+		printf("\n%zu samples", total_samples);
+		for (int m = 0; m < METHOD_COUNT; m++) {
+			printf(", %s %6.2f ns", method_names[m], total_time[m] / (double)total_samples * 1e9);
+		}
+		printf("\n");
+	}
+
+	return 0;
+}
@@ -0,0 +1,175 @@
+import os
+import sys
+import argparse
+
+src_path = os.path.dirname(os.path.realpath(__file__))
+sys.path.append(os.path.join(src_path, "..", "bindgen"))
+
+import ufbx_parser
+
+parser = argparse.ArgumentParser("gen_snapshot_layout.py")
+parser.add_argument("-i", help="Input header (default: ufbx.h)")
+argv = parser.parse_args()
+
+input_file = argv.i or os.path.join(src_path, "..", "ufbx.h")
+with open(input_file) as f:
+    source = f.read()
+
+p = ufbx_parser.Parser(source, "ufbx.h")
+top = list(ufbx_parser.format_decls(ufbx_parser.top_sdecls(p.parse_top_file()), allow_groups=True))
+
+def flatten(decls):
+    for decl in decls:
+        if decl["kind"] == "group":
+            yield from flatten(decl["decls"])
+        else:
+            yield decl
+
+structs = { d["name"]: d for d in flatten(top) if d["kind"] == "struct" and d["name"] }
+
+element_enums = []
+for d in flatten(top):
+    if d["kind"] == "enum" and d["name"] == "ufbx_element_type":
+        element_enums = [v["name"] for v in flatten(d["decls"]) if v["kind"] == "decl" and not v["value"]]
+element_types = [e.replace("UFBX_ELEMENT_", "ufbx_").lower() for e in element_enums]
+element_set = set(element_types) | { "ufbx_element" }
+
+# Pointers to these are relocated but not followed as the targets are
+# either elements (walked through `ufbx_scene.elements`) or the scene itself.
+no_follow = element_set | { "ufbx_scene" }
+
+ignored_mods = ("const", "nullable", "abi", "unsafe")
+
+def field_info(decl):
+    typ = decl["type"]
+    mods = [m for m in typ["mods"] if m["type"] not in ignored_mods]
+    count = "1"
+    if mods and mods[-1]["type"] == "array":
+        count = mods[-1]["length"]
+        mods = mods[:-1]
+    return typ["name"], [m["type"] for m in mods], count
+
+def struct_fields(st):
+    """Yield the fields of a struct following only the first member of unions"""
+    for decl in flatten(st["decls"]):
+        if decl["kind"] == "struct":
+            if decl["structKind"] == "union":
+                first = next(d for d in flatten(decl["decls"]) if d["kind"] in ("decl", "struct"))
+                if first["kind"] == "struct":
+                    yield from struct_fields(first)
+                else:
+                    yield first
+            else:
+                yield from struct_fields(decl)
+        elif decl["kind"] == "decl" and decl["declKind"] == "field":
+            yield decl
+
+def list_item(st):
+    data = next(d for d in struct_fields(st) if d["name"] == "data")
+    base, mods, _ = field_info(data)
+    assert mods[0] == "pointer"
+    return base, mods[1:]
+
+has_pointers_cache = { }
+def has_pointers(name):
+    if name in ("ufbx_string", "ufbx_blob"): return True
+    if name not in structs: return False
+    if name in has_pointers_cache: return has_pointers_cache[name]
+    has_pointers_cache[name] = False
+    st = structs[name]
+    result = st["isList"]
+    for decl in struct_fields(st):
+        base, mods, _ = field_info(decl)
+        if "function" in mods: continue
+        if mods or has_pointers(base):
+            result = True
+    has_pointers_cache[name] = result
+    return result
+
+types = []
+type_index = { }
+
+def type_enum(name):
+    return "UFBXI_SNAPSHOT_TYPE_" + name.replace("ufbx_", "").upper()
+
+def use_type(name):
+    if name not in type_index:
+        type_index[name] = len(types)
+        types.append(name)
+    return type_enum(name)
+
+def item_kind(base, mods, owner, field):
+    """Returns `(kind, type)` for a value of type `base` with pointer `mods`"""
+    if not mods:
+        if base == "ufbx_string": return "STRING", "0"
+        if base == "ufbx_blob": return "BLOB", "0"
+        if has_pointers(base):
+            if structs[base]["isList"]:
+                raise RuntimeError(f"Nested list in {owner}.{field}")
+            return "STRUCT", use_type(base)
+        return None, "0"
+    if mods == ["pointer"]:
+        if base in no_follow or not has_pointers(base):
+            return "PTR", "0"
+        return "REF", use_type(base)
+    raise RuntimeError(f"Unsupported pointer type {base} {mods} in {owner}.{field}")
+
+fields = { }
+def emit_type(name):
+    out = []
+    for decl in struct_fields(structs[name]):
+        base, mods, count = field_info(decl)
+        if "function" in mods: continue
+        field = decl["name"]
+        offset = f"offsetof({name}, {field})"
+        if not mods and base in structs and structs[base]["isList"]:
+            if not has_pointers(base): continue
+            item_base, item_mods = list_item(structs[base])
+            kind, typ = item_kind(item_base, item_mods, name, field)
+            if item_base == "void":
+                raise RuntimeError(f"Unsized list in {name}.{field}")
+            item = "void*" if item_mods else item_base
+            out.append((offset, "LIST", kind or "RAW", typ, count, f"sizeof({item})"))
+        else:
+            kind, typ = item_kind(base, mods, name, field)
+            if not kind: continue
+            out.append((offset, kind, "RAW", typ, count, "0"))
+    fields[name] = out
+
+use_type("ufbx_scene")
+for name in element_types:
+    use_type(name)
+
+ix = 0
+while ix < len(types):
+    emit_type(types[ix])
+    ix += 1
+
+print("// Generated by `misc/gen_snapshot_layout.py`")
+print("enum {")
+for name in types:
+    print(f"\t{type_enum(name)},")
+print("\tUFBXI_SNAPSHOT_TYPE_COUNT,")
+print("};")
+print()
+
+print("static const ufbxi_snapshot_field ufbxi_snapshot_fields[] = {")
+for name in types:
+    for offset, kind, item, typ, count, size in fields[name]:
+        print(f"\t{{ {offset}, UFBXI_SNAPSHOT_{kind}, UFBXI_SNAPSHOT_{item}, {typ}, {count}, {size} }},")
+print("};")
+print()
+
+print("static const ufbxi_snapshot_type ufbxi_snapshot_types[] = {")
+first = 0
+for name in types:
+    num = len(fields[name])
+    print(f"\t{{ sizeof({name}), {first}, {num} }},")
+    first += num
+print("};")
+print()
+
+print("static const uint8_t ufbxi_snapshot_element_types[] = {")
+for name in element_types:
+    print(f"\t{type_enum(name)},")
+print("};")
@@ -8,6 +8,7 @@ typedef struct {
 	uint32_t *slots;
 	size_t num_slots;
 	size_t target_slot;
+	uint64_t seed;
 } hash_info;
 
 typedef void hash_fn(hash_info info);
@@ -19,6 +20,7 @@ typedef struct {
 	size_t max_length;
 	int64_t attempts_left;
 	size_t target_slot;
+	uint64_t seed;
 } str_state;
 
 ufbxi_noinline void print_string(str_state *state, size_t length)
@@ -32,6 +34,9 @@ ufbxi_noinline void print_string(str_state *state, size_t length)
 	}
 }
 
+// NOTE: ufbx keys string and ID hashes with a seed that varies between runs, these
+// search for collisions with a fixed seed (`--seed`, zero by default) to test the worst
+// case behavior of the map, as the seed is predictable eg. in `UFBX_REGRESSION` builds.
 ufbxi_noinline void hash_string_imp(str_state *state, size_t length)
 {
 	if (state->attempts_left < 0) return;
@@ -44,11 +49,11 @@ ufbxi_noinline void hash_string_imp(str_state *state, size_t length)
 	char *p = state->str + length - 1;
 	for (uint32_t c = 'A'; c <= 'Z'; c++) {
 		*p = c;
-		uint32_t hash = ufbxi_hash_string(state->str, length);
+		uint32_t hash = ufbxi_hash_string(state->str, length, state->seed);
 		if ((hash & mask) == target_slot) print_string(state, length);
 		slots[hash & mask]++;
 		*p = c | 0x20;
-		hash = ufbxi_hash_string(state->str, length);
+		hash = ufbxi_hash_string(state->str, length, state->seed);
 		if ((hash & mask) == target_slot) print_string(state, length);
 		slots[hash & mask]++;
 	}
@@ -71,6 +76,7 @@ ufbxi_noinline void hash_string(hash_info info)
 	state.mask = mask;
 	state.slots = info.slots;
 	state.target_slot = info.target_slot;
+	state.seed = info.seed;
 
 	size_t max_len = 0;
 	uint64_t len_attempts = 1;
@@ -82,7 +88,7 @@ ufbxi_noinline void hash_string(hash_info info)
 
 	for (uint32_t c = 'A' + info.begin; c <= 'Z'; c += info.increment) {
 		state.str[0] = c;
-		uint32_t hash = ufbxi_hash_string(state.str, 1);
+		uint32_t hash = ufbxi_hash_string(state.str, 1, state.seed);
 		if ((hash & mask) == info.target_slot) print_string(&state, 1);
 		info.slots[hash & mask]++;
 		if (max_len > 1) {
@@ -90,7 +96,7 @@ ufbxi_noinline void hash_string(hash_info info)
 		}
 
 		state.str[0] = c | 0x20;
-		hash = ufbxi_hash_string(state.str, 1);
+		hash = ufbxi_hash_string(state.str, 1, state.seed);
 		if ((hash & mask) == info.target_slot) print_string(&state, 1);
 		info.slots[hash & mask]++;
 		if (max_len > 1) {
@@ -116,7 +122,7 @@ ufbxi_noinline void hash_uint64(hash_info info)
 	uint64_t increment = info.increment;
 	uint64_t end = info.attempts;
 	for (uint64_t i = info.begin; i < end; i += increment) {
-		uint32_t hash = ufbxi_hash64(i);
+		uint32_t hash = ufbxi_hash64(i ^ info.seed);
 		if ((hash & mask) == info.target_slot) print_uint64(i);
 		info.slots[hash & mask]++;
 	}
@@ -154,6 +160,7 @@ int main(int argc, char **argv)
 	size_t num_slots = 0;
 	size_t target_slot = SIZE_MAX;
 	uint64_t attempts = 0;
+	uint64_t seed = 0;
 
 	for (int i = 1; i < argc; i++) {
 		if (!strcmp(argv[i], "-f")) {
@@ -164,6 +171,8 @@ int main(int argc, char **argv)
 			if (++i < argc) attempts = (uint64_t)strtoull(argv[i], NULL, 10);
 		} else if (!strcmp(argv[i], "--target")) {
 			if (++i < argc) target_slot = (size_t)strtoull(argv[i], NULL, 10);
+		} else if (!strcmp(argv[i], "--seed")) {
+			if (++i < argc) seed = (uint64_t)strtoull(argv[i], NULL, 0);
 		} else if (!strcmp(argv[i], "--threads")) {
 			#if _OPENMP
 			if (++i < argc) omp_set_num_threads(atoi(argv[i]));
@@ -197,6 +206,7 @@ int main(int argc, char **argv)
 	info.increment = 1;
 	info.num_slots = num_slots;
 	info.target_slot = target_slot;
+	info.seed = seed;
 
 #if _OPENMP
 	#pragma omp parallel
@@ -745,7 +745,7 @@ def decorate_arch(compiler, arch):
 tests = set(argv.tests)
 impicit_tests = False
 if not tests:
-    tests = ["tests", "stack", "picort", "viewer", "domfuzz", "objfuzz", "readme", "threadcheck", "hashes"]
+    tests = ["tests", "stack", "picort", "viewer", "domfuzz", "objfuzz", "readme", "threadcheck", "poolcheck", "hashes"]
     implicit_tests = True
 
 async def main():
@@ -1399,6 +1399,51 @@ async def main():
             for line in best_target.log[1].splitlines(keepends=False):
                 log_comment(line)
 
+    if "poolcheck" in tests:
+        log_comment("-- Compiling and running poolcheck --")
+
+        target_tasks = []
+
+        poolcheck_config = {
+            "sources": ["ufbx.c", "test/poolcheck.cpp"],
+            "output": "poolcheck" + exe_suffix,
+            "cpp": True,
+            "optimize": False,
+            "regression": True,
+            "std": "c++14",
+            "threads": True,
+        }
+        target_tasks += compile_permutations("poolcheck", poolcheck_config, arch_configs, None)
+
+        targets = await gather(target_tasks)
+        all_targets += targets
+
+        def target_score(target):
+            compiler = target.compiler
+            config = target.config
+            if not target.compiled:
+                return (0, 0)
+            score = 1
+            if config["arch"] == "x64":
+                score += 10
+            if "clang" in compiler.name:
+                score += 10
+            if "msvc" in compiler.name:
+                score += 5
+            version = re.search(r"\d+", compiler.version)
+            version = int(version.group(0)) if version else 0
+            return (score, version)
+
+        best_target = max(targets, key=target_score)
+        if best_target.compiled:
+            log_comment(f"-- Running {best_target.name} --")
+
+            best_target.log.clear()
+            best_target.ran = False
+            await run_target(best_target, ["data", "4"])
+            for line in best_target.log[1].splitlines(keepends=False):
+                log_comment(line)
+
     if "hashes" in tests:
 
         hash_file = argv.hash_file
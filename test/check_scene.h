@@ -463,7 +463,7 @@ static void ufbxt_check_mesh(ufbx_scene *scene, ufbx_mesh *mesh)
 	ufbxt_assert(mesh->num_point_faces == num_bad_faces[1]);
 	ufbxt_assert(mesh->num_line_faces == num_bad_faces[2]);
 
-	if (!mesh->from_tessellated_nurbs && !mesh->subdivision_evaluated) {
+	if (!mesh->from_tessellated_nurbs && !mesh->subdivision_evaluated && !mesh->lazy_geometry_loaded) {
 		ufbxt_assert(scene->metadata.max_face_triangles >= max_face_triangles);
 	}
 
@@ -1008,6 +1008,13 @@ static void ufbxt_check_anim_curve(ufbx_scene *scene, ufbx_anim_curve *anim_curv
 		ufbx_keyframe key = anim_curve->keyframes.data[i];
 		ufbxt_assert((uint32_t)key.interpolation < (uint32_t)UFBX_INTERPOLATION_COUNT);
 	}
+
+	if (anim_curve->segments.count > 0) {
+		ufbxt_assert(anim_curve->segments.count + 1 == anim_curve->keyframes.count);
+		for (size_t i = 0; i < anim_curve->segments.count; i++) {
+			ufbxt_assert((uint32_t)anim_curve->segments.data[i].type < (uint32_t)UFBX_CURVE_SEGMENT_TYPE_COUNT);
+		}
+	}
 }
 
 static void ufbxt_check_display_layer(ufbx_scene *scene, ufbx_display_layer *layer)
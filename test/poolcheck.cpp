@@ -0,0 +1,581 @@
+#include "../ufbx.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <stdio.h>
+
+// Loads files using a real thread pool and compares the results against serial loads.
+// Build against ufbx.c compiled with `UFBX_REGRESSION` so that the small test files
+// cross the size thresholds for threaded work.
+
+std::atomic_int32_t num_errors { 0 };
+
+#define check(cond) do { if (!(cond)) { \
+		fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+		num_errors.fetch_add(1); \
+	} } while (0)
+
+thread_local bool in_task = false;
+
+struct thread_pool {
+	std::mutex mutex;
+	std::condition_variable work_cv;
+	std::condition_variable done_cv;
+	std::vector<std::thread> threads;
+
+	ufbx_thread_pool_task_fn *task_fn = nullptr;
+	void *task_user = nullptr;
+	uint32_t next = 0;
+	uint32_t count = 0;
+	uint32_t done = 0;
+	bool running = false;
+	bool quit = false;
+
+	size_t num_runs = 0;
+	size_t num_tasks = 0;
+
+	thread_pool(size_t num_threads) {
+		for (size_t i = 0; i < num_threads; i++) {
+			threads.push_back(std::thread([this]() { worker(); }));
+		}
+	}
+
+	~thread_pool() {
+		{
+			std::lock_guard<std::mutex> lock { mutex };
+			quit = true;
+		}
+		work_cv.notify_all();
+		for (std::thread &thread : threads) {
+			thread.join();
+		}
+	}
+
+	void worker() {
+		std::unique_lock<std::mutex> lock { mutex };
+		for (;;) {
+			work_cv.wait(lock, [this]() { return quit || next < count; });
+			if (next >= count) return;
+
+			uint32_t index = next++;
+			ufbx_thread_pool_task_fn *fn = task_fn;
+			void *user = task_user;
+			lock.unlock();
+
+			in_task = true;
+			fn(user, index);
+			in_task = false;
+
+			lock.lock();
+			if (++done == count) {
+				done_cv.notify_all();
+			}
+		}
+	}
+
+	void run(ufbx_thread_pool_task_fn *fn, void *user, uint32_t num) {
+		// ufbx must not dispatch work from inside tasks and must wait for a run before the next,
+		// run nested tasks inline to report the error instead of deadlocking.
+		check(!in_task);
+		if (in_task) {
+			for (uint32_t i = 0; i < num; i++) fn(user, i);
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> lock { mutex };
+			check(!running);
+			task_fn = fn;
+			task_user = user;
+			next = 0;
+			count = num;
+			done = 0;
+			running = true;
+			num_runs++;
+			num_tasks += num;
+		}
+		work_cv.notify_all();
+	}
+
+	void wait() {
+		check(!in_task);
+		if (in_task) return;
+		std::unique_lock<std::mutex> lock { mutex };
+		check(running);
+		done_cv.wait(lock, [this]() { return done == count; });
+		running = false;
+	}
+
+	bool idle() {
+		std::lock_guard<std::mutex> lock { mutex };
+		return !running;
+	}
+
+	ufbx_thread_pool get() {
+		ufbx_thread_pool pool = { };
+		pool.run_fn = [](void *user, ufbx_thread_pool_task_fn *fn, void *task_user, uint32_t count) {
+			((thread_pool*)user)->run(fn, task_user, count);
+		};
+		pool.wait_fn = [](void *user) {
+			((thread_pool*)user)->wait();
+		};
+		pool.user = this;
+		return pool;
+	}
+};
+
+bool same_real(ufbx_real a, ufbx_real b)
+{
+	return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+bool same_vec3(ufbx_vec3 a, ufbx_vec3 b)
+{
+	return same_real(a.x, b.x) && same_real(a.y, b.y) && same_real(a.z, b.z);
+}
+
+bool same_string(ufbx_string a, ufbx_string b)
+{
+	return a.length == b.length && !memcmp(a.data, b.data, a.length);
+}
+
+void check_same_mesh(const ufbx_mesh *a, const ufbx_mesh *b)
+{
+	check(a->num_vertices == b->num_vertices);
+	check(a->num_indices == b->num_indices);
+	check(a->num_faces == b->num_faces);
+	if (a->num_vertices != b->num_vertices || a->num_indices != b->num_indices) return;
+
+	for (size_t i = 0; i < a->num_vertices; i++) {
+		check(same_vec3(a->vertices.data[i], b->vertices.data[i]));
+	}
+	for (size_t i = 0; i < a->num_indices; i++) {
+		check(a->vertex_indices.data[i] == b->vertex_indices.data[i]);
+	}
+
+	check(a->vertex_normal.exists == b->vertex_normal.exists);
+	if (a->vertex_normal.exists && b->vertex_normal.exists) {
+		check(a->vertex_normal.values.count == b->vertex_normal.values.count);
+		for (size_t i = 0; i < a->num_indices; i++) {
+			check(same_vec3(ufbx_get_vertex_vec3(&a->vertex_normal, i), ufbx_get_vertex_vec3(&b->vertex_normal, i)));
+		}
+	}
+
+	check(a->vertex_uv.exists == b->vertex_uv.exists);
+	if (a->vertex_uv.exists && b->vertex_uv.exists) {
+		check(a->vertex_uv.values.count == b->vertex_uv.values.count);
+		for (size_t i = 0; i < a->num_indices; i++) {
+			ufbx_vec2 ua = ufbx_get_vertex_vec2(&a->vertex_uv, i);
+			ufbx_vec2 ub = ufbx_get_vertex_vec2(&b->vertex_uv, i);
+			check(same_real(ua.x, ub.x) && same_real(ua.y, ub.y));
+		}
+	}
+}
+
+void check_same_curve(const ufbx_anim_curve *a, const ufbx_anim_curve *b)
+{
+	check(a->keyframes.count == b->keyframes.count);
+	if (a->keyframes.count != b->keyframes.count) return;
+	for (size_t i = 0; i < a->keyframes.count; i++) {
+		check(a->keyframes.data[i].time == b->keyframes.data[i].time);
+		check(same_real(a->keyframes.data[i].value, b->keyframes.data[i].value));
+	}
+}
+
+void check_same_scene(const ufbx_scene *a, const ufbx_scene *b)
+{
+	check(a->elements.count == b->elements.count);
+	if (a->elements.count != b->elements.count) return;
+
+	for (size_t i = 0; i < a->elements.count; i++) {
+		const ufbx_element *ea = a->elements.data[i];
+		const ufbx_element *eb = b->elements.data[i];
+		check(ea->type == eb->type);
+		check(same_string(ea->name, eb->name));
+		if (ea->type != eb->type) continue;
+
+		if (ea->type == UFBX_ELEMENT_MESH) {
+			check_same_mesh((const ufbx_mesh*)ea, (const ufbx_mesh*)eb);
+		} else if (ea->type == UFBX_ELEMENT_ANIM_CURVE) {
+			check_same_curve((const ufbx_anim_curve*)ea, (const ufbx_anim_curve*)eb);
+		} else if (ea->type == UFBX_ELEMENT_NODE) {
+			const ufbx_node *na = (const ufbx_node*)ea, *nb = (const ufbx_node*)eb;
+			check(same_vec3(na->local_transform.translation, nb->local_transform.translation));
+			check(same_vec3(na->local_transform.scale, nb->local_transform.scale));
+		}
+	}
+}
+
+ufbx_scene *load_serial(const std::string &path)
+{
+	ufbx_load_opts opts = { };
+	ufbx_error error;
+	ufbx_scene *scene = ufbx_load_file(path.c_str(), &opts, &error);
+	if (!scene) {
+		fprintf(stderr, "Failed to load %s: %s\n", path.c_str(), error.description.data);
+		num_errors.fetch_add(1);
+	}
+	return scene;
+}
+
+ufbx_progress_result cancel_progress(void *user, const ufbx_progress *progress)
+{
+	(void)progress;
+	size_t *calls = (size_t*)user;
+	return (*calls)-- > 0 ? UFBX_PROGRESS_CONTINUE : UFBX_PROGRESS_CANCEL;
+}
+
+void check_read_ahead(const std::string &path, const ufbx_scene *ref, thread_pool &pool, thread_pool &aux_pool)
+{
+	static const size_t chunk_sizes[] = { 64, 1000, 4096 };
+	for (size_t chunk_size : chunk_sizes) {
+		for (int separate = 0; separate <= 1; separate++) {
+			// Read-ahead alone, sharing the pool with other work, or overlapping with
+			// the other work when using a separate pool.
+			ufbx_load_opts opts = { };
+			opts.read_ahead.pool = pool.get();
+			opts.read_ahead.num_chunks = 3;
+			opts.read_ahead.chunk_size = chunk_size;
+			opts.thread_opts.pool = separate ? aux_pool.get() : pool.get();
+
+			size_t num_runs = pool.num_runs;
+			ufbx_error error;
+			ufbx_scene *scene = ufbx_load_file(path.c_str(), &opts, &error);
+			check(scene != nullptr);
+			check(pool.num_runs > num_runs);
+			check(pool.idle() && aux_pool.idle());
+			if (scene) {
+				check(scene->metadata.io_stats.bytes_read > 0);
+				check_same_scene(ref, scene);
+				ufbx_free_scene(scene);
+			}
+		}
+	}
+
+	// Cancel the load while reads are in flight, all the tasks must be finished
+	// by the time the load returns.
+	size_t num_cancelled = 0;
+	for (size_t calls = 0; calls < 4; calls++) {
+		size_t calls_left = calls;
+		ufbx_load_opts opts = { };
+		opts.read_ahead.pool = pool.get();
+		opts.read_ahead.num_chunks = 4;
+		opts.read_ahead.chunk_size = 64;
+		opts.thread_opts.pool = aux_pool.get();
+		opts.progress_cb.fn = &cancel_progress;
+		opts.progress_cb.user = &calls_left;
+		opts.progress_interval_hint = 1;
+
+		ufbx_error error;
+		ufbx_scene *scene = ufbx_load_file(path.c_str(), &opts, &error);
+		check(pool.idle() && aux_pool.idle());
+		if (scene) {
+			ufbx_free_scene(scene);
+		} else {
+			check(error.type == UFBX_ERROR_CANCELLED);
+			num_cancelled++;
+		}
+	}
+	check(num_cancelled > 0);
+}
+
+void check_thread_opts(const std::string &path, const ufbx_scene *ref, thread_pool &pool, bool expect_runs)
+{
+	static const size_t num_tasks[] = { 0, 1, 3 };
+	static const size_t memory_limits[] = { 0, 1, 0x1000 };
+	for (size_t tasks : num_tasks) {
+		for (size_t memory_limit : memory_limits) {
+			ufbx_load_opts opts = { };
+			opts.thread_opts.pool = pool.get();
+			opts.thread_opts.num_tasks = tasks;
+			opts.thread_opts.memory_limit = memory_limit;
+
+			size_t num_runs = pool.num_runs;
+			ufbx_error error;
+			ufbx_scene *scene = ufbx_load_file(path.c_str(), &opts, &error);
+			check(scene != nullptr);
+			check(pool.idle());
+			// A small `memory_limit` flushes large arrays alone which is not worth a run
+			if (expect_runs && memory_limit == 0) {
+				check(pool.num_runs > num_runs);
+			}
+			if (scene) {
+				check_same_scene(ref, scene);
+				ufbx_free_scene(scene);
+			}
+		}
+	}
+}
+
+bool same_times(ufbx_double_list a, ufbx_double_list b)
+{
+	return a.count == b.count && !memcmp(a.data, b.data, a.count * sizeof(double));
+}
+
+void check_same_vec3_track(const ufbx_baked_vec3_track &a, const ufbx_baked_vec3_track &b)
+{
+	check(same_times(a.times, b.times));
+	check(a.values.count == b.values.count);
+	if (a.values.count != b.values.count) return;
+	for (size_t i = 0; i < a.values.count; i++) {
+		check(same_vec3(a.values.data[i], b.values.data[i]));
+	}
+}
+
+void check_same_bake(const ufbx_baked_anim *a, const ufbx_baked_anim *b)
+{
+	check(a->time_begin == b->time_begin);
+	check(a->time_end == b->time_end);
+	check(a->num_keys == b->num_keys);
+	check(a->nodes.count == b->nodes.count);
+	check(a->blend_channels.count == b->blend_channels.count);
+	check(a->props.count == b->props.count);
+
+	if (a->nodes.count == b->nodes.count) {
+		for (size_t i = 0; i < a->nodes.count; i++) {
+			const ufbx_baked_node &na = a->nodes.data[i], &nb = b->nodes.data[i];
+			check(na.typed_id == nb.typed_id);
+			check_same_vec3_track(na.translation, nb.translation);
+			check_same_vec3_track(na.scale, nb.scale);
+			check(same_times(na.rotation.times, nb.rotation.times));
+			check(na.rotation.values.count == nb.rotation.values.count);
+			if (na.rotation.values.count != nb.rotation.values.count) continue;
+			for (size_t j = 0; j < na.rotation.values.count; j++) {
+				ufbx_quat qa = na.rotation.values.data[j], qb = nb.rotation.values.data[j];
+				check(same_real(qa.x, qb.x) && same_real(qa.y, qb.y) && same_real(qa.z, qb.z) && same_real(qa.w, qb.w));
+			}
+		}
+	}
+
+	if (a->blend_channels.count == b->blend_channels.count) {
+		for (size_t i = 0; i < a->blend_channels.count; i++) {
+			const ufbx_baked_real_track &ta = a->blend_channels.data[i].weight, &tb = b->blend_channels.data[i].weight;
+			check(same_times(ta.times, tb.times));
+			check(ta.values.count == tb.values.count);
+			if (ta.values.count != tb.values.count) continue;
+			for (size_t j = 0; j < ta.values.count; j++) {
+				check(same_real(ta.values.data[j], tb.values.data[j]));
+			}
+		}
+	}
+
+	if (a->props.count == b->props.count) {
+		for (size_t i = 0; i < a->props.count; i++) {
+			check(a->props.data[i].element_id == b->props.data[i].element_id);
+			check(same_string(a->props.data[i].name, b->props.data[i].name));
+			check_same_vec3_track(a->props.data[i].value, b->props.data[i].value);
+		}
+	}
+}
+
+void check_bake(const ufbx_scene *ref, thread_pool &pool)
+{
+	if (ref->anim_stacks.count == 0) return;
+
+	for (int fixed_rate = 0; fixed_rate <= 1; fixed_rate++) {
+		ufbx_bake_opts serial_opts = { };
+		serial_opts.fixed_rate = fixed_rate != 0;
+
+		ufbx_error error;
+		ufbx_baked_anim *serial = ufbx_bake_anim(ref, NULL, &serial_opts, &error);
+		check(serial != nullptr);
+		if (!serial) continue;
+
+		static const size_t num_tasks[] = { 0, 1, 3 };
+		for (size_t tasks : num_tasks) {
+			ufbx_bake_opts opts = serial_opts;
+			opts.thread_opts.pool = pool.get();
+			opts.thread_opts.num_tasks = tasks;
+
+			size_t num_runs = pool.num_runs;
+			ufbx_baked_anim *bake = ufbx_bake_anim(ref, NULL, &opts, &error);
+			check(bake != nullptr);
+			check(pool.idle());
+			if (serial->nodes.count + serial->blend_channels.count + serial->props.count > 1) {
+				check(pool.num_runs > num_runs);
+			}
+			if (bake) {
+				check_same_bake(serial, bake);
+				ufbx_free_baked_anim(bake);
+			}
+		}
+
+		ufbx_free_baked_anim(serial);
+	}
+}
+
+void check_batch(const std::vector<std::string> &paths, const std::vector<ufbx_scene*> &refs, thread_pool &pool)
+{
+	// Load every file twice with a missing file in the middle
+	std::vector<const char*> filenames;
+	for (size_t i = 0; i < paths.size() * 2; i++) {
+		filenames.push_back(paths[i % paths.size()].c_str());
+	}
+	filenames.insert(filenames.begin() + (ptrdiff_t)paths.size(), "missing_file.fbx");
+	size_t missing_index = paths.size();
+
+	static const size_t num_workers[] = { 0, 1, 3 };
+	for (size_t workers : num_workers) {
+		for (int share_strings = 0; share_strings <= 1; share_strings++) {
+			// Per-load pools must be ignored as tasks can't be dispatched from tasks
+			ufbx_load_opts load_opts = { };
+			load_opts.thread_opts.pool = pool.get();
+			load_opts.read_ahead.pool = pool.get();
+
+			ufbx_batch_load_opts opts = { };
+			opts.pool = pool.get();
+			opts.num_workers = workers;
+			opts.share_strings = share_strings != 0;
+
+			size_t num_runs = pool.num_runs;
+			ufbx_error error;
+			ufbx_batch_result *result = ufbx_load_files_batch(filenames.data(), filenames.size(), &load_opts, &opts, &error);
+			check(result != nullptr);
+			check(pool.num_runs == num_runs + 1);
+			check(pool.idle());
+			if (!result) continue;
+
+			check(result->num_files == filenames.size());
+			check(result->num_failed == 1);
+			check(result->scenes[missing_index] == nullptr);
+			check(result->errors[missing_index].type == UFBX_ERROR_FILE_NOT_FOUND);
+
+			for (size_t i = 0; i < filenames.size(); i++) {
+				if (i == missing_index) continue;
+				const ufbx_scene *ref = refs[(i < missing_index ? i : i - 1) % refs.size()];
+				const ufbx_scene *scene = result->scenes[i];
+				check(scene != nullptr);
+				if (ref && scene) {
+					check_same_scene(ref, scene);
+				}
+			}
+
+			// Scenes retained from the result outlive it
+			ufbx_scene *retained = result->scenes[0];
+			if (retained) ufbx_retain_scene(retained);
+			ufbx_free_batch_result(result);
+			if (retained) {
+				check_same_scene(refs[0], retained);
+				ufbx_free_scene(retained);
+			}
+		}
+	}
+}
+
+struct load_context_task {
+	const std::vector<std::string> *paths;
+	const std::vector<ufbx_scene*> *refs;
+	ufbx_load_context *context;
+};
+
+void check_load_context(const std::vector<std::string> &paths, const std::vector<ufbx_scene*> &refs, thread_pool &pool)
+{
+	ufbx_error error;
+	ufbx_load_context *context = ufbx_create_load_context(nullptr, &error);
+	check(context != nullptr);
+	if (!context) return;
+
+	// Race the loads for the shared context, the ones that don't get it allocate as usual
+	load_context_task task = { &paths, &refs, context };
+	pool.run([](void *user, uint32_t index) {
+		load_context_task *task = (load_context_task*)user;
+		size_t file = index % task->paths->size();
+		const ufbx_scene *ref = (*task->refs)[file];
+
+		ufbx_load_opts opts = { };
+		opts.load_context = task->context;
+		ufbx_error error;
+		ufbx_scene *scene = ufbx_load_file((*task->paths)[file].c_str(), &opts, &error);
+		check(scene != nullptr);
+		if (ref && scene) {
+			check_same_scene(ref, scene);
+		}
+		ufbx_free_scene(scene);
+	}, &task, (uint32_t)paths.size() * 4);
+	pool.wait();
+
+	ufbx_free_load_context(context);
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 3) {
+		fprintf(stderr, "Usage: poolcheck <data-dir> <num-threads>\n");
+		return 1;
+	}
+
+	if (!ufbx_is_thread_safe()) {
+		fprintf(stderr, "WARNING: Not thread safe, expect failure!\n");
+	}
+
+	std::string data_root = argv[1];
+	if (!data_root.empty() && data_root.back() != '/' && data_root.back() != '\\') {
+		data_root += '/';
+	}
+
+	size_t num_threads = (size_t)atoi(argv[2]);
+	if (num_threads < 1) num_threads = 1;
+
+	thread_pool pool { num_threads };
+	thread_pool aux_pool { num_threads };
+
+	struct test_file {
+		const char *name;
+		bool thread_opts; // < Expected to run work in `ufbx_load_opts.thread_opts`
+	};
+
+	static const test_file files[] = {
+		// ASCII FBX files have `a:` arrays that are parsed in the pool since 7000
+		{ "maya_slime_7500_ascii.fbx", true },
+		{ "max2009_blob_6100_ascii.fbx", false },
+		// Compressed arrays in binary FBX files are decoded in the pool
+		{ "maya_slime_7500_binary.fbx", true },
+		{ "maya_kenney_character_7700_binary.fbx", true },
+		// Animated file for baking
+		{ "maya_character_7500_binary.fbx", false },
+		// Runs of vertex lines in .obj files are parsed in the pool
+		{ "blender_293_suzanne_subsurf_uv.obj", true },
+		{ "zbrush_polygroup_mess_0_obj.obj", true },
+	};
+
+	std::vector<std::string> paths;
+	std::vector<ufbx_scene*> refs;
+	for (const test_file &file : files) {
+		std::string path = data_root + file.name;
+		printf("%s\n", file.name);
+		fflush(stdout);
+
+		ufbx_scene *ref = load_serial(path);
+		paths.push_back(path);
+		refs.push_back(ref);
+		if (!ref) continue;
+
+		check_thread_opts(path, ref, pool, file.thread_opts);
+		check_read_ahead(path, ref, pool, aux_pool);
+		check_bake(ref, pool);
+	}
+
+	printf("load_context\n");
+	fflush(stdout);
+	check_load_context(paths, refs, pool);
+
+	printf("batch\n");
+	fflush(stdout);
+	check_batch(paths, refs, pool);
+
+	for (ufbx_scene *ref : refs) {
+		ufbx_free_scene(ref);
+	}
+
+	int32_t errors = num_errors.load();
+	if (errors > 0) {
+		fprintf(stderr, "%d checks failed\n", errors);
+		return 1;
+	}
+
+	return 0;
+}
@@ -568,3 +568,663 @@ UFBXT_FILE_TEST(maya_anim_interpolation)
 }
 #endif
 
+
+#if UFBXT_IMPL
+static size_t ufbxt_find_baked_key(const ufbx_double_list *times, double time)
+{
+	ufbxt_assert(times->count > 0);
+	size_t ix = 0;
+	while (ix + 1 < times->count && times->data[ix + 1] < time) ix++;
+	return ix;
+}
+
+static ufbx_vec3 ufbxt_evaluate_baked_vec3(const ufbx_baked_vec3_track *track, double time)
+{
+	ufbxt_assert(track->values.count == track->times.count);
+	size_t ix = ufbxt_find_baked_key(&track->times, time);
+	if (ix + 1 >= track->times.count || time <= track->times.data[ix]) return track->values.data[ix];
+
+	double t0 = track->times.data[ix], t1 = track->times.data[ix + 1];
+	ufbx_real t = (ufbx_real)((time - t0) / (t1 - t0));
+	ufbx_vec3 a = track->values.data[ix], b = track->values.data[ix + 1];
+	ufbx_vec3 r = { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t };
+	return r;
+}
+
+static ufbx_quat ufbxt_evaluate_baked_quat(const ufbx_baked_quat_track *track, double time)
+{
+	ufbxt_assert(track->values.count == track->times.count);
+	size_t ix = ufbxt_find_baked_key(&track->times, time);
+	if (ix + 1 >= track->times.count || time <= track->times.data[ix]) return track->values.data[ix];
+
+	double t0 = track->times.data[ix], t1 = track->times.data[ix + 1];
+	ufbx_quat a = track->values.data[ix], b = track->values.data[ix + 1];
+	ufbxt_assert(a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w >= 0.0f);
+	return ufbx_quat_slerp(a, b, (ufbx_real)((time - t0) / (t1 - t0)));
+}
+
+static ufbx_real ufbxt_evaluate_baked_real(const ufbx_baked_real_track *track, double time)
+{
+	ufbxt_assert(track->values.count == track->times.count);
+	size_t ix = ufbxt_find_baked_key(&track->times, time);
+	if (ix + 1 >= track->times.count || time <= track->times.data[ix]) return track->values.data[ix];
+
+	double t0 = track->times.data[ix], t1 = track->times.data[ix + 1];
+	ufbx_real t = (ufbx_real)((time - t0) / (t1 - t0));
+	ufbx_real a = track->values.data[ix], b = track->values.data[ix + 1];
+	return a + (b - a) * t;
+}
+
+static void ufbxt_check_baked_times(const ufbx_double_list *times, const ufbx_baked_anim *bake)
+{
+	ufbxt_assert(times->count > 0);
+	for (size_t i = 0; i < times->count; i++) {
+		ufbxt_assert(times->data[i] >= bake->time_begin && times->data[i] <= bake->time_end);
+		if (i > 0) ufbxt_assert(times->data[i] > times->data[i - 1]);
+	}
+}
+
+// Compare the baked tracks to direct evaluation at the resampling rate, keys
+// between the samples are either linear or reproduced exactly.
+static void ufbxt_check_baked_anim(ufbxt_diff_error *err, const ufbx_scene *scene, const ufbx_anim *anim, const ufbx_baked_anim *bake, double rate)
+{
+	size_t num_keys = 0;
+
+	for (size_t node_ix = 0; node_ix < bake->nodes.count; node_ix++) {
+		const ufbx_baked_node *baked = &bake->nodes.data[node_ix];
+		ufbxt_assert(baked->typed_id < scene->nodes.count);
+		ufbx_node *node = scene->nodes.data[baked->typed_id];
+		ufbxt_assert(node->element_id == baked->element_id);
+		if (node_ix > 0) ufbxt_assert(baked->typed_id > bake->nodes.data[node_ix - 1].typed_id);
+
+		ufbxt_check_baked_times(&baked->translation.times, bake);
+		ufbxt_check_baked_times(&baked->rotation.times, bake);
+		ufbxt_check_baked_times(&baked->scale.times, bake);
+		num_keys += baked->translation.times.count + baked->rotation.times.count + baked->scale.times.count;
+
+		for (size_t i = 0; ; i++) {
+			double time = bake->time_begin + (double)i / rate;
+			if (time > bake->time_end) break;
+			ufbxt_hintf("%s: %f", node->name.data, time);
+
+			ufbx_transform ref = ufbx_evaluate_transform(anim, node, time);
+			ufbx_quat rot = ufbxt_evaluate_baked_quat(&baked->rotation, time);
+			if (rot.x*ref.rotation.x + rot.y*ref.rotation.y + rot.z*ref.rotation.z + rot.w*ref.rotation.w < 0.0f) {
+				rot.x = -rot.x; rot.y = -rot.y; rot.z = -rot.z; rot.w = -rot.w;
+			}
+
+			ufbxt_assert_close_vec3(err, ref.translation, ufbxt_evaluate_baked_vec3(&baked->translation, time));
+			ufbxt_assert_close_quat(err, ref.rotation, rot);
+			ufbxt_assert_close_vec3(err, ref.scale, ufbxt_evaluate_baked_vec3(&baked->scale, time));
+		}
+	}
+
+	for (size_t chan_ix = 0; chan_ix < bake->blend_channels.count; chan_ix++) {
+		const ufbx_baked_blend_channel *baked = &bake->blend_channels.data[chan_ix];
+		ufbxt_assert(baked->typed_id < scene->blend_channels.count);
+		ufbx_blend_channel *chan = scene->blend_channels.data[baked->typed_id];
+		ufbxt_assert(chan->element_id == baked->element_id);
+
+		ufbxt_check_baked_times(&baked->weight.times, bake);
+		num_keys += baked->weight.times.count;
+
+		for (size_t i = 0; ; i++) {
+			double time = bake->time_begin + (double)i / rate;
+			if (time > bake->time_end) break;
+			ufbxt_hintf("%s: %f", chan->name.data, time);
+
+			ufbx_real ref = ufbx_evaluate_blend_weight(anim, chan, time);
+			ufbxt_assert_close_real(err, ref, ufbxt_evaluate_baked_real(&baked->weight, time));
+		}
+	}
+
+	for (size_t prop_ix = 0; prop_ix < bake->props.count; prop_ix++) {
+		const ufbx_baked_prop *baked = &bake->props.data[prop_ix];
+		ufbxt_assert(baked->element_id < scene->elements.count);
+		ufbx_element *elem = scene->elements.data[baked->element_id];
+		ufbxt_assert(ufbx_find_prop_len(&elem->props, baked->name.data, baked->name.length));
+
+		ufbxt_check_baked_times(&baked->value.times, bake);
+		num_keys += baked->value.times.count;
+
+		for (size_t i = 0; ; i++) {
+			double time = bake->time_begin + (double)i / rate;
+			if (time > bake->time_end) break;
+			ufbxt_hintf("%s.%s: %f", elem->name.data, baked->name.data, time);
+
+			ufbx_prop ref = ufbx_evaluate_prop_len(anim, elem, baked->name.data, baked->name.length, time);
+			ufbxt_assert_close_vec3(err, ref.value_vec3, ufbxt_evaluate_baked_vec3(&baked->value, time));
+		}
+	}
+
+	ufbxt_assert(num_keys == bake->num_keys);
+}
+
+static ufbx_baked_anim *ufbxt_bake_and_check(ufbxt_diff_error *err, const ufbx_scene *scene, const ufbx_bake_opts *opts)
+{
+	ufbx_error error;
+	ufbx_baked_anim *bake = ufbx_bake_anim(scene, NULL, opts, &error);
+	if (!bake) ufbxt_log_error(&error);
+	ufbxt_assert(bake);
+
+	double rate = opts && opts->resample_rate > 0.0 ? opts->resample_rate : 30.0;
+	ufbxt_check_baked_anim(err, scene, &scene->anim, bake, rate);
+	return bake;
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_transform_animation, maya_transform_animation)
+#if UFBXT_IMPL
+{
+	ufbx_node *node = ufbx_find_node(scene, "pCube1");
+	ufbxt_assert(node);
+
+	ufbx_baked_anim *bake = ufbxt_bake_and_check(err, scene, NULL);
+	ufbxt_assert(bake->nodes.count == 1);
+	ufbxt_assert(bake->nodes.data[0].typed_id == node->typed_id);
+
+	ufbx_bake_opts opts = { 0 };
+	opts.fixed_rate = true;
+	opts.no_key_reduction = true;
+	opts.resample_rate = 24.0;
+	ufbx_baked_anim *fixed_bake = ufbxt_bake_and_check(err, scene, &opts);
+	ufbxt_assert(fixed_bake->nodes.count == 1);
+	{
+		const ufbx_baked_node *baked = &fixed_bake->nodes.data[0];
+		size_t num_frames = (size_t)((fixed_bake->time_end - fixed_bake->time_begin) * 24.0 + 0.5) + 1;
+		ufbxt_assert(baked->translation.times.count == num_frames);
+		ufbxt_assert(baked->rotation.times.count == num_frames);
+		ufbxt_assert(baked->scale.times.count == num_frames);
+
+		// Key reduction must only remove keys
+		ufbxt_assert(bake->nodes.data[0].translation.times.count < num_frames);
+		ufbxt_assert(bake->num_keys < fixed_bake->num_keys);
+	}
+
+	// Baking in parallel must produce identical keys
+	opts.thread_opts.pool.run_fn = &ufbxt_serial_pool_run;
+	opts.thread_opts.pool.wait_fn = &ufbxt_serial_pool_wait;
+	opts.thread_opts.pool.user = &ufbxt_serial_pool;
+	opts.fixed_rate = false;
+	opts.no_key_reduction = false;
+	opts.resample_rate = 0.0;
+	ufbx_baked_anim *pool_bake = ufbxt_bake_and_check(err, scene, &opts);
+	ufbxt_assert(pool_bake->num_keys == bake->num_keys);
+	{
+		const ufbx_baked_node *a = &bake->nodes.data[0], *b = &pool_bake->nodes.data[0];
+		ufbxt_assert(a->rotation.times.count == b->rotation.times.count);
+		for (size_t i = 0; i < a->rotation.times.count; i++) {
+			ufbxt_assert(a->rotation.times.data[i] == b->rotation.times.data[i]);
+			ufbxt_assert(!memcmp(&a->rotation.values.data[i], &b->rotation.values.data[i], sizeof(ufbx_quat)));
+		}
+	}
+
+	ufbx_free_baked_anim(pool_bake);
+	ufbx_free_baked_anim(fixed_bake);
+	ufbx_free_baked_anim(bake);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_fixed_rate_partial_frame, maya_transform_animation)
+#if UFBXT_IMPL
+{
+	ufbx_baked_anim *bake = ufbxt_bake_and_check(err, scene, NULL);
+	double duration = bake->time_end - bake->time_begin;
+	ufbxt_assert(duration > 0.0);
+
+	// Rates where the duration ends at a fraction of a frame, the last sample must
+	// still be at `time_end` and a tiny trailing fraction is merged to the last frame
+	double fractions[] = { 0.005, 0.3, 0.995 };
+	size_t extra_frames[] = { 0, 1, 1 };
+	for (size_t i = 0; i < ufbxt_arraycount(fractions); i++) {
+		ufbxt_hintf("fraction=%f", fractions[i]);
+
+		ufbx_bake_opts opts = { 0 };
+		opts.fixed_rate = true;
+		opts.no_key_reduction = true;
+		opts.resample_rate = (20.0 + fractions[i]) / duration;
+		ufbx_baked_anim *fixed_bake = ufbxt_bake_and_check(err, scene, &opts);
+		ufbxt_assert(fixed_bake->nodes.count == 1);
+
+		const ufbx_double_list times = fixed_bake->nodes.data[0].translation.times;
+		ufbxt_assert(times.count == 21 + extra_frames[i]);
+		ufbxt_assert(times.data[0] == fixed_bake->time_begin);
+		ufbxt_assert(times.data[times.count - 1] == fixed_bake->time_end);
+		for (size_t j = 1; j < times.count; j++) {
+			ufbxt_assert(times.data[j] > times.data[j - 1]);
+		}
+
+		ufbx_free_baked_anim(fixed_bake);
+	}
+
+	ufbx_free_baked_anim(bake);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_anim_interpolation, maya_anim_interpolation)
+#if UFBXT_IMPL
+{
+	ufbx_node *node = ufbx_find_node(scene, "pCube1");
+	ufbxt_assert(node);
+
+	ufbx_baked_anim *bake = ufbxt_bake_and_check(err, scene, NULL);
+	ufbxt_assert(bake->nodes.count == 1);
+
+	// Stepped keys are emulated with an extra key `step_time` from the step
+	const ufbx_baked_vec3_track *track = &bake->nodes.data[0].translation;
+	double step_times[] = { 25.0/30.0 - 0.001, 25.0/30.0, 25.0/30.0 + 0.001, 35.0/30.0 - 0.001 };
+	for (size_t i = 0; i < ufbxt_arraycount(step_times); i++) {
+		double time = step_times[i];
+		ufbxt_hintf("%f", time);
+		ufbx_prop ref = ufbx_evaluate_prop(&scene->anim, &node->element, "Lcl Translation", time);
+		ufbxt_assert_close_real(err, ref.value_vec3.x, ufbxt_evaluate_baked_vec3(track, time).x);
+	}
+
+	ufbx_free_baked_anim(bake);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_anim_layers_over_acc, maya_anim_layers_over_acc)
+#if UFBXT_IMPL
+{
+	ufbx_baked_anim *bake = ufbxt_bake_and_check(err, scene, NULL);
+	ufbxt_assert(bake->nodes.count > 0);
+	ufbx_free_baked_anim(bake);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_blend_shape_cube, maya_blend_shape_cube)
+#if UFBXT_IMPL
+{
+	ufbx_baked_anim *bake = ufbxt_bake_and_check(err, scene, NULL);
+	ufbxt_assert(bake->blend_channels.count == 2);
+	ufbx_free_baked_anim(bake);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(bake_anim_alloc_fail, maya_transform_animation)
+#if UFBXT_IMPL
+{
+	for (size_t max_temp = 1; max_temp < 10000; max_temp++) {
+		ufbx_bake_opts opts = { 0 };
+		opts.temp_allocator.huge_threshold = 1;
+		opts.temp_allocator.allocation_limit = max_temp;
+
+		ufbxt_hintf("Temp limit: %zu", max_temp);
+
+		ufbx_error error;
+		ufbx_baked_anim *bake = ufbx_bake_anim(scene, NULL, &opts, &error);
+		if (bake) {
+			ufbxt_logf(".. Tested up to %zu temporary allocations", max_temp);
+			ufbx_free_baked_anim(bake);
+			break;
+		}
+		ufbxt_assert(error.type == UFBX_ERROR_ALLOCATION_LIMIT);
+	}
+
+	for (size_t max_result = 1; max_result < 10000; max_result++) {
+		ufbx_bake_opts opts = { 0 };
+		opts.result_allocator.huge_threshold = 1;
+		opts.result_allocator.allocation_limit = max_result;
+
+		ufbxt_hintf("Result limit: %zu", max_result);
+
+		ufbx_error error;
+		ufbx_baked_anim *bake = ufbx_bake_anim(scene, NULL, &opts, &error);
+		if (bake) {
+			ufbxt_logf(".. Tested up to %zu result allocations", max_result);
+			ufbx_free_baked_anim(bake);
+			break;
+		}
+		ufbxt_assert(error.type == UFBX_ERROR_ALLOCATION_LIMIT);
+	}
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_curve_cursor_at(ufbx_curve_cursor *cursor, double time)
+{
+	ufbxt_hintf("time=%f", time);
+	ufbx_real ref = ufbx_evaluate_curve(cursor->curve, time, -1.0f);
+	ufbx_real value = ufbx_evaluate_curve_cursor(cursor, time, -1.0f);
+	ufbxt_assert(ref == value);
+}
+
+static void ufbxt_check_curve_cursors(const ufbx_scene *scene)
+{
+	for (size_t i = 0; i < scene->anim_curves.count; i++) {
+		const ufbx_anim_curve *curve = scene->anim_curves.data[i];
+		if (curve->keyframes.count == 0) continue;
+
+		double begin = curve->keyframes.data[0].time - 0.5;
+		double end = curve->keyframes.data[curve->keyframes.count - 1].time + 0.5;
+		size_t num_samples = 1024;
+
+		ufbx_curve_cursor cursor;
+		ufbx_init_curve_cursor(&cursor, curve);
+
+		// Forward and backward playback
+		for (size_t j = 0; j <= num_samples; j++) {
+			ufbxt_check_curve_cursor_at(&cursor, begin + (end - begin) * (double)j / (double)num_samples);
+		}
+		for (size_t j = 0; j <= num_samples; j++) {
+			ufbxt_check_curve_cursor_at(&cursor, end - (end - begin) * (double)j / (double)num_samples);
+		}
+
+		// Exact keyframe times
+		for (size_t j = 0; j < curve->keyframes.count; j++) {
+			ufbxt_check_curve_cursor_at(&cursor, curve->keyframes.data[j].time);
+		}
+
+		// Random seeking
+		uint32_t seed = 1;
+		for (size_t j = 0; j < num_samples; j++) {
+			seed = seed * 1664525u + 1013904223u;
+			ufbxt_check_curve_cursor_at(&cursor, begin + (end - begin) * (double)(seed >> 8) / (double)(1u << 24));
+		}
+	}
+
+	for (size_t i = 0; i < scene->anim_values.count; i++) {
+		const ufbx_anim_value *anim_value = scene->anim_values.data[i];
+
+		ufbx_anim_value_cursor cursor;
+		ufbx_init_anim_value_cursor(&cursor, anim_value);
+		for (int frame = -10; frame <= 200; frame++) {
+			double time = (double)frame / 24.0;
+			ufbx_vec3 ref = ufbx_evaluate_anim_value_vec3(anim_value, time);
+			ufbx_vec3 value = ufbx_evaluate_anim_value_cursor_vec3(&cursor, time);
+			ufbxt_assert(ref.x == value.x && ref.y == value.y && ref.z == value.z);
+		}
+	}
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(curve_cursor_interpolation_modes, maya_interpolation_modes)
+#if UFBXT_IMPL
+{
+	ufbxt_check_curve_cursors(scene);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(curve_cursor_anim_interpolation, maya_anim_interpolation)
+#if UFBXT_IMPL
+{
+	ufbxt_check_curve_cursors(scene);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(curve_cursor_auto_clamp, maya_auto_clamp)
+#if UFBXT_IMPL
+{
+	ufbxt_check_curve_cursors(scene);
+}
+#endif
+
+UFBXT_TEST(curve_cursor_null)
+#if UFBXT_IMPL
+{
+	ufbx_curve_cursor cursor;
+	ufbx_init_curve_cursor(&cursor, NULL);
+	ufbxt_assert(ufbx_evaluate_curve_cursor(&cursor, 1.0, 2.0f) == 2.0f);
+
+	ufbx_anim_value_cursor value_cursor;
+	ufbx_init_anim_value_cursor(&value_cursor, NULL);
+	ufbx_vec3 value = ufbx_evaluate_anim_value_cursor_vec3(&value_cursor, 1.0);
+	ufbxt_assert(value.x == 0.0f && value.y == 0.0f && value.z == 0.0f);
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_curve_batch(const ufbx_scene *scene)
+{
+	size_t num_samples = 1024;
+	double *times = (double*)malloc(num_samples * sizeof(double));
+	ufbx_real *values = (ufbx_real*)malloc(num_samples * sizeof(ufbx_real));
+	ufbx_vec3 *vec_values = (ufbx_vec3*)malloc(num_samples * sizeof(ufbx_vec3));
+	ufbxt_assert(times && values && vec_values);
+
+	for (size_t i = 0; i < scene->anim_curves.count; i++) {
+		const ufbx_anim_curve *curve = scene->anim_curves.data[i];
+		if (curve->keyframes.count == 0) continue;
+
+		double begin = curve->keyframes.data[0].time - 0.5;
+		double end = curve->keyframes.data[curve->keyframes.count - 1].time + 0.5;
+
+		// Sorted times with exact keyframe times mixed in
+		for (size_t j = 0; j < num_samples; j++) {
+			times[j] = begin + (end - begin) * (double)j / (double)(num_samples - 1);
+		}
+		for (size_t j = 0; j < curve->keyframes.count; j++) {
+			double key_time = curve->keyframes.data[j].time;
+			for (size_t k = 0; k < num_samples; k++) {
+				if (times[k] >= key_time) {
+					times[k] = key_time;
+					break;
+				}
+			}
+		}
+
+		for (int pass = 0; pass < 2; pass++) {
+			// Second pass with unsorted times
+			if (pass == 1) {
+				uint32_t seed = 1;
+				for (size_t j = num_samples - 1; j > 0; j--) {
+					seed = seed * 1664525u + 1013904223u;
+					size_t k = (size_t)(seed >> 8) % (j + 1);
+					double tmp = times[j]; times[j] = times[k]; times[k] = tmp;
+				}
+			}
+
+			ufbx_evaluate_curve_batch(curve, times, num_samples, values, -1.0f);
+			for (size_t j = 0; j < num_samples; j++) {
+				ufbxt_hintf("time=%f", times[j]);
+				ufbxt_assert(values[j] == ufbx_evaluate_curve(curve, times[j], -1.0f));
+			}
+		}
+	}
+
+	for (size_t i = 0; i < num_samples; i++) {
+		times[i] = (double)i / 240.0 - 0.5;
+	}
+
+	for (size_t i = 0; i < scene->anim_values.count; i++) {
+		const ufbx_anim_value *anim_value = scene->anim_values.data[i];
+		ufbx_evaluate_anim_value_batch_vec3(anim_value, times, num_samples, vec_values);
+		for (size_t j = 0; j < num_samples; j++) {
+			ufbx_vec3 ref = ufbx_evaluate_anim_value_vec3(anim_value, times[j]);
+			ufbxt_assert(ref.x == vec_values[j].x && ref.y == vec_values[j].y && ref.z == vec_values[j].z);
+		}
+	}
+
+	free(vec_values);
+	free(values);
+	free(times);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(curve_batch_interpolation_modes, maya_interpolation_modes)
+#if UFBXT_IMPL
+{
+	ufbxt_check_curve_batch(scene);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(curve_batch_anim_interpolation, maya_anim_interpolation)
+#if UFBXT_IMPL
+{
+	ufbxt_check_curve_batch(scene);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(curve_batch_auto_clamp, maya_auto_clamp)
+#if UFBXT_IMPL
+{
+	ufbxt_check_curve_batch(scene);
+}
+#endif
+
+#if UFBXT_IMPL
+static ufbx_load_opts ufbxt_compile_anim_curves_opts()
+{
+	ufbx_load_opts opts = { 0 };
+	opts.compile_anim_curves = true;
+	return opts;
+}
+
+// Returns the number of cubic segments evaluated directly as polynomials
+static size_t ufbxt_check_compiled_curves(ufbxt_diff_error *err, const ufbx_scene *scene)
+{
+	ufbxt_assert(scene->metadata.compiled_anim_curve_memory > 0);
+
+	size_t num_polynomial = 0;
+	for (size_t i = 0; i < scene->anim_curves.count; i++) {
+		const ufbx_anim_curve *curve = scene->anim_curves.data[i];
+		if (curve->keyframes.count < 2) continue;
+		ufbxt_assert(curve->segments.count + 1 == curve->keyframes.count);
+
+		for (size_t j = 0; j < curve->segments.count; j++) {
+			if (curve->keyframes.data[j].interpolation != UFBX_INTERPOLATION_CUBIC) continue;
+			if (curve->segments.data[j].type == UFBX_CURVE_SEGMENT_POLYNOMIAL) num_polynomial++;
+		}
+
+		// Compare against evaluating the keyframes directly
+		ufbx_anim_curve plain = *curve;
+		memset(&plain.segments, 0, sizeof(plain.segments));
+
+		double begin = curve->keyframes.data[0].time - 0.5;
+		double end = curve->keyframes.data[curve->keyframes.count - 1].time + 0.5;
+		size_t num_samples = 1024;
+		for (size_t j = 0; j <= num_samples; j++) {
+			double time = begin + (end - begin) * (double)j / (double)num_samples;
+			ufbxt_hintf("time=%f", time);
+			ufbx_real ref = ufbx_evaluate_curve(&plain, time, 0.0f);
+			ufbx_real value = ufbx_evaluate_curve(curve, time, 0.0f);
+			ufbxt_assert_close_real(err, value, ref);
+		}
+
+		for (size_t j = 0; j < curve->keyframes.count; j++) {
+			double time = curve->keyframes.data[j].time;
+			ufbxt_assert(ufbx_evaluate_curve(curve, time, 0.0f) == ufbx_evaluate_curve(&plain, time, 0.0f));
+		}
+	}
+
+	// Cursors and batches must match the compiled evaluation exactly
+	ufbxt_check_curve_cursors(scene);
+	ufbxt_check_curve_batch(scene);
+
+	return num_polynomial;
+}
+#endif
+
+UFBXT_FILE_TEST_OPTS_ALT(compile_anim_curves_interpolation_modes, maya_interpolation_modes, ufbxt_compile_anim_curves_opts)
+#if UFBXT_IMPL
+{
+	ufbxt_check_compiled_curves(err, scene);
+}
+#endif
+
+UFBXT_FILE_TEST_OPTS_ALT(compile_anim_curves_anim_interpolation, maya_anim_interpolation, ufbxt_compile_anim_curves_opts)
+#if UFBXT_IMPL
+{
+	ufbxt_check_compiled_curves(err, scene);
+}
+#endif
+
+UFBXT_FILE_TEST_OPTS_ALT(compile_anim_curves_auto_clamp, maya_auto_clamp, ufbxt_compile_anim_curves_opts)
+#if UFBXT_IMPL
+{
+	ufbxt_check_compiled_curves(err, scene);
+}
+#endif
+
+UFBXT_FILE_TEST_OPTS_ALT(compile_anim_curves_transform_animation, maya_transform_animation, ufbxt_compile_anim_curves_opts)
+#if UFBXT_IMPL
+{
+	// Maya writes default tangent weights as `0.333333`
+	size_t num_polynomial = ufbxt_check_compiled_curves(err, scene);
+	ufbxt_assert(num_polynomial > 0);
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_evaluate_pose(ufbxt_diff_error *err, ufbx_scene *scene, double time)
+{
+	size_t num_nodes = scene->nodes.count;
+	ufbx_transform *local = (ufbx_transform*)malloc(num_nodes * sizeof(ufbx_transform));
+	ufbx_matrix *world = (ufbx_matrix*)malloc(num_nodes * sizeof(ufbx_matrix));
+	ufbx_matrix *geometry_world = (ufbx_matrix*)malloc(num_nodes * sizeof(ufbx_matrix));
+	ufbx_transform *world_transform = (ufbx_transform*)malloc(num_nodes * sizeof(ufbx_transform));
+	ufbxt_assert(local && world && geometry_world && world_transform);
+
+	ufbx_evaluate_pose_opts opts = { 0 };
+	opts.geometry_to_world_out = geometry_world;
+	ufbx_evaluate_pose(scene, NULL, time, local, world, &opts);
+
+	ufbx_scene *state = ufbx_evaluate_scene(scene, NULL, time, NULL, NULL);
+	ufbxt_assert(state);
+	ufbxt_assert(state->nodes.count == num_nodes);
+
+	// The pose should be identical to the evaluated scene
+	for (size_t i = 0; i < num_nodes; i++) {
+		const ufbx_node *node = state->nodes.data[i];
+		ufbxt_hintf("time=%f node=%s", time, node->name.data);
+		ufbxt_assert(!memcmp(&local[i], &node->local_transform, sizeof(ufbx_transform)));
+		ufbxt_assert(!memcmp(&world[i], &node->node_to_world, sizeof(ufbx_matrix)));
+		ufbxt_assert(!memcmp(&geometry_world[i], &node->geometry_to_world, sizeof(ufbx_matrix)));
+
+		ufbx_transform ref = ufbx_evaluate_transform(&scene->anim, scene->nodes.data[i], time);
+		ufbxt_assert_close_vec3(err, local[i].translation, ref.translation);
+		ufbxt_assert_close_quat(err, local[i].rotation, ref.rotation);
+		ufbxt_assert_close_vec3(err, local[i].scale, ref.scale);
+	}
+
+	// World transforms carried from the parents
+	memset(world, 0, num_nodes * sizeof(ufbx_matrix));
+	opts.world_transform_out = world_transform;
+	ufbx_evaluate_pose(scene, NULL, time, local, world, &opts);
+	for (size_t i = 0; i < num_nodes; i++) {
+		const ufbx_node *node = state->nodes.data[i];
+		ufbxt_hintf("time=%f node=%s", time, node->name.data);
+		ufbxt_assert(!memcmp(&world[i], &node->node_to_world, sizeof(ufbx_matrix)));
+		ufbxt_assert(!memcmp(&world_transform[i], &node->world_transform, sizeof(ufbx_transform)));
+	}
+
+	// Local transforms only
+	memset(local, 0, num_nodes * sizeof(ufbx_transform));
+	ufbx_evaluate_pose(scene, NULL, time, local, NULL, NULL);
+	for (size_t i = 0; i < num_nodes; i++) {
+		ufbxt_assert(!memcmp(&local[i], &state->nodes.data[i]->local_transform, sizeof(ufbx_transform)));
+	}
+
+	ufbx_free_scene(state);
+	free(world_transform);
+	free(geometry_world);
+	free(world);
+	free(local);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_pose_transform_animation, maya_transform_animation)
+#if UFBXT_IMPL
+{
+	for (int frame = 0; frame <= 30; frame += 5) {
+		ufbxt_check_evaluate_pose(err, scene, (double)frame / 24.0);
+	}
+}
+#endif
+
+UFBXT_FILE_TEST_OPTS_ALT(evaluate_pose_scale_no_inherit, maya_scale_no_inherit, ufbxt_scale_to_cm_opts)
+#if UFBXT_IMPL
+{
+	ufbxt_check_evaluate_pose(err, scene, 0.0);
+	ufbxt_check_evaluate_pose(err, scene, 1.0);
+}
+#endif
+
+UFBXT_FILE_TEST_ALT(evaluate_pose_geometry_transform, max_geometry_transform)
+#if UFBXT_IMPL
+{
+	ufbxt_check_evaluate_pose(err, scene, 0.0);
+	ufbxt_check_evaluate_pose(err, scene, 1.0);
+}
+#endif
@@ -132,3 +132,635 @@ UFBXT_TEST(obj_open_memory_ref)
 	ufbxt_do_open_memory_test("blender_279_ball", 1, 2, ufbxt_open_file_memory_ref);
 }
 #endif
+
+UFBXT_TEST(incremental_load)
+#if UFBXT_IMPL
+{
+	char path[512];
+	ufbxt_file_iterator iter = { "maya_cache_sine" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		ufbx_load_opts opts = { 0 };
+		opts.load_external_files = true;
+
+		ufbx_error error;
+		ufbx_scene *ref = ufbx_load_file(path, &opts, &error);
+		if (!ref) ufbxt_log_error(&error);
+		ufbxt_assert(ref);
+
+		ufbx_loader *loader = ufbx_load_begin_file(path, &opts, &error);
+		ufbxt_assert(loader);
+
+		ufbx_load_status status = { UFBX_LOAD_PHASE_HEADER };
+		ufbx_load_phase prev_phase = UFBX_LOAD_PHASE_HEADER;
+		size_t num_object_steps = 0;
+		while (ufbx_load_step(loader, 256, &status)) {
+			ufbxt_assert(!status.failed);
+			ufbxt_assert(status.phase >= prev_phase);
+			ufbxt_assert(status.progress.bytes_read <= status.progress.bytes_total);
+			if (status.phase == UFBX_LOAD_PHASE_OBJECTS) num_object_steps++;
+			prev_phase = status.phase;
+		}
+		ufbxt_assert(!status.failed);
+		ufbxt_assert(status.phase == UFBX_LOAD_PHASE_DONE);
+		ufbxt_assert(num_object_steps > 1);
+
+		ufbx_scene *scene = ufbx_load_finish(loader, &error);
+		if (!scene) ufbxt_log_error(&error);
+		ufbxt_assert(scene);
+		ufbxt_check_scene(scene);
+
+		ufbxt_assert(scene->elements.count == ref->elements.count);
+		ufbxt_assert(scene->connections_src.count == ref->connections_src.count);
+		ufbxt_assert(scene->cache_files.count == ref->cache_files.count);
+
+		ufbx_free_scene(scene);
+		ufbx_free_scene(ref);
+	}
+}
+#endif
+
+UFBXT_TEST(incremental_load_cancel)
+#if UFBXT_IMPL
+{
+	char path[512];
+	ufbxt_file_iterator iter = { "maya_cache_sine" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		ufbx_error error;
+		ufbx_loader *loader = ufbx_load_begin_file(path, NULL, &error);
+		ufbxt_assert(loader);
+
+		ufbx_load_status status;
+		ufbxt_assert(ufbx_load_step(loader, 0, &status));
+		ufbxt_assert(ufbx_load_step(loader, 0, &status));
+		ufbxt_assert(status.phase == UFBX_LOAD_PHASE_OBJECTS);
+
+		ufbx_scene *scene = ufbx_load_finish(loader, &error);
+		ufbxt_assert(!scene);
+		ufbxt_assert(error.type == UFBX_ERROR_CANCELLED);
+	}
+}
+#endif
+
+UFBXT_TEST(probe_file)
+#if UFBXT_IMPL
+{
+	char path[512];
+	ufbxt_file_iterator iter = { "maya_character" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		ufbx_error error;
+		ufbx_scene *ref = ufbx_load_file(path, NULL, &error);
+		if (!ref) ufbxt_log_error(&error);
+		ufbxt_assert(ref);
+
+		ufbx_probe *probe = ufbx_probe_file(path, NULL, &error);
+		if (!probe) ufbxt_log_error(&error);
+		ufbxt_assert(probe);
+
+		size_t size = 0;
+		void *data = ufbxt_read_file(path, &size);
+		ufbxt_assert(data);
+		ufbx_probe *mem_probe = ufbx_probe_memory(data, size, NULL, &error);
+		if (!mem_probe) ufbxt_log_error(&error);
+		ufbxt_assert(mem_probe);
+		free(data);
+
+		ufbx_probe *probes[] = { probe, mem_probe };
+		for (size_t i = 0; i < ufbxt_arraycount(probes); i++) {
+			ufbx_probe *p = probes[i];
+			ufbxt_assert(p->metadata.file_format == ref->metadata.file_format);
+			ufbxt_assert(p->metadata.version == ref->metadata.version);
+			ufbxt_assert(p->metadata.ascii == ref->metadata.ascii);
+			ufbxt_assert(p->metadata.big_endian == ref->metadata.big_endian);
+			ufbxt_assert(p->metadata.exporter == ref->metadata.exporter);
+			ufbxt_assert(p->metadata.exporter_version == ref->metadata.exporter_version);
+			ufbxt_assert(!strcmp(p->metadata.creator.data, ref->metadata.creator.data));
+			ufbxt_assert(!strcmp(p->metadata.original_application.name.data, ref->metadata.original_application.name.data));
+
+			ufbxt_assert(p->settings.axes.up == ref->settings.axes.up);
+			ufbxt_assert(p->settings.axes.front == ref->settings.axes.front);
+			ufbxt_assert(p->settings.axes.right == ref->settings.axes.right);
+			ufbxt_assert(p->settings.unit_meters == ref->settings.unit_meters);
+			ufbxt_assert(p->settings.frames_per_second == ref->settings.frames_per_second);
+			ufbxt_assert(p->settings.time_mode == ref->settings.time_mode);
+
+			// The root node is not counted
+			ufbxt_assert(p->element_counts[UFBX_ELEMENT_NODE] + 1 == ref->nodes.count);
+			ufbxt_assert(p->element_counts[UFBX_ELEMENT_MESH] == ref->meshes.count);
+			ufbxt_assert(p->element_counts[UFBX_ELEMENT_MATERIAL] == ref->materials.count);
+			ufbxt_assert(p->element_counts[UFBX_ELEMENT_SKIN_CLUSTER] == ref->skin_clusters.count);
+			ufbxt_assert(p->num_objects > 0);
+		}
+
+		ufbx_free_probe(mem_probe);
+		ufbx_free_probe(probe);
+		ufbx_free_scene(ref);
+	}
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_snapshot_dom(const ufbx_dom_node *a, const ufbx_dom_node *b)
+{
+	ufbxt_assert(a != b);
+	ufbxt_assert(!strcmp(a->name.data, b->name.data));
+	ufbxt_assert(a->children.count == b->children.count);
+	ufbxt_assert(a->values.count == b->values.count);
+
+	for (size_t i = 0; i < a->values.count; i++) {
+		const ufbx_dom_value *va = &a->values.data[i];
+		const ufbx_dom_value *vb = &b->values.data[i];
+		ufbxt_assert(va->type == vb->type);
+		ufbxt_assert(va->value_int == vb->value_int);
+		ufbxt_assert(!strcmp(va->value_str.data, vb->value_str.data));
+		ufbxt_assert(va->value_blob.size == vb->value_blob.size);
+		if (va->value_blob.size > 0) {
+			ufbxt_assert(va->value_blob.data != vb->value_blob.data);
+		}
+
+		// Raw string arrays contain pointers that must be relocated
+		if (va->type == UFBX_DOM_VALUE_ARRAY_RAW_STRING) {
+			const ufbx_blob *ba = (const ufbx_blob*)va->value_blob.data;
+			const ufbx_blob *bb = (const ufbx_blob*)vb->value_blob.data;
+			for (size_t j = 0; j < (size_t)va->value_int; j++) {
+				ufbxt_assert(ba[j].size == bb[j].size);
+				if (ba[j].size == 0) continue;
+				ufbxt_assert(ba[j].data != bb[j].data);
+				ufbxt_assert(!memcmp(ba[j].data, bb[j].data, ba[j].size));
+			}
+		} else if (va->value_blob.size > 0) {
+			ufbxt_assert(!memcmp(va->value_blob.data, vb->value_blob.data, va->value_blob.size));
+		}
+	}
+
+	for (size_t i = 0; i < a->children.count; i++) {
+		ufbxt_check_snapshot_dom(a->children.data[i], b->children.data[i]);
+	}
+}
+#endif
+
+UFBXT_TEST(scene_snapshot)
+#if UFBXT_IMPL
+{
+	static const char *const names[] = { "maya_character", "zbrush_d20" };
+
+	char path[512];
+	for (size_t name_ix = 0; name_ix < ufbxt_arraycount(names); name_ix++) {
+		for (int retain_dom = 0; retain_dom <= 1; retain_dom++) {
+			ufbxt_file_iterator iter = { names[name_ix] };
+			while (ufbxt_next_file(&iter, path, sizeof(path))) {
+				ufbxt_hintf("retain_dom=%d", retain_dom);
+
+				ufbx_load_opts load_opts = { 0 };
+				load_opts.retain_dom = retain_dom != 0;
+
+				ufbx_error error;
+				ufbx_scene *ref = ufbx_load_file(path, &load_opts, &error);
+				if (!ref) ufbxt_log_error(&error);
+				ufbxt_assert(ref);
+
+				ufbx_snapshot_opts opts = { 0 };
+				opts.key = 0x1234;
+
+				ufbx_snapshot *snapshot = ufbx_save_scene_snapshot(ref, &opts, &error);
+				if (!snapshot) ufbxt_log_error(&error);
+				ufbxt_assert(snapshot);
+				ufbxt_assert(snapshot->size > 0);
+
+				// The loaded scene does not refer to the snapshot
+				void *data = malloc(snapshot->size);
+				ufbxt_assert(data);
+				memcpy(data, snapshot->data, snapshot->size);
+				size_t data_size = snapshot->size;
+				ufbx_free_snapshot(snapshot);
+
+				ufbx_scene *scene = ufbx_load_scene_snapshot_memory(data, data_size, &opts, &error);
+				if (!scene) ufbxt_log_error(&error);
+				ufbxt_assert(scene);
+
+				ufbx_snapshot_opts bad_opts = { 0 };
+				bad_opts.key = 0x4321;
+				ufbx_scene *bad_scene = ufbx_load_scene_snapshot_memory(data, data_size, &bad_opts, &error);
+				ufbxt_assert(!bad_scene);
+				ufbxt_assert(error.type == UFBX_ERROR_SNAPSHOT_MISMATCH);
+
+				bad_scene = ufbx_load_scene_snapshot_memory(data, data_size / 2, &opts, &error);
+				ufbxt_assert(!bad_scene);
+				ufbxt_assert(error.type == UFBX_ERROR_TRUNCATED_FILE);
+
+				free(data);
+
+				ufbxt_check_scene(scene);
+
+				ufbxt_assert(scene->elements.count == ref->elements.count);
+				for (size_t i = 0; i < scene->elements.count; i++) {
+					ufbx_element *a = scene->elements.data[i];
+					ufbx_element *b = ref->elements.data[i];
+					ufbxt_assert(a != b);
+					ufbxt_assert(a->type == b->type);
+					ufbxt_assert(a->element_id == b->element_id);
+					ufbxt_assert(!strcmp(a->name.data, b->name.data));
+					ufbxt_assert(a->props.props.count == b->props.props.count);
+				}
+
+				ufbxt_assert(scene->meshes.count == ref->meshes.count);
+				for (size_t i = 0; i < scene->meshes.count; i++) {
+					ufbx_mesh *a = scene->meshes.data[i];
+					ufbx_mesh *b = ref->meshes.data[i];
+					ufbxt_assert(a->num_indices == b->num_indices);
+					ufbxt_assert(a->vertex_position.values.data != b->vertex_position.values.data);
+					for (size_t ix = 0; ix < a->num_indices; ix++) {
+						ufbx_vec3 pa = ufbx_get_vertex_vec3(&a->vertex_position, ix);
+						ufbx_vec3 pb = ufbx_get_vertex_vec3(&b->vertex_position, ix);
+						ufbxt_assert(pa.x == pb.x && pa.y == pb.y && pa.z == pb.z);
+					}
+				}
+
+				ufbxt_assert((scene->dom_root != NULL) == (retain_dom != 0));
+				if (scene->dom_root) {
+					ufbxt_check_snapshot_dom(scene->dom_root, ref->dom_root);
+				}
+
+				ufbx_free_scene(ref);
+
+				// Snapshot scenes are fully functional after the original is gone
+				ufbx_scene *state = ufbx_evaluate_scene(scene, &scene->anim, 1.0, NULL, &error);
+				if (!state) ufbxt_log_error(&error);
+				ufbxt_assert(state);
+				ufbxt_check_scene(state);
+				ufbx_free_scene(state);
+
+				ufbx_free_scene(scene);
+			}
+		}
+	}
+}
+#endif
+
+UFBXT_TEST(load_context_reuse)
+#if UFBXT_IMPL
+{
+	ufbx_error error;
+	ufbx_load_context *context = ufbx_create_load_context(NULL, &error);
+	if (!context) ufbxt_log_error(&error);
+	ufbxt_assert(context);
+
+	static const char *const names[] = { "maya_cube", "maya_character", "blender_279_ball", "maya_cube" };
+
+	char path[512];
+	for (size_t name_ix = 0; name_ix < ufbxt_arraycount(names); name_ix++) {
+		ufbxt_file_iterator iter = { names[name_ix] };
+		while (ufbxt_next_file(&iter, path, sizeof(path))) {
+			ufbx_scene *ref = ufbx_load_file(path, NULL, &error);
+			if (!ref) ufbxt_log_error(&error);
+			ufbxt_assert(ref);
+
+			ufbx_load_opts opts = { 0 };
+			opts.load_context = context;
+			ufbx_scene *scene = ufbx_load_file(path, &opts, &error);
+			if (!scene) ufbxt_log_error(&error);
+			ufbxt_assert(scene);
+			ufbxt_check_scene(scene);
+
+			ufbxt_assert(scene->elements.count == ref->elements.count);
+			for (size_t i = 0; i < scene->elements.count; i++) {
+				ufbx_element *a = scene->elements.data[i];
+				ufbx_element *b = ref->elements.data[i];
+				ufbxt_assert(a->type == b->type);
+				ufbxt_assert(!strcmp(a->name.data, b->name.data));
+				ufbxt_assert(a->props.props.count == b->props.props.count);
+			}
+
+			// Property types are resolved using the retained tables
+			for (size_t i = 0; i < scene->nodes.count; i++) {
+				ufbx_prop *a = ufbx_find_prop(&scene->nodes.data[i]->props, "Lcl Translation");
+				ufbx_prop *b = ufbx_find_prop(&ref->nodes.data[i]->props, "Lcl Translation");
+				ufbxt_assert((a == NULL) == (b == NULL));
+				if (a) ufbxt_assert(a->type == b->type);
+			}
+
+			ufbx_free_scene(scene);
+			ufbx_free_scene(ref);
+		}
+	}
+
+	// Nested loads using the same context fall back to normal allocation
+	{
+		ufbxt_file_iterator iter = { "maya_cube" };
+		ufbxt_assert(ufbxt_next_file(&iter, path, sizeof(path)));
+
+		ufbx_load_opts opts = { 0 };
+		opts.load_context = context;
+		ufbx_loader *loader = ufbx_load_begin_file(path, &opts, &error);
+		if (!loader) ufbxt_log_error(&error);
+		ufbxt_assert(loader);
+		ufbxt_assert(ufbx_load_step(loader, 1, NULL));
+
+		ufbx_scene *inner = ufbx_load_file(path, &opts, &error);
+		if (!inner) ufbxt_log_error(&error);
+		ufbxt_assert(inner);
+		ufbx_free_scene(inner);
+
+		while (ufbx_load_step(loader, SIZE_MAX, NULL)) { }
+		ufbx_scene *outer = ufbx_load_finish(loader, &error);
+		if (!outer) ufbxt_log_error(&error);
+		ufbxt_assert(outer);
+		ufbx_free_scene(outer);
+	}
+
+	ufbx_free_load_context(context);
+}
+#endif
+
+UFBXT_TEST(load_files_batch)
+#if UFBXT_IMPL
+{
+	static const char *const names[] = { "maya_cube", "maya_character", NULL, "blender_279_ball", "maya_cube" };
+
+	char paths[ufbxt_arraycount(names)][512];
+	const char *filenames[ufbxt_arraycount(names)];
+	for (size_t i = 0; i < ufbxt_arraycount(names); i++) {
+		if (names[i]) {
+			ufbxt_file_iterator iter = { names[i] };
+			ufbxt_assert(ufbxt_next_file(&iter, paths[i], sizeof(paths[i])));
+		} else {
+			strcpy(paths[i], "batch_file_that_does_not_exist.fbx");
+		}
+		filenames[i] = paths[i];
+	}
+
+	ufbx_batch_load_opts opts = { 0 };
+	opts.pool.run_fn = &ufbxt_serial_pool_run;
+	opts.pool.wait_fn = &ufbxt_serial_pool_wait;
+	opts.pool.user = &ufbxt_serial_pool;
+	opts.num_workers = 2;
+	opts.share_strings = true;
+
+	ufbx_error error;
+	ufbx_batch_result *result = ufbx_load_files_batch(filenames, ufbxt_arraycount(names), NULL, &opts, &error);
+	if (!result) ufbxt_log_error(&error);
+	ufbxt_assert(result);
+	ufbxt_assert(result->num_files == ufbxt_arraycount(names));
+	ufbxt_assert(result->num_failed == 1);
+
+	for (size_t i = 0; i < ufbxt_arraycount(names); i++) {
+		ufbx_scene *scene = result->scenes[i];
+		if (!names[i]) {
+			ufbxt_assert(!scene);
+			ufbxt_assert(result->errors[i].type == UFBX_ERROR_FILE_NOT_FOUND);
+			continue;
+		}
+
+		ufbxt_assert(scene);
+		ufbxt_assert(result->errors[i].type == UFBX_ERROR_NONE);
+		ufbxt_check_scene(scene);
+
+		ufbx_scene *ref = ufbx_load_file(filenames[i], NULL, &error);
+		if (!ref) ufbxt_log_error(&error);
+		ufbxt_assert(ref);
+		ufbxt_assert(scene->elements.count == ref->elements.count);
+		for (size_t j = 0; j < scene->elements.count; j++) {
+			ufbxt_assert(!strcmp(scene->elements.data[j]->name.data, ref->elements.data[j]->name.data));
+		}
+		ufbx_free_scene(ref);
+	}
+
+	// Identical files share all of their strings
+	ufbx_scene *a = result->scenes[0], *b = result->scenes[4];
+	ufbxt_assert(result->shared_string_size > 0);
+	ufbxt_assert(a->nodes.count == b->nodes.count);
+	for (size_t i = 0; i < a->nodes.count; i++) {
+		ufbxt_assert(a->nodes.data[i]->name.data == b->nodes.data[i]->name.data);
+	}
+
+	// Scenes can outlive the result
+	ufbx_scene *kept = result->scenes[1];
+	ufbx_retain_scene(kept);
+	ufbx_free_batch_result(result);
+	ufbxt_check_scene(kept);
+	ufbx_free_scene(kept);
+
+	// Per-load pools are ignored when running on the batch pool, the serial test pool
+	// fails if tasks are dispatched from inside a task
+	{
+		ufbx_load_opts load_opts = { 0 };
+		load_opts.thread_opts.pool = opts.pool;
+		load_opts.read_ahead.pool = opts.pool;
+		load_opts.read_ahead.chunk_size = 256;
+		opts.share_strings = false;
+		result = ufbx_load_files_batch(filenames, ufbxt_arraycount(names), &load_opts, &opts, &error);
+		if (!result) ufbxt_log_error(&error);
+		ufbxt_assert(result);
+		ufbxt_assert(result->num_failed == 1);
+		for (size_t i = 0; i < ufbxt_arraycount(names); i++) {
+			if (!names[i]) continue;
+			ufbxt_assert(result->scenes[i]);
+			ufbxt_assert(result->scenes[i]->metadata.io_stats.bytes_read > 0);
+			ufbxt_check_scene(result->scenes[i]);
+		}
+		ufbx_free_batch_result(result);
+	}
+
+	// Serial loading without a thread pool
+	result = ufbx_load_files_batch(filenames, 2, NULL, NULL, &error);
+	if (!result) ufbxt_log_error(&error);
+	ufbxt_assert(result);
+	ufbxt_assert(result->num_failed == 0);
+	ufbxt_assert(result->shared_string_size == 0);
+	ufbx_free_batch_result(result);
+}
+#endif
+
+UFBXT_TEST(load_read_ahead)
+#if UFBXT_IMPL
+{
+	static const char *const names[] = { "maya_cube", "maya_slime", "blender_279_ball" };
+
+	ufbx_thread_pool pool = { 0 };
+	pool.run_fn = &ufbxt_serial_pool_run;
+	pool.wait_fn = &ufbxt_serial_pool_wait;
+	pool.user = &ufbxt_serial_pool;
+
+	ufbx_error error;
+	char path[512];
+	for (size_t name_ix = 0; name_ix < ufbxt_arraycount(names); name_ix++) {
+		ufbxt_file_iterator iter = { names[name_ix] };
+		while (ufbxt_next_file(&iter, path, sizeof(path))) {
+			ufbx_scene *ref = ufbx_load_file(path, NULL, &error);
+			if (!ref) ufbxt_log_error(&error);
+			ufbxt_assert(ref);
+			ufbxt_assert(ref->metadata.io_stats.bytes_read > 0);
+			ufbxt_assert(ref->metadata.io_stats.num_waits == ref->metadata.io_stats.num_reads);
+
+			// Small chunks to exercise the ring buffer, share the pool with array decoding
+			ufbx_load_opts opts = { 0 };
+			opts.read_ahead.pool = pool;
+			opts.read_ahead.num_chunks = 3;
+			opts.read_ahead.chunk_size = 100;
+			opts.thread_opts.pool = pool;
+			ufbx_scene *scene = ufbx_load_file(path, &opts, &error);
+			if (!scene) ufbxt_log_error(&error);
+			ufbxt_assert(scene);
+			ufbxt_check_scene(scene);
+
+			ufbx_io_stats stats = scene->metadata.io_stats;
+			ufbxt_assert(stats.bytes_read >= ref->metadata.io_stats.bytes_read);
+			ufbxt_assert(stats.bytes_read <= ref->metadata.io_stats.bytes_read + 3 * 100);
+			ufbxt_assert(stats.num_reads > 0 && stats.num_waits > 0);
+			ufbxt_assert(stats.wait_time >= 0.0);
+
+			ufbxt_assert(scene->elements.count == ref->elements.count);
+			for (size_t i = 0; i < scene->elements.count; i++) {
+				ufbxt_assert(!strcmp(scene->elements.data[i]->name.data, ref->elements.data[i]->name.data));
+			}
+			ufbxt_assert(scene->meshes.count == ref->meshes.count);
+			for (size_t i = 0; i < scene->meshes.count; i++) {
+				ufbx_mesh *a = scene->meshes.data[i], *b = ref->meshes.data[i];
+				ufbxt_assert(a->num_indices == b->num_indices);
+				for (size_t j = 0; j < a->vertices.count; j++) {
+					ufbxt_assert(a->vertices.data[j].x == b->vertices.data[j].x);
+					ufbxt_assert(a->vertices.data[j].y == b->vertices.data[j].y);
+					ufbxt_assert(a->vertices.data[j].z == b->vertices.data[j].z);
+				}
+			}
+
+			ufbx_free_scene(scene);
+			ufbx_free_scene(ref);
+		}
+	}
+
+	// Geometry cache headers
+	{
+		char buf[512];
+		snprintf(buf, sizeof(buf), "%s%s", data_root, "caches/sine_mcmf_undersample/cache.xml");
+
+		ufbx_geometry_cache_opts opts = { 0 };
+		opts.read_ahead.pool = pool;
+		opts.read_ahead.chunk_size = 64;
+		ufbx_geometry_cache *cache = ufbx_load_geometry_cache(buf, &opts, &error);
+		if (!cache) ufbxt_log_error(&error);
+		ufbxt_assert(cache);
+		ufbxt_assert(cache->channels.count == 2);
+		ufbxt_assert(cache->io_stats.bytes_read > 0);
+		ufbxt_assert(cache->io_stats.num_reads > 0);
+		ufbx_free_geometry_cache(cache);
+	}
+}
+#endif
+
+UFBXT_TEST(load_stats)
+#if UFBXT_IMPL
+{
+	ufbx_error error;
+	char path[512];
+
+	bool found_ascii = false, found_compressed = false;
+	ufbxt_file_iterator iter = { "maya_slime" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		ufbx_scene *ref = ufbx_load_file(path, NULL, &error);
+		if (!ref) ufbxt_log_error(&error);
+		ufbxt_assert(ref);
+		ufbxt_assert(!ref->metadata.load_stats.collected);
+		ufbxt_assert(ref->metadata.load_stats.total_time == 0.0);
+		ufbxt_assert(ref->metadata.load_stats.total_cpu_time == 0.0);
+		ufbxt_assert(ref->metadata.load_stats.num_arrays == 0);
+		ufbx_free_scene(ref);
+
+		ufbx_load_opts opts = { 0 };
+		opts.collect_stats = true;
+		ufbx_scene *scene = ufbx_load_file(path, &opts, &error);
+		if (!scene) ufbxt_log_error(&error);
+		ufbxt_assert(scene);
+
+		ufbx_load_stats stats = scene->metadata.load_stats;
+		ufbxt_assert(stats.collected);
+		ufbxt_assert(stats.total_time > 0.0);
+		ufbxt_assert(stats.parse_time > 0.0);
+		ufbxt_assert(stats.detect_format_time + stats.parse_time + stats.pre_finalize_time
+			+ stats.finalize_time + stats.conversion_time <= stats.total_time);
+		ufbxt_assert(stats.inflate_time <= stats.parse_time);
+		ufbxt_assert(stats.ascii_number_time <= stats.parse_time);
+
+		// CPU times are measured over the same spans
+		ufbxt_assert(stats.total_cpu_time >= 0.0);
+		ufbxt_assert(stats.parse_cpu_time >= 0.0);
+		ufbxt_assert(stats.detect_format_cpu_time + stats.parse_cpu_time + stats.pre_finalize_cpu_time
+			+ stats.finalize_cpu_time + stats.conversion_cpu_time <= stats.total_cpu_time);
+		ufbxt_assert(stats.inflate_cpu_time <= stats.parse_cpu_time);
+		ufbxt_assert(stats.ascii_number_cpu_time <= stats.parse_cpu_time);
+		ufbxt_assert(stats.num_arrays > 0);
+		ufbxt_assert(stats.num_compressed_arrays <= stats.num_arrays);
+		ufbxt_assert(stats.string_pool_misses > 0);
+		ufbxt_assert(stats.string_pool_hits > 0);
+		ufbxt_assert(stats.map_entries > 0);
+		ufbxt_assert(stats.map_avg_probe_length >= 1.0);
+		ufbxt_assert((double)stats.map_max_probe_length >= stats.map_avg_probe_length);
+
+		if (scene->metadata.ascii) {
+			found_ascii = true;
+			ufbxt_assert(stats.ascii_number_time > 0.0);
+			ufbxt_assert(stats.num_compressed_arrays == 0);
+		}
+		if (stats.num_compressed_arrays > 0) {
+			found_compressed = true;
+			ufbxt_assert(stats.inflate_time > 0.0);
+			ufbxt_assert(stats.inflate_compressed_bytes > 0);
+			ufbxt_assert(stats.inflate_decompressed_bytes > stats.inflate_compressed_bytes);
+		}
+
+		ufbx_free_scene(scene);
+	}
+
+	ufbxt_assert(found_ascii);
+	ufbxt_assert(found_compressed);
+}
+#endif
+
+UFBXT_TEST(load_skip_deflate_checksums)
+#if UFBXT_IMPL
+{
+	ufbx_thread_pool pool = { 0 };
+	pool.run_fn = &ufbxt_serial_pool_run;
+	pool.wait_fn = &ufbxt_serial_pool_wait;
+	pool.user = &ufbxt_serial_pool;
+
+	char path[512];
+	ufbxt_file_iterator iter = { "maya_slime" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		size_t size = 0;
+		char *data = (char*)ufbxt_read_file(path, &size);
+		ufbxt_assert(data);
+
+		// Corrupt the Adler-32 checksum of every DEFLATE compressed array
+		size_t num_corrupted = 0;
+		for (size_t i = 1; i + 12 < size; i++) {
+			if (data[i - 1] == 0 || !strchr("fdilb", data[i - 1]) || ufbxt_read_u32(data + i + 4) != 1) continue;
+			size_t encoded_size = ufbxt_read_u32(data + i + 8);
+			if ((uint8_t)data[i + 12] != 0x78 || encoded_size < 6 || encoded_size > size - i - 12) continue;
+			data[i + 12 + encoded_size - 1] ^= 0xff;
+			num_corrupted++;
+		}
+		if (num_corrupted == 0) {
+			free(data);
+			continue;
+		}
+
+		for (int threaded = 0; threaded <= 1; threaded++) {
+			ufbx_load_opts opts = { 0 };
+			if (threaded) opts.thread_opts.pool = pool;
+
+			ufbx_error error;
+			ufbx_scene *scene = ufbx_load_memory(data, size, &opts, &error);
+			ufbxt_assert(!scene);
+
+			opts.skip_deflate_checksums = true;
+			scene = ufbx_load_memory(data, size, &opts, &error);
+			if (!scene) ufbxt_log_error(&error);
+			ufbxt_assert(scene);
+			ufbxt_check_scene(scene);
+			ufbx_free_scene(scene);
+		}
+
+		free(data);
+	}
+}
+#endif
@@ -812,6 +812,84 @@ UFBXT_DEFLATE_TEST(deflate_dynamic_distances_and_lengths)
 }
 #endif
 
+UFBXT_DEFLATE_TEST(deflate_overlapping_matches)
+#if UFBXT_IMPL
+{
+	// Repeating patterns of period 1-16 with various lengths separated by literals
+	char src[] =
+		"\x78\xda\xed\x87\x7d\x3c\xd3\x09\x1c\xc7\xd5\x35\x23\x44\x24\xa9\x17\x39\x6c\x6a"
+		"\x16\x16\xb5\x1a\x91\x6c\x9e\x7a\xb0\xdd\x95\x97\x43\xb2\xd8\x6e\xa5\x85\x4e\x27"
+		"\x0f\x43\x4c\x27\x96\x87\xcb\xe9\x41\x59\xa4\xf3\x90\xec\x7a\x90\x87\x56\xcd\x69"
+		"\x44\x31\x11\x8b\xca\x35\x64\x72\x16\x92\xa7\xcb\xc3\xfd\xfe\xf9\xfd\xfe\xf9\xfd"
+		"\xf9\xfb\xf7\xf7\x7d\xf8\x7c\xde\x6f\xa5\x52\xa9\xfc\xac\x64\x82\x13\x34\x79\x04"
+		"\x1a\xbb\xc1\x7c\xd8\x78\xda\x18\x22\x9d\x16\x25\x1d\x1d\xac\x99\xa9\x3e\xb0\xcc"
+		"\x38\x5d\x15\xb8\x25\x8a\xd0\x68\x68\xf3\x96\x96\x5b\xc3\x76\x24\xb3\x9d\x80\x74"
+		"\x93\x0b\x4f\x5f\x44\x57\xd7\x82\xdc\x4a\x06\x2e\x57\x6a\xae\xa1\x06\x1e\x37\x6c"
+		"\xfd\xb8\x04\xba\x17\xdd\x38\x56\x3a\xec\x2a\x88\xc2\x72\x2c\xd2\x7b\xe5\x44\x4d"
+		"\xb0\x47\x0f\x63\xfa\x79\xce\x3f\x18\xf8\x8f\x4c\xb7\xee\x67\x8e\xe0\xb7\xc8\x4f"
+		"\xa8\xa5\xe7\x43\xbf\x32\xec\x48\xb3\xbd\x21\xec\xbd\xb9\xfd\xfc\x15\xa5\x48\xff"
+		"\x92\x14\x87\xb7\x39\x8e\x7e\x3c\x56\xfc\x64\xd8\x75\x06\x08\x9a\xf4\xf0\x01\x61"
+		"\x54\x22\x18\x4c\x46\x68\xe3\xcc\x26\x39\x14\xeb\xb6\x91\x0d\x92\x63\x9f\xc3\x22"
+		"\x45\xfe\x2d\xef\x27\x8b\xdd\x48\x23\x6a\x0a\x97\x75\x82\xa3\x81\x86\xc5\xf9\x8e"
+		"\xc1\x44\x53\x23\x7f\x20\xb3\xc5\x6e\xb6\xb5\xee\x43\x65\x60\x7a\xac\xd6\x9c\xac"
+		"\x16\xae\x5e\x09\x25\x7e\xda\x5c\x78\x93\x86\xc3\xc3\x52\x29\x5e\xbb\xa7\xf2\x81"
+		"\xf5\x17\xa4\x69\xd5\xa5\xbb\x84\x6d\xf8\x5b\x1d\x4d\xcb\xcd\x36\x8e\x29\x5d\x65"
+		"\x8d\x23\x40\x29\x46\x09\xba\x05\xc4\x69\xad\xd3\x60\xed\x5c\x9c\x4d\xc6\x88\xaf"
+		"\x7a\xfd\x0c\x95\xaf\xa8\x7f\x29\xae\x44\x96\xc4\x82\xd5\x3b\x36\xf7\x59\x44\x51"
+		"\x18\x8d\x8a\xb4\x16\xef\xaf\x31\xbb\xe0\xbb\x73\x68\x02\x2d\x01\xb7\xb3\x61\xbe"
+		"\x50\x59\x8c\xd7\x03\x3a\xd3\x30\xab\xaa\x40\x93\x26\x1b\x66\x82\xad\x9d\x16\xe3"
+		"\xb9\xce\x71\x90\x2c\xb6\x82\x9a\xc5\x9e\x4c\x09\xc0\x4c\xe8\x07\xfc\x02\xeb\x8c"
+		"\xbb\x8c\xe6\x53\xc4\x8e\xc6\x3d\x43\x48\x7b\x38\xf4\x3b\x89\x48\x55\xc2\xd9\xea"
+		"\x82\x36\x37\xbe\x89\x58\x50\x7c\x4e\xe3\x1e\xc1\x00\x00\x85\x48\x2e\x98\x5b\x15"
+		"\x6e\xf6\x76\xb5\x1f\x08\xb7\x3d\xc6\xf7\x29\xe6\x89\x91\x1f\x72\x0f\x42\x90\x22"
+		"\x6c\x38\x9e\xef\x99\xb1\xc8\xee\xa0\xc0\x60\x79\xfd\xaa\xb5\xad\xce\xdf\x6c\x0f"
+		"\x7d\x3f\x82\x14\x3a\xdb\xce\x27\x7c\x99\x77\xbd\xd3\x37\x59\x84\x02\xf9\x68\xb7"
+		"\x6e\xea\x1e\x2d\xfd\x10\x9f\x28\x75\x80\x72\x8a\xab\x78\x4b\xdb\x96\x9c\x93\x58"
+		"\xff\x68\x81\x24\xe9\x64\x70\xc2\x4f\xd2\xa2\xef\x06\x16\x16\x42\x14\x12\x1e\x42"
+		"\xa2\xc6\xba\x6d\xe1\x37\x92\xfa\x60\x24\xdf\xcd\x6e\xd3\x24\xb1\xab\x6b\x1c\x45"
+		"\xc1\x48\xc9\x72\x7a\xbb\xb6\xc1\xf4\x5e\x66\x10\x85\xe3\x87\x12\x3d\xdb\x6e\x23"
+		"\x75\xd4\x8a\x54\xf2\x7c\xac\xb7\x0a\xc0\x77\x61\x4f\xd5\xd7\xb0\x03\xdb\x87\x6b"
+		"\x1e\xcb\x42\x40\x3c\x68\x87\xbd\x65\x2d\x63\x56\xf2\xb3\x1c\x19\x32\x08\xa9\xa5"
+		"\x8f\xdf\x07\xca\x8e\x05\x59\x56\x5e\x1d\xb7\x87\x21\xe6\xa1\xf1\xaf\x19\x57\x2a"
+		"\x4e\xca\x0e\x5b\x35\x2d\x22\x45\xee\xae\x16\x2d\x0a\x39\x26\x65\xa0\xd5\x38\x54"
+		"\x82\x22\x66\x2b\x3f\xe9\x42\xe5\x6b\xfb\x01\x2b\x23\x29\x43\x0a\xf0\x84\xef\x82"
+		"\xc9\xdb\x05\x79\xce\x4b\xe1\xa3\xdf\x67\xd2\x41\xce\xb9\xa4\x83\xe5\x19\xd2\x5f"
+		"\x35\x6d\x28\x7c\x61\x7c\x13\x62\xdc\xa9\xb7\x5f\x93\xe2\x8d\xb6\x8e\x79\xf1\x28"
+		"\xc6\x5d\x30\xfe\xe4\xc4\x59\xff\xd0\xc7\xa5\xae\xdf\xa3\xeb\xd3\xb9\x6e\xa4\x5c"
+		"\xe7\x9e\xeb\x1a\x3b\x4d\x29\xa8\x16\x64\x30\x33\x63\x51\x66\x26\x86\xae\xd9\xb8"
+		"\x22\x9d\xdf\xa3\x63\xe0\x10\x99\x89\x03\x84\xf8\xc3\x99\xa7\x33\x53\x55\x61\x77"
+		"\x44\x0b\x54\xfc\xae\x8f\xa0\x70\x07\x7a\xf8\x4d\xfb\xc5\x07\xfe\xcc\x0d\xea\x7d"
+		"\x4c\x1a\x85\xe4\xd6\x26\xc2\xfb\x59\xd5\x95\x15\xf8\x02\xee\xe6\xfc\x85\x12\x98"
+		"\x64\x7b\x45\x54\x97\x3c\x72\xba\xa5\xc8\xfc\x70\x6d\xa4\x28\x12\xa9\xbc\x4c\xb4"
+		"\xae\x7d\xa4\x5d\xd7\xd2\x18\x22\x6e\xf2\xf1\xf7\x47\x65\xcb\x70\xb6\x56\xa4\x09"
+		"\xe3\x92\xd6\x1b\xb3\x6b\xd6\xb7\x37\x0b\x00\xdb\x76\xc3\x5a\xc7\x8b\xf4\x86\x17"
+		"\xf1\xdf\x9d\x7f\x9b\xef\x57\x94\x83\x46\x9b\x9f\xc3\x19\x75\xdc\x5b\x56\xbf\x45"
+		"\xa5\x5d\x8b\xd9\x21\x87\x4c\xee\xcd\xfb\x51\x72\xa8\x98\xd3\xd4\xf3\x87\xc0\x74"
+		"\xe2\x3a\x05\x66\xf9\x3e\x01\x1b\x47\x34\xa6\xf5\x6f\x90\x59\x41\xd5\xe1\x67\x26"
+		"\x90\xda\xa9\xfe\xa0\xac\x36\x3f\xe1\x54\xea\x6c\x9b\xc8\x76\x26\xf2\x25\x6a\xc6"
+		"\xe1\x54\xa9\xc0\x24\x06\x33\xf1\x64\x28\x41\x4e\x7f\x4d\x2f\x06\xd4\x9b\xef\x96"
+		"\xb6\x61\x7f\x80\x1a\x67\x9f\x2b\xe1\x41\x3a\x69\x6a\x0c\x54\x42\xbe\x66\x70\xd7"
+		"\x51\x1b\xc5\x71\x83\xce\x05\xba\xb0\x50\x28\x83\x14\x7f\x6d\xcc\xbc\x06\xef\xb1"
+		"\xbd\x79\xd4\x79\x40\xbd\x7e\x32\x26\x0f\xa6\x94\x11\xcc\xb1\xfd\xb9\x92\xcb\x15"
+		"\xcf\x89\x29\xc1\x6c\xc9\x8e\x52\xa4\x5a\x20\x18\x2f\x1b\x6c\xb0\x75\xf0\xb4\x73"
+		"\x0b\x08\x3c\xda\xaa\xaf\x42\xd5\xc6\x3e\x4a\x8f\xee\xd2\xd7\x8e\xab\xec\xf5\x38"
+		"\xb6\x57\x3a\x53\xd6\x09\x38\xb6\xb5\x88\xa7\x99\x5a\x16\x2c\xba\xae\xd8\x5e\xcf"
+		"\x29\xcf\x73\x60\x80\x7e\xf6\x72\xf4\x03\x4f\x56\xa8\x0e\x8b\x40\xe3\x7d\xed\x2a"
+		"\x2f\xb5\xa9\x81\x3c\x4d\xe5\xa2\xa4\xc5\x9a\xfd\xe6\x7b\xdb\xdb\x79\xd9\xc5\xba"
+		"\xb8\xda\x83\x30\x3f\x62\x35\xac\xd7\x16\xe8\x7e\xbd\x41\x83\xc1\xee\x18\xd3\xf3"
+		"\x92\x3a\x21\x75\x99\x5f\x85\xdb\xb9\xf8\xf2\x0d\x06\xde\x6d\x8b\x0e\xe3\x7f\x75"
+		"\xb4\x67\xa3\x3e\xab\xfa\x1f\x96\xae\x42\x7a";
+
+	size_t dst_size = 6752;
+	char *dst = malloc(dst_size);
+	ptrdiff_t res = ufbxt_inflate(dst, dst_size, src, sizeof(src) - 1, opts);
+	ufbxt_hintf("res = %d", (int)res);
+	ufbxt_assert(res == dst_size);
+	ufbxt_assert(fnv1a(dst, dst_size) == 0x5ec02cae);
+	free(dst);
+}
+#endif
+
 UFBXT_DEFLATE_TEST(deflate_long_codes)
 #if UFBXT_IMPL
 {
@@ -116,6 +116,34 @@ UFBXT_TEST(ignore_embedded)
 }
 #endif
 
+UFBXT_TEST(memory_map_embedded)
+#if UFBXT_IMPL
+{
+	char path[512];
+
+	ufbxt_file_iterator iter = { "maya_textured_cube" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		ufbx_load_opts opts = { 0 };
+		opts.memory_map_file = true;
+
+		ufbx_scene *scene = ufbx_load_file(path, &opts, NULL);
+		ufbxt_assert(scene);
+		ufbxt_check_scene(scene);
+
+		// The file data must stay alive while the scene is retained
+		ufbx_retain_scene(scene);
+		ufbx_free_scene(scene);
+
+		ufbx_material *material = (ufbx_material*)ufbx_find_element(scene, UFBX_ELEMENT_MATERIAL, "phong1");
+		ufbxt_assert(material);
+		ufbxt_check_material_texture(scene, material->fbx.diffuse_color.texture, "checkerboard_diffuse.png", true);
+		ufbxt_check_material_texture(scene, material->fbx.ambient_color.texture, "checkerboard_ambient.png", true);
+
+		ufbx_free_scene(scene);
+	}
+}
+#endif
+
 UFBXT_FILE_TEST(maya_shared_textures)
 #if UFBXT_IMPL
 {
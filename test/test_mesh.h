@@ -1190,3 +1190,80 @@ UFBXT_FILE_TEST(synthetic_truncated_crease_full)
 	ufbxt_assert_close_real(err, mesh->edge_crease.data[3], 0.0f);
 }
 #endif
+
+UFBXT_TEST(lazy_geometry)
+#if UFBXT_IMPL
+{
+	char path[512];
+	ufbxt_file_iterator iter = { "maya_character" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		ufbx_load_opts ref_opts = { 0 };
+		ref_opts.generate_missing_normals = true;
+
+		ufbx_error error;
+		ufbx_scene *ref = ufbx_load_file(path, &ref_opts, &error);
+		if (!ref) ufbxt_log_error(&error);
+		ufbxt_assert(ref);
+
+		ufbx_load_opts opts = ref_opts;
+		opts.memory_map_file = true;
+		opts.lazy_geometry = true;
+
+		ufbx_scene *scene = ufbx_load_file(path, &opts, &error);
+		if (!scene) ufbxt_log_error(&error);
+		ufbxt_assert(scene);
+		ufbxt_check_scene(scene);
+
+		bool expect_lazy = !scene->metadata.ascii && scene->metadata.version >= 7200;
+
+		ufbxt_assert(scene->meshes.count == ref->meshes.count);
+		for (size_t i = 0; i < scene->meshes.count; i++) {
+			ufbx_mesh *lazy_mesh = scene->meshes.data[i];
+			ufbx_mesh *ref_mesh = ref->meshes.data[i];
+			ufbxt_assert(lazy_mesh->lazy_geometry == expect_lazy);
+			ufbxt_assert(lazy_mesh->num_vertices == ref_mesh->num_vertices);
+			if (expect_lazy) {
+				ufbxt_assert(lazy_mesh->num_indices == 0);
+				ufbxt_assert(lazy_mesh->num_faces == 0);
+			}
+
+			ufbx_mesh *mesh = ufbx_load_mesh_data(lazy_mesh, NULL, &error);
+			if (!mesh) ufbxt_log_error(&error);
+			ufbxt_assert(mesh);
+			ufbxt_check_mesh(scene, mesh);
+			ufbxt_assert(mesh->lazy_geometry_loaded == expect_lazy);
+			ufbxt_assert(!mesh->lazy_geometry);
+
+			ufbxt_assert(mesh->num_indices == ref_mesh->num_indices);
+			ufbxt_assert(mesh->num_faces == ref_mesh->num_faces);
+			ufbxt_assert(mesh->num_triangles == ref_mesh->num_triangles);
+			ufbxt_assert(mesh->num_edges == ref_mesh->num_edges);
+			ufbxt_assert(!memcmp(mesh->vertex_indices.data, ref_mesh->vertex_indices.data, mesh->num_indices * sizeof(uint32_t)));
+			ufbxt_assert(!memcmp(mesh->vertices.data, ref_mesh->vertices.data, mesh->num_vertices * sizeof(ufbx_vec3)));
+			ufbxt_assert(mesh->vertex_normal.exists == ref_mesh->vertex_normal.exists);
+			ufbxt_assert(mesh->vertex_normal.values.count == ref_mesh->vertex_normal.values.count);
+
+			ufbxt_assert(mesh->uv_sets.count == ref_mesh->uv_sets.count);
+			for (size_t j = 0; j < mesh->uv_sets.count; j++) {
+				ufbxt_assert(!strcmp(mesh->uv_sets.data[j].name.data, ref_mesh->uv_sets.data[j].name.data));
+				ufbxt_assert(mesh->uv_sets.data[j].vertex_uv.values.count == ref_mesh->uv_sets.data[j].vertex_uv.values.count);
+			}
+
+			ufbxt_assert(mesh->materials.count == ref_mesh->materials.count);
+			for (size_t j = 0; j < mesh->materials.count; j++) {
+				ufbxt_assert(mesh->materials.data[j].num_faces == ref_mesh->materials.data[j].num_faces);
+			}
+
+			ufbxt_assert(mesh->skin_deformers.count == ref_mesh->skin_deformers.count);
+			for (size_t j = 0; j < mesh->skin_deformers.count; j++) {
+				ufbxt_assert(mesh->skin_deformers.data[j]->vertices.count == ref_mesh->skin_deformers.data[j]->vertices.count);
+			}
+
+			ufbx_free_mesh(mesh);
+		}
+
+		ufbx_free_scene(scene);
+		ufbx_free_scene(ref);
+	}
+}
+#endif
@@ -1529,3 +1529,286 @@ UFBXT_FILE_TEST_OPTS_ALT(synthetic_empty_face_allow, synthetic_empty_face, ufbxt
 }
 #endif
 
+
+UFBXT_TEST(obj_thread_pool_vertices)
+#if UFBXT_IMPL
+{
+	char path[512];
+	static const char *const files[] = { "blender_279_ball", "zbrush_polygroup_mess", "max2009_blob" };
+	for (size_t i = 0; i < ufbxt_arraycount(files); i++) {
+		ufbxt_file_iterator iter = { files[i] };
+		while (ufbxt_next_file(&iter, path, sizeof(path))) {
+			size_t path_len = strlen(path);
+			if (path_len < 4 || strcmp(path + path_len - 4, ".obj") != 0) continue;
+			size_t size = 0;
+			char *data = (char*)ufbxt_read_file(path, &size);
+			ufbxt_assert(data);
+			ufbxt_check_ascii_thread_pool_scene(data, size, false);
+			free(data);
+		}
+	}
+
+	// Runs of vertices split by objects, groups and faces using negative indices. The
+	// variants contain a line continuation or mixed vertex colors within a run, which
+	// are left for the serial parser.
+	static const char *const values[] = { "-0", "+1", "1e2", "2.5E-1", "3", "-4.75", "12345678901234567", "0.1", "7" };
+	size_t num_verts = 6000;
+	size_t cap = 2*1024*1024;
+	char *data = (char*)malloc(cap);
+	ufbxt_assert(data);
+
+	for (int variant = 0; variant <= 2; variant++) {
+		size_t len = 0;
+		for (size_t obj = 0; obj < 2; obj++) {
+			len += (size_t)snprintf(data + len, cap - len, "o Object%zu\n", obj);
+			for (size_t i = 0; i < num_verts; i++) {
+				const char *x = values[i % ufbxt_arraycount(values)];
+				const char *y = values[(i / 3) % ufbxt_arraycount(values)];
+				const char *z = values[(i / 5) % ufbxt_arraycount(values)];
+				if (variant == 1 && i == num_verts / 2) {
+					len += (size_t)snprintf(data + len, cap - len, "v %s %s \\\n%s\n", x, y, z);
+				} else if (obj == 1 && (variant != 2 || i != num_verts / 2)) {
+					const char *alpha = i % 2 == 0 ? " 0.5" : "";
+					len += (size_t)snprintf(data + len, cap - len, "v %s %s %s 0.25 0.5 1%s\n", x, y, z, alpha);
+				} else {
+					const char *end = i % 7 == 0 ? " # comment\r\n" : i % 3 == 0 ? "\t\n" : "\n";
+					len += (size_t)snprintf(data + len, cap - len, "v  %s\t%s %s%s", x, y, z, end);
+				}
+			}
+			for (size_t i = 0; i < num_verts; i++) {
+				len += (size_t)snprintf(data + len, cap - len, "vt %s %s\n", values[i % ufbxt_arraycount(values)], values[(i / 2) % ufbxt_arraycount(values)]);
+			}
+			for (size_t i = 0; i < num_verts; i++) {
+				len += (size_t)snprintf(data + len, cap - len, "vn %s 0 %s\n", values[i % ufbxt_arraycount(values)], values[(i / 4) % ufbxt_arraycount(values)]);
+			}
+			len += (size_t)snprintf(data + len, cap - len, "g Group%zu\nusemtl Material%zu\n", obj, obj);
+			for (size_t i = 0; i + 3 <= num_verts; i += 3) {
+				if (i % 2 == 0) {
+					len += (size_t)snprintf(data + len, cap - len, "f -%zu/-%zu/-%zu -%zu/-%zu/-%zu -%zu/-%zu/-%zu\n",
+						num_verts - i, num_verts - i, num_verts - i, num_verts - i - 1, num_verts - i - 1, num_verts - i - 1,
+						num_verts - i - 2, num_verts - i - 2, num_verts - i - 2);
+				} else {
+					size_t base = obj * num_verts + i + 1;
+					len += (size_t)snprintf(data + len, cap - len, "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n",
+						base, base, base, base + 1, base + 1, base + 1, base + 2, base + 2, base + 2);
+				}
+			}
+		}
+		ufbxt_assert(len < cap);
+
+		ufbxt_check_ascii_thread_pool_scene(data, len, variant == 0);
+	}
+
+	free(data);
+}
+#endif
+
+#if UFBXT_IMPL
+typedef struct {
+	uint32_t mesh_element_id;
+	uint32_t material;
+	uint32_t index_begin;
+	uint32_t num_indices;
+} ufbxt_obj_stream_face;
+
+typedef struct {
+	ufbx_vec3 *positions;
+	ufbx_vec2 *uvs;
+	ufbx_vec3 *normals;
+	ufbx_vec4 *colors;
+	size_t num_positions, num_uvs, num_normals, num_colors;
+
+	ufbxt_obj_stream_face *faces;
+	uint32_t *indices;
+	size_t num_faces, num_indices;
+
+	size_t num_batches;
+	size_t max_batch_vertex_bytes;
+} ufbxt_obj_stream_result;
+
+static void *ufbxt_obj_stream_append(void *data, size_t *p_count, size_t first, const void *src, size_t count, size_t size)
+{
+	ufbxt_assert(first == *p_count);
+	data = realloc(data, (first + count) * size + 1);
+	ufbxt_assert(data);
+	if (count > 0) memcpy((char*)data + first * size, src, count * size);
+	*p_count = first + count;
+	return data;
+}
+
+static bool ufbxt_obj_stream_fn(void *user, const ufbx_obj_batch *batch)
+{
+	ufbxt_obj_stream_result *res = (ufbxt_obj_stream_result*)user;
+	res->num_batches++;
+
+	size_t vertex_bytes = batch->positions.count * sizeof(ufbx_vec3) + batch->uvs.count * sizeof(ufbx_vec2)
+		+ batch->normals.count * sizeof(ufbx_vec3) + batch->colors.count * sizeof(ufbx_vec4);
+	if (vertex_bytes > res->max_batch_vertex_bytes) res->max_batch_vertex_bytes = vertex_bytes;
+
+	res->positions = (ufbx_vec3*)ufbxt_obj_stream_append(res->positions, &res->num_positions, batch->first_position, batch->positions.data, batch->positions.count, sizeof(ufbx_vec3));
+	res->uvs = (ufbx_vec2*)ufbxt_obj_stream_append(res->uvs, &res->num_uvs, batch->first_uv, batch->uvs.data, batch->uvs.count, sizeof(ufbx_vec2));
+	res->normals = (ufbx_vec3*)ufbxt_obj_stream_append(res->normals, &res->num_normals, batch->first_normal, batch->normals.data, batch->normals.count, sizeof(ufbx_vec3));
+	res->colors = (ufbx_vec4*)ufbxt_obj_stream_append(res->colors, &res->num_colors, batch->first_color, batch->colors.data, batch->colors.count, sizeof(ufbx_vec4));
+
+	size_t num_indices = batch->position_indices.count;
+	ufbxt_assert(batch->uv_indices.count == num_indices);
+	ufbxt_assert(batch->normal_indices.count == num_indices);
+	ufbxt_assert(batch->face_material.count == batch->faces.count);
+	ufbxt_assert(batch->faces.count == 0 || batch->mesh_element_id != UFBX_NO_INDEX);
+
+	res->indices = (uint32_t*)realloc(res->indices, (res->num_indices + num_indices) * 3 * sizeof(uint32_t) + 1);
+	ufbxt_assert(res->indices);
+	for (size_t i = 0; i < num_indices; i++) {
+		uint32_t *dst = res->indices + (res->num_indices + i) * 3;
+		dst[0] = batch->position_indices.data[i];
+		dst[1] = batch->uv_indices.data[i];
+		dst[2] = batch->normal_indices.data[i];
+	}
+
+	res->faces = (ufbxt_obj_stream_face*)realloc(res->faces, (res->num_faces + batch->faces.count) * sizeof(ufbxt_obj_stream_face) + 1);
+	ufbxt_assert(res->faces);
+	for (size_t i = 0; i < batch->faces.count; i++) {
+		ufbx_face face = batch->faces.data[i];
+		ufbxt_assert((size_t)face.index_begin + face.num_indices <= num_indices);
+		ufbxt_obj_stream_face *dst = &res->faces[res->num_faces + i];
+		dst->mesh_element_id = batch->mesh_element_id;
+		dst->material = batch->face_material.data[i];
+		dst->index_begin = (uint32_t)res->num_indices + face.index_begin;
+		dst->num_indices = face.num_indices;
+	}
+
+	res->num_faces += batch->faces.count;
+	res->num_indices += num_indices;
+	return true;
+}
+
+static bool ufbxt_obj_stream_cancel_fn(void *user, const ufbx_obj_batch *batch)
+{
+	(void)user;
+	return batch->faces.count == 0;
+}
+
+// Returns the largest amount of vertex data in a single batch in bytes.
+static size_t ufbxt_check_obj_stream(const char *path, size_t memory_limit, bool threaded)
+{
+	ufbxt_obj_stream_result res = { 0 };
+
+	ufbx_load_opts opts = { 0 };
+	if (threaded) opts = ufbxt_thread_pool_opts();
+	opts.obj_stream_cb.fn = &ufbxt_obj_stream_fn;
+	opts.obj_stream_cb.user = &res;
+	opts.obj_stream_memory_limit = memory_limit;
+
+	ufbx_error error;
+	ufbx_scene *ref = ufbx_load_file(path, NULL, &error);
+	if (!ref) ufbxt_log_error(&error);
+	ufbxt_assert(ref);
+	ufbx_scene *scene = ufbx_load_file(path, &opts, &error);
+	if (!scene) ufbxt_log_error(&error);
+	ufbxt_assert(scene);
+
+	ufbxt_assert(scene->meshes.count == ref->meshes.count);
+	ufbxt_assert(scene->elements.count == ref->elements.count);
+	if (memory_limit == 1) {
+		ufbxt_assert(res.num_batches >= res.num_faces);
+	}
+
+	size_t face_ix = 0;
+	for (size_t mesh_ix = 0; mesh_ix < ref->meshes.count; mesh_ix++) {
+		ufbx_mesh *mesh = ref->meshes.data[mesh_ix];
+		ufbxt_assert(scene->meshes.data[mesh_ix]->faces.count == 0);
+		ufbxt_assert(scene->meshes.data[mesh_ix]->element_id == mesh->element_id);
+
+		for (size_t i = 0; i < mesh->faces.count; i++) {
+			// Empty meshes are skipped by the stream
+			while (face_ix < res.num_faces && res.faces[face_ix].mesh_element_id < mesh->element_id) face_ix++;
+			ufbxt_assert(face_ix < res.num_faces);
+			ufbxt_obj_stream_face sface = res.faces[face_ix++];
+			ufbx_face face = mesh->faces.data[i];
+
+			ufbxt_assert(sface.mesh_element_id == mesh->element_id);
+			ufbxt_assert(sface.num_indices == face.num_indices);
+			if (mesh->face_material.count > 0 && sface.material != UFBX_NO_INDEX) {
+				ufbxt_assert(sface.material == mesh->face_material.data[i]);
+			}
+
+			for (uint32_t j = 0; j < face.num_indices; j++) {
+				uint32_t ix = face.index_begin + j;
+				const uint32_t *sixs = res.indices + (sface.index_begin + j) * 3;
+
+				ufbxt_assert(sixs[0] < res.num_positions);
+				ufbx_vec3 pos = ufbx_get_vertex_vec3(&mesh->vertex_position, ix);
+				ufbxt_assert(!memcmp(&pos, &res.positions[sixs[0]], sizeof(ufbx_vec3)));
+
+				if (mesh->vertex_uv.exists && sixs[1] < res.num_uvs) {
+					ufbx_vec2 uv = ufbx_get_vertex_vec2(&mesh->vertex_uv, ix);
+					ufbxt_assert(!memcmp(&uv, &res.uvs[sixs[1]], sizeof(ufbx_vec2)));
+				}
+				if (mesh->vertex_normal.exists && sixs[2] < res.num_normals) {
+					ufbx_vec3 normal = ufbx_get_vertex_vec3(&mesh->vertex_normal, ix);
+					ufbxt_assert(!memcmp(&normal, &res.normals[sixs[2]], sizeof(ufbx_vec3)));
+				}
+				if (mesh->vertex_color.exists) {
+					ufbxt_assert(sixs[0] < res.num_colors);
+					ufbx_vec4 color = ufbx_get_vertex_vec4(&mesh->vertex_color, ix);
+					ufbxt_assert(!memcmp(&color, &res.colors[sixs[0]], sizeof(ufbx_vec4)));
+				}
+			}
+		}
+	}
+	ufbxt_assert(face_ix <= res.num_faces);
+
+	ufbx_free_scene(scene);
+	ufbx_free_scene(ref);
+	free(res.positions);
+	free(res.uvs);
+	free(res.normals);
+	free(res.colors);
+	free(res.faces);
+	free(res.indices);
+	return res.max_batch_vertex_bytes;
+}
+#endif
+
+UFBXT_TEST(obj_stream_geometry)
+#if UFBXT_IMPL
+{
+	char path[512];
+	static const char *const files[] = { "blender_279_ball", "zbrush_polygroup_mess", "zbrush_vertex_color", "max2009_blob" };
+	for (size_t i = 0; i < ufbxt_arraycount(files); i++) {
+		ufbxt_file_iterator iter = { files[i] };
+		while (ufbxt_next_file(&iter, path, sizeof(path))) {
+			size_t path_len = strlen(path);
+			if (path_len < 4 || strcmp(path + path_len - 4, ".obj") != 0) continue;
+			ufbxt_check_obj_stream(path, 0, false);
+			ufbxt_check_obj_stream(path, 0, true);
+
+			// Parallel vertex runs must respect the memory limit like serial parsing
+			static const size_t limits[] = { 1, 4096 };
+			for (size_t j = 0; j < ufbxt_arraycount(limits); j++) {
+				ufbxt_hintf("memory_limit=%zu", limits[j]);
+				size_t serial_bytes = ufbxt_check_obj_stream(path, limits[j], false);
+				size_t threaded_bytes = ufbxt_check_obj_stream(path, limits[j], true);
+				ufbxt_assert(threaded_bytes <= serial_bytes);
+			}
+		}
+	}
+}
+#endif
+
+UFBXT_TEST(obj_stream_cancel)
+#if UFBXT_IMPL
+{
+	char path[512];
+	snprintf(path, sizeof(path), "%sblender_279_ball_0_obj.obj", data_root);
+
+	ufbx_load_opts opts = { 0 };
+	opts.obj_stream_cb.fn = &ufbxt_obj_stream_cancel_fn;
+	opts.obj_stream_memory_limit = 1;
+
+	ufbx_error error;
+	ufbx_scene *scene = ufbx_load_file(path, &opts, &error);
+	ufbxt_assert(!scene);
+	ufbxt_assert(error.type == UFBX_ERROR_CANCELLED);
+}
+#endif
@@ -109,6 +109,150 @@ UFBXT_FILE_TEST_OPTS_ALT_FLAGS(max2009_blob_dom, max2009_blob, ufbxt_retain_dom_
 }
 #endif
 
+#if UFBXT_IMPL
+typedef struct {
+	ufbx_thread_pool_task_fn *task_fn;
+	void *task_user;
+	uint32_t count;
+	size_t num_runs;
+} ufbxt_serial_thread_pool;
+
+static ufbxt_serial_thread_pool ufbxt_serial_pool;
+
+static void ufbxt_serial_pool_run(void *user, ufbx_thread_pool_task_fn *task_fn, void *task_user, uint32_t count)
+{
+	ufbxt_serial_thread_pool *pool = (ufbxt_serial_thread_pool*)user;
+	ufbxt_assert(pool->count == 0);
+	pool->task_fn = task_fn;
+	pool->task_user = task_user;
+	pool->count = count;
+	pool->num_runs++;
+}
+
+static void ufbxt_serial_pool_wait(void *user)
+{
+	ufbxt_serial_thread_pool *pool = (ufbxt_serial_thread_pool*)user;
+
+	// Run in reverse order to catch dependencies between tasks
+	for (uint32_t i = pool->count; i > 0; i--) {
+		pool->task_fn(pool->task_user, i - 1);
+	}
+	pool->count = 0;
+}
+
+static ufbx_load_opts ufbxt_thread_pool_opts()
+{
+	ufbx_load_opts opts = { 0 };
+	opts.thread_opts.pool.run_fn = &ufbxt_serial_pool_run;
+	opts.thread_opts.pool.wait_fn = &ufbxt_serial_pool_wait;
+	opts.thread_opts.pool.user = &ufbxt_serial_pool;
+	opts.thread_opts.num_tasks = 3;
+	return opts;
+}
+#endif
+
+UFBXT_FILE_TEST_OPTS_ALT(maya_slime_thread_pool, maya_slime, ufbxt_thread_pool_opts)
+#if UFBXT_IMPL
+{
+	ufbxt_assert(ufbxt_serial_pool.num_runs > 0);
+}
+#endif
+
+#if UFBXT_IMPL
+static void ufbxt_check_ascii_thread_pool_scene(const char *data, size_t size, bool expect_deferred)
+{
+	ufbx_load_opts opts = ufbxt_thread_pool_opts();
+	size_t num_runs = ufbxt_serial_pool.num_runs;
+
+	ufbx_error error;
+	ufbx_scene *serial = ufbx_load_memory(data, size, NULL, &error);
+	if (!serial) ufbxt_log_error(&error);
+	ufbxt_assert(serial);
+	ufbx_scene *threaded = ufbx_load_memory(data, size, &opts, &error);
+	if (!threaded) ufbxt_log_error(&error);
+	ufbxt_assert(threaded);
+	if (expect_deferred) {
+		ufbxt_assert(ufbxt_serial_pool.num_runs > num_runs);
+	}
+
+	ufbxt_assert(serial->meshes.count == threaded->meshes.count);
+	for (size_t i = 0; i < serial->meshes.count; i++) {
+		ufbx_mesh *a = serial->meshes.data[i], *b = threaded->meshes.data[i];
+		ufbxt_assert(a->num_vertices == b->num_vertices);
+		ufbxt_assert(a->num_indices == b->num_indices);
+		ufbxt_assert(!memcmp(a->vertices.data, b->vertices.data, a->num_vertices * sizeof(ufbx_vec3)));
+		ufbxt_assert(!memcmp(a->vertex_indices.data, b->vertex_indices.data, a->num_indices * sizeof(uint32_t)));
+		ufbxt_assert(a->vertex_normal.values.count == b->vertex_normal.values.count);
+		if (a->vertex_normal.exists) {
+			ufbxt_assert(!memcmp(a->vertex_normal.values.data, b->vertex_normal.values.data, a->vertex_normal.values.count * sizeof(ufbx_vec3)));
+		}
+		ufbxt_assert(a->vertex_uv.values.count == b->vertex_uv.values.count);
+		if (a->vertex_uv.exists) {
+			ufbxt_assert(!memcmp(a->vertex_uv.values.data, b->vertex_uv.values.data, a->vertex_uv.values.count * sizeof(ufbx_vec2)));
+		}
+		ufbxt_assert(a->vertex_color.values.count == b->vertex_color.values.count);
+		if (a->vertex_color.exists) {
+			ufbxt_assert(!memcmp(a->vertex_color.values.data, b->vertex_color.values.data, a->vertex_color.values.count * sizeof(ufbx_vec4)));
+			ufbxt_assert(!memcmp(a->vertex_color.indices.data, b->vertex_color.indices.data, a->num_indices * sizeof(uint32_t)));
+		}
+	}
+
+	ufbx_free_scene(serial);
+	ufbx_free_scene(threaded);
+}
+#endif
+
+UFBXT_TEST(ascii_thread_pool_arrays)
+#if UFBXT_IMPL
+{
+	char path[512];
+	ufbxt_file_iterator iter = { "maya_slime" };
+	while (ufbxt_next_file(&iter, path, sizeof(path))) {
+		size_t size = 0;
+		char *data = (char*)ufbxt_read_file(path, &size);
+		ufbxt_assert(data);
+		if (size > 0 && data[0] == ';') {
+			ufbxt_check_ascii_thread_pool_scene(data, size, true);
+		}
+		free(data);
+	}
+
+	// Numbers in every format the tokenizer accepts, with and without a comment
+	// in the middle that forces the array to be parsed serially.
+	static const char *const values[] = { "-0", "+1", "1e2", "2.5E-1", " 3 ", "-4.75", "\n12345678901234567", "0.1", "7\t" };
+	size_t num_verts = 6000;
+	size_t cap = 1024*1024;
+	char *data = (char*)malloc(cap);
+	ufbxt_assert(data);
+
+	for (int comment = 0; comment <= 1; comment++) {
+		size_t len = 0;
+		len += (size_t)snprintf(data + len, cap - len,
+			"; FBX 7.5.0 project file\nFBXHeaderExtension:  {\n\tFBXHeaderVersion: 1003\n\tFBXVersion: 7500\n}\n"
+			"Objects:  {\n\tGeometry: 1, \"Geometry::\", \"Mesh\" {\n\t\tVertices: *%zu {\n\t\t\ta: ", num_verts * 3);
+		for (size_t i = 0; i < num_verts * 3; i++) {
+			if (comment && i == num_verts) len += (size_t)snprintf(data + len, cap - len, "; comment\n");
+			len += (size_t)snprintf(data + len, cap - len, "%s%s", i > 0 ? "," : "", values[i % ufbxt_arraycount(values)]);
+		}
+		len += (size_t)snprintf(data + len, cap - len, "\n\t\t}\n\t\tPolygonVertexIndex: *%zu {\n\t\t\ta: ", num_verts);
+		for (size_t i = 0; i < num_verts; i++) {
+			int ix = (int)i;
+			if (i % 3 == 2) len += (size_t)snprintf(data + len, cap - len, "%s%d", i > 0 ? "," : "", -ix - 1);
+			else if (i % 3 == 1) len += (size_t)snprintf(data + len, cap - len, "%s+%d", i > 0 ? "," : "", ix);
+			else len += (size_t)snprintf(data + len, cap - len, "%s %d ", i > 0 ? "," : "", ix);
+		}
+		len += (size_t)snprintf(data + len, cap - len,
+			"\n\t\t}\n\t}\n\tModel: 2, \"Model::Mesh\", \"Mesh\" {\n\t}\n}\n"
+			"Connections:  {\n\tC: \"OO\",1,2\n\tC: \"OO\",2,0\n}\n");
+		ufbxt_assert(len < cap);
+
+		ufbxt_check_ascii_thread_pool_scene(data, len, comment == 0);
+	}
+
+	free(data);
+}
+#endif
+
 UFBXT_FILE_TEST(maya_leading_comma)
 #if UFBXT_IMPL
 {
@@ -1460,3 +1604,54 @@ UFBXT_FILE_TEST(maya_notes)
 }
 #endif
 
+
+UFBXT_TEST(unicode_ascii_run_boundaries)
+#if UFBXT_IMPL
+{
+	static const char *const valid_seqs[] = {
+		"", "\xc3\xa4", "\xe3\x81\x82", "\xf0\x9f\x98\x80",
+	};
+	static const char *const invalid_seqs[] = {
+		"\x80", "\xc3", "\xc0\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xff",
+	};
+
+	char name[128];
+	char obj[256];
+	for (size_t prefix = 0; prefix <= 40; prefix++) {
+		for (size_t ix = 0; ix < ufbxt_arraycount(valid_seqs) + ufbxt_arraycount(invalid_seqs); ix++) {
+			bool valid = ix < ufbxt_arraycount(valid_seqs);
+			const char *seq = valid ? valid_seqs[ix] : invalid_seqs[ix - ufbxt_arraycount(valid_seqs)];
+			ufbxt_hintf("prefix=%zu ix=%zu", prefix, ix);
+
+			memset(name, 'a', prefix);
+			snprintf(name + prefix, sizeof(name) - prefix, "%sbcdefghijklmnopq", seq);
+			int obj_len = snprintf(obj, sizeof(obj), "o %s\nv 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n", name);
+			ufbxt_assert(obj_len > 0 && (size_t)obj_len < sizeof(obj));
+
+			ufbx_load_opts opts = { 0 };
+			opts.file_format = UFBX_FILE_FORMAT_OBJ;
+			ufbx_scene *scene = ufbx_load_memory(obj, (size_t)obj_len, &opts, NULL);
+			ufbxt_assert(scene);
+
+			bool has_warning = false;
+			for (size_t i = 0; i < scene->metadata.warnings.count; i++) {
+				if (scene->metadata.warnings.data[i].type == UFBX_WARNING_BAD_UNICODE) has_warning = true;
+			}
+			ufbxt_assert(has_warning == !valid);
+
+			ufbxt_assert(scene->meshes.count == 1);
+			ufbx_node *node = scene->meshes.data[0]->instances.data[0];
+			if (valid) {
+				ufbxt_assert(!strcmp(node->name.data, name));
+			} else {
+				ufbxt_assert(node->name.length > prefix);
+				ufbxt_assert(!strncmp(node->name.data, name, prefix));
+				ufbxt_assert(!strncmp(node->name.data + prefix, "\xef\xbf\xbd", 3));
+				ufbxt_assert(strstr(node->name.data, "bcdefghijklmnopq"));
+			}
+
+			ufbx_free_scene(scene);
+		}
+	}
+}
+#endif
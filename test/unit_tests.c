@@ -295,10 +295,82 @@ void test_sorts()
 	}
 }
 
+static size_t g_map_compares = 0;
+
+static int cmp_counted_uint64(void *user, const void *va, const void *vb)
+{
+	g_map_compares++;
+	return ufbxi_map_cmp_uint64(user, va, vb);
+}
+
+// Insert keys that all have the same hash, the fallback tree should keep the amount of
+// comparisons logarithmic instead of scanning through every colliding item.
+void test_map_collisions()
+{
+	ufbx_error error = { UFBX_ERROR_NONE };
+	ufbx_allocator_opts ator_opts = { 0 };
+	ufbxi_allocator ator;
+	memset(&ator, 0, sizeof(ator));
+	ufbxi_init_ator(&error, &ator, &ator_opts, "test");
+
+	ufbxi_map map = { 0 };
+	ufbxi_map_init(&map, &ator, &cmp_counted_uint64, NULL);
+
+	const uint32_t hash = 0x12345678u;
+	const size_t num_keys = 20000;
+	const size_t max_find_compares = UFBXI_MAP_MAX_SCAN * UFBXI_MAP_GROUP + 2 * 16;
+
+	for (int round = 0; round < 2; round++) {
+		uint32_t state = 1;
+		g_map_compares = 0;
+		for (size_t i = 0; i < num_keys; i++) {
+			uint64_t key = (uint64_t)xorshift32(&state) << 32u | i;
+			uint64_t *entry = ufbxi_map_insert(&map, uint64_t, hash, &key);
+			test_assert(entry != NULL);
+			*entry = key;
+		}
+		test_assert(g_map_compares < num_keys * 64);
+
+		// Copies must retain the tree
+		ufbxi_map copy = { 0 };
+		ufbxi_map_init(&copy, &ator, &cmp_counted_uint64, NULL);
+		test_assert(ufbxi_map_copy(&copy, &map));
+
+		ufbxi_map *maps[] = { &map, &copy };
+		for (size_t map_ix = 0; map_ix < 2; map_ix++) {
+			state = 1;
+			for (size_t i = 0; i < num_keys; i++) {
+				uint64_t key = (uint64_t)xorshift32(&state) << 32u | i;
+				g_map_compares = 0;
+				uint64_t *entry = ufbxi_map_find(maps[map_ix], uint64_t, hash, &key);
+				test_assert(entry != NULL && *entry == key);
+				test_assert(g_map_compares <= max_find_compares);
+
+				key ^= UINT64_C(0x8000000000000000);
+				g_map_compares = 0;
+				test_assert(ufbxi_map_find(maps[map_ix], uint64_t, hash, &key) == NULL);
+				test_assert(g_map_compares <= max_find_compares);
+			}
+		}
+
+		ufbxi_map_free(&copy);
+
+		// The second round reuses the cleared memory
+		ufbxi_map_clear(&map);
+		uint64_t key = 0;
+		test_assert(ufbxi_map_find(&map, uint64_t, hash, &key) == NULL);
+	}
+
+	ufbxi_map_free(&map);
+	ufbxi_free_ator(&ator);
+	test_assert(error.type == UFBX_ERROR_NONE);
+}
+
 int main(int argc, char **argv)
 {
 	test_sorts();
 	test_quats();
+	test_map_collisions();
 
 	return 0;
 }
@@ -19,11 +19,21 @@
 #define UFBXI_MAX_NODE_DEPTH 32
 #define UFBXI_MAX_XML_DEPTH 32
 #define UFBXI_MAX_SKIP_SIZE 0x40000000
-#define UFBXI_MAP_MAX_SCAN 32
+#define UFBXI_MAP_MAX_SCAN 8
 #define UFBXI_KD_FAST_DEPTH 6
 #define UFBXI_HUGE_MAX_SCAN 16
 #define UFBXI_MIN_FILE_FORMAT_LOOKAHEAD 32
 #define UFBXI_FACE_GROUP_HASH_BITS 8
+#define UFBXI_MIN_THREADED_DEFLATE_BYTES 0x10000
+#define UFBXI_MIN_DEFERRED_ASCII_ARRAY_BYTES 0x1000
+#define UFBXI_ASCII_ARRAY_CHUNK_SIZE 0x10000
+#define UFBXI_MIN_THREADED_OBJ_VERTEX_BYTES 0x10000
+#define UFBXI_OBJ_VERTEX_CHUNK_SIZE 0x8000
+#define UFBXI_CONVERT_BLOCK_SIZE 4096
+#define UFBXI_MIN_RADIX_SORT_SIZE 256
+#define UFBXI_MIN_THREADED_BAKE_SAMPLES 0x1000
+#define UFBXI_BAKE_MAX_REDUCE_SPAN 256
+#define UFBXI_POSE_ANCESTOR_STACK 64
 
 #ifndef UFBXI_MAX_NURBS_ORDER
 #define UFBXI_MAX_NURBS_ORDER 128
@@ -56,6 +66,12 @@
 	#if !defined(UFBX_NO_FORMAT_OBJ)
 		#define UFBXI_FEATURE_FORMAT_OBJ 1
 	#endif
+	#if !defined(UFBX_NO_SNAPSHOT)
+		#define UFBXI_FEATURE_SNAPSHOT 1
+	#endif
+	#if !defined(UFBX_NO_ANIMATION_BAKING)
+		#define UFBXI_FEATURE_ANIMATION_BAKING 1
+	#endif
 #endif
 
 #if defined(UFBX_DEV)
@@ -88,6 +104,12 @@
 #if !defined(UFBXI_FEATURE_FORMAT_OBJ) && defined(UFBX_ENABLE_FORMAT_OBJ)
 	#define UFBXI_FEATURE_FORMAT_OBJ 1
 #endif
+#if !defined(UFBXI_FEATURE_SNAPSHOT) && defined(UFBX_ENABLE_SNAPSHOT)
+	#define UFBXI_FEATURE_SNAPSHOT 1
+#endif
+#if !defined(UFBXI_FEATURE_ANIMATION_BAKING) && defined(UFBX_ENABLE_ANIMATION_BAKING)
+	#define UFBXI_FEATURE_ANIMATION_BAKING 1
+#endif
 #if !defined(UFBXI_FEATURE_ERROR_STACK) && defined(UFBX_ENABLE_ERROR_STACK)
 	#define UFBXI_FEATURE_ERROR_STACK 1
 #endif
@@ -116,6 +138,12 @@
 #if !defined(UFBXI_FEATURE_FORMAT_OBJ)
 	#define UFBXI_FEATURE_FORMAT_OBJ 0
 #endif
+#if !defined(UFBXI_FEATURE_SNAPSHOT)
+	#define UFBXI_FEATURE_SNAPSHOT 0
+#endif
+#if !defined(UFBXI_FEATURE_ANIMATION_BAKING)
+	#define UFBXI_FEATURE_ANIMATION_BAKING 0
+#endif
 #if !defined(UFBXI_FEATURE_ERROR_STACK)
 	#define UFBXI_FEATURE_ERROR_STACK 0
 #endif
@@ -134,7 +162,7 @@
 	#define UFBXI_FEATURE_KD 0
 #endif
 
-#if !UFBXI_FEATURE_SUBDIVISION || !UFBXI_FEATURE_TESSELLATION || !UFBXI_FEATURE_GEOMETRY_CACHE || !UFBXI_FEATURE_SCENE_EVALUATION || !UFBXI_FEATURE_SKINNING_EVALUATION || !UFBXI_FEATURE_TRIANGULATION || !UFBXI_FEATURE_INDEX_GENERATION || !UFBXI_FEATURE_XML || !UFBXI_FEATURE_KD
+#if !UFBXI_FEATURE_SUBDIVISION || !UFBXI_FEATURE_TESSELLATION || !UFBXI_FEATURE_GEOMETRY_CACHE || !UFBXI_FEATURE_SCENE_EVALUATION || !UFBXI_FEATURE_SKINNING_EVALUATION || !UFBXI_FEATURE_TRIANGULATION || !UFBXI_FEATURE_INDEX_GENERATION || !UFBXI_FEATURE_SNAPSHOT || !UFBXI_FEATURE_ANIMATION_BAKING || !UFBXI_FEATURE_XML || !UFBXI_FEATURE_KD
 	#define UFBXI_PARTIAL_FEATURES 1
 #endif
 
@@ -145,6 +173,7 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <locale.h>
+#include <float.h>
 
 #if !defined(UFBX_NO_MATH_H)
 	#include <math.h>
@@ -400,6 +429,16 @@
 	#endif
 #endif
 
+#if !defined(UFBX_STANDARD_C) && !defined(UFBX_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#define UFBXI_HAS_MMAP 1
+#else
+	#define UFBXI_HAS_MMAP 0
+#endif
+
 // Unaligned little-endian load functions
 // On platforms that support unaligned access natively (x86, x64, ARM64) just use normal loads,
 // with unaligned attributes, otherwise do manual byte-wise load.
@@ -520,6 +559,13 @@ ufbx_static_assert(sizeof_f64, sizeof(double) == 8);
 	#define UFBXI_HAS_SSE 0
 #endif
 
+#if !defined(UFBX_STANDARD_C) && !UFBXI_HAS_SSE && (defined(__ARM_NEON) || defined(_M_ARM64) || defined(UFBX_USE_NEON))
+	#define UFBXI_HAS_NEON 1
+	#include <arm_neon.h>
+#else
+	#define UFBXI_HAS_NEON 0
+#endif
+
 #if !defined(UFBX_LITTLE_ENDIAN)
 	#if !defined(UFBX_STANDARD_C) && (defined(_M_IX86) || defined(__i386__) || defined(_M_X64) || defined(__x86_64__) || defined(_M_ARM64) || defined(__aarch64__) || defined(__wasm__) || defined(__EMSCRIPTEN__))
 		#define UFBX_LITTLE_ENDIAN 1
@@ -543,6 +589,20 @@ ufbx_static_assert(sizeof_f64, sizeof(double) == 8);
 	#define ufbxi_copy_16_bytes(dst, src) memcpy((dst), (src), 16)
 #endif
 
+#if defined(UFBXI_HAS_UNALIGNED)
+	#define ufbxi_copy_8_bytes(dst, src) (*(ufbxi_unaligned ufbxi_unaligned_u64 *)(dst) = *(const ufbxi_unaligned ufbxi_unaligned_u64 *)(src))
+#else
+	#define ufbxi_copy_8_bytes(dst, src) memcpy((dst), (src), 8)
+#endif
+
+#if !defined(UFBX_STANDARD_C) && (defined(__GNUC__) || defined(__clang__))
+	#define ufbxi_prefetch(ptr) __builtin_prefetch((ptr))
+#elif UFBXI_HAS_SSE
+	#define ufbxi_prefetch(ptr) _mm_prefetch((const char*)(ptr), _MM_HINT_T0)
+#else
+	#define ufbxi_prefetch(ptr) ((void)(ptr))
+#endif
+
 
 // -- Large fast integer
 
@@ -618,7 +678,7 @@ ufbx_static_assert(sizeof_f64, sizeof(double) == 8);
 	#include <atomic>
 	typedef struct { alignas(std::atomic_size_t) char data[sizeof(std::atomic_size_t)]; } ufbxi_atomic_counter;
 	#define ufbxi_atomic_counter_init(ptr) (new (&(ptr)->data) std::atomic_size_t(0))
-	#define ufbxi_atomic_counter_free(ptr) (((std::atomic_size_t*)(ptr)->data)->~atomic_size_t())
+	#define ufbxi_atomic_counter_free(ptr) (((std::atomic_size_t*)(ptr)->data)->~atomic())
 	#define ufbxi_atomic_counter_inc(ptr) ((std::atomic_size_t*)(ptr)->data)->fetch_add(1)
 	#define ufbxi_atomic_counter_dec(ptr) ((std::atomic_size_t*)(ptr)->data)->fetch_sub(1)
 #elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
@@ -638,6 +698,47 @@ ufbx_static_assert(sizeof_f64, sizeof(double) == 8);
 	#define UFBXI_THREAD_SAFE 0
 #endif
 
+// -- Timer
+
+#include <time.h>
+
+#if !defined(UFBX_STANDARD_C) && (defined(__unix__) || defined(__APPLE__)) && defined(CLOCK_MONOTONIC)
+	#define UFBXI_HAS_CLOCK_GETTIME 1
+#elif !defined(UFBX_STANDARD_C) && defined(_MSC_VER) && _MSC_VER >= 1900
+	#define UFBXI_HAS_TIMESPEC_GET 1
+#endif
+
+// Processor time used by the process in nanoseconds, summed over all threads.
+static ufbxi_noinline uint64_t ufbxi_cpu_time_ns(void)
+{
+#if defined(UFBXI_HAS_CLOCK_GETTIME) && defined(CLOCK_PROCESS_CPUTIME_ID)
+	struct timespec ts;
+	if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) == 0) {
+		return (uint64_t)ts.tv_sec * UINT64_C(1000000000) + (uint64_t)ts.tv_nsec;
+	}
+#endif
+	clock_t c = clock();
+	if (c == (clock_t)-1) return 0;
+	return (uint64_t)((double)c * (1e9 / (double)CLOCKS_PER_SEC));
+}
+
+// Timestamp in nanoseconds for measuring durations, falls back to processor time
+// from `clock()` if there is no better clock available.
+static ufbxi_noinline uint64_t ufbxi_time_ns(void)
+{
+#if defined(UFBXI_HAS_CLOCK_GETTIME)
+	struct timespec ts;
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) return 0;
+	return (uint64_t)ts.tv_sec * UINT64_C(1000000000) + (uint64_t)ts.tv_nsec;
+#elif defined(UFBXI_HAS_TIMESPEC_GET)
+	struct timespec ts;
+	if (timespec_get(&ts, TIME_UTC) == 0) return 0;
+	return (uint64_t)ts.tv_sec * UINT64_C(1000000000) + (uint64_t)ts.tv_nsec;
+#else
+	return ufbxi_cpu_time_ns();
+#endif
+}
+
 // -- Bit manipulation
 
 #if !defined(UFBX_STANDARD_C) && defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
@@ -702,13 +803,40 @@ ufbx_static_assert(source_header_version, UFBX_SOURCE_VERSION/1000u == UFBX_HEAD
 	#define UFBXI_MAX_SKIP_SIZE 128
 
 	#undef UFBXI_MAP_MAX_SCAN
-	#define UFBXI_MAP_MAX_SCAN 2
+	#define UFBXI_MAP_MAX_SCAN 1
 
 	#undef UFBXI_KD_FAST_DEPTH
 	#define UFBXI_KD_FAST_DEPTH 2
 
 	#undef UFBXI_FACE_GROUP_HASH_BITS
 	#define UFBXI_FACE_GROUP_HASH_BITS 2
+
+	#undef UFBXI_MIN_THREADED_DEFLATE_BYTES
+	#define UFBXI_MIN_THREADED_DEFLATE_BYTES 1
+
+	#undef UFBXI_MIN_DEFERRED_ASCII_ARRAY_BYTES
+	#define UFBXI_MIN_DEFERRED_ASCII_ARRAY_BYTES 1
+
+	#undef UFBXI_ASCII_ARRAY_CHUNK_SIZE
+	#define UFBXI_ASCII_ARRAY_CHUNK_SIZE 16
+
+	#undef UFBXI_MIN_THREADED_OBJ_VERTEX_BYTES
+	#define UFBXI_MIN_THREADED_OBJ_VERTEX_BYTES 1
+
+	#undef UFBXI_OBJ_VERTEX_CHUNK_SIZE
+	#define UFBXI_OBJ_VERTEX_CHUNK_SIZE 16
+
+	#undef UFBXI_MIN_RADIX_SORT_SIZE
+	#define UFBXI_MIN_RADIX_SORT_SIZE 2
+
+	#undef UFBXI_MIN_THREADED_BAKE_SAMPLES
+	#define UFBXI_MIN_THREADED_BAKE_SAMPLES 1
+
+	#undef UFBXI_BAKE_MAX_REDUCE_SPAN
+	#define UFBXI_BAKE_MAX_REDUCE_SPAN 4
+
+	#undef UFBXI_POSE_ANCESTOR_STACK
+	#define UFBXI_POSE_ANCESTOR_STACK 2
 #endif
 
 #if defined(UFBX_REGRESSION)
@@ -978,6 +1106,88 @@ static ufbxi_noinline void ufbxi_stable_sort(size_t stride, size_t linear_size,
 	if (dst != data) memcpy((void*)data, dst, size * stride);
 }
 
+typedef struct {
+	uint64_t key;
+	size_t index;
+} ufbxi_radix_entry;
+
+// Stable LSD radix sort `entries[count]` by `key` one byte at a time, ping-ponging between
+// `entries` and `tmp`. Bytes that are the same for all the keys are skipped, so sorting small
+// or pointer keys only needs a few passes. Returns the buffer containing the sorted entries.
+static ufbxi_noinline ufbxi_radix_entry *ufbxi_radix_sort(ufbxi_radix_entry *entries, ufbxi_radix_entry *tmp, size_t count)
+{
+	ufbx_assert(count > 0);
+
+	size_t offsets[8][256];
+	memset(offsets, 0, sizeof(offsets));
+	for (size_t i = 0; i < count; i++) {
+		uint64_t key = entries[i].key;
+		for (uint32_t d = 0; d < 8; d++) {
+			offsets[d][(key >> (d * 8u)) & 0xff]++;
+		}
+	}
+
+	ufbxi_radix_entry *src = entries, *dst = tmp;
+	for (uint32_t d = 0; d < 8; d++) {
+		size_t *offset = offsets[d];
+		uint32_t shift = d * 8u;
+		if (offset[(src[0].key >> shift) & 0xff] == count) continue;
+
+		size_t total = 0;
+		for (size_t i = 0; i < 256; i++) {
+			size_t num = offset[i];
+			offset[i] = total;
+			total += num;
+		}
+
+		for (size_t i = 0; i < count; i++) {
+			ufbxi_radix_entry entry = src[i];
+			dst[offset[(entry.key >> shift) & 0xff]++] = entry;
+		}
+
+		ufbxi_radix_entry *swap = src; src = dst; dst = swap;
+	}
+
+	return src;
+}
+
+// Size of the temporary buffer needed for `ufbxi_macro_radix_sort()`.
+#define ufbxi_radix_sort_tmp_size(m_type, m_size) ((m_size) * (2 * sizeof(ufbxi_radix_entry) + sizeof(m_type)))
+
+// Stable sort array `m_type m_data[m_size]` using the predicate `m_cmp_lambda(a, b)` like
+// `ufbxi_macro_stable_sort()`, but first radix sort by a `uint64_t` key `m_key_lambda(a)`.
+// The predicate must order elements by the key first, it is only used to sort runs of equal keys.
+// `m_tmp` must be a memory buffer with at least `ufbxi_radix_sort_tmp_size()` bytes.
+#define ufbxi_macro_radix_sort(m_type, m_linear_size, m_data, m_tmp, m_size, m_key_lambda, m_cmp_lambda) do { \
+	typedef m_type mr_type; \
+	mr_type *mr_data = (m_data); \
+	size_t mr_size = (m_size); \
+	if (mr_size < UFBXI_MIN_RADIX_SORT_SIZE) { \
+		ufbxi_macro_stable_sort(m_type, m_linear_size, mr_data, (m_tmp), mr_size, m_cmp_lambda); \
+		break; \
+	} \
+	ufbxi_radix_entry *mr_entries = (ufbxi_radix_entry*)(m_tmp); \
+	mr_type *mr_tmp = (mr_type*)(mr_entries + mr_size * 2); \
+	for (size_t mr_i = 0; mr_i < mr_size; mr_i++) { \
+		const mr_type *a = &mr_data[mr_i]; \
+		mr_entries[mr_i].key = (uint64_t)( m_key_lambda ); \
+		mr_entries[mr_i].index = mr_i; \
+	} \
+	mr_entries = ufbxi_radix_sort(mr_entries, mr_entries + mr_size, mr_size); \
+	for (size_t mr_i = 0; mr_i < mr_size; mr_i++) { \
+		mr_tmp[mr_i] = mr_data[mr_entries[mr_i].index]; \
+	} \
+	memcpy((void*)mr_data, mr_tmp, sizeof(mr_type) * mr_size); \
+	/* Sort runs of equal keys with the full predicate */ \
+	for (size_t mr_begin = 0, mr_end; mr_begin < mr_size; mr_begin = mr_end) { \
+		uint64_t mr_key = mr_entries[mr_begin].key; \
+		for (mr_end = mr_begin + 1; mr_end < mr_size && mr_entries[mr_end].key == mr_key; mr_end++) { } \
+		if (mr_end - mr_begin > 1) { \
+			ufbxi_macro_stable_sort(m_type, m_linear_size, mr_data + mr_begin, mr_tmp, mr_end - mr_begin, m_cmp_lambda); \
+		} \
+	} \
+	} while (0)
+
 // -- Float parsing
 //
 // Custom float parsing that handles floats up to (-)ddddddddddddddddddd.ddddddddddddddddddd
@@ -1121,17 +1331,92 @@ static const uint64_t ufbxi_pow10_tab[] = {
 	UINT64_C(1000000000000000000),
 };
 
-static ufbxi_noinline double ufbxi_parse_double(const char *str, size_t max_length, char **end, bool verify_length)
+#if UFBX_LITTLE_ENDIAN
+	#define UFBXI_HAS_SWAR_DIGITS 1
+#else
+	#define UFBXI_HAS_SWAR_DIGITS 0
+#endif
+
+#if UFBXI_HAS_SWAR_DIGITS
+
+// Parse up to 8 leading decimal digits from the 8 bytes at `p` at once (SWAR).
+// Returns the number of digits and stores their value in `*p_value`.
+static ufbxi_forceinline uint32_t ufbxi_parse_digits_swar(const char *p, uint64_t *p_value)
 {
-	// TODO: Use this for optimizing digit parsing
-	(void)max_length;
+	uint64_t v = ufbxi_read_u64(p) - UINT64_C(0x3030303030303030);
+
+	// Find the first byte that is not in '0'..'9'. Borrows and carries only propagate
+	// towards later characters so they can't affect the bytes before the first non-digit.
+	uint64_t non_digit = (v | (v + UINT64_C(0x7676767676767676))) & UINT64_C(0x8080808080808080);
+	if (non_digit & 0x80) {
+		*p_value = 0;
+		return 0;
+	}
+	uint32_t num = non_digit ? (63u - ufbxi_lzcnt64(non_digit & (~non_digit + 1))) / 8u : 8u;
+
+	// Shift the digits to the top so that the missing ones act as leading zeros and
+	// combine pairs of digits, then pairs of those, etc.
+	v <<= 64u - 8u * num;
+	v = (v * 10u + (v >> 8u)) & UINT64_C(0x00ff00ff00ff00ff);
+	v = (v * 100u + (v >> 16u)) & UINT64_C(0x0000ffff0000ffff);
+	v = (v * 10000u + (v >> 32u)) & UINT64_C(0x00000000ffffffff);
+	*p_value = v;
+	return num;
+}
+
+#endif
+
+// Parse a run of decimal digits, `*p_value` and `*p_count` are accumulated to.
+// The result is only meaningful if the total count stays below 20 digits.
+static ufbxi_forceinline const char *ufbxi_parse_digits(const char *p, const char *str_end, uint64_t *p_value, uint32_t *p_count)
+{
+	uint64_t value = *p_value;
+	uint32_t count = *p_count;
+#if UFBXI_HAS_SWAR_DIGITS
+	while (str_end - p >= 8) {
+		uint64_t part;
+		uint32_t num = ufbxi_parse_digits_swar(p, &part);
+		value = value * ufbxi_pow10_tab[num] + part;
+		count += num;
+		p += num;
+		if (num < 8) {
+			*p_value = value;
+			*p_count = count;
+			return p;
+		}
+	}
+#else
+	(void)str_end;
+#endif
+	while (((uint32_t)*p - '0') < 10) {
+		value = value * 10 + (uint64_t)(*p++ - '0');
+		count++;
+	}
+	*p_value = value;
+	*p_count = count;
+	return p;
+}
+
+// Division of two exactly representable doubles is correctly rounded only if it's
+// not evaluated in extended precision (eg. x87).
+#if (defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0) || defined(_M_X64) || defined(_M_ARM64)
+	#define UFBXI_HAS_EXACT_F64_DIV 1
+#else
+	#define UFBXI_HAS_EXACT_F64_DIV 0
+#endif
 
+// Parse a decimal number from `str`, `max_length` bytes must be readable from `str`.
+static ufbxi_noinline double ufbxi_parse_double(const char *str, size_t max_length, char **end, bool verify_length)
+{
 	uint64_t integer = 0;
 	uint32_t n_integer = 0;
 	uint64_t decimals = 0;
 	uint32_t n_decimals = 0;
 	bool negative = false;
 
+	// Digits can be parsed 8 at a time as long as there are 8 readable bytes
+	const char *str_end = str + max_length;
+
 	const char *p = str;
 	if (*p == '-') {
 		negative = true;
@@ -1139,16 +1424,10 @@ static ufbxi_noinline double ufbxi_parse_double(const char *str, size_t max_leng
 	} else if (*p == '+') {
 		p++;
 	}
-	while (((uint32_t)*p - '0') < 10) {
-		integer = integer * 10 + (uint64_t)(*p++ - '0');
-		n_integer++;
-	}
+	p = ufbxi_parse_digits(p, str_end, &integer, &n_integer);
 	if (*p == '.') {
 		p++;
-		while (((uint32_t)*p - '0') < 10) {
-			decimals = decimals * 10 + (uint64_t)(*p++ - '0');
-			n_decimals++;
-		}
+		p = ufbxi_parse_digits(p, str_end, &decimals, &n_decimals);
 	}
 
 	if (((*p | 0x20) == 'e') || n_decimals >= 19 || n_integer >= 19) {
@@ -1174,6 +1453,16 @@ static ufbxi_noinline double ufbxi_parse_double(const char *str, size_t max_leng
 		return (negative ? -1.0 : 1.0) * (double)integer;
 	}
 
+#if UFBXI_HAS_EXACT_F64_DIV
+	// If all the digits fit in 53 bits both `digits` and `10^n_decimals` are exact
+	// so a single correctly rounded division gives the same result as the path below.
+	if (n_integer + n_decimals <= 15) {
+		uint64_t digits = integer * ufbxi_pow10_tab[n_decimals] + decimals;
+		double result = (double)digits / (double)ufbxi_pow10_tab[n_decimals];
+		return negative ? -result : result;
+	}
+#endif
+
 	uint64_t divisor = ufbxi_pow10_tab[n_decimals];
 
 	uint64_t b_int = integer;
@@ -2130,6 +2419,62 @@ static ufbxi_noinline uint32_t ufbxi_adler32(const void *data, size_t size)
 			a += (uint32_t)_mm_cvtsi128_si32(s1);
 			b += (uint32_t)_mm_cvtsi128_si32(s2);
 		}
+#elif UFBXI_HAS_NEON
+		static const uint16_t factors[4][4] = {
+			{ 32, 31, 30, 29, }, { 28, 27, 26, 25, }, { 24, 23, 22, 21, }, { 20, 19, 18, 17, },
+		};
+
+		const uint16x4_t factor_0 = vld1_u16(factors[0]);
+		const uint16x4_t factor_1 = vld1_u16(factors[1]);
+		const uint16x4_t factor_2 = vld1_u16(factors[2]);
+		const uint16x4_t factor_3 = vld1_u16(factors[3]);
+		const uint16x4_t factor_16 = vdup_n_u16(16);
+
+		for (;;) {
+			// 5552 is the largest block size where the 32-bit `s2` lanes cannot overflow
+			size_t chunk_size = ufbxi_min_sz(ufbxi_to_size(end - p), 5552) & ~(size_t)0x1f;
+			if (chunk_size == 0) break;
+			const char *chunk_end = p + chunk_size;
+
+			uint32x4_t s1 = vdupq_n_u32(0);
+			uint32x4_t s2 = vdupq_n_u32(0);
+
+			// Per-column byte sums, weighted by their position in the 32 byte block below
+			uint16x8_t col_0 = vdupq_n_u16(0), col_1 = vdupq_n_u16(0);
+			uint16x8_t col_2 = vdupq_n_u16(0), col_3 = vdupq_n_u16(0);
+
+			while (p != chunk_end) {
+				uint8x16_t d0 = vld1q_u8((const uint8_t*)p);
+				uint8x16_t d1 = vld1q_u8((const uint8_t*)p + 16);
+
+				s2 = vaddq_u32(s2, s1);
+				s1 = vpadalq_u16(s1, vpadalq_u8(vpaddlq_u8(d0), d1));
+
+				col_0 = vaddw_u8(col_0, vget_low_u8(d0));
+				col_1 = vaddw_u8(col_1, vget_high_u8(d0));
+				col_2 = vaddw_u8(col_2, vget_low_u8(d1));
+				col_3 = vaddw_u8(col_3, vget_high_u8(d1));
+
+				p += 32;
+			}
+
+			s2 = vshlq_n_u32(s2, 5);
+			s2 = vmlal_u16(s2, vget_low_u16(col_0), factor_0);
+			s2 = vmlal_u16(s2, vget_high_u16(col_0), factor_1);
+			s2 = vmlal_u16(s2, vget_low_u16(col_1), factor_2);
+			s2 = vmlal_u16(s2, vget_high_u16(col_1), factor_3);
+			s2 = vmlal_u16(s2, vget_low_u16(col_2), vsub_u16(factor_0, factor_16));
+			s2 = vmlal_u16(s2, vget_high_u16(col_2), vsub_u16(factor_1, factor_16));
+			s2 = vmlal_u16(s2, vget_low_u16(col_3), vsub_u16(factor_2, factor_16));
+			s2 = vmlal_u16(s2, vget_high_u16(col_3), vsub_u16(factor_3, factor_16));
+
+			uint32x2_t s1_pair = vadd_u32(vget_low_u32(s1), vget_high_u32(s1));
+			uint32x2_t s2_pair = vadd_u32(vget_low_u32(s2), vget_high_u32(s2));
+
+			b += chunk_size * a;
+			a += vget_lane_u32(s1_pair, 0) + vget_lane_u32(s1_pair, 1);
+			b += vget_lane_u32(s2_pair, 0) + vget_lane_u32(s2_pair, 1);
+		}
 #elif UFBX_LITTLE_ENDIAN
 		for (;;) {
 			size_t chunk_size = ufbxi_min_sz(ufbxi_to_size(end - p), 256*8/4) & ~(size_t)0xf;
@@ -2189,6 +2534,46 @@ static ufbxi_noinline uint32_t ufbxi_adler32(const void *data, size_t size)
 	return (uint32_t)((b << 16) | (a & 0xffff));
 }
 
+// Smallest multiple of `distance` that is at least 8, used to replicate short
+// repeating patterns of overlapping matches 8 bytes at a time.
+static const uint8_t ufbxi_inflate_overlap_period[16] = {
+	0, 8, 8, 9, 8, 10, 12, 14, 8, 9, 10, 11, 12, 13, 14, 15,
+};
+
+// Copy a match of `m_length` bytes from `m_distance` bytes back from `m_dst`.
+// May write up to 15 bytes of garbage past the end of the match, callers must check for space.
+// Overlapping matches with `m_distance < 16` (eg. runs of zeros) are expanded by first writing
+// a single period of the pattern byte-by-byte and then copying 8 byte chunks from one period back.
+// NOTE: Local names must not clash with the ones used in `ufbxi_copy_16_bytes()`.
+#define ufbxi_macro_inflate_copy_match(m_dst, m_length, m_distance) do { \
+		char *mi_out = (m_dst); \
+		const char *mi_match = mi_out - (m_distance); \
+		uint32_t mi_length = (m_length); \
+		if ((m_distance) >= 16 || (m_distance) >= mi_length) { \
+			ufbxi_copy_16_bytes(mi_out, mi_match); \
+			while (mi_length > 16) { \
+				mi_match += 16; \
+				mi_out += 16; \
+				mi_length -= 16; \
+				ufbxi_copy_16_bytes(mi_out, mi_match); \
+			} \
+		} else { \
+			uint32_t mi_period = ufbxi_inflate_overlap_period[(m_distance)]; \
+			uint32_t mi_prefix = mi_period < mi_length ? mi_period : mi_length; \
+			char *mi_end = mi_out + mi_length; \
+			char *mi_prefix_end = mi_out + mi_prefix; \
+			while (mi_out != mi_prefix_end) { \
+				*mi_out++ = *mi_match++; \
+			} \
+			mi_match = mi_out - mi_period; \
+			while (mi_out < mi_end) { \
+				ufbxi_copy_8_bytes(mi_out, mi_match); \
+				mi_out += 8; \
+				mi_match += 8; \
+			} \
+		} \
+	} while (0)
+
 static ufbxi_noinline int
 ufbxi_inflate_block_slow(ufbxi_deflate_context *dc, ufbxi_trees *trees, size_t max_symbols)
 {
@@ -2262,20 +2647,7 @@ ufbxi_inflate_block_slow(ufbxi_deflate_context *dc, ufbxi_trees *trees, size_t m
 		out_ptr += length;
 
 		if (out_space >= length + 16) {
-			uint32_t min_dist = length < 16 ? length : 16;
-			if (distance >= min_dist) {
-				ufbxi_copy_16_bytes(dst, src);
-				while (length > 16) {
-					src += 16;
-					dst += 16;
-					length -= 16;
-					ufbxi_copy_16_bytes(dst, src);
-				}
-			} else {
-				while (dst != end) {
-					*dst++ = *src++;
-				}
-			}
+			ufbxi_macro_inflate_copy_match(dst, length, distance);
 		} else {
 			while (dst != end) {
 				*dst++ = *src++;
@@ -2449,15 +2821,8 @@ ufbxi_inflate_block_fast(ufbxi_deflate_context *dc, ufbxi_trees *trees)
 
 		// Copy the match
 
-		uint32_t min_dist = length < 16 ? length : 16;
-		if (distance >= min_dist && dst_space >= 16) {
-			ufbxi_copy_16_bytes(dst, src);
-			while (length > 16) {
-				src += 16;
-				dst += 16;
-				length -= 16;
-				ufbxi_copy_16_bytes(dst, src);
-			}
+		if (dst_space >= 16) {
+			ufbxi_macro_inflate_copy_match(dst, length, distance);
 		} else {
 			while (dst != end) {
 				*dst++ = *src++;
@@ -2513,8 +2878,9 @@ ufbxi_extern_c ptrdiff_t ufbx_inflate(void *dst, size_t dst_size, const ufbx_inf
 		dc.fast_bits = (uint32_t)input->internal_fast_bits;
 		if (dc.fast_bits < 1 || dc.fast_bits == 9 || dc.fast_bits > 10) return -29;
 	} else {
-		// TODO: Profile this
-		dc.fast_bits = input->total_size > 2048 ? 10 : 8;
+		// Only `fast_bits == 10` can use `ufbxi_inflate_block_fast()`, building the larger
+		// tables pays for itself already for quite small streams (measured on real FBX arrays).
+		dc.fast_bits = input->total_size > 512 ? 10 : 8;
 	}
 
 	uint64_t bits = dc.stream.bits;
@@ -2770,6 +3136,22 @@ static ufbxi_noinline void ufbxi_clear_error(ufbx_error *err)
 	err->info_length = 0;
 }
 
+static ufbxi_noinline void ufbxi_file_not_found_error(ufbx_error *err, const char *filename, size_t filename_len, const char *func, uint32_t line)
+{
+	if (!err) return;
+
+	ufbxi_set_err_info(err, filename, filename_len);
+	err->stack_size = 1;
+	err->type = UFBX_ERROR_FILE_NOT_FOUND;
+	err->description.data = "File not found";
+	err->description.length = strlen(err->description.data);
+	err->stack[0].description.data = "File not found";
+	err->stack[0].description.length = strlen(err->stack[0].description.data);
+	err->stack[0].function.data = func;
+	err->stack[0].function.length = strlen(func);
+	err->stack[0].source_line = line;
+}
+
 #if UFBXI_FEATURE_ERROR_STACK
 	#define ufbxi_function __FUNCTION__
 	#define ufbxi_line __LINE__
@@ -2824,6 +3206,8 @@ static ufbxi_noinline void ufbxi_fix_error_type(ufbx_error *error, const char *d
 		error->type = UFBX_ERROR_BAD_INDEX;
 	} else if (!strcmp(desc, "Unsafe options")) {
 		error->type = UFBX_ERROR_UNSAFE_OPTIONS;
+	} else if (!strcmp(desc, "Snapshot mismatch")) {
+		error->type = UFBX_ERROR_SNAPSHOT_MISMATCH;
 	}
 	error->description.data = desc;
 	error->description.length = strlen(desc);
@@ -3028,8 +3412,15 @@ static ufbxi_noinline void ufbxi_free_ator(ufbxi_allocator *ator)
 #define UFBXI_MESH_IMP_MAGIC 0x48534d55
 #define UFBXI_LINE_CURVE_IMP_MAGIC 0x55434c55
 #define UFBXI_CACHE_IMP_MAGIC 0x48434355
+#define UFBXI_LOADER_IMP_MAGIC 0x52444c55
+#define UFBXI_PROBE_IMP_MAGIC 0x42525055
+#define UFBXI_SNAPSHOT_IMP_MAGIC 0x504e5355
+#define UFBXI_LOAD_CONTEXT_IMP_MAGIC 0x58434c55
+#define UFBXI_BATCH_IMP_MAGIC 0x48544255
+#define UFBXI_STRING_TABLE_IMP_MAGIC 0x42545355
 #define UFBXI_REFCOUNT_IMP_MAGIC 0x46455255
 #define UFBXI_BUF_CHUNK_IMP_MAGIC 0x46554255
+#define UFBXI_BAKED_ANIM_IMP_MAGIC 0x4b414255
 
 // -- Memory buffer
 //
@@ -3508,12 +3899,18 @@ static ufbxi_noinline void ufbxi_buf_clear(ufbxi_buf *buf)
 	}
 
 	// Reset the non-huge chunks as `chunk->next` is always free.
+	// Ordered buffers expect the free chunks to have `pushed_pos == 0`.
 	ufbxi_buf_chunk *chunk = buf->chunks[0];
 	if (chunk) {
 		ufbxi_buf_chunk *root = chunk->root;
 		buf->chunks[0] = root;
 		buf->pos = 0;
 		buf->size = root->size;
+		if (!buf->unordered) {
+			for (; chunk != root; chunk = chunk->prev) {
+				chunk->pushed_pos = 0;
+			}
+		}
 	}
 	buf->num_items = 0;
 
@@ -3553,141 +3950,289 @@ static ufbxi_noinline void ufbxi_buf_clear(ufbxi_buf *buf)
 
 // -- Hash map
 //
+// Open addressing hash table with SIMD probed control bytes. Every slot has a control
+// byte containing either `UFBXI_MAP_EMPTY` or the top 7 bits of the hash of the item,
+// which are compared `UFBXI_MAP_GROUP` bytes at a time. Groups are probed triangularly,
+// which visits all the slots as the table size is a power of two.
+//
+// Items are stored in insertion order with their full hashes, slots only refer to them
+// by index. This means that growing the table doesn't need to compare any items and the
+// layout of the items doesn't depend on the hashes.
+//
+// Items that don't find an empty slot within `UFBXI_MAP_MAX_SCAN` groups are stored in an
+// AA tree instead. This bounds the cost of operations even if the keys collide completely,
+// eg. when the seed is predictable on targets without address space layout randomization.
+//
 // The actual element comparison is left to the user of `ufbxi_map`, see usage below.
 //
 // NOTES:
 //   ufbxi_map_insert() does not support duplicate values, use find first if duplicates are possible!
 //   Inserting duplicate elements fails with an assertion if `UFBX_REGRESSION` is enabled.
+//   Keys that can be controlled by the input file should be hashed with `ufbxi_map.seed`,
+//   otherwise it's possible to craft files where every key collides.
+
+#define UFBXI_MAP_EMPTY 0x80
+#define UFBXI_MAP_TREE_NONE UINT32_MAX
 
-typedef struct ufbxi_aa_node ufbxi_aa_node;
+#if UFBXI_HAS_SSE
+	#define UFBXI_MAP_GROUP 16
+	#define UFBXI_MAP_BIT_SHIFT 0
+#elif UFBXI_HAS_NEON
+	#define UFBXI_MAP_GROUP 16
+	#define UFBXI_MAP_BIT_SHIFT 2
+#else
+	#define UFBXI_MAP_GROUP 8
+	#define UFBXI_MAP_BIT_SHIFT 3
+#endif
 
 typedef int ufbxi_cmp_fn(void *user, const void *a, const void *b);
 
-struct ufbxi_aa_node {
-	ufbxi_aa_node *left, *right;
+// AA tree node of the item with the same index.
+typedef struct {
+	uint32_t left, right; // < Item indices of the children or `UFBXI_MAP_TREE_NONE`
 	uint32_t level;
-	uint32_t index;
-};
+} ufbxi_map_node;
 
 typedef struct {
 	ufbxi_allocator *ator;
 	size_t data_size;
 
-	void *items;
-	uint64_t *entries;
+	uint32_t *hashes; // < Hashes of `items`, also the start of the allocation
+	void *items;      // < Items in insertion order
+	uint32_t *slots;  // < Indices to `items` per slot
+	uint8_t *ctrl;    // < Control byte per slot, followed by a copy of the first group
 	uint32_t mask;
 
 	uint32_t capacity;
 	uint32_t size;
 
+	// Fallback tree for items that didn't fit in the table, allocated on demand
+	ufbxi_map_node *tree;
+	uint32_t tree_capacity;
+	uint32_t tree_root;
+
+	// Key for hashing untrusted data
+	uint64_t seed;
+
 	ufbxi_cmp_fn *cmp_fn;
 	void *cmp_user;
 
-	ufbxi_buf aa_buf;
-	ufbxi_aa_node *aa_root;
-
 } ufbxi_map;
 
+// Returns a bitmask of the control bytes in a group equal to `tag`, use `ufbxi_map_bit_index()`
+// to find the matching slots. May contain false positives that should be checked by comparing.
+static ufbxi_forceinline uint64_t ufbxi_map_group_match(const uint8_t *ctrl, uint32_t tag)
+{
+#if UFBXI_HAS_SSE
+	__m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+	return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)tag)));
+#elif UFBXI_HAS_NEON
+	uint8x16_t eq = vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8((uint8_t)tag));
+	uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+	return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & UINT64_C(0x8888888888888888);
+#else
+	// Borrows may cause false positives above a real match, but never for empty slots
+	uint64_t x = ufbxi_read_u64(ctrl) ^ (UINT64_C(0x0101010101010101) * tag);
+	return (x - UINT64_C(0x0101010101010101)) & ~x & UINT64_C(0x8080808080808080);
+#endif
+}
+
+// Returns a bitmask of the empty control bytes in a group.
+static ufbxi_forceinline uint64_t ufbxi_map_group_empty(const uint8_t *ctrl)
+{
+#if UFBXI_HAS_SSE
+	return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+#elif UFBXI_HAS_NEON
+	uint8x16_t empty = vtstq_u8(vld1q_u8(ctrl), vdupq_n_u8(UFBXI_MAP_EMPTY));
+	uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(empty), 4);
+	return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & UINT64_C(0x8888888888888888);
+#else
+	return ufbxi_read_u64(ctrl) & UINT64_C(0x8080808080808080);
+#endif
+}
+
+// Index of the lowest slot in a non-zero group bitmask.
+static ufbxi_forceinline uint32_t ufbxi_map_bit_index(uint64_t bits)
+{
+	return (63u - ufbxi_lzcnt64(bits & (~bits + 1))) >> UFBXI_MAP_BIT_SHIFT;
+}
+
 static ufbxi_noinline void ufbxi_map_init(ufbxi_map *map, ufbxi_allocator *ator, ufbxi_cmp_fn *cmp_fn, void *cmp_user)
 {
 	map->ator = ator;
+	map->cmp_fn = cmp_fn;
+	map->cmp_user = cmp_user;
+	map->tree_root = UFBXI_MAP_TREE_NONE;
+
 #if defined(UFBX_REGRESSION)
-	// HACK: Maps contain pointers that are not stable between runs, in regression
-	// mode this causes instability in allocation patterns due to different AA trees
-	// being built, which is a problem in fuzz checks that need to have deterministic
-	// allocation counts. We can work around this using a local allocator that doesn't
-	// count the allocations.
-	{
-		ufbxi_allocator *regression_ator = (ufbxi_allocator*)malloc(sizeof(ufbxi_allocator));
-		ufbx_assert(regression_ator);
-		memset(regression_ator, 0, sizeof(ufbxi_allocator));
-		regression_ator->name = "regression";
-		regression_ator->error = ator->error;
-		regression_ator->huge_size = ator->huge_size;
-		regression_ator->max_size = SIZE_MAX;
-		regression_ator->max_allocs = SIZE_MAX;
-		regression_ator->chunk_max = 0x1000000;
-		map->aa_buf.ator = regression_ator;
-	}
+	// Keep regression runs reproducible
+	map->seed = UINT64_C(0x6a09e667f3bcc908);
 #else
-	map->aa_buf.ator = ator;
+	// Derive the seed from addresses that vary between runs with address space layout
+	// randomization, making it harder to craft colliding keys ahead of time. The seed is
+	// not a secret, the tree fallback keeps the map usable if keys do collide.
+	uint64_t seed = (uint64_t)(uintptr_t)map * UINT64_C(0x9e3779b97f4a7c15);
+	seed ^= (uint64_t)(uintptr_t)&seed * UINT64_C(0xc2b2ae3d27d4eb4f);
+	seed ^= (uint64_t)(uintptr_t)ufbxi_empty_char * UINT64_C(0x165667b19e3779f9);
+	seed ^= seed >> 32u;
+	seed *= UINT64_C(0xd6e8feb86659fd93);
+	seed ^= seed >> 32u;
+	map->seed = seed;
 #endif
-	map->cmp_fn = cmp_fn;
-	map->cmp_user = cmp_user;
 }
 
 static ufbxi_noinline void ufbxi_map_free(ufbxi_map *map)
 {
-#if defined(UFBX_REGRESSION)
-	ufbxi_allocator *regression_ator = map->aa_buf.ator;
-#endif
-
-	ufbxi_buf_free(&map->aa_buf);
-	ufbxi_free(map->ator, char, map->entries, map->data_size);
-	map->entries = NULL;
+	ufbxi_free(map->ator, char, (char*)map->hashes, map->data_size);
+	ufbxi_free(map->ator, ufbxi_map_node, map->tree, map->tree_capacity);
+	map->hashes = NULL;
 	map->items = NULL;
-	map->aa_root = NULL;
+	map->slots = NULL;
+	map->ctrl = NULL;
+	map->tree = NULL;
+	map->data_size = 0;
 	map->mask = map->capacity = map->size = 0;
+	map->tree_capacity = 0;
+	map->tree_root = UFBXI_MAP_TREE_NONE;
+}
 
-#if defined(UFBX_REGRESSION)
-	if (regression_ator) {
-		ufbxi_free_ator(regression_ator);
-		free(regression_ator);
+// Remove all items from `map` but retain the allocated memory.
+static ufbxi_noinline void ufbxi_map_clear(ufbxi_map *map)
+{
+	if (map->ctrl) {
+		memset(map->ctrl, UFBXI_MAP_EMPTY, (size_t)map->mask + 1 + UFBXI_MAP_GROUP);
 	}
-#endif
+	map->size = 0;
+	map->tree_root = UFBXI_MAP_TREE_NONE;
 }
 
-// Recursion limit: log2(2^64 / sizeof(ufbxi_aa_node))
-static ufbxi_noinline ufbxi_aa_node *ufbxi_aa_tree_insert(ufbxi_map *map, ufbxi_aa_node *node, const void *value, uint32_t index, size_t item_size)
-	ufbxi_recursive_function(ufbxi_aa_node *, ufbxi_aa_tree_insert, (map, node, value, index, item_size), 59,
-		(ufbxi_map *map, ufbxi_aa_node *node, const void *value, uint32_t index, size_t item_size))
+// Make sure `map->tree` has a node for every item that fits in the table.
+ufbxi_nodiscard static ufbxi_noinline bool ufbxi_map_reserve_tree(ufbxi_map *map, uint32_t capacity)
 {
-	if (!node) {
-		ufbxi_aa_node *new_node = ufbxi_push(&map->aa_buf, ufbxi_aa_node, 1);
-		if (!new_node) return NULL;
-		new_node->left = NULL;
-		new_node->right = NULL;
-		new_node->level = 1;
-		new_node->index = index;
-		return new_node;
+	if (map->tree_capacity >= capacity) return true;
+	ufbxi_map_node *tree = ufbxi_alloc(map->ator, ufbxi_map_node, capacity);
+	ufbxi_check_return_err(map->ator->error, tree, false);
+	if (map->tree_root != UFBXI_MAP_TREE_NONE) {
+		memcpy(tree, map->tree, map->tree_capacity * sizeof(ufbxi_map_node));
+	}
+	ufbxi_free(map->ator, ufbxi_map_node, map->tree, map->tree_capacity);
+	map->tree = tree;
+	map->tree_capacity = capacity;
+	return true;
+}
+
+// Copy the contents of `src` to `dst`, items are copied as-is so they must not own memory.
+ufbxi_nodiscard static ufbxi_noinline bool ufbxi_map_copy(ufbxi_map *dst, const ufbxi_map *src)
+{
+	if (dst->data_size != src->data_size) {
+		char *data = ufbxi_alloc(dst->ator, char, src->data_size);
+		ufbxi_check_return_err(dst->ator->error, data, false);
+		ufbxi_free(dst->ator, char, (char*)dst->hashes, dst->data_size);
+		dst->hashes = (uint32_t*)data;
+		dst->data_size = src->data_size;
+	}
+
+	const char *src_data = (const char*)src->hashes;
+	char *dst_data = (char*)dst->hashes;
+	memcpy(dst_data, src_data, src->data_size);
+	dst->items = dst_data + ((const char*)src->items - src_data);
+	dst->slots = (uint32_t*)(dst_data + ((const char*)src->slots - src_data));
+	dst->ctrl = (uint8_t*)dst_data + (src->ctrl - (const uint8_t*)src_data);
+	dst->mask = src->mask;
+	dst->capacity = src->capacity;
+	dst->size = src->size;
+	dst->seed = src->seed;
+
+	dst->tree_root = UFBXI_MAP_TREE_NONE;
+	if (src->tree_root != UFBXI_MAP_TREE_NONE) {
+		if (!ufbxi_map_reserve_tree(dst, src->tree_capacity)) return false;
+		memcpy(dst->tree, src->tree, src->tree_capacity * sizeof(ufbxi_map_node));
+		dst->tree_root = src->tree_root;
+	}
+	return true;
+}
+
+static ufbxi_noinline void ufbxi_map_set_ator(ufbxi_map *map, ufbxi_allocator *ator)
+{
+	map->ator = ator;
+}
+
+// Place item `index` in the first empty slot along the probe sequence of `hash`.
+// Returns `false` if there is no empty slot within `UFBXI_MAP_MAX_SCAN` groups.
+static ufbxi_forceinline bool ufbxi_map_insert_slot(ufbxi_map *map, uint32_t hash, uint32_t index)
+{
+	uint8_t *ctrl = map->ctrl;
+	uint32_t mask = map->mask;
+	uint32_t pos = hash & mask, stride = 0;
+	for (uint32_t scan = 0; scan < UFBXI_MAP_MAX_SCAN; scan++) {
+		uint64_t empty = ufbxi_map_group_empty(ctrl + pos);
+		if (empty) {
+			uint32_t slot = (pos + ufbxi_map_bit_index(empty)) & mask;
+			uint8_t tag = (uint8_t)(hash >> 25u);
+			ctrl[slot] = tag;
+			if (slot < UFBXI_MAP_GROUP) ctrl[mask + 1 + slot] = tag;
+			map->slots[slot] = index;
+			return true;
+		}
+		stride += UFBXI_MAP_GROUP;
+		pos = (pos + stride) & mask;
+	}
+	return false;
+}
+
+// Insert item `index` with the value `value` to the subtree at `node_ix`, returns the new root of the subtree.
+// Recursion limit: AA trees are at most 2*log2(n) deep
+static ufbxi_noinline uint32_t ufbxi_map_tree_insert(ufbxi_map *map, uint32_t node_ix, const void *value, uint32_t index, size_t item_size)
+	ufbxi_recursive_function(uint32_t, ufbxi_map_tree_insert, (map, node_ix, value, index, item_size), 64,
+		(ufbxi_map *map, uint32_t node_ix, const void *value, uint32_t index, size_t item_size))
+{
+	ufbxi_map_node *nodes = map->tree;
+	if (node_ix == UFBXI_MAP_TREE_NONE) {
+		ufbxi_map_node *node = &nodes[index];
+		node->left = UFBXI_MAP_TREE_NONE;
+		node->right = UFBXI_MAP_TREE_NONE;
+		node->level = 1;
+		return index;
 	}
 
-	void *entry = (char*)map->items + node->index * item_size;
-	int cmp = map->cmp_fn(map->cmp_user, value, entry);
-	if (cmp < 0) {
-		node->left = ufbxi_aa_tree_insert(map, node->left, value, index, item_size);
-	} else if (cmp >= 0) {
-		node->right = ufbxi_aa_tree_insert(map, node->right, value, index, item_size);
+	ufbxi_map_node *node = &nodes[node_ix];
+	const void *entry = (const char*)map->items + node_ix * item_size;
+	if (map->cmp_fn(map->cmp_user, value, entry) < 0) {
+		node->left = ufbxi_map_tree_insert(map, node->left, value, index, item_size);
+	} else {
+		node->right = ufbxi_map_tree_insert(map, node->right, value, index, item_size);
 	}
 
-	if (node->left && node->left->level == node->level) {
-		ufbxi_aa_node *left = node->left;
-		node->left = left->right;
-		left->right = node;
-		node = left;
+	if (node->left != UFBXI_MAP_TREE_NONE && nodes[node->left].level == node->level) {
+		uint32_t left = node->left;
+		node->left = nodes[left].right;
+		nodes[left].right = node_ix;
+		node_ix = left;
+		node = &nodes[node_ix];
 	}
 
-	if (node->right && node->right->right && node->right->right->level == node->level) {
-		ufbxi_aa_node *right = node->right;
-		node->right = right->left;
-		right->left = node;
-		right->level += 1;
-		node = right;
+	if (node->right != UFBXI_MAP_TREE_NONE && nodes[node->right].right != UFBXI_MAP_TREE_NONE
+		&& nodes[nodes[node->right].right].level == node->level) {
+		uint32_t right = node->right;
+		node->right = nodes[right].left;
+		nodes[right].left = node_ix;
+		nodes[right].level += 1;
+		node_ix = right;
 	}
 
-	return node;
+	return node_ix;
 }
 
-static ufbxi_noinline void *ufbxi_aa_tree_find(ufbxi_map *map, const void *value, size_t item_size)
+static ufbxi_noinline void *ufbxi_map_tree_find(ufbxi_map *map, size_t item_size, const void *value)
 {
-	ufbxi_aa_node *node = map->aa_root;
-	while (node) {
-		void *entry = (char*)map->items + node->index * item_size;
+	uint32_t node_ix = map->tree_root;
+	while (node_ix != UFBXI_MAP_TREE_NONE) {
+		void *entry = (char*)map->items + node_ix * item_size;
 		int cmp = map->cmp_fn(map->cmp_user, value, entry);
 		if (cmp < 0) {
-			node = node->left;
+			node_ix = map->tree[node_ix].left;
 		} else if (cmp > 0) {
-			node = node->right;
+			node_ix = map->tree[node_ix].right;
 		} else {
 			return entry;
 		}
@@ -3695,78 +4240,69 @@ static ufbxi_noinline void *ufbxi_aa_tree_find(ufbxi_map *map, const void *value
 	return NULL;
 }
 
+// Store item `index` in the table, or in the tree if the probe sequence of `hash` is full.
+ufbxi_nodiscard static ufbxi_forceinline bool ufbxi_map_insert_index(ufbxi_map *map, size_t item_size, uint32_t hash, uint32_t index, const void *value)
+{
+	if (ufbxi_map_insert_slot(map, hash, index)) return true;
+	if (!ufbxi_map_reserve_tree(map, map->capacity)) return false;
+	map->tree_root = ufbxi_map_tree_insert(map, map->tree_root, value, index, item_size);
+	return true;
+}
+
 static ufbxi_noinline bool ufbxi_map_grow_size_imp(ufbxi_map *map, size_t item_size, size_t min_size)
 {
 	ufbx_assert(min_size > 0);
-	const double load_factor = 0.7;
 
-	// Find the lowest power of two size that fits `min_size` within `load_factor`
-	size_t num_entries = map->mask + 1;
-	size_t new_size = (size_t)((double)num_entries * load_factor);
+	// Find the lowest power of two amount of slots that fits `min_size` within 7/8 load factor
+	size_t num_slots = map->mask ? (size_t)map->mask + 1 : UFBXI_MAP_GROUP;
 	if (min_size < map->capacity + 1) min_size = map->capacity + 1;
-	while (new_size < min_size) {
-		num_entries *= 2;
-		new_size = (size_t)((double)num_entries * load_factor);
+	while (num_slots - num_slots / 8 < min_size) {
+		ufbxi_check_return_err(map->ator->error, num_slots <= UINT32_MAX / 2, false);
+		num_slots *= 2;
 	}
+	size_t capacity = num_slots - num_slots / 8;
 
-	// Check for overflow
-	ufbxi_check_return_err(map->ator->error, SIZE_MAX / num_entries > sizeof(uint64_t), false);
-	size_t alloc_size = num_entries * sizeof(uint64_t);
-
-	// Allocate a combined entry/item memory block
-	ufbxi_check_return_err(map->ator->error, (SIZE_MAX - alloc_size) / new_size > item_size, false);
-	size_t data_size = alloc_size + new_size * item_size;
+	// Allocate a combined hash/slot/item/control memory block, check for overflow
+	ufbxi_check_return_err(map->ator->error, SIZE_MAX / num_slots > 16, false);
+	size_t items_offset = ufbxi_align_to_mask((capacity + num_slots) * sizeof(uint32_t), 7);
+	size_t ctrl_size = num_slots + UFBXI_MAP_GROUP;
+	ufbxi_check_return_err(map->ator->error, (SIZE_MAX - items_offset - ctrl_size) / capacity > item_size, false);
+	size_t ctrl_offset = items_offset + capacity * item_size;
+	size_t data_size = ctrl_offset + ctrl_size;
 
 	char *data = ufbxi_alloc(map->ator, char, data_size);
 	ufbxi_check_return_err(map->ator->error, data, false);
 
-	// Copy the previous user items over
-	uint64_t *old_entries = map->entries;
-	uint64_t *new_entries = (uint64_t*)data;
-	void *new_items = data + alloc_size;
+	// Copy the previous user items and their hashes over
+	uint32_t *new_hashes = (uint32_t*)data;
+	void *new_items = data + items_offset;
 	if (map->size > 0) {
+		memcpy(new_hashes, map->hashes, sizeof(uint32_t) * map->size);
 		memcpy(new_items, map->items, item_size * map->size);
 	}
 
-	// Re-hash the entries
-	uint32_t old_mask = map->mask;
-	uint32_t new_mask = (uint32_t)(num_entries) - 1;
-	memset(new_entries, 0, sizeof(uint64_t) * num_entries);
-	if (old_mask) {
-		for (uint32_t i = 0; i <= old_mask; i++) {
-			uint64_t entry, new_entry = old_entries[i];
-			if (!new_entry) continue;
-
-			// Reconstruct the hash of the old entry at `i`
-			uint32_t old_scan = (uint32_t)(new_entry & old_mask) - 1;
-			uint32_t hash = ((uint32_t)new_entry & ~old_mask) | ((i - old_scan) & old_mask);
-			uint32_t slot = hash & new_mask;
-			new_entry &= ~(uint64_t)new_mask;
-
-			// Scan forward until we find an empty slot, potentially swapping
-			// `new_element` if it has a shorter scan distance (Robin Hood).
-			uint32_t scan = 1;
-			while ((entry = new_entries[slot]) != 0) {
-				uint32_t entry_scan = (uint32_t)(entry & new_mask);
-				if (entry_scan < scan) {
-					new_entries[slot] = new_entry + scan;
-					new_entry = (entry & ~(uint64_t)new_mask);
-					scan = entry_scan;
-				}
-				scan += 1;
-				slot = (slot + 1) & new_mask;
-			}
-			new_entries[slot] = new_entry + scan;
-		}
-	}
-
 	// And finally free the previous allocation
-	ufbxi_free(map->ator, char, (char*)old_entries, map->data_size);
+	ufbxi_free(map->ator, char, (char*)map->hashes, map->data_size);
+	map->hashes = new_hashes;
 	map->items = new_items;
+	map->slots = new_hashes + capacity;
+	map->ctrl = (uint8_t*)data + ctrl_offset;
 	map->data_size = data_size;
-	map->entries = new_entries;
-	map->mask = new_mask;
-	map->capacity = (uint32_t)new_size;
+	map->mask = (uint32_t)num_slots - 1;
+	map->capacity = (uint32_t)capacity;
+	map->tree_root = UFBXI_MAP_TREE_NONE;
+
+	// Regression builds always reserve the tree so that the allocations don't depend on hash values
+	#if defined(UFBX_REGRESSION)
+		if (!ufbxi_map_reserve_tree(map, map->capacity)) return false;
+	#endif
+
+	// Re-insert the items in order using the stored hashes
+	memset(map->ctrl, UFBXI_MAP_EMPTY, ctrl_size);
+	for (uint32_t i = 0; i < map->size; i++) {
+		const void *item = (const char*)new_items + i * item_size;
+		if (!ufbxi_map_insert_index(map, item_size, new_hashes[i], i, item)) return false;
+	}
 
 	return true;
 }
@@ -3787,30 +4323,59 @@ static ufbxi_forceinline bool ufbxi_map_grow_size(ufbxi_map *map, size_t size, s
 
 static ufbxi_noinline void *ufbxi_map_find_size(ufbxi_map *map, size_t size, uint32_t hash, const void *value)
 {
-	uint64_t *entries = map->entries;
-	uint32_t mask = map->mask, scan = 0;
-
-	uint32_t ref = hash & ~mask;
-	if (!mask || scan == UINT32_MAX) return 0;
-
-	// Scan entries until we find an exact match of the hash or until we hit
-	// an element that has lower scan distance than our search (Robin Hood).
-	// The encoding guarantees that zero slots also terminate with the same test.
-	for (;;) {
-		uint64_t entry = entries[(hash + scan) & mask];
-		scan += 1;
-		if ((uint32_t)entry == ref + scan) {
-			uint32_t index = (uint32_t)(entry >> 32u);
+	uint32_t mask = map->mask;
+	if (!mask) return NULL;
+
+	const uint8_t *ctrl = map->ctrl;
+	uint32_t tag = hash >> 25u;
+	uint32_t pos = hash & mask, stride = 0;
+
+	// Compare all the items with a matching tag in each group until we reach a group
+	// with an empty slot, as the key would have been inserted there. The slots are in
+	// a separate array so start fetching them while matching the control bytes.
+	ufbxi_prefetch(map->slots + pos);
+	for (uint32_t scan = 0; scan < UFBXI_MAP_MAX_SCAN; scan++) {
+		uint64_t match = ufbxi_map_group_match(ctrl + pos, tag);
+		while (match) {
+			uint32_t index = map->slots[(pos + ufbxi_map_bit_index(match)) & mask];
 			void *data = (char*)map->items + size * index;
 			int cmp = map->cmp_fn(map->cmp_user, value, data);
 			if (cmp == 0) return data;
-		} else if ((entry & mask) < scan) {
-			if (map->aa_root) {
-				return ufbxi_aa_tree_find(map, value, size);
-			} else {
-				return NULL;
+			match &= match - 1;
+		}
+		if (ufbxi_map_group_empty(ctrl + pos)) return NULL;
+		stride += UFBXI_MAP_GROUP;
+		pos = (pos + stride) & mask;
+	}
+
+	// The probe sequence is full so the item may have been stored in the tree
+	return ufbxi_map_tree_find(map, size, value);
+}
+
+// Accumulate the number of groups probed to find each item in `map`.
+static ufbxi_noinline void ufbxi_map_probe_stats(const ufbxi_map *map, size_t *p_entries, uint64_t *p_total, size_t *p_max)
+{
+	uint32_t mask = map->mask;
+	for (uint32_t i = 0; i < map->size; i++) {
+		uint32_t hash = map->hashes[i];
+		uint32_t pos = hash & mask, stride = 0;
+		size_t probes = 1;
+		for (;;) {
+			uint64_t match = ufbxi_map_group_match(map->ctrl + pos, hash >> 25u);
+			while (match && map->slots[(pos + ufbxi_map_bit_index(match)) & mask] != i) {
+				match &= match - 1;
 			}
+			if (match) break;
+
+			// Items in the tree are found after probing the maximum amount of groups
+			if (probes >= UFBXI_MAP_MAX_SCAN) break;
+			stride += UFBXI_MAP_GROUP;
+			pos = (pos + stride) & mask;
+			probes++;
 		}
+		*p_entries += 1;
+		*p_total += probes;
+		if (probes > *p_max) *p_max = probes;
 	}
 }
 
@@ -3820,34 +4385,10 @@ static ufbxi_noinline void *ufbxi_map_insert_size(ufbxi_map *map, size_t size, u
 
 	ufbxi_regression_assert(ufbxi_map_find_size(map, size, hash, value) == NULL);
 
-	uint32_t index = map->size++;
-
-	uint64_t *entries = map->entries;
-	uint32_t mask = map->mask;
-
-	// Scan forward until we find an empty slot, potentially swapping
-	// `new_element` if it has a shorter scan distance (Robin Hood).
-	uint32_t slot = hash & mask;
-	uint64_t entry, new_entry = (uint64_t)index << 32u | (hash & ~mask);
-	uint32_t scan = 1;
-	while ((entry = entries[slot]) != 0) {
-		uint32_t entry_scan = (uint32_t)(entry & mask);
-		if (entry_scan < scan) {
-			entries[slot] = new_entry + scan;
-			new_entry = (entry & ~(uint64_t)mask);
-			scan = entry_scan;
-		}
-		scan += 1;
-		slot = (slot + 1) & mask;
-
-		if (scan > UFBXI_MAP_MAX_SCAN) {
-			uint32_t new_index = (uint32_t)(new_entry >> 32u);
-			const void *new_value = new_index == index ? value : (const void*)((char*)map->items + size * new_index);
-			map->aa_root = ufbxi_aa_tree_insert(map, map->aa_root, new_value, new_index, size);
-			return (char*)map->items + size * index;
-		}
-	}
-	entries[slot] = new_entry + scan;
+	uint32_t index = map->size;
+	if (!ufbxi_map_insert_index(map, size, hash, index, value)) return NULL;
+	map->hashes[index] = hash;
+	map->size++;
 
 	return (char*)map->items + size * index;
 }
@@ -3885,59 +4426,81 @@ static int ufbxi_map_cmp_uintptr(void *user, const void *va, const void *vb)
 
 // -- Hash functions
 
-static ufbxi_noinline uint32_t ufbxi_hash_string(const char *str, size_t length)
+// Mix a 32-bit word into a keyed string hash. The state is wider than the words so the
+// carries of the multiplication depend on the seed, which prevents building colliding
+// strings without knowing it. Strings are hashed in two independent lanes of 4 bytes.
+#define ufbxi_hash_string_mix(hash, word) do { \
+		hash = (hash ^ (word)) * UINT64_C(0x9e3779b97f4a7c15); \
+		hash = hash << 32u | hash >> 32u; \
+	} while (0)
+
+static ufbxi_forceinline uint32_t ufbxi_hash_string_finish(uint64_t hash_a, uint64_t hash_b)
 {
-	uint32_t hash = (uint32_t)length;
-	uint32_t seed = UINT32_C(0x9e3779b9);
-	if (length >= 4) {
+	uint64_t hash = hash_a ^ (hash_b << 32u | hash_b >> 32u);
+	hash *= UINT64_C(0xd6e8feb86659fd93);
+	hash ^= hash >> 32u;
+	return (uint32_t)hash;
+}
+
+static ufbxi_noinline uint32_t ufbxi_hash_string(const char *str, size_t length, uint64_t seed)
+{
+	uint64_t hash_a = seed ^ (uint64_t)length;
+	uint64_t hash_b = seed + UINT64_C(0x6a09e667f3bcc909);
+	if (length >= 8) {
 		do {
-			uint32_t word = ufbxi_read_u32(str);
-			hash = ((hash << 5u | hash >> 27u) ^ word) * seed;
-			str += 4;
-			length -= 4;
-		} while (length >= 4);
-
-		uint32_t word = ufbxi_read_u32(str + length - 4);
-		hash = ((hash << 5u | hash >> 27u) ^ word) * seed;
+			ufbxi_hash_string_mix(hash_a, ufbxi_read_u32(str));
+			ufbxi_hash_string_mix(hash_b, ufbxi_read_u32(str + 4));
+			str += 8;
+			length -= 8;
+		} while (length >= 8);
+
+		ufbxi_hash_string_mix(hash_a, ufbxi_read_u32(str + length - 8));
+		ufbxi_hash_string_mix(hash_b, ufbxi_read_u32(str + length - 4));
+	} else if (length >= 4) {
+		ufbxi_hash_string_mix(hash_a, ufbxi_read_u32(str));
+		ufbxi_hash_string_mix(hash_b, ufbxi_read_u32(str + length - 4));
 	} else {
 		uint32_t word = 0;
 		if (length >= 1) word |= (uint32_t)(uint8_t)str[0] << 0;
 		if (length >= 2) word |= (uint32_t)(uint8_t)str[1] << 8;
 		if (length >= 3) word |= (uint32_t)(uint8_t)str[2] << 16;
-		hash = ((hash << 5u | hash >> 27u) ^ word) * seed;
+		ufbxi_hash_string_mix(hash_a, word);
 	}
-	hash ^= hash >> 16;
-	hash *= UINT32_C(0x7feb352d);
-	hash ^= hash >> 15;
-	return hash;
+	return ufbxi_hash_string_finish(hash_a, hash_b);
 }
 
 // NOTE: _Must_ match `ufbxi_hash_string()`
-static ufbxi_noinline uint32_t ufbxi_hash_string_check_ascii(const char *str, size_t length, bool *p_non_ascii)
+static ufbxi_noinline uint32_t ufbxi_hash_string_check_ascii(const char *str, size_t length, uint64_t seed, bool *p_non_ascii)
 {
 	uint32_t ascii_mask = 0;
 	uint32_t zero_mask = 0;
 
 	ufbx_assert(length > 0);
 
-	uint32_t hash = (uint32_t)length;
-	uint32_t seed = UINT32_C(0x9e3779b9);
+	uint64_t hash_a = seed ^ (uint64_t)length;
+	uint64_t hash_b = seed + UINT64_C(0x6a09e667f3bcc909);
 	if (length >= 4) {
-		do {
-			uint32_t word = ufbxi_read_u32(str);
-			ascii_mask |= word;
-			zero_mask |= UINT32_C(0x80808080) - word;
-
-			hash = ((hash << 5u | hash >> 27u) ^ word) * seed;
-			str += 4;
-			length -= 4;
-		} while (length >= 4);
-
-		uint32_t word = ufbxi_read_u32(str + length - 4);
-		ascii_mask |= word;
-		zero_mask |= UINT32_C(0x80808080) - word;
-
-		hash = ((hash << 5u | hash >> 27u) ^ word) * seed;
+		const char *last_a = length >= 8 ? str + length - 8 : str;
+		while (length >= 8) {
+			uint32_t word_a = ufbxi_read_u32(str);
+			uint32_t word_b = ufbxi_read_u32(str + 4);
+			ascii_mask |= word_a | word_b;
+			zero_mask |= (UINT32_C(0x80808080) - word_a) | (UINT32_C(0x80808080) - word_b);
+
+			ufbxi_hash_string_mix(hash_a, word_a);
+			ufbxi_hash_string_mix(hash_b, word_b);
+			str += 8;
+			length -= 8;
+		}
+
+		// Remaining bytes, overlapping the previously hashed ones
+		uint32_t word_a = ufbxi_read_u32(last_a);
+		uint32_t word_b = ufbxi_read_u32(str + length - 4);
+		ascii_mask |= word_a | word_b;
+		zero_mask |= (UINT32_C(0x80808080) - word_a) | (UINT32_C(0x80808080) - word_b);
+
+		ufbxi_hash_string_mix(hash_a, word_a);
+		ufbxi_hash_string_mix(hash_b, word_b);
 	} else {
 		uint32_t word = 0;
 		if (length >= 1) word |= (uint32_t)(uint8_t)str[0] << 0;
@@ -3947,7 +4510,7 @@ static ufbxi_noinline uint32_t ufbxi_hash_string_check_ascii(const char *str, si
 		ascii_mask |= word;
 		zero_mask |= (UINT32_C(0x80808080) >> ((4u - length) * 8u)) - word;
 
-		hash = ((hash << 5u | hash >> 27u) ^ word) * seed;
+		ufbxi_hash_string_mix(hash_a, word);
 	}
 
 	// If any character has high bit set or is zero we're not ASCII
@@ -3955,11 +4518,7 @@ static ufbxi_noinline uint32_t ufbxi_hash_string_check_ascii(const char *str, si
 		*p_non_ascii = true;
 	}
 
-	hash ^= hash >> 16;
-	hash *= UINT32_C(0x7feb352d);
-	hash ^= hash >> 15;
-
-	return hash;
+	return ufbxi_hash_string_finish(hash_a, hash_b);
 }
 
 static ufbxi_forceinline uint32_t ufbxi_hash32(uint32_t x)
@@ -3991,18 +4550,50 @@ static ufbxi_forceinline uint32_t ufbxi_hash_uptr(uintptr_t ptr)
 
 // -- Warnings
 
+// Skip plain ASCII bytes in `[1, 0x7f]` starting from `index` in blocks, returns the index
+// of the first other byte or `length`.
+static ufbxi_forceinline size_t ufbxi_utf8_skip_ascii(const char *str, size_t index, size_t length)
+{
+#if UFBXI_HAS_SSE
+	const __m128i zero = _mm_setzero_si128();
+	while (length - index >= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i*)(str + index));
+		if (_mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, zero))) != 0) break;
+		index += 16;
+	}
+#elif UFBXI_HAS_NEON
+	while (length - index >= 16) {
+		uint8x16_t v = vld1q_u8((const uint8_t*)str + index);
+		uint64x2_t bad = vreinterpretq_u64_u8(vcgeq_u8(vsubq_u8(v, vdupq_n_u8(1)), vdupq_n_u8(0x7f)));
+		if ((vgetq_lane_u64(bad, 0) | vgetq_lane_u64(bad, 1)) != 0) break;
+		index += 16;
+	}
+#endif
+	while (length - index >= 8) {
+		uint64_t word = ufbxi_read_u64(str + index);
+		uint64_t zero_bytes = (word - UINT64_C(0x0101010101010101)) & ~word;
+		if (((word | zero_bytes) & UINT64_C(0x8080808080808080)) != 0) break;
+		index += 8;
+	}
+	while (index < length && (uint8_t)((uint8_t)str[index] - 1u) < 0x7fu) {
+		index++;
+	}
+	return index;
+}
+
 ufbxi_nodiscard static ufbxi_noinline size_t ufbxi_utf8_valid_length(const char *str, size_t length)
 {
 	size_t index = 0;
 	while (index < length) {
+		index = ufbxi_utf8_skip_ascii(str, index, length);
+		if (index == length) break;
+
 		uint8_t c = (uint8_t)str[index];
 		size_t left = length - index;
 
+		// NUL bytes are not allowed, other ASCII is skipped above
 		if ((c & 0x80) == 0) {
-			if (c != 0) {
-				index += 1;
-				continue;
-			}
+			break;
 		} else if ((c & 0xe0) == 0xc0 && left >= 2) {
 			uint8_t t0 = (uint8_t)str[index + 1];
 			uint32_t code = (uint32_t)c << 8 | (uint32_t)t0;
@@ -4112,6 +4703,8 @@ typedef struct {
 	size_t temp_cap; // < Capacity of the temporary buffer
 	ufbx_unicode_error_handling error_handling;
 	ufbxi_warnings *warnings;
+	size_t num_hits;   // < Number of strings found in `map`
+	size_t num_misses; // < Number of strings added to `map`
 } ufbxi_string_pool;
 
 typedef struct {
@@ -4372,7 +4965,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_sanitize_string(ufbxi_string_poo
 
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_push_sanitized_string(ufbxi_string_pool *pool, ufbxi_sanitized_string *sanitized, const char *str, size_t length, uint32_t hash, bool raw)
 {
-	ufbxi_regression_assert(hash == ufbxi_hash_string(str, length));
+	ufbxi_regression_assert(hash == ufbxi_hash_string(str, length, pool->map.seed));
 
 	ufbxi_check_err(pool->error, length <= UINT32_MAX);
 	ufbxi_check_err(pool->error, ufbxi_map_grow(&pool->map, ufbx_string, pool->initial_size));
@@ -4389,7 +4982,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_push_sanitized_string(ufbxi_stri
 			ufbxi_check_err(pool->error, ufbxi_sanitize_string(pool, sanitized, str, length, valid_length, true));
 			total_data = sanitized->raw_data;
 			total_length = sanitized->raw_length + sanitized->utf8_length + 1;
-			hash = ufbxi_hash_string(str, length);
+			hash = ufbxi_hash_string(str, length, pool->map.seed);
 		}
 	}
 
@@ -4397,8 +4990,10 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_push_sanitized_string(ufbxi_stri
 
 	ufbx_string *entry = ufbxi_map_find(&pool->map, ufbx_string, hash, &ref);
 	if (entry) {
+		pool->num_hits++;
 		sanitized->raw_data = entry->data;
 	} else {
+		pool->num_misses++;
 		entry = ufbxi_map_insert(&pool->map, ufbx_string, hash, &ref);
 		ufbxi_check_err(pool->error, entry);
 		entry->length = total_length;
@@ -4421,10 +5016,10 @@ ufbxi_nodiscard static ufbxi_noinline const char *ufbxi_push_string_imp(ufbxi_st
 
 	uint32_t hash;
 	if (raw) {
-		hash = ufbxi_hash_string(str, length);
+		hash = ufbxi_hash_string(str, length, pool->map.seed);
 	} else {
 		bool non_ascii = false;
-		hash = ufbxi_hash_string_check_ascii(str, length, &non_ascii);
+		hash = ufbxi_hash_string_check_ascii(str, length, pool->map.seed, &non_ascii);
 		if (non_ascii) {
 			size_t valid_length = ufbxi_utf8_valid_length(str, length);
 			if (valid_length < length) {
@@ -4432,7 +5027,7 @@ ufbxi_nodiscard static ufbxi_noinline const char *ufbxi_push_string_imp(ufbxi_st
 				ufbxi_check_return_err(pool->error, ufbxi_sanitize_string(pool, &sanitized, str, length, valid_length, false), NULL);
 				str = sanitized.raw_data;
 				length = sanitized.raw_length;
-				hash = ufbxi_hash_string(str, length);
+				hash = ufbxi_hash_string(str, length, pool->map.seed);
 				*p_out_length = length;
 			}
 		}
@@ -4441,7 +5036,11 @@ ufbxi_nodiscard static ufbxi_noinline const char *ufbxi_push_string_imp(ufbxi_st
 	ufbx_string ref = { str, length };
 
 	ufbx_string *entry = ufbxi_map_find(&pool->map, ufbx_string, hash, &ref);
-	if (entry) return entry->data;
+	if (entry) {
+		pool->num_hits++;
+		return entry->data;
+	}
+	pool->num_misses++;
 	entry = ufbxi_map_insert(&pool->map, ufbx_string, hash, &ref);
 	ufbxi_check_return_err(pool->error, entry, NULL);
 	entry->length = length;
@@ -5148,6 +5747,247 @@ static ufbxi_noinline ufbx_vec3 ufbxi_slow_normalized_cross3(const ufbx_vec3 *a,
 	return ufbxi_normalize3(ufbxi_cross3(*a, *b));
 }
 
+// -- Read-ahead
+
+// Streams are wrapped in `ufbxi_read_ahead` to measure the time spent waiting for data.
+// If a thread pool is provided a background task reads chunks into a ring buffer ahead
+// of the parser. The task and the parser never touch the same chunks and the parser only
+// looks at the results of the task after `ufbx_thread_pool_wait_fn()`.
+
+#define UFBXI_READ_AHEAD_MAX_CHUNKS 64
+
+typedef struct {
+	ufbx_stream src;
+	ufbx_thread_pool pool;
+	ufbxi_allocator *ator;
+	ufbx_io_stats *stats;
+
+	// Ring buffer of `num_chunks` chunks of `chunk_size` bytes, allocated on first read.
+	// `num_ready` chunks starting from `head` contain `chunk_sizes[]` bytes of data.
+	char *chunks;
+	size_t chunk_size;
+	size_t num_chunks;
+	size_t head;
+	size_t head_pos;
+	size_t num_ready;
+	size_t chunk_sizes[UFBXI_READ_AHEAD_MAX_CHUNKS];
+
+	// Background task reading `task_count` chunks starting from `task_first`
+	bool pending;
+	size_t task_first;
+	size_t task_count;
+	size_t task_filled;
+	bool task_eof;
+	bool task_error;
+
+	bool eof;
+	bool error;
+	bool synchronous;
+} ufbxi_read_ahead;
+
+static void ufbxi_read_ahead_task(void *user, uint32_t index)
+{
+	ufbxi_read_ahead *ra = (ufbxi_read_ahead*)user;
+	ufbxi_ignore(index);
+
+	for (size_t i = 0; i < ra->task_count; i++) {
+		size_t slot = (ra->task_first + i) % ra->num_chunks;
+		size_t num_read = ra->src.read_fn(ra->src.user, ra->chunks + slot * ra->chunk_size, ra->chunk_size);
+		if (num_read > ra->chunk_size) {
+			ra->task_error = true;
+			break;
+		}
+		ra->chunk_sizes[slot] = num_read;
+		ra->task_filled++;
+		if (num_read < ra->chunk_size) {
+			ra->task_eof = true;
+			break;
+		}
+	}
+}
+
+static ufbxi_noinline void ufbxi_read_ahead_kick(ufbxi_read_ahead *ra)
+{
+	if (ra->pending || ra->eof || ra->error || ra->num_ready == ra->num_chunks) return;
+
+	ra->pending = true;
+	ra->task_first = (ra->head + ra->num_ready) % ra->num_chunks;
+	ra->task_count = ra->num_chunks - ra->num_ready;
+	ra->task_filled = 0;
+	ra->task_eof = false;
+	ra->task_error = false;
+	ra->pool.run_fn(ra->pool.user, &ufbxi_read_ahead_task, ra, 1);
+}
+
+// Wait for the background task to finish, `parser_wait` should be set if
+// the parser can't progress without the data.
+static ufbxi_noinline void ufbxi_read_ahead_sync(ufbxi_read_ahead *ra, bool parser_wait)
+{
+	if (!ra->pending) return;
+
+	uint64_t begin = parser_wait ? ufbxi_time_ns() : 0;
+	ra->pool.wait_fn(ra->pool.user);
+	if (parser_wait) {
+		ra->stats->num_waits++;
+		ra->stats->wait_time += (double)(ufbxi_time_ns() - begin) * 1e-9;
+	}
+
+	ra->pending = false;
+	for (size_t i = 0; i < ra->task_filled; i++) {
+		ra->stats->bytes_read += ra->chunk_sizes[(ra->task_first + i) % ra->num_chunks];
+	}
+	ra->stats->num_reads += ra->task_filled + (ra->task_error ? 1 : 0);
+	ra->num_ready += ra->task_filled;
+	if (ra->task_eof) ra->eof = true;
+	if (ra->task_error) ra->error = true;
+}
+
+// Synchronous read used if there is no thread pool
+static ufbxi_noinline size_t ufbxi_read_ahead_read_sync(ufbxi_read_ahead *ra, void *data, size_t size)
+{
+	uint64_t begin = ufbxi_time_ns();
+	size_t num_read = ra->src.read_fn(ra->src.user, data, size);
+	ra->stats->num_reads++;
+	ra->stats->num_waits++;
+	ra->stats->wait_time += (double)(ufbxi_time_ns() - begin) * 1e-9;
+	if (num_read <= size) {
+		ra->stats->bytes_read += num_read;
+	}
+	return num_read;
+}
+
+static size_t ufbxi_read_ahead_read(void *user, void *data, size_t size)
+{
+	ufbxi_read_ahead *ra = (ufbxi_read_ahead*)user;
+	if (!ra->chunks && !ra->synchronous) {
+		// Fall back to synchronous reads if we fail to allocate the chunks
+		ufbx_error *error = ra->ator->error;
+		ufbx_error ignored_error = { UFBX_ERROR_NONE };
+		ra->ator->error = &ignored_error;
+		ra->chunks = ufbxi_alloc(ra->ator, char, ra->num_chunks * ra->chunk_size);
+		ra->ator->error = error;
+		if (!ra->chunks) ra->synchronous = true;
+	}
+	if (ra->synchronous) {
+		return ufbxi_read_ahead_read_sync(ra, data, size);
+	}
+
+	char *dst = (char*)data;
+	size_t num_read = 0;
+	while (num_read < size) {
+		if (ra->num_ready == 0) {
+			if (!ra->pending) {
+				if (ra->error) return SIZE_MAX;
+				if (ra->eof) break;
+				ufbxi_read_ahead_kick(ra);
+			}
+			ufbxi_read_ahead_sync(ra, true);
+			continue;
+		}
+
+		size_t chunk_size = ra->chunk_sizes[ra->head];
+		size_t to_copy = ufbxi_min_sz(chunk_size - ra->head_pos, size - num_read);
+		memcpy(dst + num_read, ra->chunks + ra->head * ra->chunk_size + ra->head_pos, to_copy);
+		num_read += to_copy;
+		ra->head_pos += to_copy;
+		if (ra->head_pos == chunk_size) {
+			ra->head = (ra->head + 1) % ra->num_chunks;
+			ra->head_pos = 0;
+			ra->num_ready--;
+		}
+	}
+
+	// Keep reading in the background while the parser processes the data
+	ufbxi_read_ahead_kick(ra);
+
+	return num_read;
+}
+
+static bool ufbxi_read_ahead_skip(void *user, size_t size)
+{
+	ufbxi_read_ahead *ra = (ufbxi_read_ahead*)user;
+	if (!ra->chunks) {
+		return ra->src.skip_fn(ra->src.user, size);
+	}
+
+	// Skip buffered data first, the stream itself is positioned after the last read chunk
+	while (size > 0 && (ra->num_ready > 0 || ra->pending)) {
+		if (ra->num_ready == 0) {
+			ufbxi_read_ahead_sync(ra, true);
+			continue;
+		}
+
+		size_t chunk_size = ra->chunk_sizes[ra->head];
+		size_t to_skip = ufbxi_min_sz(chunk_size - ra->head_pos, size);
+		size -= to_skip;
+		ra->head_pos += to_skip;
+		if (ra->head_pos == chunk_size) {
+			ra->head = (ra->head + 1) % ra->num_chunks;
+			ra->head_pos = 0;
+			ra->num_ready--;
+		}
+	}
+
+	if (size > 0) {
+		if (ra->eof || ra->error) return false;
+		return ra->src.skip_fn(ra->src.user, size);
+	}
+	return true;
+}
+
+static void ufbxi_read_ahead_close(void *user)
+{
+	ufbxi_read_ahead *ra = (ufbxi_read_ahead*)user;
+	ufbxi_read_ahead_sync(ra, false);
+	if (ra->src.close_fn) {
+		ra->src.close_fn(ra->src.user);
+	}
+}
+
+// Route reads from `stream` through `ra`, statistics are accumulated to `stats`.
+static ufbxi_noinline void ufbxi_read_ahead_init(ufbxi_read_ahead *ra, ufbx_stream *stream, const ufbx_read_ahead_opts *opts, size_t default_chunk_size, ufbxi_allocator *ator, ufbx_io_stats *stats)
+{
+	memset(ra, 0, sizeof(ufbxi_read_ahead));
+	ra->src = *stream;
+	ra->ator = ator;
+	ra->stats = stats;
+
+	if (opts->pool.run_fn && opts->pool.wait_fn) {
+		ra->pool = opts->pool;
+		ra->num_chunks = opts->num_chunks ? ufbxi_min_sz(opts->num_chunks, UFBXI_READ_AHEAD_MAX_CHUNKS) : 4;
+		ra->chunk_size = opts->chunk_size ? opts->chunk_size : default_chunk_size;
+		if (ra->chunk_size > SIZE_MAX / 2 / ra->num_chunks) {
+			ra->synchronous = true;
+		}
+	} else {
+		ra->synchronous = true;
+	}
+
+	stream->read_fn = &ufbxi_read_ahead_read;
+	stream->skip_fn = ra->src.skip_fn ? &ufbxi_read_ahead_skip : NULL;
+	stream->close_fn = &ufbxi_read_ahead_close;
+	stream->user = ra;
+}
+
+// Wait for any reads in flight and free the buffers, must be called before freeing `ra->ator`.
+static ufbxi_noinline void ufbxi_read_ahead_free(ufbxi_read_ahead *ra)
+{
+	ufbxi_read_ahead_sync(ra, false);
+	if (ra->chunks) {
+		ufbxi_free(ra->ator, char, ra->chunks, ra->num_chunks * ra->chunk_size);
+		ra->chunks = NULL;
+		ra->synchronous = true;
+	}
+}
+
+// Wait for reads in flight if `pool` is about to be used for something else.
+static ufbxi_forceinline void ufbxi_read_ahead_yield_pool(ufbxi_read_ahead *ra, const ufbx_thread_pool *pool)
+{
+	if (ra->pending && ra->pool.run_fn == pool->run_fn && ra->pool.user == pool->user) {
+		ufbxi_read_ahead_sync(ra, false);
+	}
+}
+
 // -- Type definitions
 
 typedef struct ufbxi_node ufbxi_node;
@@ -5202,9 +6042,16 @@ struct ufbxi_refcount {
 
 static ufbxi_noinline void ufbxi_init_ref(ufbxi_refcount *refcount, uint32_t magic, ufbxi_refcount *parent);
 static ufbxi_noinline void ufbxi_retain_ref(ufbxi_refcount *refcount);
+static ufbxi_noinline void ufbxi_release_ref(ufbxi_refcount *refcount);
 
 #define ufbxi_get_imp(type, ptr) ((type*)((char*)ptr - sizeof(ufbxi_refcount)))
 
+// File range of a `Geometry` node skipped with `ufbx_load_opts.lazy_geometry`
+typedef struct {
+	uint64_t begin;
+	uint64_t end;
+} ufbxi_lazy_range;
+
 typedef struct {
 	ufbxi_refcount refcount;
 	ufbx_scene scene;
@@ -5213,6 +6060,22 @@ typedef struct {
 	ufbxi_allocator ator;
 	ufbxi_buf result_buf;
 	ufbxi_buf string_buf;
+
+	// File mapping referred to by the scene, see `ufbx_load_opts.memory_map_file`
+	void *mapped_data;
+	size_t mapped_size;
+
+	// Source data and options for `ufbx_load_mesh_data()`, see `ufbx_load_opts.lazy_geometry`
+	// `lazy_ranges[]` contains the file range of each mesh indexed by `ufbx_mesh.typed_id`.
+	const char *lazy_data;
+	size_t lazy_size;
+	ufbx_load_opts lazy_opts;
+	ufbxi_lazy_range *lazy_ranges;
+
+	// Single allocation containing the whole scene (including this struct) if loaded
+	// using `ufbx_load_scene_snapshot()`.
+	void *snapshot_data;
+	size_t snapshot_size;
 } ufbxi_scene_imp;
 
 ufbx_static_assert(scene_imp_offset, offsetof(ufbxi_scene_imp, scene) == sizeof(ufbxi_refcount));
@@ -5311,6 +6174,7 @@ typedef struct {
 typedef struct {
 	ufbxi_tmp_mesh_texture *texture_arr;
 	size_t texture_count;
+	ufbxi_lazy_range lazy_range;
 } ufbxi_mesh_extra;
 
 typedef struct {
@@ -5374,6 +6238,15 @@ typedef struct {
 	size_t num_left;
 } ufbxi_obj_fast_indices;
 
+// Newline-aligned chunk of consecutive vertex lines, see `ufbxi_obj_try_parse_vertex_run()`
+typedef struct {
+	const char *begin, *end;
+	size_t num_lines;
+	ufbx_real *dst;
+	ufbx_real *dst_color;
+	ptrdiff_t result;
+} ufbxi_obj_vertex_chunk;
+
 typedef struct {
 
 	// Current line and tokens.
@@ -5419,6 +6292,16 @@ typedef struct {
 	bool has_vertex_color;
 	size_t mrgb_vertex_count;
 
+	// Parallel parsing of vertex lines, see `ufbxi_obj_try_parse_vertex_run()`
+	bool parallel_vertices;
+	size_t serial_vertex_lines;
+	ufbxi_obj_vertex_chunk *vertex_chunks;
+	size_t vertex_chunks_cap;
+
+	// Geometry streaming, see `ufbxi_obj_stream_batch()`
+	ufbxi_buf tmp_stream;
+	size_t stream_first[UFBXI_OBJ_NUM_ATTRIBS_EXT];
+
 	bool eof;
 	bool initialized;
 
@@ -5436,6 +6319,35 @@ typedef struct {
 
 } ufbxi_obj_context;
 
+// DEFLATE compressed array or a chunk of an ASCII array whose decoding has been
+// deferred to `ufbxi_flush_deferred_arrays()`
+typedef struct {
+	const void *encoded_data;
+	size_t encoded_size;
+
+	void *decoded_data;
+	size_t decoded_size;
+
+	void *arr_data;
+	size_t arr_size;
+	char src_type;
+	char dst_type;
+	bool post_bool;
+	bool no_checksum;
+
+	// `encoded_data` is ASCII text containing `arr_size` values, see `ufbxi_ascii_try_defer_array()`
+	bool ascii;
+
+	ptrdiff_t result;
+} ufbxi_deferred_array;
+
+typedef struct {
+	ufbxi_deferred_array *arrays;
+	size_t num_arrays;
+	ufbx_inflate_retain *retains;
+	uint32_t num_tasks;
+} ufbxi_deferred_array_tasks;
+
 typedef struct {
 
 	ufbx_error error;
@@ -5460,15 +6372,28 @@ typedef struct {
 	char *read_buffer;
 	size_t read_buffer_size;
 
+	ufbxi_read_ahead read_ahead;
+	ufbx_io_stats io_stats;
+
+	// Collected only if `opts.collect_stats`, counters are updated unconditionally.
+	ufbx_load_stats load_stats;
+
 	const char *data_begin;
 	const char *data;
 	size_t yield_size;
 	size_t data_size;
 
+	// Set if the whole file is memory mapped at `data_begin`, data can be referenced directly
+	void *mapped_data;
+	size_t mapped_size;
+
 	// Allocators
 	ufbxi_allocator ator_result;
 	ufbxi_allocator ator_tmp;
 
+	// Temporary state borrowed from `ufbx_load_opts.load_context` (if any)
+	ufbx_load_context *load_context;
+
 	// Temporary maps
 	ufbxi_map prop_type_map;    // < `ufbxi_prop_type_name` Property type to enum
 	ufbxi_map fbx_id_map;       // < `ufbxi_fbx_id_entry` FBX ID to local ID
@@ -5530,6 +6455,18 @@ typedef struct {
 	ufbxi_node top_child;
 	bool has_next_child;
 
+	// Set if `Mesh` geometry is parsed later, see `ufbx_load_opts.lazy_geometry`.
+	// `lazy_geometry_node` is set for the current top-level child if it is skipped
+	// and the file range of the node is stored in `lazy_geometry_begin/end`.
+	bool lazy_geometry;
+	bool lazy_geometry_node;
+	uint64_t lazy_geometry_begin;
+	uint64_t lazy_geometry_end;
+
+	// Set if only probing the file, see `ufbx_probe_file()`.
+	// Skips the children of all objects except `GlobalSettings/SceneInfo`.
+	bool probe;
+
 	// Shared consecutive and all-zero index buffers
 	uint32_t *zero_indices;
 	uint32_t *consecutive_indices;
@@ -5540,6 +6477,9 @@ typedef struct {
 	uint64_t latest_progress_bytes;
 	size_t progress_interval;
 
+	// Next phase to run in `ufbxi_load_step()`
+	ufbx_load_phase load_phase;
+
 	// Extra data on the side of elements
 	void **element_extra_arr;
 	size_t element_extra_cap;
@@ -5555,6 +6495,14 @@ typedef struct {
 
 	ufbx_inflate_retain *inflate_retain;
 
+	// Arrays to decode in parallel using `opts.thread_opts`
+	ufbxi_deferred_array *deferred_arrays;
+	size_t num_deferred_arrays, deferred_arrays_cap;
+	size_t deferred_memory;
+	ufbxi_buf tmp_deferred;
+	ufbx_inflate_retain *task_retains;
+	size_t task_retains_cap;
+
 	uint64_t root_id;
 	uint32_t num_elements;
 
@@ -5572,6 +6520,67 @@ typedef struct {
 	ufbxi_warnings warnings;
 } ufbxi_context;
 
+// Temporary state retained between loads using `ufbx_load_opts.load_context`.
+// The retained fields are swapped with the matching ones in `ufbxi_context` in
+// `ufbxi_load_init()` and `ufbxi_free_temp()` so loading works as usual in between.
+struct ufbx_load_context {
+	uint32_t magic;
+	ufbxi_atomic_counter num_borrows; // < Loads racing to borrow the context, see `ufbxi_acquire_load_context()`
+	bool in_use;           // < Currently borrowed by a `ufbxi_context`, only accessed by the borrower
+	bool maps_initialized; // < Retained maps have been initialized by `ufbxi_load_init()`
+	bool has_tables;       // < `string_table` and `prop_type_map` contain the constant tables
+
+	ufbx_error error;
+	ufbxi_allocator ator;
+
+	// `ufbxi_string_pool.map` containing only the constant strings, see `ufbxi_load_tables()`
+	ufbxi_map string_table;
+
+	ufbxi_map string_map;
+	char *string_temp_str;
+	size_t string_temp_cap;
+
+	ufbxi_map prop_type_map;
+	ufbxi_map fbx_id_map;
+	ufbxi_map texture_file_map;
+	ufbxi_map fbx_attr_map;
+	ufbxi_map node_prop_set;
+	ufbxi_map dom_node_map;
+
+	ufbxi_buf tmp_parse;
+	ufbxi_buf tmp_stack;
+	ufbxi_buf tmp_connections;
+	ufbxi_buf tmp_node_ids;
+	ufbxi_buf tmp_elements;
+	ufbxi_buf tmp_element_offsets;
+	ufbxi_buf tmp_element_ptrs;
+	ufbxi_buf tmp_typed_element_offsets[UFBX_ELEMENT_TYPE_COUNT];
+	ufbxi_buf tmp_mesh_textures;
+	ufbxi_buf tmp_full_weights;
+	ufbxi_buf tmp_dom_nodes;
+	ufbxi_buf tmp_deferred;
+	ufbxi_buf tmp_warnings;
+
+	char *read_buffer;
+	size_t read_buffer_size;
+	char *tmp_arr;
+	size_t tmp_arr_size;
+	char *swap_arr;
+	size_t swap_arr_size;
+	ufbxi_node *top_nodes;
+	size_t top_nodes_cap;
+	void **element_extra_arr;
+	size_t element_extra_cap;
+	char *token_str_data;
+	size_t token_str_cap;
+	char *prev_token_str_data;
+	size_t prev_token_str_cap;
+	ufbxi_deferred_array *deferred_arrays;
+	size_t deferred_arrays_cap;
+	ufbx_inflate_retain *task_retains;
+	size_t task_retains_cap;
+};
+
 static ufbxi_noinline int ufbxi_fail_imp(ufbxi_context *uc, const char *cond, const char *func, uint32_t line)
 {
 	return ufbxi_fail_imp_err(&uc->error, cond, func, line);
@@ -5588,6 +6597,56 @@ static ufbxi_noinline int ufbxi_fail_imp(ufbxi_context *uc, const char *cond, co
 
 #define ufbxi_warnf(type, ...) ufbxi_warnf_imp(&uc->warnings, type, __VA_ARGS__)
 
+// -- Load statistics
+
+typedef struct {
+	uint64_t time;
+	uint64_t cpu_time;
+} ufbxi_stats_timer;
+
+static ufbxi_forceinline ufbxi_stats_timer ufbxi_stats_begin(ufbxi_context *uc)
+{
+	ufbxi_stats_timer timer = { 0, 0 };
+	if (uc->opts.collect_stats) {
+		timer.time = ufbxi_time_ns();
+		timer.cpu_time = ufbxi_cpu_time_ns();
+	}
+	return timer;
+}
+
+static ufbxi_forceinline void ufbxi_stats_end_imp(ufbxi_context *uc, double *p_time, double *p_cpu_time, ufbxi_stats_timer begin)
+{
+	if (uc->opts.collect_stats) {
+		*p_time += (double)(ufbxi_time_ns() - begin.time) * 1e-9;
+		*p_cpu_time += (double)(ufbxi_cpu_time_ns() - begin.cpu_time) * 1e-9;
+	}
+}
+
+// Add the wall clock and CPU time since `begin` to `ufbx_load_stats.<phase>_time` and `<phase>_cpu_time`.
+#define ufbxi_stats_end(uc, phase, begin) ufbxi_stats_end_imp((uc), &(uc)->load_stats.phase##_time, &(uc)->load_stats.phase##_cpu_time, (begin))
+
+static ufbxi_noinline void ufbxi_finish_load_stats(ufbxi_context *uc)
+{
+	ufbx_load_stats *stats = &uc->load_stats;
+	stats->collected = true;
+	stats->string_pool_hits = uc->string_pool.num_hits;
+	stats->string_pool_misses = uc->string_pool.num_misses;
+
+	const ufbxi_map *maps[] = {
+		&uc->string_pool.map, &uc->prop_type_map, &uc->fbx_id_map, &uc->texture_file_map,
+		&uc->fbx_attr_map, &uc->node_prop_set, &uc->dom_node_map,
+	};
+
+	size_t num_entries = 0, max_probes = 0;
+	uint64_t total_probes = 0;
+	ufbxi_for_ptr(const ufbxi_map, p_map, maps, ufbxi_arraycount(maps)) {
+		ufbxi_map_probe_stats(*p_map, &num_entries, &total_probes, &max_probes);
+	}
+	stats->map_entries = num_entries;
+	stats->map_avg_probe_length = num_entries > 0 ? (double)total_probes / (double)num_entries : 0.0;
+	stats->map_max_probe_length = max_probes;
+}
+
 // -- Progress
 
 static ufbxi_forceinline uint64_t ufbxi_get_read_offset(ufbxi_context *uc)
@@ -5981,6 +7040,66 @@ static void ufbxi_file_close(void *user)
 	fclose(file);
 }
 
+// Map the whole file to memory as private copy-on-write pages, returns `NULL` if
+// the file cannot be mapped in which case it should be read normally.
+static ufbxi_noinline void *ufbxi_map_file(const char *path, size_t path_len, size_t *p_size, ufbxi_allocator *tmp_ator)
+{
+#if UFBXI_HAS_MMAP
+	char copy_buf[256];
+	char *copy = NULL;
+
+	if (path_len == SIZE_MAX) {
+		path_len = strlen(path);
+	}
+	if (path_len < ufbxi_arraycount(copy_buf) - 1) {
+		copy = copy_buf;
+	} else {
+		copy = ufbxi_alloc(tmp_ator, char, path_len + 1);
+		if (!copy) return NULL;
+	}
+	memcpy(copy, path, path_len);
+	copy[path_len] = '\0';
+
+	void *data = NULL;
+	int fd = open(copy, O_RDONLY);
+	if (fd >= 0) {
+		struct stat st;
+		if (fstat(fd, &st) == 0 && st.st_size > 0 && (uint64_t)st.st_size <= (uint64_t)SIZE_MAX) {
+			size_t size = (size_t)st.st_size;
+			data = mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED) {
+				*p_size = size;
+			} else {
+				data = NULL;
+			}
+		}
+		close(fd);
+	}
+
+	if (copy != copy_buf) {
+		ufbxi_free(tmp_ator, char, copy, path_len + 1);
+	}
+
+	return data;
+#else
+	(void)path;
+	(void)path_len;
+	(void)p_size;
+	(void)tmp_ator;
+	return NULL;
+#endif
+}
+
+static void ufbxi_unmap_file(void *data, size_t size)
+{
+#if UFBXI_HAS_MMAP
+	munmap(data, size);
+#else
+	(void)data;
+	(void)size;
+#endif
+}
+
 typedef struct {
 	const void *data;
 	size_t size;
@@ -6860,6 +7979,9 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 {
 	info->flags = 0;
 
+	// Skip geometry arrays of meshes that are loaded later, see `ufbx_load_opts.lazy_geometry`
+	bool skip_geometry = uc->opts.ignore_geometry || uc->lazy_geometry_node;
+
 	// Retain all arrays if user wants the DOM representation
 	if (uc->opts.retain_dom) {
 		info->flags |= UFBXI_ARRAY_FLAG_RESULT;
@@ -6874,38 +7996,38 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		} else if (name == ufbxi_PolygonVertexIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_Edges) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			return true;
 		} else if (name == ufbxi_Indexes) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_Points) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_KnotVector) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_KnotVectorU) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_KnotVectorV) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_PointsIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_Normals) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		}
@@ -6913,19 +8035,19 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LEGACY_MODEL:
 		if (name == ufbxi_Vertices) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		} else if (name == ufbxi_Normals) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		} else if (name == ufbxi_Materials) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_PolygonVertexIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_Children) {
@@ -7003,11 +8125,11 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_NORMAL:
 		if (name == ufbxi_Normals) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		} else if (name == ufbxi_NormalsIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_NormalsW) {
@@ -7019,11 +8141,11 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_BINORMAL:
 		if (name == ufbxi_Binormals) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		} else if (name == ufbxi_BinormalsIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_BinormalsW) {
@@ -7035,11 +8157,11 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_TANGENT:
 		if (name == ufbxi_Tangents) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		} else if (name == ufbxi_TangentsIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_TangentsW) {
@@ -7051,11 +8173,11 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_UV:
 		if (name == ufbxi_UV) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		} else if (name == ufbxi_UVIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -7063,11 +8185,11 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_COLOR:
 		if (name == ufbxi_Colors) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		} else if (name == ufbxi_ColorIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -7075,11 +8197,11 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_VERTEX_CREASE:
 		if (name == ufbxi_VertexCrease) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		} else if (name == ufbxi_VertexCreaseIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -7087,7 +8209,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_EDGE_CREASE:
 		if (name == ufbxi_EdgeCrease) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -7095,7 +8217,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_SMOOTHING:
 		if (name == ufbxi_Smoothing) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'b';
+			info->type = skip_geometry ? '-' : 'b';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -7103,7 +8225,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_VISIBILITY:
 		if (name == ufbxi_Visibility) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'b';
+			info->type = skip_geometry ? '-' : 'b';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -7111,7 +8233,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_POLYGON_GROUP:
 		if (name == ufbxi_PolygonGroup) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -7119,7 +8241,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_HOLE:
 		if (name == ufbxi_Hole) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'b';
+			info->type = skip_geometry ? '-' : 'b';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -7127,7 +8249,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_MATERIAL:
 		if (name == ufbxi_Materials) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -7135,7 +8257,7 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_LAYER_ELEMENT_OTHER:
 		if (name == ufbxi_TextureId) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags |= UFBXI_ARRAY_FLAG_TMP_BUF;
 			return true;
 		} else if (name == ufbxi_UV) {
@@ -7149,11 +8271,11 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_GEOMETRY_UV_INFO:
 		if (name == ufbxi_TextureUV) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		} else if (name == ufbxi_TextureUVVerticeIndex) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		}
@@ -7161,17 +8283,17 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 
 	case UFBXI_PARSE_SHAPE:
 		if (name == ufbxi_Indexes) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
 		if (name == ufbxi_Vertices) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		}
 		if (name == ufbxi_Normals) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT | UFBXI_ARRAY_FLAG_PAD_BEGIN;
 			return true;
 		}
@@ -7185,15 +8307,15 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 			info->type = 'r';
 			return true;
 		} else if (name == ufbxi_Indexes) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_Weights) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_BlendWeights) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_FullWeights) {
@@ -7227,11 +8349,11 @@ static bool ufbxi_is_array_node(ufbxi_context *uc, ufbxi_parse_state parent, con
 			info->type = 'r';
 			return true;
 		} else if (name == ufbxi_Indexes) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'i';
+			info->type = skip_geometry ? '-' : 'i';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		} else if (name == ufbxi_Weights) {
-			info->type = uc->opts.ignore_geometry ? '-' : 'r';
+			info->type = skip_geometry ? '-' : 'r';
 			info->flags = UFBXI_ARRAY_FLAG_RESULT;
 			return true;
 		}
@@ -7360,16 +8482,44 @@ static ufbxi_noinline bool ufbxi_is_raw_string(ufbxi_context *uc, ufbxi_parse_st
 
 // -- Binary parsing
 
-ufbxi_nodiscard static ufbxi_noinline char *ufbxi_swap_endian(ufbxi_context *uc, const void *src, size_t count, size_t elem_size)
+// Swap the endianness of `count` elements of `elem_size` bytes from `src` to `dst`.
+// NOTE: `src` and `dst` must not overlap.
+static ufbxi_noinline void ufbxi_swap_endian_to(void *dst, const void *src, size_t count, size_t elem_size)
 {
-	size_t total_size = count * elem_size;
-	ufbxi_check_return(!ufbxi_does_overflow(total_size, count, elem_size), NULL);
-	if (uc->swap_arr_size < total_size) {
-		ufbxi_check_return(ufbxi_grow_array(&uc->ator_tmp, &uc->swap_arr, &uc->swap_arr_size, total_size), NULL);
+	char *d = (char*)dst;
+	const char *s = (const char*)src;
+
+#if UFBXI_HAS_SSE
+	if (elem_size >= 2) {
+		for (; count >= 16 / elem_size; count -= 16 / elem_size) {
+			__m128i v = _mm_loadu_si128((const __m128i*)s);
+			v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+			if (elem_size == 4) {
+				v = _mm_shufflelo_epi16(_mm_shufflehi_epi16(v, _MM_SHUFFLE(2,3,0,1)), _MM_SHUFFLE(2,3,0,1));
+			} else if (elem_size == 8) {
+				v = _mm_shufflelo_epi16(_mm_shufflehi_epi16(v, _MM_SHUFFLE(0,1,2,3)), _MM_SHUFFLE(0,1,2,3));
+			}
+			_mm_storeu_si128((__m128i*)d, v);
+			d += 16; s += 16;
+		}
+	}
+#elif UFBXI_HAS_NEON
+	if (elem_size >= 2) {
+		for (; count >= 16 / elem_size; count -= 16 / elem_size) {
+			uint8x16_t v = vld1q_u8((const uint8_t*)s);
+			if (elem_size == 2) {
+				v = vrev16q_u8(v);
+			} else if (elem_size == 4) {
+				v = vrev32q_u8(v);
+			} else {
+				v = vrev64q_u8(v);
+			}
+			vst1q_u8((uint8_t*)d, v);
+			d += 16; s += 16;
+		}
 	}
-	char *dst = uc->swap_arr, *d = dst;
+#endif
 
-	const char *s = (const char*)src;
 	switch (elem_size) {
 	case 1:
 		for (size_t i = 0; i < count; i++) {
@@ -7399,18 +8549,17 @@ ufbxi_nodiscard static ufbxi_noinline char *ufbxi_swap_endian(ufbxi_context *uc,
 	default:
 		ufbx_assert(0 && "Bad endian swap size");
 	}
-
-	return dst;
 }
 
-// Swap the endianness of an array typed with a lowercase letter
-ufbxi_nodiscard static ufbxi_noinline const char *ufbxi_swap_endian_array(ufbxi_context *uc, const void *src, size_t count, char type)
+ufbxi_nodiscard static ufbxi_noinline char *ufbxi_swap_endian(ufbxi_context *uc, const void *src, size_t count, size_t elem_size)
 {
-	switch (type) {
-	case 'i': case 'f': return ufbxi_swap_endian(uc, src, count, 4);
-	case 'l': case 'd': return ufbxi_swap_endian(uc, src, count, 8);
-	default: return (const char*)src;
+	size_t total_size = count * elem_size;
+	ufbxi_check_return(!ufbxi_does_overflow(total_size, count, elem_size), NULL);
+	if (uc->swap_arr_size < total_size) {
+		ufbxi_check_return(ufbxi_grow_array(&uc->ator_tmp, &uc->swap_arr, &uc->swap_arr_size, total_size), NULL);
 	}
+	ufbxi_swap_endian_to(uc->swap_arr, src, count, elem_size);
+	return uc->swap_arr;
 }
 
 // Swap the endianness of a single value (shallow, swaps string/array header words)
@@ -7426,24 +8575,60 @@ ufbxi_nodiscard static ufbxi_noinline const char *ufbxi_swap_endian_value(ufbxi_
 	}
 }
 
-// Read and convert a post-7000 FBX data array into a different format. `src_type` may be equal to `dst_type`
-// if the platform is not binary compatible with the FBX data representation.
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_context *uc, char src_type, char dst_type, const void *src, void *dst, size_t size)
-{
-	// TODO: We might want to use the slow path if the machine float/double doesn't match IEEE 754!
-	// Convert commented out lines under some `#if UFBX_NON_IEE754` define or something.
-	if (src_type == dst_type) {
-		src = ufbxi_swap_endian_array(uc, src, size, src_type);
-		ufbxi_check(src);
-		memcpy(dst, src, size * ufbxi_array_type_size(dst_type));
-		return 1;
+#if UFBXI_HAS_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+	#define UFBXI_HAS_NEON_F64 1
+#else
+	#define UFBXI_HAS_NEON_F64 0
+#endif
+
+// Narrow `double` values to `float`, the common case for `UFBX_REAL_IS_FLOAT`.
+static ufbxi_noinline void ufbxi_convert_f64_to_f32(float *dst, const char *src, size_t count)
+{
+	float *d = dst, *d_end = dst + count;
+#if UFBXI_HAS_SSE
+	for (; d_end - d >= 4; d += 4, src += 32) {
+		__m128 lo = _mm_cvtpd_ps(_mm_loadu_pd((const double*)src));
+		__m128 hi = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(src + 16)));
+		_mm_storeu_ps(d, _mm_movelh_ps(lo, hi));
+	}
+#elif UFBXI_HAS_NEON_F64
+	for (; d_end - d >= 4; d += 4, src += 32) {
+		float32x2_t lo = vcvt_f32_f64(vld1q_f64((const double*)src));
+		float32x2_t hi = vcvt_f32_f64(vld1q_f64((const double*)(src + 16)));
+		vst1q_f32(d, vcombine_f32(lo, hi));
+	}
+#endif
+	for (; d != d_end; d++, src += 8) {
+		*d = (float)ufbxi_read_f64(src);
 	}
+}
 
-	if (uc->file_big_endian) {
-		src = ufbxi_swap_endian_array(uc, src, size, src_type);
-		ufbxi_check(src);
+// Widen `float` values to `double`.
+static ufbxi_noinline void ufbxi_convert_f32_to_f64(double *dst, const char *src, size_t count)
+{
+	double *d = dst, *d_end = dst + count;
+#if UFBXI_HAS_SSE
+	for (; d_end - d >= 4; d += 4, src += 16) {
+		__m128 v = _mm_loadu_ps((const float*)src);
+		_mm_storeu_pd(d + 0, _mm_cvtps_pd(v));
+		_mm_storeu_pd(d + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+	}
+#elif UFBXI_HAS_NEON_F64
+	for (; d_end - d >= 4; d += 4, src += 16) {
+		float32x4_t v = vld1q_f32((const float*)src);
+		vst1q_f64(d + 0, vcvt_f64_f32(vget_low_f32(v)));
+		vst1q_f64(d + 2, vcvt_f64_f32(vget_high_f32(v)));
 	}
+#endif
+	for (; d != d_end; d++, src += 4) {
+		*d = (double)ufbxi_read_f32(src);
+	}
+}
 
+// Convert a data array in the native endianness from `src_type` to `dst_type`.
+// Returns `false` if the conversion is not supported.
+static ufbxi_noinline bool ufbxi_convert_array_data(char src_type, char dst_type, const void *src, void *dst, size_t size)
+{
 	switch (dst_type)
 	{
 
@@ -7466,7 +8651,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_conte
 		case 'l': ufbxi_convert_loop_slow(uint8_t, (uint8_t), 8, (uint8_t)ufbxi_read_i64(val)); break;
 		case 'f': ufbxi_convert_loop_slow(uint8_t, (uint8_t), 4, (uint8_t)ufbxi_read_f32(val)); break;
 		case 'd': ufbxi_convert_loop_slow(uint8_t, (uint8_t), 8, (uint8_t)ufbxi_read_f64(val)); break;
-		default: ufbxi_fail("Bad array source type");
+		default: return false;
 		}
 		break;
 
@@ -7477,7 +8662,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_conte
 		case 'l': ufbxi_convert_loop_slow(int32_t, (int32_t), 8, ufbxi_read_i64(val)); break;
 		case 'f': ufbxi_convert_loop_slow(int32_t, ufbxi_f64_to_i32, 4, ufbxi_read_f32(val)); break;
 		case 'd': ufbxi_convert_loop_slow(int32_t, ufbxi_f64_to_i32, 8, ufbxi_read_f64(val)); break;
-		default: ufbxi_fail("Bad array source type");
+		default: return false;
 		}
 		break;
 
@@ -7488,7 +8673,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_conte
 		// case 'l': ufbxi_convert_loop_slow(int64_t, (int64_t), 8, ufbxi_read_i64(val)); break;
 		case 'f': ufbxi_convert_loop_slow(int64_t, ufbxi_f64_to_i64, 4, ufbxi_read_f32(val)); break;
 		case 'd': ufbxi_convert_loop_slow(int64_t, ufbxi_f64_to_i64, 8, ufbxi_read_f64(val)); break;
-		default: ufbxi_fail("Bad array source type");
+		default: return false;
 		}
 		break;
 
@@ -7498,8 +8683,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_conte
 		case 'i': ufbxi_convert_loop_slow(float, (float), 4, ufbxi_read_i32(val)); break;
 		case 'l': ufbxi_convert_loop_slow(float, (float), 8, ufbxi_read_i64(val)); break;
 		// case 'f': ufbxi_convert_loop_slow(float, (float), 4, ufbxi_read_f32(val)); break;
-		case 'd': ufbxi_convert_loop_fast(float, (float), 8, ufbxi_read_f64(val)); break;
-		default: ufbxi_fail("Bad array source type");
+		case 'd': ufbxi_convert_f64_to_f32((float*)dst, (const char*)src, size); break;
+		default: return false;
 		}
 		break;
 
@@ -7508,16 +8693,219 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_conte
 		case 'c': ufbxi_convert_loop_slow(double, (double), 1, *val); break;
 		case 'i': ufbxi_convert_loop_slow(double, (double), 4, ufbxi_read_i32(val)); break;
 		case 'l': ufbxi_convert_loop_slow(double, (double), 8, ufbxi_read_i64(val)); break;
-		case 'f': ufbxi_convert_loop_fast(double, (double), 4, ufbxi_read_f32(val)); break;
+		case 'f': ufbxi_convert_f32_to_f64((double*)dst, (const char*)src, size); break;
 		// case 'd': ufbxi_convert_loop_slow(double, (double), 8, ufbxi_read_f64(val)); break;
-		default: ufbxi_fail("Bad array source type");
+		default: return false;
 		}
 		break;
 
-	default: return 0;
+	default: return false;
+
+	}
+
+	return true;
+}
+
+// Read and convert a post-7000 FBX data array into a different format. `src_type` may be equal to `dst_type`
+// if the platform is not binary compatible with the FBX data representation.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_convert_array(ufbxi_context *uc, char src_type, char dst_type, const void *src, void *dst, size_t size)
+{
+	// TODO: We might want to use the slow path if the machine float/double doesn't match IEEE 754!
+	// Convert commented out lines under some `#if UFBX_NON_IEE754` define or something.
+	size_t src_elem_size = ufbxi_array_type_size(src_type);
+	if (src_type == dst_type) {
+		if (src_elem_size > 1) {
+			ufbxi_swap_endian_to(dst, src, size, src_elem_size);
+		} else {
+			memcpy(dst, src, size);
+		}
+		return 1;
+	}
+
+	if (uc->file_big_endian && src_elem_size > 1) {
+		// Swap and convert in small blocks that stay in cache instead of swapping the whole array first
+		size_t dst_elem_size = ufbxi_array_type_size(dst_type);
+		size_t block_size = UFBXI_CONVERT_BLOCK_SIZE / src_elem_size;
+		uint64_t block[UFBXI_CONVERT_BLOCK_SIZE / sizeof(uint64_t)];
+		const char *s = (const char*)src;
+		char *d = (char*)dst;
+		size_t left = size;
+		do {
+			size_t num = ufbxi_min_sz(left, block_size);
+			ufbxi_swap_endian_to(block, s, num, src_elem_size);
+			ufbxi_check_msg(ufbxi_convert_array_data(src_type, dst_type, block, d, num), "Bad array source type");
+			s += num * src_elem_size;
+			d += num * dst_elem_size;
+			left -= num;
+		} while (left > 0);
+		return 1;
+	}
+
+	ufbxi_check_msg(ufbxi_convert_array_data(src_type, dst_type, src, dst, size), "Bad array source type");
+	return 1;
+}
+
+// -- Deferred array decoding
+//
+// With `ufbx_load_opts.thread_opts` DEFLATE compressed arrays are not decoded immediately
+// but collected into `uc->deferred_arrays`. The arrays are decoded and converted in
+// parallel when a top-level node has been parsed in `ufbxi_flush_deferred_arrays()`.
+// Large ASCII arrays are split into chunks and parsed the same way.
+
+static ufbxi_noinline ptrdiff_t ufbxi_ascii_parse_array_chunk(const char *src, const char *end, char dst_type, void *dst, size_t count);
+
+static bool ufbxi_is_plain_array_type(char type)
+{
+	return type == 'c' || type == 'i' || type == 'l' || type == 'f' || type == 'd';
+}
+
+static ufbxi_forceinline bool ufbxi_can_defer_array(ufbxi_context *uc, char src_type, char dst_type)
+{
+	if (!uc->opts.thread_opts.pool.run_fn) return false;
+	if (uc->file_big_endian || uc->local_big_endian) return false;
+	return ufbxi_is_plain_array_type(src_type) && ufbxi_is_plain_array_type(dst_type);
+}
+
+static ufbxi_noinline void ufbxi_decode_deferred_array(ufbxi_deferred_array *arr, ufbx_inflate_retain *retain)
+{
+	if (arr->ascii) {
+		const char *src = (const char*)arr->encoded_data;
+		arr->result = ufbxi_ascii_parse_array_chunk(src, src + arr->encoded_size, arr->dst_type, arr->arr_data, arr->arr_size);
+		return;
+	}
+
+	ufbx_inflate_input input;
+	memset(&input, 0, sizeof(input));
+	input.total_size = arr->encoded_size;
+	input.data = arr->encoded_data;
+	input.data_size = arr->encoded_size;
+	input.no_checksum = arr->no_checksum;
+
+	arr->result = ufbx_inflate(arr->decoded_data, arr->decoded_size, &input, retain);
+	if (arr->result != (ptrdiff_t)arr->decoded_size) return;
+
+	if (arr->decoded_data != arr->arr_data) {
+		// Types are validated in `ufbxi_can_defer_array()`
+		ufbxi_ignore(ufbxi_convert_array_data(arr->src_type, arr->dst_type, arr->decoded_data, arr->arr_data, arr->arr_size));
+	}
+
+	if (arr->post_bool) {
+		ufbxi_for(char, b, (char*)arr->arr_data, arr->arr_size) {
+			*b = (char)(*b != 0);
+		}
+	}
+}
+
+static void ufbxi_deferred_array_task(void *user, uint32_t index)
+{
+	ufbxi_deferred_array_tasks *tasks = (ufbxi_deferred_array_tasks*)user;
+	ufbx_inflate_retain *retain = &tasks->retains[index];
+	for (size_t i = index; i < tasks->num_arrays; i += tasks->num_tasks) {
+		ufbxi_decode_deferred_array(&tasks->arrays[i], retain);
+	}
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_flush_deferred_arrays(ufbxi_context *uc)
+{
+	size_t num_arrays = uc->num_deferred_arrays;
+	if (num_arrays == 0) return 1;
+
+	ufbxi_stats_timer stats_begin = ufbxi_stats_begin(uc);
+
+	ufbxi_deferred_array_tasks tasks;
+	tasks.arrays = uc->deferred_arrays;
+	tasks.num_arrays = num_arrays;
+
+	// Only dispatch to the thread pool if there is enough work to amortize the overhead,
+	// each task needs its own `ufbx_inflate_retain` as they may run concurrently.
+	if (num_arrays > 1 && uc->deferred_memory >= UFBXI_MIN_THREADED_DEFLATE_BYTES) {
+		size_t num_tasks = ufbxi_min_sz(num_arrays, uc->opts.thread_opts.num_tasks);
+		if (uc->task_retains_cap < num_tasks) {
+			size_t old_cap = uc->task_retains_cap;
+			ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->task_retains, &uc->task_retains_cap, num_tasks));
+			for (size_t i = old_cap; i < uc->task_retains_cap; i++) {
+				uc->task_retains[i].initialized = false;
+			}
+		}
+
+		tasks.retains = uc->task_retains;
+		tasks.num_tasks = (uint32_t)num_tasks;
+
+		ufbx_thread_pool *pool = &uc->opts.thread_opts.pool;
+		ufbxi_read_ahead_yield_pool(&uc->read_ahead, pool);
+		pool->run_fn(pool->user, &ufbxi_deferred_array_task, &tasks, tasks.num_tasks);
+		pool->wait_fn(pool->user);
+	} else {
+		tasks.retains = uc->inflate_retain;
+		tasks.num_tasks = 1;
+		ufbxi_deferred_array_task(&tasks, 0);
+	}
+
+	if (uc->from_ascii) {
+		ufbxi_stats_end(uc, ascii_number, stats_begin);
+	} else {
+		ufbxi_stats_end(uc, inflate, stats_begin);
+	}
+
+	ufbxi_for(ufbxi_deferred_array, arr, uc->deferred_arrays, num_arrays) {
+		if (arr->ascii) {
+			ufbxi_check_msg(arr->result == (ptrdiff_t)arr->arr_size, "Bad ASCII array");
+		} else {
+			ufbxi_check_msg(arr->result != -28, "Cancelled");
+			ufbxi_check_msg(arr->result == (ptrdiff_t)arr->decoded_size, "Bad DEFLATE data");
+		}
+	}
+
+	uc->num_deferred_arrays = 0;
+	uc->deferred_memory = 0;
+	ufbxi_buf_clear(&uc->tmp_deferred);
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_defer_deflate_array(ufbxi_context *uc, char src_type, char dst_type, void *arr_data, size_t size, size_t encoded_size, bool post_bool)
+{
+	size_t decoded_size = size * ufbxi_array_type_size(src_type);
+
+	// Decode the pending arrays first if we would exceed the memory limit
+	size_t memory = encoded_size + decoded_size, memory_limit = uc->opts.thread_opts.memory_limit;
+	if (uc->deferred_memory > 0 && (uc->deferred_memory >= memory_limit || memory_limit - uc->deferred_memory < memory)) {
+		ufbxi_check(ufbxi_flush_deferred_arrays(uc));
+	}
+
+	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->deferred_arrays, &uc->deferred_arrays_cap, uc->num_deferred_arrays + 1));
+	ufbxi_deferred_array *arr = &uc->deferred_arrays[uc->num_deferred_arrays++];
+	arr->encoded_size = encoded_size;
+	arr->decoded_size = decoded_size;
+	arr->arr_data = arr_data;
+	arr->arr_size = size;
+	arr->src_type = src_type;
+	arr->dst_type = dst_type;
+	arr->post_bool = post_bool;
+	arr->no_checksum = uc->opts.skip_deflate_checksums;
+	arr->ascii = false;
+	arr->result = 0;
+
+	// If the whole file is in memory we can refer to the encoded data directly,
+	// otherwise it must be copied as the read buffer will be overwritten.
+	if (!uc->read_fn) {
+		arr->encoded_data = ufbxi_read_bytes(uc, encoded_size);
+		ufbxi_check(arr->encoded_data);
+	} else {
+		char *encoded_data = ufbxi_push(&uc->tmp_deferred, char, encoded_size);
+		ufbxi_check(encoded_data);
+		ufbxi_check(ufbxi_read_to(uc, encoded_data, encoded_size));
+		arr->encoded_data = encoded_data;
+	}
 
+	if (src_type != dst_type) {
+		arr->decoded_data = ufbxi_push(&uc->tmp_deferred, char, decoded_size);
+		ufbxi_check(arr->decoded_data);
+	} else {
+		arr->decoded_data = arr_data;
 	}
 
+	uc->deferred_memory += memory;
 	return 1;
 }
 
@@ -7561,9 +8949,12 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_binary_parse_multivalue_array(uf
 			d->length = len;
 			ufbxi_check(d->data);
 			if (dst_type == 'C') {
-				ufbxi_buf *buf = size == 1 || uc->opts.retain_dom ? &uc->result : tmp_buf;
-				d->data = ufbxi_push_copy(buf, char, len, d->data);
-				ufbxi_check(d->data);
+				// Memory mapped data can be referenced directly
+				if (!uc->mapped_data) {
+					ufbxi_buf *buf = size == 1 || uc->opts.retain_dom ? &uc->result : tmp_buf;
+					d->data = ufbxi_push_copy(buf, char, len, d->data);
+					ufbxi_check(d->data);
+				}
 			} else {
 				ufbxi_check(ufbxi_push_string_place_str(&uc->string_pool, d, raw));
 			}
@@ -7662,6 +9053,12 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 	// Parse an FBX document node in the binary format
 	ufbxi_check(depth < UFBXI_MAX_NODE_DEPTH);
 
+	uint64_t begin_offset = 0;
+	if (depth == 0) {
+		begin_offset = ufbxi_get_read_offset(uc);
+		uc->lazy_geometry_node = false;
+	}
+
 	// Parse the node header, post-7500 versions use 64-bit values for most
 	// header fields.
 	uint64_t end_offset, num_values64, values_len;
@@ -7750,6 +9147,9 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 		if (num_values == 0) c = '0';
 		if (dst_type == '-') c = '-';
 
+		// Set if the array is decoded later, see `ufbxi_flush_deferred_arrays()`
+		bool deferred = false;
+
 		if (c=='c' || c=='b' || c=='i' || c=='l' || c =='f' || c=='d') {
 
 			const char *arr_words = data + 1;
@@ -7771,15 +9171,29 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 			size_t src_elem_size = ufbxi_array_type_size(src_type);
 			size_t decoded_data_size = src_elem_size * size;
 
+			// Uncompressed arrays in memory mapped files can be referenced in place if they
+			// don't need any conversion, see `ufbx_load_opts.memory_map_file`.
+			bool in_place = encoding == 0 && uc->mapped_data && src_type == dst_type
+				&& !uc->file_big_endian && !uc->local_big_endian
+				&& (arr_info.flags & UFBXI_ARRAY_FLAG_PAD_BEGIN) == 0
+				&& encoded_size == decoded_data_size
+				&& ((uintptr_t)uc->data & (src_elem_size - 1)) == 0;
+
 			// Allocate `size` elements for the array.
-			char *arr_data = (char*)ufbxi_push_array_data(uc, &arr_info, size, tmp_buf);
-			ufbxi_check(arr_data);
+			char *arr_data = NULL;
+			if (!in_place) {
+				arr_data = (char*)ufbxi_push_array_data(uc, &arr_info, size, tmp_buf);
+				ufbxi_check(arr_data);
+			}
+
+			// DEFLATE compressed arrays may be decoded later in parallel.
+			deferred = encoding == 1 && ufbxi_can_defer_array(uc, src_type, dst_type);
 
 			// If the source and destination types are equal and our build is binary-compatible
 			// with the FBX format we can read the decoded data directly into the array buffer.
 			// Otherwise we need a temporary buffer to decode the array into before conversion.
 			void *decoded_data = arr_data;
-			if (src_type != dst_type || uc->local_big_endian != uc->file_big_endian) {
+			if (!deferred && (src_type != dst_type || uc->local_big_endian != uc->file_big_endian)) {
 				ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, decoded_data_size));
 				decoded_data = uc->tmp_arr;
 			}
@@ -7791,6 +9205,13 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 				uc->progress_bytes_total = arr_end;
 			}
 
+			uc->load_stats.num_arrays++;
+			if (encoding == 1) {
+				uc->load_stats.num_compressed_arrays++;
+				uc->load_stats.inflate_compressed_bytes += encoded_size;
+				uc->load_stats.inflate_decompressed_bytes += decoded_data_size;
+			}
+
 			if (encoding == 0) {
 				// Encoding 0: Plain binary data.
 				ufbxi_check(encoded_size == decoded_data_size);
@@ -7798,7 +9219,11 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 				// If the array is contained in the current read buffer and we need to convert
 				// the data anyway we can use the read buffer as the decoded array source, otherwise
 				// do a plain byte copy to the array/conversion buffer.
-				if (uc->yield_size + uc->data_size >= encoded_size && decoded_data != arr_data) {
+				if (in_place) {
+					arr_data = (char*)ufbxi_read_bytes(uc, encoded_size);
+					ufbxi_check(arr_data);
+					decoded_data = arr_data;
+				} else if (uc->yield_size + uc->data_size >= encoded_size && decoded_data != arr_data) {
 					// Yield right after this if we crossed the yield threshold
 					if (encoded_size > uc->yield_size) {
 						uc->data_size += uc->yield_size;
@@ -7811,6 +9236,9 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 				} else {
 					ufbxi_check(ufbxi_read_to(uc, decoded_data, encoded_size));
 				}
+			} else if (deferred) {
+				// Encoding 1: DEFLATE, decoded in `ufbxi_flush_deferred_arrays()`
+				ufbxi_check(ufbxi_defer_deflate_array(uc, src_type, dst_type, arr_data, size, encoded_size, arr_info.type == 'b'));
 			} else if (encoding == 1) {
 				// Encoding 1: DEFLATE
 
@@ -7822,7 +9250,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 				input.data = uc->data;
 				input.data_size = uc->data_size;
 				input.no_header = false;
-				input.no_checksum = false;
+				input.no_checksum = uc->opts.skip_deflate_checksums;
 				input.internal_fast_bits = 0;
 
 				if (uc->opts.progress_cb.fn) {
@@ -7864,7 +9292,9 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 					ufbxi_check(ufbxi_resume_progress(uc));
 				}
 
+				ufbxi_stats_timer stats_begin = ufbxi_stats_begin(uc);
 				ptrdiff_t res = ufbx_inflate(decoded_data, decoded_data_size, &input, uc->inflate_retain);
+				ufbxi_stats_end(uc, inflate, stats_begin);
 				ufbxi_check_msg(res != -28, "Cancelled");
 				ufbxi_check_msg(res == (ptrdiff_t)decoded_data_size, "Bad DEFLATE data");
 
@@ -7894,8 +9324,8 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 			arr->size = num_values;
 		}
 
-		// Post-process boolean arrays
-		if (arr_info.type == 'b') {
+		// Post-process boolean arrays, deferred ones in `ufbxi_decode_deferred_array()`
+		if (arr_info.type == 'b' && !deferred) {
 			ufbxi_for(char, b, (char*)arr->data, arr->size) {
 				*b = (char)(*b != 0);
 			}
@@ -7974,7 +9404,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 					vals[i].s.utf8_length = 0;
 				} else {
 					bool non_ascii = false;
-					uint32_t hash = ufbxi_hash_string_check_ascii(str, length, &non_ascii);
+					uint32_t hash = ufbxi_hash_string_check_ascii(str, length, uc->string_pool.map.seed, &non_ascii);
 					bool raw = !non_ascii || ufbxi_is_raw_string(uc, parent_state, name, i);
 					ufbxi_check(ufbxi_push_sanitized_string(&uc->string_pool, &vals[i].s, str, length, hash, raw));
 
@@ -8012,6 +9442,25 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 		ufbxi_check(ufbxi_skip_bytes(uc, values_end_offset - offset));
 	}
 
+	// Probing only needs the object headers, skip directly to the end of the node.
+	if (depth == 0 && uc->probe && parent_state == UFBXI_PARSE_OBJECTS && name != ufbxi_GlobalSettings && name != ufbxi_SceneInfo) {
+		ufbxi_check(values_end_offset <= end_offset);
+		ufbxi_check(ufbxi_skip_bytes(uc, end_offset - values_end_offset));
+		return 1;
+	}
+
+	// Skip the geometry arrays of top-level `Geometry: ..., "Mesh"` objects and
+	// record the node range for `ufbx_load_mesh_data()`.
+	if (depth == 0 && uc->lazy_geometry && parent_state == UFBXI_PARSE_OBJECTS && name == ufbxi_Geometry) {
+		const char *sub_type;
+		if (ufbxi_get_val_at(node, 2, 'C', (char**)&sub_type) && sub_type == ufbxi_Mesh) {
+			ufbxi_check(end_offset > begin_offset);
+			uc->lazy_geometry_node = true;
+			uc->lazy_geometry_begin = begin_offset;
+			uc->lazy_geometry_end = end_offset;
+		}
+	}
+
 	if (recursive) {
 		// Recursively parse the children of this node. Update the parse state
 		// to provide context for child node parsing.
@@ -8042,6 +9491,11 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_binary_parse_node(ufbxi_context
 		uc->has_next_child = (current_offset < end_offset);
 	}
 
+	// Decode arrays before returning the node to the caller
+	if (depth == 0) {
+		ufbxi_check(ufbxi_flush_deferred_arrays(uc));
+	}
+
 	return 1;
 }
 
@@ -8254,6 +9708,57 @@ ufbxi_nodiscard static ufbxi_forceinline int ufbxi_ascii_push_token_char(ufbxi_c
 	return 1;
 }
 
+// Push a run of `len` characters starting at `ua->src` to `token` and advance past them.
+// The run must be within the current buffer ie. `ua->src + len <= ua->src_yield`.
+ufbxi_nodiscard static ufbxi_forceinline int ufbxi_ascii_push_token_run(ufbxi_context *uc, ufbxi_ascii_token *token, size_t len)
+{
+	ufbxi_ascii *ua = &uc->ascii;
+	if (len == 0) return 1;
+	if (token->str_cap - token->str_len < len) {
+		size_t cap = ufbxi_max_sz(token->str_len + len, 256);
+		ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &token->str_data, &token->str_cap, cap));
+	}
+
+	memcpy(token->str_data + token->str_len, ua->src, len);
+	token->str_len += len;
+	ua->src += len;
+
+	return 1;
+}
+
+static ufbxi_forceinline bool ufbxi_is_bare_word_char(char c)
+{
+	return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static ufbxi_forceinline bool ufbxi_is_number_char(char c)
+{
+	return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+// Parse a token consisting only of an optional sign and digits, returns `false`
+// if `str` doesn't fit the fast path and should be parsed using `strtoll()`.
+static ufbxi_forceinline bool ufbxi_parse_int64_token(const char *str, int64_t *p_value, char **end)
+{
+	const char *p = str;
+	bool negative = *p == '-';
+	if (*p == '-' || *p == '+') p++;
+
+	uint64_t value = 0;
+	const char *digits = p;
+	while (((uint32_t)*p - '0') < 10) {
+		value = value * 10 + (uint64_t)(*p++ - '0');
+	}
+
+	// Up to 18 digits can't overflow `int64_t`
+	size_t num_digits = ufbxi_to_size(p - digits);
+	if (num_digits == 0 || num_digits > 18) return false;
+
+	*p_value = negative ? -(int64_t)value : (int64_t)value;
+	*end = (char*)p;
+	return true;
+}
+
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_skip_until(ufbxi_context *uc, char dst)
 {
 	ufbxi_ascii *ua = &uc->ascii;
@@ -8321,8 +9826,14 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_next_token(ufbxi_context *
 
 	if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_') {
 		token->type = UFBXI_ASCII_BARE_WORD;
-		while ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')
-			|| (c >= '0' && c <= '9') || c == '_') {
+
+		// Copy the part of the word that is already buffered at once
+		const char *scan = ua->src;
+		while (scan != ua->src_yield && ufbxi_is_bare_word_char(*scan)) scan++;
+		ufbxi_check(ufbxi_ascii_push_token_run(uc, token, ufbxi_to_size(scan - ua->src)));
+		c = ufbxi_ascii_peek(uc);
+
+		while (ufbxi_is_bare_word_char(c)) {
 			ufbxi_check(ufbxi_ascii_push_token_char(uc, token, c));
 			c = ufbxi_ascii_next(uc);
 		}
@@ -8338,7 +9849,19 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_next_token(ufbxi_context *
 		token->type = UFBXI_ASCII_INT;
 
 		token->negative = c == '-';
-		while ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+
+		// Copy the part of the number that is already buffered at once
+		const char *scan = ua->src;
+		while (scan != ua->src_yield && ufbxi_is_number_char(*scan)) {
+			if (*scan == '.' || *scan == 'e' || *scan == 'E') {
+				token->type = UFBXI_ASCII_FLOAT;
+			}
+			scan++;
+		}
+		ufbxi_check(ufbxi_ascii_push_token_run(uc, token, ufbxi_to_size(scan - ua->src)));
+		c = ufbxi_ascii_peek(uc);
+
+		while (ufbxi_is_number_char(c)) {
 			if (c == '.' || c == 'e' || c == 'E') {
 				token->type = UFBXI_ASCII_FLOAT;
 			}
@@ -8369,8 +9892,9 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_next_token(ufbxi_context *
 
 			char *end;
 			if (token->type == UFBXI_ASCII_INT) {
-				// TODO: Custom parsing is probably better?
-				token->value.i64 = strtoll(token->str_data, &end, 10);
+				if (!ufbxi_parse_int64_token(token->str_data, &token->value.i64, &end)) {
+					token->value.i64 = strtoll(token->str_data, &end, 10);
+				}
 				ufbxi_check(end == token->str_data + token->str_len - 1);
 			} else if (token->type == UFBXI_ASCII_FLOAT) {
 				if (ua->parse_as_f32) {
@@ -8384,6 +9908,13 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_next_token(ufbxi_context *
 	} else if (c == '"') {
 		token->type = UFBXI_ASCII_STRING;
 		c = ufbxi_ascii_next(uc);
+
+		// Copy the part of the string without escapes that is already buffered at once
+		const char *scan = ua->src;
+		while (scan != ua->src_yield && *scan != '"' && *scan != '&' && *scan != '\0') scan++;
+		ufbxi_check(ufbxi_ascii_push_token_run(uc, token, ufbxi_to_size(scan - ua->src)));
+		c = ufbxi_ascii_peek(uc);
+
 		while (c != '"') {
 
 			// Escape XML-like elements, funny enough there is no way to escape '&' itself, there is no `&amp`.
@@ -8511,12 +10042,23 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_read_int_array(ufbxi_conte
 
 		size_t init_len = negative ? 1 : 0;
 		size_t len = init_len;
+#if UFBXI_HAS_SWAR_DIGITS
+		// At most three 8 byte words are read here, `left >= 32` so this is always safe.
+		while (len < 20) {
+			uint64_t part;
+			uint32_t num = ufbxi_parse_digits_swar(src_scan + len, &part);
+			abs_val = abs_val * ufbxi_pow10_tab[num] + part;
+			len += num;
+			if (num < 8) break;
+		}
+#else
 		for (; len < 20; len++) {
 			char c = src_scan[len];
 			if (!(c >= '0' && c <= '9')) break;
 			abs_val = 10 * abs_val + (uint64_t)(c - '0');
 		}
-		if (len == 20 || len == init_len) break;
+#endif
+		if (len >= 20 || len == init_len) break;
 
 		// TODO: Do we want to wrap here?
 		val = negative ? -(int64_t)abs_val : (int64_t)abs_val;
@@ -8596,6 +10138,297 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_read_float_array(ufbxi_con
 	return 1;
 }
 
+// Parse `count` comma separated values of an ASCII array in `[src, end)` to `dst`, the character
+// at `end` must be readable. Values are converted the same way as in `ufbxi_ascii_read_float_array()`
+// and `ufbxi_ascii_read_int_array()` falling back to the conversions of `ufbxi_ascii_parse_node()`.
+// Returns the number of values parsed or -1 if the text is not a plain list of numbers.
+static ufbxi_noinline ptrdiff_t ufbxi_ascii_parse_array_chunk(const char *src, const char *end, char dst_type, void *dst, size_t count)
+{
+	bool dst_float = dst_type == 'f' || dst_type == 'd';
+
+	const char *p = src;
+	size_t num = 0;
+	for (;;) {
+		while (p != end && ufbxi_is_space(*p)) p++;
+		if (p == end) break;
+		if (num == count) return -1;
+
+		// Fast path for plain numbers
+		char *num_end = NULL;
+		if (dst_float) {
+			double val = ufbxi_parse_double(p, ufbxi_to_size(end - p) + 1, &num_end, true);
+			if (num_end && num_end != p && !ufbxi_is_number_char(*num_end)) {
+				if (dst_type == 'd') {
+					((double*)dst)[num] = val;
+				} else {
+					((float*)dst)[num] = (float)val;
+				}
+			} else {
+				num_end = NULL;
+			}
+		} else {
+			int64_t val;
+			if (ufbxi_parse_int64_token(p, &val, &num_end) && !ufbxi_is_number_char(*num_end)) {
+				if (dst_type == 'l') {
+					((int64_t*)dst)[num] = val;
+				} else {
+					((int32_t*)dst)[num] = (int32_t)val;
+				}
+			} else {
+				num_end = NULL;
+			}
+		}
+
+		if (num_end) {
+			p = num_end;
+		} else {
+			// Tokenize the value like `ufbxi_ascii_next_token()`
+			const char *word = p;
+			bool is_float = false;
+			while (p != end && ufbxi_is_number_char(*p)) {
+				char c = *p++;
+				if (c == '.' || c == 'e' || c == 'E') is_float = true;
+			}
+
+			int64_t i64 = 0;
+			double f64 = 0.0, fsign = 1.0;
+			if (*word == 'e' || *word == 'E') {
+				// Bare word, evaluates to its first character
+				for (const char *c = word; c != p; c++) {
+					if (*c == '+' || *c == '-' || *c == '.') return -1;
+				}
+				i64 = (int64_t)*word;
+				is_float = false;
+			} else if (is_float) {
+				f64 = ufbxi_parse_double(word, ufbxi_to_size(end - word) + 1, &num_end, true);
+				if (num_end != p) return -1;
+			} else {
+				if (!ufbxi_parse_int64_token(word, &i64, &num_end)) {
+					i64 = strtoll(word, &num_end, 10);
+				}
+				if (num_end != p || p == word) return -1;
+				if (i64 == 0 && *word == '-') fsign = -1.0;
+			}
+
+			switch (dst_type) {
+			case 'i': ((int32_t*)dst)[num] = is_float ? ufbxi_f64_to_i32(f64) : (int32_t)i64; break;
+			case 'l': ((int64_t*)dst)[num] = is_float ? ufbxi_f64_to_i64(f64) : i64; break;
+			case 'f': ((float*)dst)[num] = is_float ? (float)f64 : (float)i64 * (float)fsign; break;
+			case 'd': ((double*)dst)[num] = is_float ? f64 : (double)i64 * fsign; break;
+			default: return -1;
+			}
+		}
+		num++;
+
+		while (p != end && ufbxi_is_space(*p)) p++;
+		if (p == end) break;
+		if (*p != ',') return -1;
+		p++;
+	}
+	return (ptrdiff_t)num;
+}
+
+static ufbxi_forceinline bool ufbxi_is_ascii_array_char(char c)
+{
+	return ufbxi_is_number_char(c) || c == ',' || ufbxi_is_space(c);
+}
+
+// Scan `[src, end)` for characters that can't appear in a plain list of numbers,
+// returns the first such character or `end`. Adds the number of commas to `*p_num_commas`.
+static ufbxi_noinline const char *ufbxi_ascii_scan_array_text(const char *src, const char *end, size_t *p_num_commas)
+{
+	const char *p = src;
+	size_t num_commas = 0;
+
+#if UFBXI_HAS_SSE
+	const __m128i c_plus = _mm_set1_epi8('+'), c_zero = _mm_set1_epi8('0');
+	const __m128i c_3 = _mm_set1_epi8(3), c_9 = _mm_set1_epi8(9);
+	const __m128i c_lower = _mm_set1_epi8(0x20), c_e = _mm_set1_epi8('e'), c_comma = _mm_set1_epi8(',');
+	const __m128i c_space = _mm_set1_epi8(' '), c_tab = _mm_set1_epi8('\t');
+	const __m128i c_lf = _mm_set1_epi8('\n'), c_cr = _mm_set1_epi8('\r');
+	while (ufbxi_to_size(end - p) >= 16) {
+		__m128i x = _mm_loadu_si128((const __m128i*)p);
+
+		// "+,-." and "0-9" as unsigned ranges, 'e' and 'E', whitespace
+		__m128i sign = _mm_sub_epi8(x, c_plus), digit = _mm_sub_epi8(x, c_zero);
+		__m128i ok = _mm_cmpeq_epi8(_mm_min_epu8(sign, c_3), sign);
+		ok = _mm_or_si128(ok, _mm_cmpeq_epi8(_mm_min_epu8(digit, c_9), digit));
+		ok = _mm_or_si128(ok, _mm_cmpeq_epi8(_mm_or_si128(x, c_lower), c_e));
+		ok = _mm_or_si128(ok, _mm_or_si128(_mm_cmpeq_epi8(x, c_space), _mm_cmpeq_epi8(x, c_tab)));
+		ok = _mm_or_si128(ok, _mm_or_si128(_mm_cmpeq_epi8(x, c_lf), _mm_cmpeq_epi8(x, c_cr)));
+		if (_mm_movemask_epi8(ok) != 0xffff) break;
+
+		uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, c_comma));
+		m = m - ((m >> 1) & 0x5555u);
+		m = (m & 0x3333u) + ((m >> 2) & 0x3333u);
+		m = (m + (m >> 4)) & 0x0f0fu;
+		num_commas += (m + (m >> 8)) & 0x1fu;
+		p += 16;
+	}
+#endif
+
+	for (; p != end; p++) {
+		char c = *p;
+		if (!ufbxi_is_ascii_array_char(c)) break;
+		if (c == ',') num_commas++;
+	}
+
+	*p_num_commas += num_commas;
+	return p;
+}
+
+static ufbxi_forceinline bool ufbxi_ascii_can_defer_array(ufbxi_context *uc, int arr_type)
+{
+	if (!uc->opts.thread_opts.pool.run_fn || uc->ascii.parse_as_f32) return false;
+	return arr_type == 'i' || arr_type == 'l' || arr_type == 'f' || arr_type == 'd';
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_push_deferred_chunk(ufbxi_context *uc, char type, const char *begin, const char *end, size_t count)
+{
+	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->deferred_arrays, &uc->deferred_arrays_cap, uc->num_deferred_arrays + 1));
+	ufbxi_deferred_array *arr = &uc->deferred_arrays[uc->num_deferred_arrays++];
+	memset(arr, 0, sizeof(ufbxi_deferred_array));
+	arr->encoded_data = begin;
+	arr->encoded_size = ufbxi_to_size(end - begin);
+	arr->arr_size = count;
+	arr->src_type = type;
+	arr->dst_type = type;
+	arr->ascii = true;
+	return 1;
+}
+
+// Try to defer parsing the values of a post-7000 ASCII array eg. "*3 { a: 1,2,3 }" to
+// `ufbxi_flush_deferred_arrays()`. `ua->token` must be the `a:` name and the whole array
+// must be buffered and consist only of numbers. A structural pre-scan splits the array into
+// chunks at commas and counts the values in each chunk, so the chunks can be parsed to their
+// final positions in parallel. If the array is deferred, skips to the closing '}' and returns
+// the index of the first chunk in `uc->deferred_arrays` and the total number of values.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_ascii_try_defer_array(ufbxi_context *uc, char type, bool *p_deferred, size_t *p_first_chunk, size_t *p_num_values)
+{
+	ufbxi_ascii *ua = &uc->ascii;
+	*p_deferred = false;
+
+	const char *begin = ua->src;
+	const char *body_end = (const char*)memchr(begin, '}', ufbxi_to_size(ua->src_end - begin));
+	if (!body_end) return 1;
+
+	size_t size = ufbxi_to_size(body_end - begin);
+	if (size < UFBXI_MIN_DEFERRED_ASCII_ARRAY_BYTES) return 1;
+
+	// Decode the pending arrays first if we would exceed the memory limit,
+	// ASCII arrays count towards the limit by the size of their text.
+	size_t memory_limit = uc->opts.thread_opts.memory_limit;
+	if (uc->deferred_memory > 0 && (uc->deferred_memory >= memory_limit || memory_limit - uc->deferred_memory < size)) {
+		ufbxi_check(ufbxi_flush_deferred_arrays(uc));
+	}
+
+	size_t first_chunk = uc->num_deferred_arrays;
+	size_t num_values = 0;
+	const char *chunk_begin = begin;
+	for (;;) {
+		size_t chunk_values = 0;
+		size_t left = ufbxi_to_size(body_end - chunk_begin);
+		const char *chunk_end = chunk_begin + ufbxi_min_sz(left, UFBXI_ASCII_ARRAY_CHUNK_SIZE);
+		const char *p = ufbxi_ascii_scan_array_text(chunk_begin, chunk_end, &chunk_values);
+
+		// Extend the chunk up to and including the next comma
+		bool split = false;
+		if (p == chunk_end) {
+			while (p != body_end && *p != ',' && ufbxi_is_ascii_array_char(*p)) p++;
+			if (p != body_end && *p == ',') {
+				chunk_values++;
+				p++;
+				split = true;
+			}
+		}
+
+		if (p != body_end && !split) {
+			// Comments, strings etc. are left for the normal parser
+			uc->num_deferred_arrays = first_chunk;
+			return 1;
+		}
+
+		if (p == body_end) {
+			// Count the last value if there is no trailing comma
+			const char *last = body_end;
+			while (last != chunk_begin && ufbxi_is_space(last[-1])) last--;
+			if (last != chunk_begin && last[-1] != ',') chunk_values++;
+		}
+
+		ufbxi_check(ufbxi_ascii_push_deferred_chunk(uc, type, chunk_begin, p, chunk_values));
+		num_values += chunk_values;
+		chunk_begin = p;
+		if (p == body_end) break;
+	}
+
+	// The read buffer will be overwritten before the chunks are parsed so copy the text,
+	// including the character following each chunk.
+	if (uc->read_fn) {
+		char *copy = ufbxi_push_copy(&uc->tmp_deferred, char, size + 1, begin);
+		ufbxi_check(copy);
+		for (size_t i = first_chunk; i < uc->num_deferred_arrays; i++) {
+			ufbxi_deferred_array *arr = &uc->deferred_arrays[i];
+			arr->encoded_data = copy + ((const char*)arr->encoded_data - begin);
+		}
+	}
+	uc->deferred_memory += size;
+
+	// Skip to the closing '}', `ufbxi_ascii_yield()` updates `ua->src_yield` for it
+	ua->src = body_end;
+	ufbxi_check(ufbxi_ascii_yield(uc) == '}');
+	ufbxi_check(ufbxi_ascii_next_token(uc, &ua->token));
+
+	*p_deferred = true;
+	*p_first_chunk = first_chunk;
+	*p_num_values = num_values;
+	return 1;
+}
+
+// Skip the rest of a `{ ... }` block without tokenizing it, the opening brace must
+// have been accepted so `ua->token` already contains the first token of the block.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_skip_block(ufbxi_context *uc)
+{
+	ufbxi_ascii *ua = &uc->ascii;
+
+	size_t depth = 1;
+	if (ua->token.type == '{') {
+		depth++;
+	} else if (ua->token.type == '}') {
+		depth--;
+	} else {
+		ufbxi_check_msg(ua->token.type != UFBXI_ASCII_END, "Truncated file");
+	}
+
+	while (depth > 0) {
+		// Skip quickly over characters that can't affect nesting
+		const char *src = ua->src, *src_yield = ua->src_yield;
+		while (src != src_yield) {
+			char s = *src;
+			if (s == '{' || s == '}' || s == '"' || s == ';') break;
+			src++;
+		}
+		ua->src = src;
+
+		char c = ufbxi_ascii_peek(uc);
+		if (c == '"') {
+			ufbxi_ascii_next(uc);
+			ufbxi_check(ufbxi_ascii_skip_until(uc, '"'));
+		} else if (c == ';') {
+			ufbxi_check(ufbxi_ascii_skip_until(uc, '\n'));
+		} else if (c == '{') {
+			depth++;
+		} else if (c == '}') {
+			depth--;
+		} else {
+			ufbxi_check_msg(c != '\0', "Truncated file");
+		}
+		ufbxi_ascii_next(uc);
+	}
+
+	ufbxi_check(ufbxi_ascii_next_token(uc, &ua->token));
+	return 1;
+}
+
 // Recursion limited by check at the start
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *uc, uint32_t depth, ufbxi_parse_state parent_state, bool *p_end, ufbxi_buf *tmp_buf, bool recursive)
 	ufbxi_recursive_function(int, ufbxi_ascii_parse_node, (uc, depth, parent_state, p_end, tmp_buf, recursive), UFBXI_MAX_NODE_DEPTH + 1,
@@ -8642,6 +10475,11 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 	ufbxi_buf *arr_buf = NULL;
 	size_t arr_elem_size = 0;
 
+	// Set if the array values are parsed later, see `ufbxi_ascii_try_defer_array()`
+	bool deferred = false;
+	size_t deferred_first_chunk = 0;
+	size_t num_deferred_values = 0;
+
 	// Check if the values of the node we're parsing currently should be
 	// treated as an array.
 	ufbxi_array_info arr_info;
@@ -8702,11 +10540,13 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 
 		if (arr_type) {
 			size_t num_read = 0;
+			ufbxi_stats_timer stats_begin = ufbxi_stats_begin(uc);
 			if (arr_type == 'f' || arr_type == 'd') {
 				ufbxi_check(ufbxi_ascii_read_float_array(uc, (char)arr_type, &num_read));
 			} else if (arr_type == 'i' || arr_type == 'l') {
 				ufbxi_check(ufbxi_ascii_read_int_array(uc, (char)arr_type, &num_read));
 			}
+			ufbxi_stats_end(uc, ascii_number, stats_begin);
 			ufbxi_check(UINT32_MAX - num_values > num_read);
 			num_values += (uint32_t)num_read;
 		}
@@ -8748,7 +10588,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 					v->s.utf8_length = 0;
 				} else {
 					bool non_ascii = false;
-					uint32_t hash = ufbxi_hash_string_check_ascii(str, length, &non_ascii);
+					uint32_t hash = ufbxi_hash_string_check_ascii(str, length, uc->string_pool.map.seed, &non_ascii);
 					bool raw = !non_ascii || ufbxi_is_raw_string(uc, parent_state, name, num_values);
 					ufbxi_check(ufbxi_push_sanitized_string(&uc->string_pool, &v->s, str, length, hash, raw));
 					if (non_ascii && raw) v->s.utf8_length = UINT32_MAX;
@@ -8857,7 +10697,12 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 			ufbxi_check(ufbxi_ascii_accept(uc, UFBXI_ASCII_INT));
 
 			if (ufbxi_ascii_accept(uc, '{')) {
-				ufbxi_check(ufbxi_ascii_accept(uc, UFBXI_ASCII_NAME));
+				if (ua->token.type == UFBXI_ASCII_NAME && ufbxi_ascii_can_defer_array(uc, arr_type)) {
+					ufbxi_check(ufbxi_ascii_try_defer_array(uc, (char)arr_type, &deferred, &deferred_first_chunk, &num_deferred_values));
+				}
+				if (!deferred) {
+					ufbxi_check(ufbxi_ascii_accept(uc, UFBXI_ASCII_NAME));
+				}
 
 				// NOTE: This `continue` skips incrementing `num_values` and parsing
 				// a comma, continuing to parse the values in the array.
@@ -8888,9 +10733,36 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 	ua->parse_as_f32 = false;
 
 	if (arr_type) {
+		uc->load_stats.num_arrays++;
 		if (arr_type == '-') {
 			node->array->data = NULL;
 			node->array->size = 0;
+		} else if (deferred) {
+			// Reserve space for the deferred values after the ones already parsed
+			ufbxi_check(UINT32_MAX - num_values > num_deferred_values);
+			size_t num_parsed = num_values;
+			num_values += (uint32_t)num_deferred_values;
+			void *arr_data = ufbxi_push_size(arr_buf, arr_elem_size, num_values);
+			ufbxi_check(arr_data);
+			ufbxi_pop_size(&uc->tmp_stack, arr_elem_size, num_parsed, arr_data, false);
+
+			char *chunk_data = (char*)arr_data + num_parsed * arr_elem_size;
+			for (size_t i = deferred_first_chunk; i < uc->num_deferred_arrays; i++) {
+				ufbxi_deferred_array *chunk = &uc->deferred_arrays[i];
+				chunk->arr_data = chunk_data;
+				chunk_data += chunk->arr_size * arr_elem_size;
+			}
+
+			if (arr_info.flags & UFBXI_ARRAY_FLAG_PAD_BEGIN) {
+				node->array->data = (char*)arr_data + 4*arr_elem_size;
+				node->array->size = num_values - 4;
+			} else {
+				node->array->data = arr_data;
+				node->array->size = num_values;
+			}
+
+			// Pop alignment helper
+			ufbxi_pop_size(&uc->tmp_stack, 8, 1, NULL, false);
 		} else {
 			void *arr_data = ufbxi_push_pop_size(arr_buf, &uc->tmp_stack, arr_elem_size, num_values);
 			ufbxi_check(arr_data);
@@ -8915,7 +10787,12 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 	// Recursively parse the children of this node. Update the parse state
 	// to provide context for child node parsing.
 	if (ufbxi_ascii_accept(uc, '{')) {
-		if (recursive) {
+		if (depth == 0 && uc->probe && parent_state == UFBXI_PARSE_OBJECTS && name != ufbxi_GlobalSettings && name != ufbxi_SceneInfo) {
+			// Probing only needs the object headers, see `ufbxi_binary_parse_node()`.
+			ufbxi_check(ufbxi_ascii_skip_block(uc));
+			uc->has_next_child = false;
+			return 1;
+		} else if (recursive) {
 			size_t num_children = 0;
 			for (;;) {
 				bool end = false;
@@ -8935,6 +10812,11 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_ascii_parse_node(ufbxi_context *
 		uc->has_next_child = false;
 	}
 
+	// Parse deferred arrays before returning the node to the caller
+	if (depth == 0) {
+		ufbxi_check(ufbxi_flush_deferred_arrays(uc));
+	}
+
 	return 1;
 }
 
@@ -9460,8 +11342,15 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_begin_parse(ufbxi_context *uc)
 	} else {
 		uc->from_ascii = true;
 
-		// Use the current read buffer as the initial parse buffer
+		// Use the current read buffer as the initial parse buffer, token buffers
+		// may have been retained from a previous load by `ufbx_load_context`.
+		char *token_data = uc->ascii.token.str_data, *prev_token_data = uc->ascii.prev_token.str_data;
+		size_t token_cap = uc->ascii.token.str_cap, prev_token_cap = uc->ascii.prev_token.str_cap;
 		memset(&uc->ascii, 0, sizeof(uc->ascii));
+		uc->ascii.token.str_data = token_data;
+		uc->ascii.token.str_cap = token_cap;
+		uc->ascii.prev_token.str_data = prev_token_data;
+		uc->ascii.prev_token.str_cap = prev_token_cap;
 		uc->ascii.src = uc->data;
 		uc->ascii.src_yield = uc->data + uc->yield_size;
 		uc->ascii.src_end = uc->data + uc->data_size + uc->yield_size;
@@ -9548,15 +11437,19 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_parse_toplevel(ufbxi_context *uc
 			return 1;
 		}
 
-		// If not we need to parse all the children of the node for later
+		// If not we need to parse all the children of the node for later, the
+		// node ranges of lazy geometry are not retained so parse them fully.
 		uint32_t num_children = 0;
 		ufbxi_parse_state state = ufbxi_update_parse_state(UFBXI_PARSE_ROOT, node->name);
 		if (uc->has_next_child) {
+			bool lazy_geometry = uc->lazy_geometry;
+			uc->lazy_geometry = false;
 			for (;;) {
 				ufbxi_check(ufbxi_parse_toplevel_child_imp(uc, state, &uc->tmp, &end));
 				if (end) break;
 				num_children++;
 			}
+			uc->lazy_geometry = lazy_geometry;
 		}
 
 		node->num_children = num_children;
@@ -9981,6 +11874,28 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_maps(ufbxi_context *uc)
 	return 1;
 }
 
+// Set up the string pool and `prop_type_map`, copying the tables from the load context if possible
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_tables(ufbxi_context *uc)
+{
+	ufbx_load_context *lc = uc->load_context;
+	if (lc && lc->has_tables) {
+		ufbxi_check(ufbxi_map_copy(&uc->string_pool.map, &lc->string_table));
+		return 1;
+	}
+
+	ufbxi_check(ufbxi_load_strings(uc));
+	ufbxi_check(ufbxi_load_maps(uc));
+
+	// `prop_type_map` is retained as-is in the load context, strings need to be
+	// restored to this state for every load.
+	if (lc) {
+		ufbxi_check(ufbxi_map_copy(&lc->string_table, &uc->string_pool.map));
+		lc->has_tables = true;
+	}
+
+	return 1;
+}
+
 // -- Reading the parsed data
 
 ufbxi_noinline static void ufbxi_decode_base64(char *dst, const char *src, size_t src_length)
@@ -10479,7 +12394,7 @@ ufbxi_nodiscard static int ufbxi_split_type_and_name(ufbxi_context *uc, ufbx_str
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_insert_fbx_id(ufbxi_context *uc, uint64_t fbx_id, uint32_t element_id)
 {
-	uint32_t hash = ufbxi_hash64(fbx_id);
+	uint32_t hash = ufbxi_hash64(fbx_id ^ uc->fbx_id_map.seed);
 	ufbxi_fbx_id_entry *entry = ufbxi_map_find(&uc->fbx_id_map, ufbxi_fbx_id_entry, hash, &fbx_id);
 
 	if (!entry) {
@@ -10497,7 +12412,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_insert_fbx_id(ufbxi_context *uc,
 
 static ufbxi_noinline ufbxi_fbx_id_entry *ufbxi_find_fbx_id(ufbxi_context *uc, uint64_t fbx_id)
 {
-	uint32_t hash = ufbxi_hash64(fbx_id);
+	uint32_t hash = ufbxi_hash64(fbx_id ^ uc->fbx_id_map.seed);
 	return ufbxi_map_find(&uc->fbx_id_map, ufbxi_fbx_id_entry, hash, &fbx_id);
 }
 
@@ -10508,7 +12423,7 @@ static ufbxi_forceinline bool ufbxi_fbx_id_exists(ufbxi_context *uc, uint64_t fb
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_insert_fbx_attr(ufbxi_context *uc, uint64_t fbx_id, uint64_t attrib_fbx_id)
 {
-	uint32_t hash = ufbxi_hash64(fbx_id);
+	uint32_t hash = ufbxi_hash64(fbx_id ^ uc->fbx_attr_map.seed);
 	ufbxi_fbx_attr_entry *entry = ufbxi_map_find(&uc->fbx_attr_map, ufbxi_fbx_attr_entry, hash, &fbx_id);
 	// TODO: Strict / warn about duplicate objects
 
@@ -11389,28 +13304,11 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_update_face_groups(ufbxi_buf *bu
 	return 1;
 }
 
-ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh(ufbxi_context *uc, ufbxi_node *node, ufbxi_element_info *info)
+// Read the geometry data of a mesh, also used for lazy meshes in `ufbx_load_mesh_data()`.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh_data(ufbxi_context *uc, ufbxi_node *node, ufbx_mesh *mesh)
 {
-	ufbx_mesh *ufbxi_restrict mesh = ufbxi_push_element(uc, info, ufbx_mesh, UFBX_ELEMENT_MESH);
-	ufbxi_check(mesh);
-
-	// In up to version 7100 FBX files blend shapes are contained within the same geometry node
-	if (uc->version <= 7100) {
-		ufbxi_check(ufbxi_read_synthetic_blend_shapes(uc, node, info));
-	}
-
-	ufbxi_patch_mesh_reals(mesh);
-
-	// Sometimes there are empty meshes in FBX files?
-	// TODO: Should these be included in output? option? strict mode?
-	ufbxi_node *node_vertices = ufbxi_find_child(node, ufbxi_Vertices);
-	ufbxi_node *node_indices = ufbxi_find_child(node, ufbxi_PolygonVertexIndex);
-	if (!node_vertices || !node_indices) return 1;
-
-	if (uc->opts.ignore_geometry) return 1;
-
-	ufbxi_value_array *vertices = ufbxi_get_array(node_vertices, 'r');
-	ufbxi_value_array *indices = ufbxi_get_array(node_indices, 'i');
+	ufbxi_value_array *vertices = ufbxi_find_array(node, ufbxi_Vertices, 'r');
+	ufbxi_value_array *indices = ufbxi_find_array(node, ufbxi_PolygonVertexIndex, 'i');
 	ufbxi_value_array *edge_indices = ufbxi_find_array(node, ufbxi_Edges, 'i');
 	ufbxi_check(vertices && indices);
 	ufbxi_check(vertices->size % 3 == 0);
@@ -11739,6 +13637,63 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh(ufbxi_context *uc, ufb
 		ufbxi_check(extra->texture_arr);
 	}
 
+	return 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_mesh(ufbxi_context *uc, ufbxi_node *node, ufbxi_element_info *info)
+{
+	ufbx_mesh *ufbxi_restrict mesh = ufbxi_push_element(uc, info, ufbx_mesh, UFBX_ELEMENT_MESH);
+	ufbxi_check(mesh);
+
+	// In up to version 7100 FBX files blend shapes are contained within the same geometry node
+	if (uc->version <= 7100) {
+		ufbxi_check(ufbxi_read_synthetic_blend_shapes(uc, node, info));
+	}
+
+	ufbxi_patch_mesh_reals(mesh);
+
+	// Sometimes there are empty meshes in FBX files?
+	// TODO: Should these be included in output? option? strict mode?
+	ufbxi_node *node_vertices = ufbxi_find_child(node, ufbxi_Vertices);
+	ufbxi_node *node_indices = ufbxi_find_child(node, ufbxi_PolygonVertexIndex);
+	if (!node_vertices || !node_indices) return 1;
+
+	if (uc->opts.ignore_geometry) return 1;
+
+	if (uc->lazy_geometry_node) {
+		// Only vertex positions are parsed for lazy meshes, they are needed for
+		// sizing skin deformers and are useful for eg. bounds.
+		ufbxi_value_array *vertices = ufbxi_get_array(node_vertices, 'r');
+		ufbxi_check(vertices);
+		ufbxi_check(vertices->size % 3 == 0);
+
+		mesh->num_vertices = vertices->size / 3;
+		mesh->vertices.data = (ufbx_vec3*)vertices->data;
+		mesh->vertices.count = mesh->num_vertices;
+		mesh->vertex_position.exists = true;
+		mesh->vertex_position.values = mesh->vertices;
+		mesh->vertex_position.unique_per_vertex = true;
+		mesh->skinned_is_local = true;
+		mesh->skinned_position = mesh->vertex_position;
+
+		// No vertices are referenced by faces yet
+		mesh->vertex_first_index.count = mesh->num_vertices;
+		mesh->vertex_first_index.data = ufbxi_push(&uc->result, uint32_t, mesh->num_vertices);
+		ufbxi_check(mesh->vertex_first_index.data);
+		ufbxi_for_list(uint32_t, p_vx_ix, mesh->vertex_first_index) {
+			*p_vx_ix = UFBX_NO_INDEX;
+		}
+
+		// Collected to `ufbxi_scene_imp.lazy_ranges` in `ufbxi_collect_lazy_ranges()`
+		ufbxi_mesh_extra *extra = ufbxi_push_element_extra(uc, mesh->element.element_id, ufbxi_mesh_extra);
+		ufbxi_check(extra);
+		extra->lazy_range.begin = uc->lazy_geometry_begin;
+		extra->lazy_range.end = uc->lazy_geometry_end;
+		mesh->lazy_geometry = true;
+	} else {
+		ufbxi_check(ufbxi_read_mesh_data(uc, node, mesh));
+	}
+
 	// Subdivision
 
 	ufbxi_ignore(ufbxi_find_val1(node, ufbxi_PreviewDivisionLevels, "I", &mesh->subdivision_preview_levels));
@@ -12600,13 +14555,106 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_global_settings(ufbxi_conte
 	return 1;
 }
 
-ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects(ufbxi_context *uc)
+// Element type of a node attribute, `synthetic` for pre-7000 models that contain
+// their attributes, see `ufbxi_read_synthetic_attribute()`.
+static ufbxi_noinline ufbx_element_type ufbxi_attribute_element_type(const char *sub_type, bool synthetic)
+{
+	if (sub_type == ufbxi_Light) return UFBX_ELEMENT_LIGHT;
+	if (sub_type == ufbxi_Camera) return UFBX_ELEMENT_CAMERA;
+	if (sub_type == ufbxi_LimbNode || sub_type == ufbxi_Limb || sub_type == ufbxi_Root) return UFBX_ELEMENT_BONE;
+	if (sub_type == ufbxi_Null || sub_type == ufbxi_Marker) return UFBX_ELEMENT_EMPTY;
+	if (sub_type == ufbxi_CameraStereo) return UFBX_ELEMENT_STEREO_CAMERA;
+	if (sub_type == ufbxi_CameraSwitcher) return UFBX_ELEMENT_CAMERA_SWITCHER;
+	if (sub_type == ufbxi_FKEffector || sub_type == ufbxi_IKEffector) return UFBX_ELEMENT_MARKER;
+	if (sub_type == ufbxi_LodGroup) return UFBX_ELEMENT_LOD_GROUP;
+	if (synthetic) {
+		if (sub_type == ufbxi_Mesh) return UFBX_ELEMENT_MESH;
+		if (sub_type == ufbxi_NurbsCurve) return UFBX_ELEMENT_NURBS_CURVE;
+		if (sub_type == ufbxi_NurbsSurface) return UFBX_ELEMENT_NURBS_SURFACE;
+		if (sub_type == ufbxi_Line) return UFBX_ELEMENT_LINE_CURVE;
+		if (sub_type == ufbxi_TrimNurbsSurface) return UFBX_ELEMENT_NURBS_TRIM_SURFACE;
+		if (sub_type == ufbxi_Boundary) return UFBX_ELEMENT_NURBS_TRIM_BOUNDARY;
+	}
+	return UFBX_ELEMENT_UNKNOWN;
+}
+
+// Element type created for an object in `ufbxi_read_objects()` and counted by `ufbx_probe_file()`,
+// returns `false` if the object is ignored.
+static ufbxi_noinline bool ufbxi_object_element_type(ufbx_element_type *p_type, const char *name, const char *sub_type)
+{
+	ufbx_element_type type = UFBX_ELEMENT_UNKNOWN;
+	if (name == ufbxi_Model) {
+		type = UFBX_ELEMENT_NODE;
+	} else if (name == ufbxi_NodeAttribute) {
+		type = ufbxi_attribute_element_type(sub_type, false);
+	} else if (name == ufbxi_Geometry) {
+		if (sub_type == ufbxi_Mesh) type = UFBX_ELEMENT_MESH;
+		else if (sub_type == ufbxi_Shape) type = UFBX_ELEMENT_BLEND_SHAPE;
+		else if (sub_type == ufbxi_NurbsCurve) type = UFBX_ELEMENT_NURBS_CURVE;
+		else if (sub_type == ufbxi_NurbsSurface) type = UFBX_ELEMENT_NURBS_SURFACE;
+		else if (sub_type == ufbxi_Line) type = UFBX_ELEMENT_LINE_CURVE;
+		else if (sub_type == ufbxi_TrimNurbsSurface) type = UFBX_ELEMENT_NURBS_TRIM_SURFACE;
+		else if (sub_type == ufbxi_Boundary) type = UFBX_ELEMENT_NURBS_TRIM_BOUNDARY;
+	} else if (name == ufbxi_Deformer) {
+		if (sub_type == ufbxi_Skin) type = UFBX_ELEMENT_SKIN_DEFORMER;
+		else if (sub_type == ufbxi_Cluster) type = UFBX_ELEMENT_SKIN_CLUSTER;
+		else if (sub_type == ufbxi_BlendShape) type = UFBX_ELEMENT_BLEND_DEFORMER;
+		else if (sub_type == ufbxi_BlendShapeChannel) type = UFBX_ELEMENT_BLEND_CHANNEL;
+		else if (sub_type == ufbxi_VertexCacheDeformer) type = UFBX_ELEMENT_CACHE_DEFORMER;
+	} else if (name == ufbxi_Material) {
+		type = UFBX_ELEMENT_MATERIAL;
+	} else if (name == ufbxi_Texture || name == ufbxi_LayeredTexture) {
+		type = UFBX_ELEMENT_TEXTURE;
+	} else if (name == ufbxi_Video) {
+		type = UFBX_ELEMENT_VIDEO;
+	} else if (name == ufbxi_AnimationStack) {
+		type = UFBX_ELEMENT_ANIM_STACK;
+	} else if (name == ufbxi_AnimationLayer) {
+		type = UFBX_ELEMENT_ANIM_LAYER;
+	} else if (name == ufbxi_AnimationCurveNode) {
+		type = UFBX_ELEMENT_ANIM_VALUE;
+	} else if (name == ufbxi_AnimationCurve) {
+		type = UFBX_ELEMENT_ANIM_CURVE;
+	} else if (name == ufbxi_Pose) {
+		type = UFBX_ELEMENT_POSE;
+	} else if (name == ufbxi_Implementation) {
+		type = UFBX_ELEMENT_SHADER;
+	} else if (name == ufbxi_BindingTable) {
+		type = UFBX_ELEMENT_SHADER_BINDING;
+	} else if (name == ufbxi_Collection) {
+		if (sub_type != ufbxi_SelectionSet) return false;
+		type = UFBX_ELEMENT_SELECTION_SET;
+	} else if (name == ufbxi_CollectionExclusive) {
+		if (sub_type != ufbxi_DisplayLayer) return false;
+		type = UFBX_ELEMENT_DISPLAY_LAYER;
+	} else if (name == ufbxi_SelectionNode) {
+		type = UFBX_ELEMENT_SELECTION_NODE;
+	} else if (name == ufbxi_Constraint) {
+		type = sub_type == ufbxi_Character ? UFBX_ELEMENT_CHARACTER : UFBX_ELEMENT_CONSTRAINT;
+	} else if (name == ufbxi_Cache) {
+		type = UFBX_ELEMENT_CACHE_FILE;
+	} else if (name == ufbxi_ObjectMetaData) {
+		type = UFBX_ELEMENT_METADATA_OBJECT;
+	}
+
+	*p_type = type;
+	return true;
+}
+
+// Read objects until at least `max_bytes` of the file has been consumed, always reading
+// at least one object. `*p_done` is set when there are no more objects left to read.
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects(ufbxi_context *uc, uint64_t max_bytes, bool *p_done)
 {
 	ufbxi_element_info info = { 0 };
-	for (;;) {
+	uint64_t begin_offset = ufbxi_get_read_offset(uc);
+	max_bytes = ufbxi_max64(max_bytes, 1);
+	while (ufbxi_get_read_offset(uc) - begin_offset < max_bytes) {
 		ufbxi_node *node;
 		ufbxi_check(ufbxi_parse_toplevel_child(uc, &node));
-		if (!node) break;
+		if (!node) {
+			*p_done = true;
+			break;
+		}
 
 		info.dom_node = ufbxi_get_dom_node(uc, node);
 
@@ -12644,111 +14692,92 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_objects(ufbxi_context *uc)
 		ufbxi_check(ufbxi_read_properties(uc, node, &info.props));
 		info.props.defaults = ufbxi_find_template(uc, name, sub_type);
 
-		if (name == ufbxi_Model) {
+		if (name == ufbxi_SceneInfo) {
+			ufbxi_check(ufbxi_read_scene_info(uc, node));
+			continue;
+		}
+
+		ufbx_element_type type;
+		if (!ufbxi_object_element_type(&type, name, sub_type)) continue;
+
+		switch (type) {
+		case UFBX_ELEMENT_UNKNOWN:
+			ufbxi_check(ufbxi_read_unknown(uc, node, &info, type_str, sub_type_str, name));
+			break;
+		case UFBX_ELEMENT_NODE:
 			if (uc->version < 7000) {
 				ufbxi_check(ufbxi_read_synthetic_attribute(uc, node, &info, type_str, sub_type, name));
 			}
 			ufbxi_check(ufbxi_read_model(uc, node, &info));
-		} else if (name == ufbxi_NodeAttribute) {
-			if (sub_type == ufbxi_Light) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_light), UFBX_ELEMENT_LIGHT));
-			} else if (sub_type == ufbxi_Camera) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_camera), UFBX_ELEMENT_CAMERA));
-			} else if (sub_type == ufbxi_LimbNode || sub_type == ufbxi_Limb || sub_type == ufbxi_Root) {
-				ufbxi_check(ufbxi_read_bone(uc, node, &info, sub_type));
-			} else if (sub_type == ufbxi_Null || sub_type == ufbxi_Marker) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_empty), UFBX_ELEMENT_EMPTY));
-			} else if (sub_type == ufbxi_CameraStereo) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_stereo_camera), UFBX_ELEMENT_STEREO_CAMERA));
-			} else if (sub_type == ufbxi_CameraSwitcher) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_camera_switcher), UFBX_ELEMENT_CAMERA_SWITCHER));
-			} else if (sub_type == ufbxi_FKEffector) {
-				ufbxi_check(ufbxi_read_marker(uc, node, &info, sub_type, UFBX_MARKER_FK_EFFECTOR));
-			} else if (sub_type == ufbxi_IKEffector) {
-				ufbxi_check(ufbxi_read_marker(uc, node, &info, sub_type, UFBX_MARKER_IK_EFFECTOR));
-			} else if (sub_type == ufbxi_LodGroup) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_lod_group), UFBX_ELEMENT_LOD_GROUP));
-			} else {
-				ufbxi_check(ufbxi_read_unknown(uc, node, &info, type_str, sub_type_str, name));
-			}
-		} else if (name == ufbxi_Geometry) {
-			if (sub_type == ufbxi_Mesh) {
-				ufbxi_check(ufbxi_read_mesh(uc, node, &info));
-			} else if (sub_type == ufbxi_Shape) {
-				ufbxi_check(ufbxi_read_shape(uc, node, &info));
-			} else if (sub_type == ufbxi_NurbsCurve) {
-				ufbxi_check(ufbxi_read_nurbs_curve(uc, node, &info));
-			} else if (sub_type == ufbxi_NurbsSurface) {
-				ufbxi_check(ufbxi_read_nurbs_surface(uc, node, &info));
-			} else if (sub_type == ufbxi_Line) {
-				ufbxi_check(ufbxi_read_line(uc, node, &info));
-			} else if (sub_type == ufbxi_TrimNurbsSurface) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_nurbs_trim_surface), UFBX_ELEMENT_NURBS_TRIM_SURFACE));
-			} else if (sub_type == ufbxi_Boundary) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_nurbs_trim_boundary), UFBX_ELEMENT_NURBS_TRIM_BOUNDARY));
-			} else {
-				ufbxi_check(ufbxi_read_unknown(uc, node, &info, type_str, sub_type_str, name));
-			}
-		} else if (name == ufbxi_Deformer) {
-			if (sub_type == ufbxi_Skin) {
-				ufbxi_check(ufbxi_read_skin(uc, node, &info));
-			} else if (sub_type == ufbxi_Cluster) {
-				ufbxi_check(ufbxi_read_skin_cluster(uc, node, &info));
-			} else if (sub_type == ufbxi_BlendShape) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_blend_deformer), UFBX_ELEMENT_BLEND_DEFORMER));
-			} else if (sub_type == ufbxi_BlendShapeChannel) {
-				ufbxi_check(ufbxi_read_blend_channel(uc, node, &info));
-			} else if (sub_type == ufbxi_VertexCacheDeformer) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_cache_deformer), UFBX_ELEMENT_CACHE_DEFORMER));
+			break;
+		case UFBX_ELEMENT_BONE:
+			ufbxi_check(ufbxi_read_bone(uc, node, &info, sub_type));
+			break;
+		case UFBX_ELEMENT_MARKER:
+			ufbxi_check(ufbxi_read_marker(uc, node, &info, sub_type, sub_type == ufbxi_FKEffector ? UFBX_MARKER_FK_EFFECTOR : UFBX_MARKER_IK_EFFECTOR));
+			break;
+		case UFBX_ELEMENT_MESH:
+			ufbxi_check(ufbxi_read_mesh(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_BLEND_SHAPE:
+			ufbxi_check(ufbxi_read_shape(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_NURBS_CURVE:
+			ufbxi_check(ufbxi_read_nurbs_curve(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_NURBS_SURFACE:
+			ufbxi_check(ufbxi_read_nurbs_surface(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_LINE_CURVE:
+			ufbxi_check(ufbxi_read_line(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_SKIN_DEFORMER:
+			ufbxi_check(ufbxi_read_skin(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_SKIN_CLUSTER:
+			ufbxi_check(ufbxi_read_skin_cluster(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_BLEND_CHANNEL:
+			ufbxi_check(ufbxi_read_blend_channel(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_MATERIAL:
+			ufbxi_check(ufbxi_read_material(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_TEXTURE:
+			if (name == ufbxi_LayeredTexture) {
+				ufbxi_check(ufbxi_read_layered_texture(uc, node, &info));
 			} else {
-				ufbxi_check(ufbxi_read_unknown(uc, node, &info, type_str, sub_type_str, name));
+				ufbxi_check(ufbxi_read_texture(uc, node, &info));
 			}
-		} else if (name == ufbxi_Material) {
-			ufbxi_check(ufbxi_read_material(uc, node, &info));
-		} else if (name == ufbxi_Texture) {
-			ufbxi_check(ufbxi_read_texture(uc, node, &info));
-		} else if (name == ufbxi_LayeredTexture) {
-			ufbxi_check(ufbxi_read_layered_texture(uc, node, &info));
-		} else if (name == ufbxi_Video) {
+			break;
+		case UFBX_ELEMENT_VIDEO:
 			ufbxi_check(ufbxi_read_video(uc, node, &info));
-		} else if (name == ufbxi_AnimationStack) {
-			ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_anim_stack), UFBX_ELEMENT_ANIM_STACK));
-		} else if (name == ufbxi_AnimationLayer) {
-			ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_anim_layer), UFBX_ELEMENT_ANIM_LAYER));
-		} else if (name == ufbxi_AnimationCurveNode) {
-			ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_anim_value), UFBX_ELEMENT_ANIM_VALUE));
-		} else if (name == ufbxi_AnimationCurve) {
+			break;
+		case UFBX_ELEMENT_ANIM_CURVE:
 			ufbxi_check(ufbxi_read_animation_curve(uc, node, &info));
-		} else if (name == ufbxi_Pose) {
+			break;
+		case UFBX_ELEMENT_POSE:
 			ufbxi_check(ufbxi_read_pose(uc, node, &info, sub_type));
-		} else if (name == ufbxi_Implementation) {
-			ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_shader), UFBX_ELEMENT_SHADER));
-		} else if (name == ufbxi_BindingTable) {
+			break;
+		case UFBX_ELEMENT_SHADER_BINDING:
 			ufbxi_check(ufbxi_read_binding_table(uc, node, &info));
-		} else if (name == ufbxi_Collection) {
-			if (sub_type == ufbxi_SelectionSet) {
-				ufbxi_check(ufbxi_read_selection_set(uc, node, &info));
-			}
-		} else if (name == ufbxi_CollectionExclusive) {
-			if (sub_type == ufbxi_DisplayLayer) {
-				ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_display_layer), UFBX_ELEMENT_DISPLAY_LAYER));
-			}
-		} else if (name == ufbxi_SelectionNode) {
+			break;
+		case UFBX_ELEMENT_SELECTION_SET:
+			ufbxi_check(ufbxi_read_selection_set(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_SELECTION_NODE:
 			ufbxi_check(ufbxi_read_selection_node(uc, node, &info));
-		} else if (name == ufbxi_Constraint) {
-			if (sub_type == ufbxi_Character) {
-				ufbxi_check(ufbxi_read_character(uc, node, &info));
-			} else {
-				ufbxi_check(ufbxi_read_constraint(uc, node, &info));
-			}
-		} else if (name == ufbxi_SceneInfo) {
-			ufbxi_check(ufbxi_read_scene_info(uc, node));
-		} else if (name == ufbxi_Cache) {
-			ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_cache_file), UFBX_ELEMENT_CACHE_FILE));
-		} else if (name == ufbxi_ObjectMetaData) {
-			ufbxi_check(ufbxi_read_element(uc, node, &info, sizeof(ufbx_metadata_object), UFBX_ELEMENT_METADATA_OBJECT));
-		} else {
-			ufbxi_check(ufbxi_read_unknown(uc, node, &info, type_str, sub_type_str, name));
+			break;
+		case UFBX_ELEMENT_CHARACTER:
+			ufbxi_check(ufbxi_read_character(uc, node, &info));
+			break;
+		case UFBX_ELEMENT_CONSTRAINT:
+			ufbxi_check(ufbxi_read_constraint(uc, node, &info));
+			break;
+		default:
+			// Elements that only have properties in the file
+			ufbxi_check(ufbxi_read_element(uc, node, &info, ufbx_element_type_size[type], type));
+			break;
 		}
 	}
 
@@ -13190,7 +15219,7 @@ ufbxi_noinline static void ufbxi_setup_root_node(ufbxi_context *uc, ufbx_node *r
 	root->is_root = true;
 }
 
-ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_root(ufbxi_context *uc)
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_root_begin(ufbxi_context *uc)
 {
 	// FBXHeaderExtension: Some metadata (optional)
 	ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_FBXHeaderExtension));
@@ -13244,8 +15273,13 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_root(ufbxi_context *uc)
 		// even the objects are not found.
 		ufbxi_check_msg(uc->top_node, "Not an FBX file");
 	}
-	ufbxi_check(ufbxi_read_objects(uc));
 
+	// Objects are read incrementally using `ufbxi_read_objects()` followed by `ufbxi_read_root_end()`.
+	return 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_root_end(ufbxi_context *uc)
+{
 	// Connections: Relationships between nodes
 	ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_Connections));
 	ufbxi_check(ufbxi_read_connections(uc));
@@ -14212,6 +16246,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_init(ufbxi_context *uc)
 	uc->obj.tmp_face_group_infos.ator = &uc->ator_tmp;
 	uc->obj.tmp_meshes.ator = &uc->ator_tmp;
 	uc->obj.tmp_props.ator = &uc->ator_tmp;
+	uc->obj.tmp_stream.ator = &uc->ator_tmp;
 
 	// .obj parsing does its own yield logic
 	uc->data_size += uc->yield_size;
@@ -14219,6 +16254,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_init(ufbxi_context *uc)
 	uc->obj.object.data = ufbxi_empty_char;
 	uc->obj.group.data = ufbxi_empty_char;
 
+	uc->obj.parallel_vertices = uc->opts.thread_opts.pool.run_fn != NULL && !uc->opts.ignore_geometry;
+
 	ufbxi_map_init(&uc->obj.group_map, &uc->ator_tmp, ufbxi_map_cmp_const_char_ptr, NULL);
 
 	// Add a nameless root node with the root ID
@@ -14250,11 +16287,13 @@ static ufbxi_noinline void ufbxi_obj_free(ufbxi_context *uc)
 	ufbxi_buf_free(&uc->obj.tmp_face_group_infos);
 	ufbxi_buf_free(&uc->obj.tmp_meshes);
 	ufbxi_buf_free(&uc->obj.tmp_props);
+	ufbxi_buf_free(&uc->obj.tmp_stream);
 
 	ufbxi_map_free(&uc->obj.group_map);
 
 	ufbxi_free(&uc->ator_tmp, ufbx_string, uc->obj.tokens, uc->obj.tokens_cap);
 	ufbxi_free(&uc->ator_tmp, ufbx_material*, uc->obj.tmp_materials, uc->obj.tmp_materials_cap);
+	ufbxi_free(&uc->ator_tmp, ufbxi_obj_vertex_chunk, uc->obj.vertex_chunks, uc->obj.vertex_chunks_cap);
 }
 
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_read_line(ufbxi_context *uc)
@@ -14445,6 +16484,135 @@ static ufbxi_noinline int ufbxi_obj_parse_vertex(ufbxi_context *uc, ufbxi_obj_at
 	return 1;
 }
 
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_pad_colors(ufbxi_context *uc, size_t num_vertices)
+{
+	if (uc->opts.ignore_geometry) return 1;
+
+	size_t num_colors = uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_COLOR];
+	if (num_vertices > num_colors) {
+		size_t num_pad = num_vertices - num_colors;
+		ufbxi_check(ufbxi_push_zero(&uc->obj.tmp_vertices[UFBXI_OBJ_ATTRIB_COLOR], ufbx_real, num_pad * 4));
+		ufbxi_check(ufbxi_push_zero(&uc->obj.tmp_color_valid, bool, num_pad));
+		uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_COLOR] += num_pad;
+	}
+
+	return 1;
+}
+
+// Total size of the geometry buffered for `ufbx_load_opts.obj_stream_cb`.
+static ufbxi_noinline size_t ufbxi_obj_stream_size(ufbxi_context *uc)
+{
+	size_t size = 0;
+	ufbxi_nounroll for (size_t i = 0; i < UFBXI_OBJ_NUM_ATTRIBS_EXT; i++) {
+		size += uc->obj.tmp_vertices[i].num_items * sizeof(ufbx_real);
+		size += uc->obj.tmp_indices[i].num_items * sizeof(uint64_t);
+	}
+	size += uc->obj.tmp_faces.num_items * (sizeof(ufbx_face) + sizeof(uint32_t) * 2 + sizeof(bool) * 2);
+	return size;
+}
+
+// Emit the buffered geometry to `ufbx_load_opts.obj_stream_cb` and clear the buffers.
+// All buffered faces belong to `uc->obj.mesh` as a batch is emitted before switching meshes.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_stream_batch(ufbxi_context *uc)
+{
+	ufbxi_buf *stream = &uc->obj.tmp_stream;
+
+	// Keep the colors aligned with positions across batches
+	if (uc->obj.has_vertex_color) {
+		ufbxi_check(ufbxi_obj_pad_colors(uc, uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_POSITION]));
+	}
+
+	ufbx_real_list vertices[UFBXI_OBJ_NUM_ATTRIBS_EXT];
+	size_t num_values = 0;
+	ufbxi_nounroll for (size_t i = 0; i < UFBXI_OBJ_NUM_ATTRIBS_EXT; i++) {
+		size_t count = uc->obj.tmp_vertices[i].num_items;
+		vertices[i].data = ufbxi_push_pop(stream, &uc->obj.tmp_vertices[i], ufbx_real, count);
+		vertices[i].count = count / ufbxi_obj_attrib_stride[i];
+		ufbxi_check(vertices[i].data);
+		num_values += count;
+	}
+	ufbxi_pop(&uc->obj.tmp_color_valid, bool, uc->obj.tmp_color_valid.num_items, NULL);
+
+	ufbx_obj_batch batch;
+	memset(&batch, 0, sizeof(batch));
+	batch.positions.data = (ufbx_vec3*)vertices[UFBXI_OBJ_ATTRIB_POSITION].data;
+	batch.positions.count = vertices[UFBXI_OBJ_ATTRIB_POSITION].count;
+	batch.uvs.data = (ufbx_vec2*)vertices[UFBXI_OBJ_ATTRIB_UV].data;
+	batch.uvs.count = vertices[UFBXI_OBJ_ATTRIB_UV].count;
+	batch.normals.data = (ufbx_vec3*)vertices[UFBXI_OBJ_ATTRIB_NORMAL].data;
+	batch.normals.count = vertices[UFBXI_OBJ_ATTRIB_NORMAL].count;
+	batch.colors.data = (ufbx_vec4*)vertices[UFBXI_OBJ_ATTRIB_COLOR].data;
+	batch.colors.count = vertices[UFBXI_OBJ_ATTRIB_COLOR].count;
+	batch.first_position = uc->obj.stream_first[UFBXI_OBJ_ATTRIB_POSITION];
+	batch.first_uv = uc->obj.stream_first[UFBXI_OBJ_ATTRIB_UV];
+	batch.first_normal = uc->obj.stream_first[UFBXI_OBJ_ATTRIB_NORMAL];
+	batch.first_color = uc->obj.stream_first[UFBXI_OBJ_ATTRIB_COLOR];
+	ufbxi_nounroll for (size_t i = 0; i < UFBXI_OBJ_NUM_ATTRIBS_EXT; i++) {
+		uc->obj.stream_first[i] += vertices[i].count;
+	}
+
+	size_t num_faces = uc->obj.tmp_faces.num_items;
+	batch.faces.data = ufbxi_push_pop(stream, &uc->obj.tmp_faces, ufbx_face, num_faces);
+	batch.faces.count = num_faces;
+	batch.face_material.data = ufbxi_push_pop(stream, &uc->obj.tmp_face_material, uint32_t, num_faces);
+	batch.face_material.count = num_faces;
+	ufbxi_check(batch.faces.data && batch.face_material.data);
+
+	if (uc->obj.has_face_smoothing) {
+		batch.face_smoothing.data = ufbxi_push_pop(stream, &uc->obj.tmp_face_smoothing, bool, num_faces);
+		batch.face_smoothing.count = num_faces;
+		ufbxi_check(batch.face_smoothing.data);
+	}
+	if (uc->obj.has_face_group) {
+		batch.face_group.data = ufbxi_push_pop(stream, &uc->obj.tmp_face_group, uint32_t, num_faces);
+		batch.face_group.count = num_faces;
+		ufbxi_check(batch.face_group.data);
+	}
+
+	ufbx_uint32_list *dst_indices[UFBXI_OBJ_NUM_ATTRIBS] = { &batch.position_indices, &batch.uv_indices, &batch.normal_indices };
+	ufbxi_nounroll for (size_t i = 0; i < UFBXI_OBJ_NUM_ATTRIBS; i++) {
+		// Pop unused fast indices, the next index pushes a new block
+		ufbxi_pop(&uc->obj.tmp_indices[i], uint64_t, uc->obj.fast_indices[i].num_left, NULL);
+		uc->obj.fast_indices[i].num_left = 0;
+
+		size_t num_indices = uc->obj.tmp_indices[i].num_items;
+		uint64_t *src = ufbxi_push_pop(stream, &uc->obj.tmp_indices[i], uint64_t, num_indices);
+		uint32_t *dst = ufbxi_push(stream, uint32_t, num_indices);
+		ufbxi_check(src && dst);
+		for (size_t ix = 0; ix < num_indices; ix++) {
+			uint64_t index = src[ix];
+			ufbxi_check(index == UINT64_MAX || index < UINT32_MAX);
+			dst[ix] = index != UINT64_MAX ? (uint32_t)index : UFBX_NO_INDEX;
+		}
+		dst_indices[i]->data = dst;
+		dst_indices[i]->count = num_indices;
+	}
+
+	// Face indices are relative to the batch as the mesh restarts from zero
+	ufbxi_obj_mesh *mesh = uc->obj.mesh;
+	if (mesh) {
+		batch.mesh_element_id = mesh->fbx_mesh->element_id;
+		batch.mesh_name = mesh->fbx_mesh->name;
+		mesh->num_faces = 0;
+		mesh->num_indices = 0;
+		ufbxi_nounroll for (size_t i = 0; i < UFBXI_OBJ_NUM_ATTRIBS; i++) {
+			mesh->vertex_range[i].min_ix = UINT64_MAX;
+			mesh->vertex_range[i].max_ix = 0;
+		}
+	} else {
+		batch.mesh_element_id = UFBX_NO_INDEX;
+		batch.mesh_name = ufbx_empty_string;
+	}
+
+	if (num_values > 0 || num_faces > 0) {
+		bool ok = uc->opts.obj_stream_cb.fn(uc->opts.obj_stream_cb.user, &batch);
+		ufbxi_check_msg(ok, "Cancelled");
+	}
+
+	ufbxi_buf_clear(stream);
+	return 1;
+}
+
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_index(ufbxi_context *uc, ufbx_string *s, uint32_t attrib)
 {
 	const char *ptr = s->data, *end = ptr + s->length;
@@ -14522,6 +16690,9 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_indices(ufbxi_context
 	}
 
 	if (!uc->obj.mesh || flush_mesh) {
+		if (uc->opts.obj_stream_cb.fn && uc->obj.mesh) {
+			ufbxi_check(ufbxi_obj_stream_batch(uc));
+		}
 		ufbxi_check(ufbxi_obj_flush_mesh(uc));
 		ufbxi_check(ufbxi_obj_push_mesh(uc));
 	}
@@ -14666,7 +16837,8 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_comment(ufbxi_context
 
 		// Pop standard vertex colors and replace them with MRGB colors
 		if (num_color > uc->obj.mrgb_vertex_count) {
-			size_t num_pop = num_color - uc->obj.mrgb_vertex_count;
+			// Streamed colors may have been emitted already
+			size_t num_pop = ufbxi_min_sz(num_color - uc->obj.mrgb_vertex_count, uc->obj.tmp_color_valid.num_items);
 			ufbxi_pop(&uc->obj.tmp_color_valid, bool, num_pop, NULL);
 			ufbxi_pop(&uc->obj.tmp_vertices[UFBXI_OBJ_ATTRIB_COLOR], ufbx_real, num_pop * 4, NULL);
 			uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_COLOR] -= num_pop;
@@ -14811,67 +16983,315 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_setup_attrib(ufbxi_context *
 	return 1;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_pad_colors(ufbxi_context *uc, size_t num_vertices)
+static ufbxi_forceinline bool ufbxi_obj_is_blank(char c)
 {
-	if (uc->opts.ignore_geometry) return 1;
+	return c == ' ' || c == '\t' || c == '\r';
+}
 
-	size_t num_colors = uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_COLOR];
-	if (num_vertices > num_colors) {
-		size_t num_pad = num_vertices - num_colors;
-		ufbxi_check(ufbxi_push_zero(&uc->obj.tmp_vertices[UFBXI_OBJ_ATTRIB_COLOR], ufbx_real, num_pad * 4));
-		ufbxi_check(ufbxi_push_zero(&uc->obj.tmp_color_valid, bool, num_pad));
-		uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_COLOR] += num_pad;
+// Count the tokens of a line like `ufbxi_obj_tokenize()` ignoring line continuations.
+static ufbxi_noinline size_t ufbxi_obj_count_line_tokens(const char *p)
+{
+	size_t num_tokens = 0;
+	for (;;) {
+		char c = *p;
+		while (ufbxi_obj_is_blank(c)) c = *++p;
+		if (c == '\n' || (c == '#' && num_tokens > 0)) break;
+		num_tokens++;
+		while (!ufbxi_is_space(*++p)) { }
 	}
-
-	return 1;
+	return num_tokens;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_pop_meshes(ufbxi_context *uc)
+// Parse `v`, `vt` or `vn` lines in `[src, end)` with the values of `attrib` written to `dst`
+// and vertex colors to `dst_color` if not `NULL`. Mirrors `ufbxi_obj_tokenize()` and
+// `ufbxi_obj_parse_vertex()`, returns the number of lines parsed or -1 if any line needs
+// to be handled by the serial parser (line continuations, errors, mixed vertex colors).
+static ufbxi_noinline ptrdiff_t ufbxi_obj_parse_vertex_chunk(const char *src, const char *end, ufbxi_obj_attrib attrib, ufbx_real *dst, ufbx_real *dst_color)
 {
-	size_t num_meshes = uc->obj.tmp_meshes.num_items;
-	ufbxi_obj_mesh *meshes = ufbxi_push_pop(&uc->tmp, &uc->obj.tmp_meshes, ufbxi_obj_mesh, num_meshes);
-	ufbxi_check(meshes);
+	size_t cmd_len = attrib == UFBXI_OBJ_ATTRIB_POSITION ? 1 : 2;
+	size_t stride = ufbxi_obj_attrib_stride[attrib];
+	size_t max_values = dst_color ? 7 : stride;
+
+	size_t num_lines = 0;
+	const char *p = src;
+	while (p != end) {
+		ufbx_real vals[7];
+		size_t num_tokens = 1;
+		p += cmd_len;
+		for (;;) {
+			char c = *p;
+			while (ufbxi_obj_is_blank(c)) c = *++p;
+			if (c == '\n' || c == '#') break;
+			if (c == '\\') return -1;
 
-	if (uc->obj.has_vertex_color) {
-		ufbxi_check(ufbxi_obj_pad_colors(uc, uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_POSITION]));
-	}
+			const char *token = p;
+			for (;;) {
+				c = *++p;
+				if (ufbxi_is_space(c)) break;
+				if (c == '\\') return -1;
+			}
 
-	// Pop unused fast indices
-	for (size_t i = 0; i < UFBXI_OBJ_NUM_ATTRIBS; i++) {
-		ufbxi_pop(&uc->obj.tmp_indices[i], uint64_t, uc->obj.fast_indices[i].num_left, NULL);
-	}
+			if (num_tokens <= max_values) {
+				char *num_end;
+				double val = ufbxi_parse_double(token, ufbxi_to_size(p - token), &num_end, false);
+				if (num_end != p) return -1;
+				vals[num_tokens - 1] = (ufbx_real)val;
+			}
+			num_tokens++;
+		}
 
-	// Check if the file has disjoint vertices
-	bool non_disjoint[UFBXI_OBJ_NUM_ATTRIBS] = { 0 };
-	uint64_t next_min[UFBXI_OBJ_NUM_ATTRIBS] = { 0 };
-	ufbx_real_list vertices[UFBXI_OBJ_NUM_ATTRIBS_EXT] = { 0 };
-	bool *color_valid = NULL;
+		// Skip a trailing comment
+		while (*p != '\n') p++;
+		p++;
 
-	size_t max_indices = 0;
+		if (num_tokens < 1 + stride) return -1;
+		if (attrib == UFBXI_OBJ_ATTRIB_POSITION && (num_tokens >= 7) != (dst_color != NULL)) return -1;
 
-	for (size_t i = 0; i < num_meshes; i++) {
-		ufbxi_obj_mesh *mesh = &meshes[i];
-		max_indices = ufbxi_max_sz(max_indices, mesh->num_indices);
-		ufbxi_nounroll for (uint32_t attrib = 0; attrib < UFBXI_OBJ_NUM_ATTRIBS; attrib++) {
-			ufbxi_obj_index_range range = mesh->vertex_range[attrib];
-			if (range.min_ix > range.max_ix) continue;
-			if (range.min_ix < next_min[attrib]) {
-				non_disjoint[attrib] = true;
-			}
-			next_min[attrib] = range.max_ix + 1;
+		ufbx_real *d = dst + num_lines * stride;
+		for (size_t i = 0; i < stride; i++) {
+			d[i] = vals[i];
 		}
+		if (dst_color) {
+			ufbx_real *c = dst_color + num_lines * 4;
+			c[0] = vals[3];
+			c[1] = vals[4];
+			c[2] = vals[5];
+			c[3] = num_tokens >= 8 ? vals[6] : 1.0f;
+		}
+
+		num_lines++;
 	}
 
-	uint64_t *tmp_indices = ufbxi_push(&uc->tmp, uint64_t, max_indices);
-	ufbxi_check(tmp_indices);
+	return (ptrdiff_t)num_lines;
+}
 
-	ufbxi_nounroll for (uint32_t attrib = 0; attrib < UFBXI_OBJ_NUM_ATTRIBS; attrib++) {
-		if (!non_disjoint[attrib]) continue;
-		ufbxi_check(ufbxi_obj_pop_vertices(uc, &vertices[attrib], attrib, 0));
+typedef struct {
+	ufbxi_obj_vertex_chunk *chunks;
+	size_t num_chunks;
+	uint32_t num_tasks;
+	ufbxi_obj_attrib attrib;
+} ufbxi_obj_vertex_tasks;
+
+static void ufbxi_obj_vertex_task(void *user, uint32_t index)
+{
+	ufbxi_obj_vertex_tasks *tasks = (ufbxi_obj_vertex_tasks*)user;
+	for (size_t i = index; i < tasks->num_chunks; i += tasks->num_tasks) {
+		ufbxi_obj_vertex_chunk *chunk = &tasks->chunks[i];
+		chunk->result = ufbxi_obj_parse_vertex_chunk(chunk->begin, chunk->end, tasks->attrib, chunk->dst, chunk->dst_color);
 	}
-	if (uc->obj.has_vertex_color && non_disjoint[UFBXI_OBJ_ATTRIB_POSITION]) {
-		ufbxi_check(ufbxi_obj_pop_vertices(uc, &vertices[UFBXI_OBJ_ATTRIB_COLOR], UFBXI_OBJ_ATTRIB_COLOR, 0));
-		color_valid = ufbxi_push_pop(&uc->tmp, &uc->obj.tmp_color_valid, bool, vertices[UFBXI_OBJ_ATTRIB_COLOR].count / 4);
+}
+
+// Parse a run of consecutive `v`, `vt` or `vn` lines in parallel using `ufbx_load_opts.thread_opts`.
+// The buffered lines are split into newline-aligned chunks and as every line has a fixed number of
+// values the line counts determine where each chunk writes its values. Other commands are always
+// parsed serially, so negative indices and object/group/material state resolve as usual. Runs that
+// the chunk parser rejects are left for the serial parser without retrying for `serial_vertex_lines`.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_try_parse_vertex_run(ufbxi_context *uc, bool *p_parsed)
+{
+	*p_parsed = false;
+	if (uc->obj.serial_vertex_lines > 0) {
+		uc->obj.serial_vertex_lines--;
+		return 1;
+	}
+
+	const char *begin = uc->data, *data_end = uc->data + uc->data_size;
+	const char *line_end = (const char*)memchr(begin, '\n', uc->data_size);
+	if (!line_end) return 1;
+
+	ufbxi_obj_attrib attrib;
+	size_t cmd_len = 2;
+	if (ufbxi_obj_is_blank(begin[1])) {
+		attrib = UFBXI_OBJ_ATTRIB_POSITION;
+		cmd_len = 1;
+	} else if (begin[1] == 't' && ufbxi_obj_is_blank(begin[2])) {
+		attrib = UFBXI_OBJ_ATTRIB_UV;
+	} else if (begin[1] == 'n' && ufbxi_obj_is_blank(begin[2])) {
+		attrib = UFBXI_OBJ_ATTRIB_NORMAL;
+	} else {
+		return 1;
+	}
+
+	// Vertex colors are parsed in the run only if every line has them, see `ufbxi_obj_parse_file()`
+	bool colors = attrib == UFBXI_OBJ_ATTRIB_POSITION && ufbxi_obj_count_line_tokens(begin) >= 7;
+	if (colors && uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_COLOR] > uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_POSITION]) return 1;
+
+	// When streaming, limit the run to the values that fit in `ufbx_load_opts.obj_stream_memory_limit`
+	// so `ufbxi_obj_parse_file()` can emit the batch right after it like after any serial line.
+	size_t max_lines = SIZE_MAX;
+	if (uc->opts.obj_stream_cb.fn) {
+		size_t stream_size = ufbxi_obj_stream_size(uc);
+		size_t line_size = ufbxi_obj_attrib_stride[attrib] * sizeof(ufbx_real);
+		if (colors) {
+			stream_size += (uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_POSITION] - uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_COLOR]) * 4 * sizeof(ufbx_real);
+			line_size += 4 * sizeof(ufbx_real);
+		}
+		size_t stream_limit = uc->opts.obj_stream_memory_limit;
+		max_lines = stream_size < stream_limit ? ufbxi_max_sz((stream_limit - stream_size) / line_size, 1) : 1;
+	}
+
+	// Split the run into chunks, the text in a single batch is bounded by `memory_limit`
+	size_t memory_limit = uc->opts.thread_opts.memory_limit;
+	size_t num_chunks = 0, num_lines = 0, chunk_lines = 0;
+	const char *chunk_begin = begin, *line = begin;
+	for (;;) {
+		line = line_end + 1;
+		chunk_lines++;
+
+		const char *next_end = NULL;
+		if (line != data_end && ufbxi_to_size(line - begin) < memory_limit && num_lines + chunk_lines < max_lines) {
+			next_end = (const char*)memchr(line, '\n', ufbxi_to_size(data_end - line));
+			if (next_end && !(line[0] == 'v' && (cmd_len == 1 || line[1] == begin[1]) && ufbxi_obj_is_blank(line[cmd_len]))) {
+				next_end = NULL;
+			}
+		}
+
+		if (!next_end || ufbxi_to_size(line - chunk_begin) >= UFBXI_OBJ_VERTEX_CHUNK_SIZE) {
+			ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->obj.vertex_chunks, &uc->obj.vertex_chunks_cap, num_chunks + 1));
+			ufbxi_obj_vertex_chunk *chunk = &uc->obj.vertex_chunks[num_chunks++];
+			chunk->begin = chunk_begin;
+			chunk->end = line;
+			chunk->num_lines = chunk_lines;
+			chunk->result = -1;
+			num_lines += chunk_lines;
+			chunk_lines = 0;
+			chunk_begin = line;
+		}
+
+		if (!next_end) break;
+		line_end = next_end;
+	}
+
+	size_t size = ufbxi_to_size(line - begin);
+	if (size < UFBXI_MIN_THREADED_OBJ_VERTEX_BYTES) {
+		uc->obj.serial_vertex_lines = num_lines - 1;
+		return 1;
+	}
+
+	size_t stride = ufbxi_obj_attrib_stride[attrib];
+	ufbx_real *dst = ufbxi_push(&uc->obj.tmp_vertices[attrib], ufbx_real, num_lines * stride);
+	ufbxi_check(dst);
+
+	ufbx_real *dst_color = NULL;
+	if (colors) {
+		ufbxi_check(ufbxi_obj_pad_colors(uc, uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_POSITION]));
+		dst_color = ufbxi_push(&uc->obj.tmp_vertices[UFBXI_OBJ_ATTRIB_COLOR], ufbx_real, num_lines * 4);
+		bool *valid = ufbxi_push(&uc->obj.tmp_color_valid, bool, num_lines);
+		ufbxi_check(dst_color && valid);
+		ufbxi_for(bool, v, valid, num_lines) {
+			*v = true;
+		}
+	}
+
+	size_t line_ix = 0;
+	ufbxi_for(ufbxi_obj_vertex_chunk, chunk, uc->obj.vertex_chunks, num_chunks) {
+		chunk->dst = dst + line_ix * stride;
+		chunk->dst_color = dst_color ? dst_color + line_ix * 4 : NULL;
+		line_ix += chunk->num_lines;
+	}
+
+	ufbxi_stats_timer stats_begin = ufbxi_stats_begin(uc);
+
+	ufbxi_obj_vertex_tasks tasks;
+	tasks.chunks = uc->obj.vertex_chunks;
+	tasks.num_chunks = num_chunks;
+	tasks.attrib = attrib;
+
+	if (num_chunks > 1) {
+		tasks.num_tasks = (uint32_t)ufbxi_min_sz(num_chunks, uc->opts.thread_opts.num_tasks);
+		ufbx_thread_pool *pool = &uc->opts.thread_opts.pool;
+		ufbxi_read_ahead_yield_pool(&uc->read_ahead, pool);
+		pool->run_fn(pool->user, &ufbxi_obj_vertex_task, &tasks, tasks.num_tasks);
+		pool->wait_fn(pool->user);
+	} else {
+		tasks.num_tasks = 1;
+		ufbxi_obj_vertex_task(&tasks, 0);
+	}
+
+	ufbxi_stats_end(uc, ascii_number, stats_begin);
+
+	bool ok = true;
+	ufbxi_for(ufbxi_obj_vertex_chunk, chunk, uc->obj.vertex_chunks, num_chunks) {
+		if (chunk->result != (ptrdiff_t)chunk->num_lines) ok = false;
+	}
+
+	if (!ok) {
+		ufbxi_pop(&uc->obj.tmp_vertices[attrib], ufbx_real, num_lines * stride, NULL);
+		if (colors) {
+			ufbxi_pop(&uc->obj.tmp_vertices[UFBXI_OBJ_ATTRIB_COLOR], ufbx_real, num_lines * 4, NULL);
+			ufbxi_pop(&uc->obj.tmp_color_valid, bool, num_lines, NULL);
+		}
+		uc->obj.serial_vertex_lines = num_lines - 1;
+		return 1;
+	}
+
+	uc->obj.vertex_count[attrib] += num_lines;
+	if (colors) {
+		uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_COLOR] += num_lines;
+		uc->obj.has_vertex_color = true;
+	}
+
+	uc->data += size;
+	uc->data_size -= size;
+
+	uc->obj.read_progress += size;
+	if (uc->obj.read_progress >= uc->progress_interval) {
+		ufbxi_check(ufbxi_report_progress(uc));
+		uc->obj.read_progress %= uc->progress_interval;
+	}
+
+	*p_parsed = true;
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_pop_meshes(ufbxi_context *uc)
+{
+	size_t num_meshes = uc->obj.tmp_meshes.num_items;
+	ufbxi_obj_mesh *meshes = ufbxi_push_pop(&uc->tmp, &uc->obj.tmp_meshes, ufbxi_obj_mesh, num_meshes);
+	ufbxi_check(meshes);
+
+	// Streamed geometry has already been emitted, see `ufbxi_obj_stream_batch()`
+	bool has_geometry = !uc->opts.ignore_geometry && !uc->opts.obj_stream_cb.fn;
+
+	if (uc->obj.has_vertex_color && has_geometry) {
+		ufbxi_check(ufbxi_obj_pad_colors(uc, uc->obj.vertex_count[UFBXI_OBJ_ATTRIB_POSITION]));
+	}
+
+	// Pop unused fast indices
+	for (size_t i = 0; i < UFBXI_OBJ_NUM_ATTRIBS; i++) {
+		ufbxi_pop(&uc->obj.tmp_indices[i], uint64_t, uc->obj.fast_indices[i].num_left, NULL);
+	}
+
+	// Check if the file has disjoint vertices
+	bool non_disjoint[UFBXI_OBJ_NUM_ATTRIBS] = { 0 };
+	uint64_t next_min[UFBXI_OBJ_NUM_ATTRIBS] = { 0 };
+	ufbx_real_list vertices[UFBXI_OBJ_NUM_ATTRIBS_EXT] = { 0 };
+	bool *color_valid = NULL;
+
+	size_t max_indices = 0;
+
+	for (size_t i = 0; i < num_meshes; i++) {
+		ufbxi_obj_mesh *mesh = &meshes[i];
+		max_indices = ufbxi_max_sz(max_indices, mesh->num_indices);
+		ufbxi_nounroll for (uint32_t attrib = 0; attrib < UFBXI_OBJ_NUM_ATTRIBS; attrib++) {
+			ufbxi_obj_index_range range = mesh->vertex_range[attrib];
+			if (range.min_ix > range.max_ix) continue;
+			if (range.min_ix < next_min[attrib]) {
+				non_disjoint[attrib] = true;
+			}
+			next_min[attrib] = range.max_ix + 1;
+		}
+	}
+
+	uint64_t *tmp_indices = ufbxi_push(&uc->tmp, uint64_t, max_indices);
+	ufbxi_check(tmp_indices);
+
+	ufbxi_nounroll for (uint32_t attrib = 0; attrib < UFBXI_OBJ_NUM_ATTRIBS; attrib++) {
+		if (!non_disjoint[attrib]) continue;
+		ufbxi_check(ufbxi_obj_pop_vertices(uc, &vertices[attrib], attrib, 0));
+	}
+	if (uc->obj.has_vertex_color && non_disjoint[UFBXI_OBJ_ATTRIB_POSITION]) {
+		ufbxi_check(ufbxi_obj_pop_vertices(uc, &vertices[UFBXI_OBJ_ATTRIB_COLOR], UFBXI_OBJ_ATTRIB_COLOR, 0));
+		color_valid = ufbxi_push_pop(&uc->tmp, &uc->obj.tmp_color_valid, bool, vertices[UFBXI_OBJ_ATTRIB_COLOR].count / 4);
 		ufbxi_check(color_valid);
 	}
 
@@ -14882,7 +17302,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_pop_meshes(ufbxi_context *uc
 
 		size_t num_faces = mesh->num_faces;
 
-		if (!uc->opts.ignore_geometry) {
+		if (has_geometry) {
 			ufbxi_nounroll for (uint32_t attrib = 0; attrib < UFBXI_OBJ_NUM_ATTRIBS; attrib++) {
 				if (non_disjoint[attrib]) continue;
 				uint64_t min_ix = mesh->vertex_range[attrib].min_ix;
@@ -14999,6 +17419,17 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_pop_meshes(ufbxi_context *uc
 ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_file(ufbxi_context *uc)
 {
 	while (!uc->obj.eof) {
+		if (uc->obj.parallel_vertices && uc->data_size > 0 && uc->data[0] == 'v') {
+			bool parsed = false;
+			ufbxi_check(ufbxi_obj_try_parse_vertex_run(uc, &parsed));
+			if (parsed) {
+				if (uc->opts.obj_stream_cb.fn && ufbxi_obj_stream_size(uc) >= uc->opts.obj_stream_memory_limit) {
+					ufbxi_check(ufbxi_obj_stream_batch(uc));
+				}
+				continue;
+			}
+		}
+
 		ufbxi_check(ufbxi_obj_tokenize_line(uc));
 		size_t num_tokens = uc->obj.num_tokens;
 		if (num_tokens == 0) continue;
@@ -15068,8 +17499,15 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_obj_parse_file(ufbxi_context *uc
 		} else {
 			ufbxi_check(ufbxi_warnf(UFBX_WARNING_UNKNOWN_OBJ_DIRECTIVE, "Unknown .obj directive, skipped line"));
 		}
+
+		if (uc->opts.obj_stream_cb.fn && ufbxi_obj_stream_size(uc) >= uc->opts.obj_stream_memory_limit) {
+			ufbxi_check(ufbxi_obj_stream_batch(uc));
+		}
 	}
 
+	if (uc->opts.obj_stream_cb.fn) {
+		ufbxi_check(ufbxi_obj_stream_batch(uc));
+	}
 	ufbxi_check(ufbxi_obj_flush_mesh(uc));
 	ufbxi_check(ufbxi_obj_pop_meshes(uc));
 
@@ -15518,9 +17956,9 @@ ufbxi_forceinline static bool ufbxi_cmp_prop_less_concat(const ufbx_prop *a, con
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_sort_name_elements(ufbxi_context *uc, ufbx_name_element *name_elems, size_t count)
 {
-	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, count * sizeof(ufbx_name_element)));
-	ufbxi_macro_stable_sort(ufbx_name_element, 32, name_elems, uc->tmp_arr, count,
-		( ufbxi_cmp_name_element_less(a, b) ) );
+	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, ufbxi_radix_sort_tmp_size(ufbx_name_element, count)));
+	ufbxi_macro_radix_sort(ufbx_name_element, 32, name_elems, uc->tmp_arr, count,
+		( a->_internal_key ), ( ufbxi_cmp_name_element_less(a, b) ) );
 	return 1;
 }
 
@@ -15540,11 +17978,18 @@ ufbxi_noinline static bool ufbxi_cmp_node_less(ufbx_node *a, ufbx_node *b)
 	return a->element.element_id < b->element.element_id;
 }
 
+// Sort key for `ufbxi_cmp_node_less()`: depth and parent, siblings are sorted by comparison.
+static ufbxi_forceinline uint64_t ufbxi_node_sort_key(const ufbx_node *node)
+{
+	uint32_t parent_id = node->parent ? node->parent->element.element_id : 0;
+	return (uint64_t)node->node_depth << 32u | parent_id;
+}
+
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_sort_node_ptrs(ufbxi_context *uc, ufbx_node **nodes, size_t count)
 {
-	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, count * sizeof(ufbx_node*)));
-	ufbxi_macro_stable_sort(ufbx_node*, 32, nodes, uc->tmp_arr, count,
-		( ufbxi_cmp_node_less(*a, *b) ) );
+	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, ufbxi_radix_sort_tmp_size(ufbx_node*, count)));
+	ufbxi_macro_radix_sort(ufbx_node*, 32, nodes, uc->tmp_arr, count,
+		( ufbxi_node_sort_key(*a) ), ( ufbxi_cmp_node_less(*a, *b) ) );
 	return 1;
 }
 
@@ -15557,8 +18002,9 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_cmp_tmp_material_texture_less(co
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_sort_tmp_material_textures(ufbxi_context *uc, ufbxi_tmp_material_texture *mat_texs, size_t count)
 {
-	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, count * sizeof(ufbxi_tmp_material_texture)));
-	ufbxi_macro_stable_sort(ufbxi_tmp_material_texture, 32, mat_texs, uc->tmp_arr, count,
+	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, ufbxi_radix_sort_tmp_size(ufbxi_tmp_material_texture, count)));
+	ufbxi_macro_radix_sort(ufbxi_tmp_material_texture, 32, mat_texs, uc->tmp_arr, count,
+		( (uint64_t)((uint32_t)a->material_id ^ 0x80000000u) << 32u | ((uint32_t)a->texture_id ^ 0x80000000u) ),
 		( ufbxi_cmp_tmp_material_texture_less(a, b) ));
 	return 1;
 }
@@ -15578,14 +18024,15 @@ ufbxi_forceinline static bool ufbxi_cmp_connection_less(ufbx_connection *a, ufbx
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_sort_connections(ufbxi_context *uc, ufbx_connection *connections, size_t count, size_t index)
 {
-	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, count * sizeof(ufbx_connection)));
-	ufbxi_macro_stable_sort(ufbx_connection, 32, connections, uc->tmp_arr, count, ( ufbxi_cmp_connection_less(a, b, index) ));
+	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, ufbxi_radix_sort_tmp_size(ufbx_connection, count)));
+	ufbxi_macro_radix_sort(ufbx_connection, 32, connections, uc->tmp_arr, count,
+		( (uintptr_t)(&a->src)[index] ), ( ufbxi_cmp_connection_less(a, b, index) ));
 	return 1;
 }
 
 static uint64_t ufbxi_find_attribute_fbx_id(ufbxi_context *uc, uint64_t node_fbx_id)
 {
-	uint32_t hash = ufbxi_hash64(node_fbx_id);
+	uint32_t hash = ufbxi_hash64(node_fbx_id ^ uc->fbx_attr_map.seed);
 	ufbxi_fbx_attr_entry *entry = ufbxi_map_find(&uc->fbx_attr_map, ufbxi_fbx_attr_entry, hash, &node_fbx_id);
 	if (entry) {
 		return entry->attr_fbx_id;
@@ -16153,8 +18600,9 @@ ufbxi_nodiscard static bool ufbxi_cmp_anim_prop_less(const ufbx_anim_prop *a, co
 
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_sort_anim_props(ufbxi_context *uc, ufbx_anim_prop *aprops, size_t count)
 {
-	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, count * sizeof(ufbx_anim_prop)));
-	ufbxi_macro_stable_sort(ufbx_anim_prop, 32, aprops, uc->tmp_arr, count, ( ufbxi_cmp_anim_prop_less(a, b) ));
+	ufbxi_check(ufbxi_grow_array(&uc->ator_tmp, &uc->tmp_arr, &uc->tmp_arr_size, ufbxi_radix_sort_tmp_size(ufbx_anim_prop, count)));
+	ufbxi_macro_radix_sort(ufbx_anim_prop, 32, aprops, uc->tmp_arr, count,
+		( (uintptr_t)a->element ), ( ufbxi_cmp_anim_prop_less(a, b) ));
 	return 1;
 }
 
@@ -18093,6 +20541,93 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_finalize_mesh_material(ufbxi_buf
 	return 1;
 }
 
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_push_index_buffers(ufbxi_context *uc)
+{
+	// Generate procedural index buffers
+	uint32_t *zero_indices = ufbxi_push(&uc->result, uint32_t, uc->max_zero_indices);
+	uint32_t *consecutive_indices = ufbxi_push(&uc->result, uint32_t, uc->max_consecutive_indices);
+	ufbxi_check(zero_indices && consecutive_indices);
+
+	memset(zero_indices, 0, sizeof(uint32_t) * uc->max_zero_indices);
+	for (size_t i = 0; i < uc->max_consecutive_indices; i++) {
+		consecutive_indices[i] = (uint32_t)i;
+	}
+
+	uc->zero_indices = zero_indices;
+	uc->consecutive_indices = consecutive_indices;
+
+	return 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_mesh_data(ufbxi_context *uc, ufbx_mesh *mesh)
+{
+	ufbxi_patch_index_pointer(uc, &mesh->vertex_position.indices.data);
+	ufbxi_patch_index_pointer(uc, &mesh->vertex_normal.indices.data);
+	ufbxi_patch_index_pointer(uc, &mesh->vertex_bitangent.indices.data);
+	ufbxi_patch_index_pointer(uc, &mesh->vertex_tangent.indices.data);
+	ufbxi_patch_index_pointer(uc, &mesh->face_material.data);
+	ufbxi_patch_index_pointer(uc, &mesh->face_group.data);
+
+	ufbxi_patch_index_pointer(uc, &mesh->skinned_position.indices.data);
+	ufbxi_patch_index_pointer(uc, &mesh->skinned_normal.indices.data);
+
+	ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
+		ufbxi_patch_index_pointer(uc, &set->vertex_uv.indices.data);
+		ufbxi_patch_index_pointer(uc, &set->vertex_bitangent.indices.data);
+		ufbxi_patch_index_pointer(uc, &set->vertex_tangent.indices.data);
+	}
+
+	ufbxi_for_list(ufbx_color_set, set, mesh->color_sets) {
+		ufbxi_patch_index_pointer(uc, &set->vertex_color.indices.data);
+	}
+
+	// Generate normals if necessary
+	if (!mesh->vertex_normal.exists && uc->opts.generate_missing_normals) {
+		ufbxi_check(ufbxi_generate_normals(uc, mesh));
+	}
+
+	// Assign first UV and color sets as the "canonical" ones
+	if (mesh->uv_sets.count > 0) {
+		mesh->vertex_uv = mesh->uv_sets.data[0].vertex_uv;
+		mesh->vertex_bitangent = mesh->uv_sets.data[0].vertex_bitangent;
+		mesh->vertex_tangent = mesh->uv_sets.data[0].vertex_tangent;
+	}
+	if (mesh->color_sets.count > 0) {
+		mesh->vertex_color = mesh->color_sets.data[0].vertex_color;
+	}
+
+	if (mesh->face_groups.count == 1) {
+		ufbxi_patch_index_pointer(uc, &mesh->face_groups.data[0].face_indices.data);
+	}
+
+	return 1;
+}
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_assign_mesh_material_faces(ufbxi_context *uc, ufbx_mesh *mesh)
+{
+	if (mesh->materials.count == 1) {
+		// Use the shared consecutive index buffer for mesh faces if there's only one material
+		// See HACK(consecutive-faces) in `ufbxi_read_mesh()`.
+		ufbx_mesh_material *mat = &mesh->materials.data[0];
+		mat->num_faces = mesh->num_faces;
+		mat->num_triangles = mesh->num_triangles;
+		mat->num_empty_faces = mesh->num_empty_faces;
+		mat->num_point_faces = mesh->num_point_faces;
+		mat->num_line_faces = mesh->num_line_faces;
+		mat->face_indices.data = uc->consecutive_indices;
+		mat->face_indices.count = mat->num_faces;
+		mesh->face_material.data = uc->zero_indices;
+		mesh->face_material.count = mesh->num_faces;
+	} else if (mesh->materials.count > 0 && mesh->face_material.count) {
+		ufbxi_check(ufbxi_finalize_mesh_material(&uc->result, &uc->error, mesh));
+	} else {
+		mesh->face_material.data = NULL;
+		mesh->face_material.count = 0;
+	}
+
+	return 1;
+}
+
 ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc)
 {
 	size_t num_elements = uc->num_elements;
@@ -18426,60 +20961,12 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 	ufbxi_buf_free(&uc->tmp_full_weights);
 
 	{
-		// Generate and patch procedural index buffers
-		uint32_t *zero_indices = ufbxi_push(&uc->result, uint32_t, uc->max_zero_indices);
-		uint32_t *consecutive_indices = ufbxi_push(&uc->result, uint32_t, uc->max_consecutive_indices);
-		ufbxi_check(zero_indices && consecutive_indices);
-
-		memset(zero_indices, 0, sizeof(uint32_t) * uc->max_zero_indices);
-		for (size_t i = 0; i < uc->max_consecutive_indices; i++) {
-			consecutive_indices[i] = (uint32_t)i;
-		}
-
-		uc->zero_indices = zero_indices;
-		uc->consecutive_indices = consecutive_indices;
+		ufbxi_check(ufbxi_push_index_buffers(uc));
 
 		ufbxi_for_ptr_list(ufbx_mesh, p_mesh, uc->scene.meshes) {
 			ufbx_mesh *mesh = *p_mesh;
 
-			ufbxi_patch_index_pointer(uc, &mesh->vertex_position.indices.data);
-			ufbxi_patch_index_pointer(uc, &mesh->vertex_normal.indices.data);
-			ufbxi_patch_index_pointer(uc, &mesh->vertex_bitangent.indices.data);
-			ufbxi_patch_index_pointer(uc, &mesh->vertex_tangent.indices.data);
-			ufbxi_patch_index_pointer(uc, &mesh->face_material.data);
-			ufbxi_patch_index_pointer(uc, &mesh->face_group.data);
-
-			ufbxi_patch_index_pointer(uc, &mesh->skinned_position.indices.data);
-			ufbxi_patch_index_pointer(uc, &mesh->skinned_normal.indices.data);
-
-			ufbxi_for_list(ufbx_uv_set, set, mesh->uv_sets) {
-				ufbxi_patch_index_pointer(uc, &set->vertex_uv.indices.data);
-				ufbxi_patch_index_pointer(uc, &set->vertex_bitangent.indices.data);
-				ufbxi_patch_index_pointer(uc, &set->vertex_tangent.indices.data);
-			}
-
-			ufbxi_for_list(ufbx_color_set, set, mesh->color_sets) {
-				ufbxi_patch_index_pointer(uc, &set->vertex_color.indices.data);
-			}
-
-			// Generate normals if necessary
-			if (!mesh->vertex_normal.exists && uc->opts.generate_missing_normals) {
-				ufbxi_check(ufbxi_generate_normals(uc, mesh));
-			}
-
-			// Assign first UV and color sets as the "canonical" ones
-			if (mesh->uv_sets.count > 0) {
-				mesh->vertex_uv = mesh->uv_sets.data[0].vertex_uv;
-				mesh->vertex_bitangent = mesh->uv_sets.data[0].vertex_bitangent;
-				mesh->vertex_tangent = mesh->uv_sets.data[0].vertex_tangent;
-			}
-			if (mesh->color_sets.count > 0) {
-				mesh->vertex_color = mesh->color_sets.data[0].vertex_color;
-			}
-
-			if (mesh->face_groups.count == 1) {
-				ufbxi_patch_index_pointer(uc, &mesh->face_groups.data[0].face_indices.data);
-			}
+			ufbxi_check(ufbxi_finalize_mesh_data(uc, mesh));
 
 			ufbxi_check(ufbxi_fetch_mesh_materials(uc, &mesh->materials, &mesh->element, true));
 
@@ -18509,25 +20996,7 @@ ufbxi_nodiscard ufbxi_noinline static int ufbxi_finalize_scene(ufbxi_context *uc
 				mesh->materials.count = 1;
 			}
 
-			if (mesh->materials.count == 1) {
-				// Use the shared consecutive index buffer for mesh faces if there's only one material
-				// See HACK(consecutive-faces) in `ufbxi_read_mesh()`.
-				ufbx_mesh_material *mat = &mesh->materials.data[0];
-				mat->num_faces = mesh->num_faces;
-				mat->num_triangles = mesh->num_triangles;
-				mat->num_empty_faces = mesh->num_empty_faces;
-				mat->num_point_faces = mesh->num_point_faces;
-				mat->num_line_faces = mesh->num_line_faces;
-				mat->face_indices.data = uc->consecutive_indices;
-				mat->face_indices.count = mat->num_faces;
-				mesh->face_material.data = uc->zero_indices;
-				mesh->face_material.count = mesh->num_faces;
-			} else if (mesh->materials.count > 0 && mesh->face_material.count) {
-				ufbxi_check(ufbxi_finalize_mesh_material(&uc->result, &uc->error, mesh));
-			} else {
-				mesh->face_material.data = NULL;
-				mesh->face_material.count = 0;
-			}
+			ufbxi_check(ufbxi_assign_mesh_material_faces(uc, mesh));
 
 			// Fetch deformers
 			ufbxi_check(ufbxi_fetch_dst_elements(uc, &mesh->skin_deformers, &mesh->element, search_node, NULL, UFBX_ELEMENT_SKIN_DEFORMER));
@@ -20183,6 +22652,8 @@ typedef struct {
 	ufbx_geometry_cache cache;
 	ufbxi_geometry_cache_imp *imp;
 
+	ufbxi_read_ahead read_ahead;
+
 	char buffer[128];
 } ufbxi_cache_context;
 
@@ -20597,12 +23068,13 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_cache_try_open_file(ufbxi_cache_
 		return 1;
 	}
 
+	ufbxi_read_ahead_init(&cc->read_ahead, &cc->stream, &cc->opts.read_ahead, 0x4000, cc->ator_tmp, &cc->cache.io_stats);
+
 	int ok = ufbxi_cache_load_file(cc, filename);
 	*p_found = true;
 
-	if (cc->stream.close_fn) {
-		cc->stream.close_fn(cc->stream.user);
-	}
+	ufbxi_read_ahead_free(&cc->read_ahead);
+	cc->stream.close_fn(cc->stream.user);
 
 	return ok;
 }
@@ -20972,6 +23444,7 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_external_cache(ufbxi_contex
 
 	cc.open_file_cb = uc->opts.open_file_cb;
 	cc.frames_per_second = uc->scene.settings.frames_per_second;
+	cc.opts.read_ahead = uc->opts.read_ahead;
 
 	// Temporarily "borrow" allocators for the geometry cache
 	cc.ator_tmp = &uc->ator_tmp;
@@ -21001,6 +23474,13 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_external_cache(ufbxi_contex
 	}
 
 	file->data = cache;
+
+	ufbx_io_stats *stats = &uc->io_stats;
+	stats->bytes_read += cache->io_stats.bytes_read;
+	stats->num_reads += cache->io_stats.num_reads;
+	stats->num_waits += cache->io_stats.num_waits;
+	stats->wait_time += cache->io_stats.wait_time;
+
 	return 1;
 #else
 	if (uc->opts.ignore_missing_external_files) return 1;
@@ -21230,13 +23710,9 @@ static ufbxi_noinline int ufbxi_scale_units(ufbxi_context *uc, ufbx_real target_
 
 // -- Curve evaluation
 
-static ufbxi_forceinline double ufbxi_find_cubic_bezier_t(double p1, double p2, double x0)
+// Solve `t` for `a*t^3 + b*t^2 + c*t = x0`, see `ufbxi_find_cubic_bezier_t()`
+static ufbxi_forceinline double ufbxi_solve_cubic_bezier_t(double a, double b, double c, double x0)
 {
-	double p1_3 = p1 * 3.0, p2_3 = p2 * 3.0;
-	double a = p1_3 - p2_3 + 1.0;
-	double b = p2_3 - p1_3 - p1_3;
-	double c = p1_3;
-
 	double a_3 = 3.0*a, b_2 = 2.0*b;
 	double t = x0;
 	double x1, t2, t3;
@@ -21271,76 +23747,448 @@ static ufbxi_forceinline double ufbxi_find_cubic_bezier_t(double p1, double p2,
 	return t;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *scene, ufbx_error *error, ufbxi_buf *buf_result, ufbxi_buf *buf_tmp,
-	double time, bool load_caches, ufbx_geometry_cache_data_opts *cache_opts)
+static ufbxi_forceinline void ufbxi_cubic_bezier_coefficients(double *coeffs, double p1, double p2)
 {
-#if UFBXI_FEATURE_SKINNING_EVALUATION
-	size_t max_skinned_indices = 0;
+	double p1_3 = p1 * 3.0, p2_3 = p2 * 3.0;
+	coeffs[0] = p1_3 - p2_3 + 1.0;
+	coeffs[1] = p2_3 - p1_3 - p1_3;
+	coeffs[2] = p1_3;
+}
 
-	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
-		ufbx_mesh *mesh = *p_mesh;
-		if (mesh->blend_deformers.count == 0 && mesh->skin_deformers.count == 0 && (mesh->cache_deformers.count == 0 || !load_caches)) continue;
-		max_skinned_indices = ufbxi_max_sz(max_skinned_indices, mesh->num_indices);
+static ufbxi_forceinline double ufbxi_find_cubic_bezier_t(double p1, double p2, double x0)
+{
+	double coeffs[3];
+	ufbxi_cubic_bezier_coefficients(coeffs, p1, p2);
+	return ufbxi_solve_cubic_bezier_t(coeffs[0], coeffs[1], coeffs[2], x0);
+}
+
+// Find the index of the first time after `time` in `[begin, end)` or `end` if there is none.
+// `times` are spaced `stride` doubles apart to support both `ufbx_keyframe` and `double` arrays.
+static ufbxi_forceinline size_t ufbxi_find_next_time(const double *times, size_t stride, size_t begin, size_t end, double time)
+{
+	while (end - begin >= 8) {
+		size_t mid = (begin + end) >> 1;
+		if (times[mid * stride] <= time) {
+			begin = mid + 1;
+		} else {
+			end = mid;
+		}
 	}
 
-	ufbx_topo_edge *topo = ufbxi_push(buf_tmp, ufbx_topo_edge, max_skinned_indices);
-	ufbxi_check_err(error, topo);
+	while (begin < end && times[begin * stride] <= time) {
+		begin++;
+	}
+	return begin;
+}
 
-	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
-		ufbx_mesh *mesh = *p_mesh;
-		if (mesh->blend_deformers.count == 0 && mesh->skin_deformers.count == 0 && (mesh->cache_deformers.count == 0 || !load_caches)) continue;
-		if (mesh->num_vertices == 0) continue;
+ufbx_static_assert(keyframe_time_stride, sizeof(ufbx_keyframe) % sizeof(double) == 0);
+#define ufbxi_keyframe_time_stride (sizeof(ufbx_keyframe) / sizeof(double))
 
-		size_t num_vertices = mesh->num_vertices;
-		ufbx_vec3 *result_pos = ufbxi_push(buf_result, ufbx_vec3, num_vertices + 1);
-		ufbxi_check_err(error, result_pos);
+static ufbxi_noinline void ufbxi_compile_curve_segment(ufbx_curve_segment *segment, const ufbx_keyframe *prev, const ufbx_keyframe *next, double tolerance)
+{
+	double rcp_delta = 1.0 / (next->time - prev->time);
+	double y0 = prev->value, y3 = next->value;
 
-		result_pos[0] = ufbx_zero_vec3;
-		result_pos++;
+	memset(segment, 0, sizeof(ufbx_curve_segment));
+	segment->type = UFBX_CURVE_SEGMENT_POLYNOMIAL;
 
-		bool cached_position = false, cached_normals = false;
-		if (load_caches && mesh->cache_deformers.count > 0) {
-			ufbxi_for_ptr_list(ufbx_cache_deformer, p_cache, mesh->cache_deformers) {
-				ufbx_cache_channel *channel = (*p_cache)->external_channel;
-				if (!channel) continue;
+	switch (prev->interpolation) {
 
-				if ((channel->interpretation == UFBX_CACHE_INTERPRETATION_VERTEX_POSITION || channel->interpretation == UFBX_CACHE_INTERPRETATION_POINTS) && !cached_position) {
-					size_t num_read = ufbx_sample_geometry_cache_vec3(channel, time, result_pos, num_vertices, cache_opts);
-					if (num_read == num_vertices) {
-						mesh->skinned_is_local = true;
-						cached_position = true;
-					}
-				} else if (channel->interpretation == UFBX_CACHE_INTERPRETATION_VERTEX_NORMAL && !cached_normals) {
-					// TODO: Is this right at all?
-					size_t num_normals = mesh->skinned_normal.values.count;
-					ufbx_vec3 *normal_data = ufbxi_push(buf_result, ufbx_vec3, num_normals + 1);
-					ufbxi_check_err(error, normal_data);
-					normal_data[0] = ufbx_zero_vec3;
-					normal_data++;
+	case UFBX_INTERPOLATION_CONSTANT_PREV:
+		break;
 
-					size_t num_read = ufbx_sample_geometry_cache_vec3(channel, time, normal_data, num_normals, cache_opts);
-					if (num_read == num_normals) {
-						cached_normals = true;
-						mesh->skinned_normal.values.data = normal_data;
-					} else {
-						ufbxi_pop(buf_result, ufbx_vec3, num_normals + 1, NULL);
-					}
-				}
-			}
-		}
+	case UFBX_INTERPOLATION_CONSTANT_NEXT:
+		segment->type = UFBX_CURVE_SEGMENT_STEP;
+		break;
 
-		if (!cached_position) {
-			memcpy(result_pos, mesh->vertices.data, num_vertices * sizeof(ufbx_vec3));
+	case UFBX_INTERPOLATION_LINEAR:
+		segment->coeffs[0] = (ufbx_real)(y3 - y0);
+		break;
 
-			ufbxi_for_ptr_list(ufbx_blend_deformer, p_blend, mesh->blend_deformers) {
-				ufbx_add_blend_vertex_offsets(*p_blend, result_pos, num_vertices, 1.0f);
-			}
+	case UFBX_INTERPOLATION_CUBIC:
+	{
+		double x1 = prev->right.dx * rcp_delta;
+		double x2 = 1.0 - next->left.dx * rcp_delta;
+		double y1 = y0 + prev->right.dy;
+		double y2 = y3 - next->left.dy;
+
+		// Convert the Bernstein form to a power basis
+		segment->coeffs[0] = (ufbx_real)(3.0 * (y1 - y0));
+		segment->coeffs[1] = (ufbx_real)(3.0 * (y0 - 2.0*y1 + y2));
+		segment->coeffs[2] = (ufbx_real)(y3 - y0 + 3.0 * (y1 - y2));
+
+		// Tangents spaced evenly in time result in `x(s) = s`, no need to solve `s` then
+		double bx[3];
+		ufbxi_cubic_bezier_coefficients(bx, x1, x2);
+		if (!(ufbx_fabs(bx[0]) + ufbx_fabs(bx[1]) + ufbx_fabs(bx[2] - 1.0) <= tolerance)) {
+			segment->type = UFBX_CURVE_SEGMENT_BEZIER;
+			segment->bezier_x[0] = (float)bx[0];
+			segment->bezier_x[1] = (float)bx[1];
+			segment->bezier_x[2] = (float)bx[2];
+		}
+	} break;
 
-			// TODO: What should we do about multiple skins??
-			if (mesh->skin_deformers.count > 0) {
-				ufbx_matrix *fallback = mesh->instances.count > 0 ? &mesh->instances.data[0]->geometry_to_world : NULL;
-				ufbx_skin_deformer *skin = mesh->skin_deformers.data[0];
-				for (size_t i = 0; i < num_vertices; i++) {
+	default:
+		ufbx_assert(0 && "Bad interpolation mode");
+		break;
+
+	}
+}
+
+// Evaluate `segment` between keyframes with values `y0` and `y1` starting at `time_begin`,
+// `rcp_delta` is the reciprocal of the duration of the segment.
+static ufbxi_forceinline ufbx_real ufbxi_evaluate_curve_segment(const ufbx_curve_segment *segment, double time_begin, double rcp_delta, ufbx_real y0, ufbx_real y1, double time)
+{
+	const ufbx_real *c = segment->coeffs;
+	double t = (time - time_begin) * rcp_delta;
+
+	switch (segment->type) {
+
+	case UFBX_CURVE_SEGMENT_POLYNOMIAL:
+		break;
+
+	case UFBX_CURVE_SEGMENT_BEZIER:
+		// Exact keyframe, avoids dividing by a zero derivative
+		if (time == time_begin) return y0;
+		t = ufbxi_solve_cubic_bezier_t((double)segment->bezier_x[0], (double)segment->bezier_x[1], (double)segment->bezier_x[2], t);
+		break;
+
+	case UFBX_CURVE_SEGMENT_STEP:
+		return time == time_begin ? y0 : y1;
+
+	default:
+		ufbx_assert(0 && "Bad segment type");
+		return 0.0f;
+
+	}
+
+	return (ufbx_real)((((double)c[2]*t + (double)c[1])*t + (double)c[0])*t + (double)y0);
+}
+
+// Set up the segment containing `time` to `cursor`, the cached segment is used as a
+// hint as the time has usually advanced to one of the next few keyframes.
+static ufbxi_noinline void ufbxi_curve_cursor_seek(ufbx_curve_cursor *cursor, double time)
+{
+	const ufbx_anim_curve *curve = cursor->curve;
+	const ufbx_keyframe *keys = curve->keyframes.data;
+	size_t num_keys = curve->keyframes.count;
+
+	const double *times = &keys[0].time;
+	size_t stride = ufbxi_keyframe_time_stride;
+	bool compiled = curve->segments.count > 0;
+	ufbx_assert(!compiled || curve->segments.count + 1 == num_keys);
+
+	size_t begin = 0, end = num_keys;
+	size_t index = cursor->_index;
+	if (index < num_keys && times[index * stride] <= time) {
+		begin = index + 1;
+		size_t scan_end = ufbxi_min_sz(begin + 4, num_keys);
+		while (begin < scan_end && times[begin * stride] <= time) {
+			begin++;
+		}
+		if (begin < scan_end) end = begin;
+	} else if (index > 0 && index <= num_keys && !(times[(index - 1) * stride] <= time)) {
+		end = index - 1;
+	}
+	index = ufbxi_find_next_time(times, stride, begin, end, time);
+	cursor->_index = index;
+	cursor->_segment = NULL;
+
+	// Hold the first and last values outside of the keyframes
+	if (index == 0 || index == num_keys) {
+		cursor->_time_begin = index == 0 ? -UFBX_INFINITY : keys[num_keys - 1].time;
+		cursor->_time_end = index == 0 ? keys[0].time : UFBX_INFINITY;
+		cursor->_interpolation = UFBX_INTERPOLATION_CONSTANT_PREV;
+		cursor->_bezier_y[0] = keys[index == 0 ? 0 : num_keys - 1].value;
+		return;
+	}
+
+	const ufbx_keyframe *next = &keys[index];
+	const ufbx_keyframe *prev = next - 1;
+	cursor->_time_begin = prev->time;
+	cursor->_time_end = next->time;
+
+	double rcp_delta = 1.0 / (next->time - prev->time);
+	cursor->_rcp_delta = rcp_delta;
+	cursor->_bezier_y[0] = prev->value;
+	cursor->_bezier_y[3] = next->value;
+
+	if (compiled) {
+		cursor->_segment = &curve->segments.data[index - 1];
+		return;
+	}
+	cursor->_interpolation = prev->interpolation;
+
+	if (prev->interpolation == UFBX_INTERPOLATION_CUBIC) {
+		double x1 = prev->right.dx * rcp_delta;
+		double x2 = 1.0 - next->left.dx * rcp_delta;
+		ufbxi_cubic_bezier_coefficients(cursor->_bezier_x, x1, x2);
+		cursor->_bezier_y[1] = cursor->_bezier_y[0] + prev->right.dy;
+		cursor->_bezier_y[2] = cursor->_bezier_y[3] - next->left.dy;
+	}
+}
+
+// Evaluate the segment cached in `cursor`, `time` must be within the segment.
+static ufbxi_forceinline ufbx_real ufbxi_evaluate_curve_cursor_at(const ufbx_curve_cursor *cursor, double time)
+{
+	if (cursor->_segment) {
+		const double *y = cursor->_bezier_y;
+		return ufbxi_evaluate_curve_segment(cursor->_segment, cursor->_time_begin, cursor->_rcp_delta, (ufbx_real)y[0], (ufbx_real)y[3], time);
+	}
+
+	// Exact keyframe
+	const double *y = cursor->_bezier_y;
+	if (time == cursor->_time_begin) return (ufbx_real)y[0];
+
+	double t = (time - cursor->_time_begin) * cursor->_rcp_delta;
+
+	switch (cursor->_interpolation) {
+
+	case UFBX_INTERPOLATION_CONSTANT_PREV:
+		return (ufbx_real)y[0];
+
+	case UFBX_INTERPOLATION_CONSTANT_NEXT:
+		return (ufbx_real)y[3];
+
+	case UFBX_INTERPOLATION_LINEAR:
+		return (ufbx_real)(y[0]*(1.0 - t) + y[3]*t);
+
+	case UFBX_INTERPOLATION_CUBIC:
+	{
+		const double *x = cursor->_bezier_x;
+		t = ufbxi_solve_cubic_bezier_t(x[0], x[1], x[2], t);
+
+		double t2 = t*t, t3 = t2*t;
+		double u = 1.0 - t, u2 = u*u, u3 = u2*u;
+
+		return (ufbx_real)(u3*y[0] + 3.0 * (u2*t*y[1] + u*t2*y[2]) + t3*y[3]);
+	}
+
+	default:
+		ufbx_assert(0 && "Bad interpolation mode");
+		return 0.0f;
+
+	}
+}
+
+// Compilers may contract the scalar evaluation into FMA instructions if they are available,
+// in which case the SSE2 version would not match `ufbx_evaluate_curve()` exactly anymore.
+#if UFBXI_HAS_SSE && !defined(__FMA__) && !defined(__AVX2__)
+	#define UFBXI_HAS_SSE_CURVE_EVAL 1
+#else
+	#define UFBXI_HAS_SSE_CURVE_EVAL 0
+#endif
+
+#if UFBXI_HAS_SSE_CURVE_EVAL
+
+// One Newton-Rhapson iteration of `ufbxi_solve_cubic_bezier_t()` for two samples
+#define ufbxi_sse_bezier_newton_step(t, x1, x0) do { \
+		__m128d mi_t2 = _mm_mul_pd(t, t), mi_t3 = _mm_mul_pd(mi_t2, t); \
+		x1 = _mm_sub_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(a, mi_t3), _mm_mul_pd(b, mi_t2)), _mm_mul_pd(c, t)), x0); \
+		t = _mm_sub_pd(t, _mm_div_pd(x1, _mm_add_pd(_mm_add_pd(_mm_mul_pd(a_3, mi_t2), _mm_mul_pd(b_2, t)), c))); \
+	} while (0)
+
+// Evaluate four samples of the cubic segment in `cursor`. Performs exactly the same
+// operations as `ufbxi_evaluate_curve_cursor_at()` so the results are identical.
+static ufbxi_noinline void ufbxi_evaluate_cubic_sse(const ufbx_curve_cursor *cursor, const double *times, ufbx_real *values, size_t stride)
+{
+	const __m128d a = _mm_set1_pd(cursor->_bezier_x[0]);
+	const __m128d b = _mm_set1_pd(cursor->_bezier_x[1]);
+	const __m128d c = _mm_set1_pd(cursor->_bezier_x[2]);
+	const __m128d a_3 = _mm_mul_pd(_mm_set1_pd(3.0), a);
+	const __m128d b_2 = _mm_mul_pd(_mm_set1_pd(2.0), b);
+	const __m128d sign = _mm_set1_pd(-0.0);
+	const __m128d eps = _mm_set1_pd(8.881784197001252e-16);
+	const __m128d begin = _mm_set1_pd(cursor->_time_begin);
+	const __m128d rcp_delta = _mm_set1_pd(cursor->_rcp_delta);
+
+	__m128d time_lo = _mm_loadu_pd(times + 0);
+	__m128d time_hi = _mm_loadu_pd(times + 2);
+	__m128d x0_lo = _mm_mul_pd(_mm_sub_pd(time_lo, begin), rcp_delta);
+	__m128d x0_hi = _mm_mul_pd(_mm_sub_pd(time_hi, begin), rcp_delta);
+
+	__m128d t_lo = x0_lo, t_hi = x0_hi, x1_lo, x1_hi;
+	ufbxi_sse_bezier_newton_step(t_lo, x1_lo, x0_lo);
+	ufbxi_sse_bezier_newton_step(t_hi, x1_hi, x0_hi);
+	ufbxi_sse_bezier_newton_step(t_lo, x1_lo, x0_lo);
+	ufbxi_sse_bezier_newton_step(t_hi, x1_hi, x0_hi);
+	ufbxi_sse_bezier_newton_step(t_lo, x1_lo, x0_lo);
+	ufbxi_sse_bezier_newton_step(t_hi, x1_hi, x0_hi);
+
+	// Keep iterating the samples that have not converged yet, freezing the
+	// converged ones as the scalar version returns early.
+	__m128d done_lo = _mm_cmple_pd(_mm_andnot_pd(sign, x1_lo), eps);
+	__m128d done_hi = _mm_cmple_pd(_mm_andnot_pd(sign, x1_hi), eps);
+	for (size_t i = 0; i < 4; i++) {
+		if (_mm_movemask_pd(_mm_and_pd(done_lo, done_hi)) == 3) break;
+
+		__m128d next_lo = t_lo, next_hi = t_hi;
+		ufbxi_sse_bezier_newton_step(next_lo, x1_lo, x0_lo);
+		ufbxi_sse_bezier_newton_step(next_hi, x1_hi, x0_hi);
+		ufbxi_sse_bezier_newton_step(next_lo, x1_lo, x0_lo);
+		ufbxi_sse_bezier_newton_step(next_hi, x1_hi, x0_hi);
+
+		t_lo = _mm_or_pd(_mm_and_pd(done_lo, t_lo), _mm_andnot_pd(done_lo, next_lo));
+		t_hi = _mm_or_pd(_mm_and_pd(done_hi, t_hi), _mm_andnot_pd(done_hi, next_hi));
+		done_lo = _mm_or_pd(done_lo, _mm_cmple_pd(_mm_andnot_pd(sign, x1_lo), eps));
+		done_hi = _mm_or_pd(done_hi, _mm_cmple_pd(_mm_andnot_pd(sign, x1_hi), eps));
+	}
+
+	const __m128d one = _mm_set1_pd(1.0);
+	const __m128d three = _mm_set1_pd(3.0);
+	const __m128d y0 = _mm_set1_pd(cursor->_bezier_y[0]);
+	const __m128d y1 = _mm_set1_pd(cursor->_bezier_y[1]);
+	const __m128d y2 = _mm_set1_pd(cursor->_bezier_y[2]);
+	const __m128d y3 = _mm_set1_pd(cursor->_bezier_y[3]);
+
+	double result[4];
+	for (size_t i = 0; i < 2; i++) {
+		__m128d t = i == 0 ? t_lo : t_hi;
+		__m128d time = i == 0 ? time_lo : time_hi;
+
+		__m128d t2 = _mm_mul_pd(t, t), t3 = _mm_mul_pd(t2, t);
+		__m128d u = _mm_sub_pd(one, t), u2 = _mm_mul_pd(u, u), u3 = _mm_mul_pd(u2, u);
+
+		__m128d mid = _mm_add_pd(_mm_mul_pd(_mm_mul_pd(u2, t), y1), _mm_mul_pd(_mm_mul_pd(u, t2), y2));
+		__m128d res = _mm_add_pd(_mm_add_pd(_mm_mul_pd(u3, y0), _mm_mul_pd(three, mid)), _mm_mul_pd(t3, y3));
+
+		// Exact keyframe
+		__m128d exact = _mm_cmpeq_pd(time, begin);
+		res = _mm_or_pd(_mm_and_pd(exact, y0), _mm_andnot_pd(exact, res));
+		_mm_storeu_pd(result + i * 2, res);
+	}
+
+	values[0 * stride] = (ufbx_real)result[0];
+	values[1 * stride] = (ufbx_real)result[1];
+	values[2 * stride] = (ufbx_real)result[2];
+	values[3 * stride] = (ufbx_real)result[3];
+}
+
+#undef ufbxi_sse_bezier_newton_step
+
+#endif
+
+// Evaluate `curve` at `times` walking the keyframes once if `times` is sorted.
+static ufbxi_noinline void ufbxi_evaluate_curve_batch(const ufbx_anim_curve *curve, const double *times, size_t count, ufbx_real *values, size_t stride, ufbx_real default_value)
+{
+	if (!curve || curve->keyframes.count <= 1) {
+		ufbx_real value = default_value;
+		if (curve && curve->keyframes.count == 1) value = curve->keyframes.data[0].value;
+		for (size_t i = 0; i < count; i++) {
+			values[i * stride] = value;
+		}
+		return;
+	}
+
+	ufbx_curve_cursor cursor;
+	memset(&cursor, 0, sizeof(cursor));
+	cursor.curve = curve;
+
+	size_t begin = 0;
+	while (begin < count) {
+		ufbxi_curve_cursor_seek(&cursor, times[begin]);
+
+		// Find the run of samples within the segment
+		size_t end = begin + 1;
+		while (end < count && times[end] >= cursor._time_begin && times[end] < cursor._time_end) {
+			end++;
+		}
+
+		size_t ix = begin;
+#if UFBXI_HAS_SSE_CURVE_EVAL
+		if (!cursor._segment && cursor._interpolation == UFBX_INTERPOLATION_CUBIC) {
+			for (; end - ix >= 4; ix += 4) {
+				ufbxi_evaluate_cubic_sse(&cursor, times + ix, values + ix * stride, stride);
+			}
+		}
+#endif
+		for (; ix < end; ix++) {
+			values[ix * stride] = ufbxi_evaluate_curve_cursor_at(&cursor, times[ix]);
+		}
+
+		begin = end;
+	}
+}
+
+static ufbxi_noinline void ufbxi_evaluate_anim_value_batch(const ufbx_anim_value *anim_value, const double *times, size_t count, ufbx_real *values, size_t num_components)
+{
+	for (size_t i = 0; i < num_components; i++) {
+		const ufbx_anim_curve *curve = anim_value ? anim_value->curves[i] : NULL;
+		ufbx_real default_value = anim_value ? anim_value->default_value.v[i] : 0.0f;
+		ufbxi_evaluate_curve_batch(curve, times, count, values + i, num_components, default_value);
+	}
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_skinning(ufbx_scene *scene, ufbx_error *error, ufbxi_buf *buf_result, ufbxi_buf *buf_tmp,
+	double time, bool load_caches, ufbx_geometry_cache_data_opts *cache_opts)
+{
+#if UFBXI_FEATURE_SKINNING_EVALUATION
+	size_t max_skinned_indices = 0;
+
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
+		ufbx_mesh *mesh = *p_mesh;
+		if (mesh->blend_deformers.count == 0 && mesh->skin_deformers.count == 0 && (mesh->cache_deformers.count == 0 || !load_caches)) continue;
+		max_skinned_indices = ufbxi_max_sz(max_skinned_indices, mesh->num_indices);
+	}
+
+	ufbx_topo_edge *topo = ufbxi_push(buf_tmp, ufbx_topo_edge, max_skinned_indices);
+	ufbxi_check_err(error, topo);
+
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
+		ufbx_mesh *mesh = *p_mesh;
+		if (mesh->blend_deformers.count == 0 && mesh->skin_deformers.count == 0 && (mesh->cache_deformers.count == 0 || !load_caches)) continue;
+		if (mesh->num_vertices == 0) continue;
+
+		size_t num_vertices = mesh->num_vertices;
+		ufbx_vec3 *result_pos = ufbxi_push(buf_result, ufbx_vec3, num_vertices + 1);
+		ufbxi_check_err(error, result_pos);
+
+		result_pos[0] = ufbx_zero_vec3;
+		result_pos++;
+
+		bool cached_position = false, cached_normals = false;
+		if (load_caches && mesh->cache_deformers.count > 0) {
+			ufbxi_for_ptr_list(ufbx_cache_deformer, p_cache, mesh->cache_deformers) {
+				ufbx_cache_channel *channel = (*p_cache)->external_channel;
+				if (!channel) continue;
+
+				if ((channel->interpretation == UFBX_CACHE_INTERPRETATION_VERTEX_POSITION || channel->interpretation == UFBX_CACHE_INTERPRETATION_POINTS) && !cached_position) {
+					size_t num_read = ufbx_sample_geometry_cache_vec3(channel, time, result_pos, num_vertices, cache_opts);
+					if (num_read == num_vertices) {
+						mesh->skinned_is_local = true;
+						cached_position = true;
+					}
+				} else if (channel->interpretation == UFBX_CACHE_INTERPRETATION_VERTEX_NORMAL && !cached_normals) {
+					// TODO: Is this right at all?
+					size_t num_normals = mesh->skinned_normal.values.count;
+					ufbx_vec3 *normal_data = ufbxi_push(buf_result, ufbx_vec3, num_normals + 1);
+					ufbxi_check_err(error, normal_data);
+					normal_data[0] = ufbx_zero_vec3;
+					normal_data++;
+
+					size_t num_read = ufbx_sample_geometry_cache_vec3(channel, time, normal_data, num_normals, cache_opts);
+					if (num_read == num_normals) {
+						cached_normals = true;
+						mesh->skinned_normal.values.data = normal_data;
+					} else {
+						ufbxi_pop(buf_result, ufbx_vec3, num_normals + 1, NULL);
+					}
+				}
+			}
+		}
+
+		if (!cached_position) {
+			memcpy(result_pos, mesh->vertices.data, num_vertices * sizeof(ufbx_vec3));
+
+			ufbxi_for_ptr_list(ufbx_blend_deformer, p_blend, mesh->blend_deformers) {
+				ufbx_add_blend_vertex_offsets(*p_blend, result_pos, num_vertices, 1.0f);
+			}
+
+			// TODO: What should we do about multiple skins??
+			if (mesh->skin_deformers.count > 0) {
+				ufbx_matrix *fallback = mesh->instances.count > 0 ? &mesh->instances.data[0]->geometry_to_world : NULL;
+				ufbx_skin_deformer *skin = mesh->skin_deformers.data[0];
+				for (size_t i = 0; i < num_vertices; i++) {
 					ufbx_matrix mat = ufbx_get_skin_vertex_matrix(skin, i, fallback);
 					result_pos[i] = ufbx_transform_position(&mat, result_pos[i]);
 				}
@@ -21405,12 +24253,50 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_fixup_opts_string(ufbxi_context
 	return 1;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
+// Gather the file ranges of lazy meshes from `ufbxi_mesh_extra` to a table indexed by `typed_id`
+static ufbxi_noinline ufbxi_lazy_range *ufbxi_collect_lazy_ranges(ufbxi_context *uc)
+{
+	size_t num_meshes = uc->scene.meshes.count;
+	ufbxi_lazy_range *ranges = ufbxi_push_zero(&uc->result, ufbxi_lazy_range, ufbxi_max_sz(num_meshes, 1));
+	ufbxi_check_return(ranges, NULL);
+
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, uc->scene.meshes) {
+		ufbx_mesh *mesh = *p_mesh;
+		if (!mesh->lazy_geometry) continue;
+		ufbxi_mesh_extra *extra = (ufbxi_mesh_extra*)ufbxi_get_element_extra(uc, mesh->element.element_id);
+		ufbx_assert(extra);
+		if (extra) {
+			ranges[mesh->element.typed_id] = extra->lazy_range;
+		}
+	}
+
+	return ranges;
+}
+
+static ufbxi_noinline void ufbxi_setup_lazy_geometry(ufbxi_context *uc)
+{
+	if (!uc->opts.lazy_geometry) return;
+
+	// Lazy meshes are re-parsed from the original data so it must be fully in memory.
+	// Pre-7200 files may contain blend shapes within mesh geometry and we need the full
+	// geometry during loading if it's modified in post-processing.
+	if (uc->read_fn || uc->data_offset != 0) return;
+	if (uc->from_ascii || uc->version < 7200) return;
+	if (uc->opts.ignore_geometry || uc->opts.retain_dom) return;
+	if (uc->opts.normalize_normals || uc->opts.normalize_tangents) return;
+	if (uc->opts.geometry_transform_handling == UFBX_GEOMETRY_TRANSFORM_HANDLING_MODIFY_GEOMETRY) return;
+	if (uc->opts.geometry_transform_handling == UFBX_GEOMETRY_TRANSFORM_HANDLING_MODIFY_GEOMETRY_NO_FALLBACK) return;
+
+	uc->lazy_geometry = true;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_header(ufbxi_context *uc)
 {
 	// `ufbx_load_opts` must be cleared to zero first!
 	ufbx_assert(uc->opts._begin_zero == 0 && uc->opts._end_zero == 0);
 	ufbxi_check_msg(uc->opts._begin_zero == 0 && uc->opts._end_zero == 0, "Uninitialized options");
 	ufbxi_check(uc->opts.path_separator >= 0x20 && uc->opts.path_separator <= 0x7e);
+	ufbxi_check(!uc->opts.thread_opts.pool.run_fn || uc->opts.thread_opts.pool.wait_fn);
 
 	ufbxi_check(ufbxi_fixup_opts_string(uc, &uc->opts.filename, false));
 	ufbxi_check(ufbxi_fixup_opts_string(uc, &uc->opts.obj_mtl_path, true));
@@ -21435,26 +24321,49 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 
 	uc->unit_scale = 1.0f;
 
-	ufbxi_check(ufbxi_load_strings(uc));
-	ufbxi_check(ufbxi_load_maps(uc));
+	ufbxi_stats_timer stats_begin = ufbxi_stats_begin(uc);
+	ufbxi_check(ufbxi_load_tables(uc));
 	ufbxi_check(ufbxi_determine_format(uc));
+	ufbxi_stats_end(uc, detect_format, stats_begin);
 
 	ufbx_file_format format = uc->scene.metadata.file_format;
 
+	// Modern FBX files are parsed incrementally in `UFBX_LOAD_PHASE_OBJECTS`,
+	// other formats are parsed in one go here.
+	stats_begin = ufbxi_stats_begin(uc);
 	if (format == UFBX_FILE_FORMAT_FBX) {
 		ufbxi_check(ufbxi_begin_parse(uc));
+		ufbxi_setup_lazy_geometry(uc);
 		if (uc->version < 6000) {
 			ufbxi_check(ufbxi_read_legacy_root(uc));
 		} else {
-			ufbxi_check(ufbxi_read_root(uc));
+			ufbxi_check(ufbxi_read_root_begin(uc));
+			ufbxi_stats_end(uc, parse, stats_begin);
+			uc->load_phase = UFBX_LOAD_PHASE_OBJECTS;
+			return 1;
 		}
-		ufbxi_update_scene_metadata(&uc->scene.metadata);
-		ufbxi_check(ufbxi_init_file_paths(uc));
 	} else if (format == UFBX_FILE_FORMAT_OBJ) {
 		ufbxi_check(ufbxi_obj_load(uc));
-		ufbxi_update_scene_metadata(&uc->scene.metadata);
 	} else if (format == UFBX_FILE_FORMAT_MTL) {
 		ufbxi_check(ufbxi_mtl_load(uc));
+	}
+	ufbxi_stats_end(uc, parse, stats_begin);
+
+	uc->load_phase = UFBX_LOAD_PHASE_CONNECTIONS;
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_connections(ufbxi_context *uc)
+{
+	ufbx_file_format format = uc->scene.metadata.file_format;
+
+	if (format == UFBX_FILE_FORMAT_FBX) {
+		if (uc->version >= 6000) {
+			ufbxi_check(ufbxi_read_root_end(uc));
+		}
+		ufbxi_update_scene_metadata(&uc->scene.metadata);
+		ufbxi_check(ufbxi_init_file_paths(uc));
+	} else {
 		ufbxi_update_scene_metadata(&uc->scene.metadata);
 	}
 
@@ -21466,13 +24375,55 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 		uc->scene.dom_root = dom_root;
 	}
 
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_finalize(ufbxi_context *uc)
+{
+	ufbxi_stats_timer stats_begin = ufbxi_stats_begin(uc);
 	ufbxi_check(ufbxi_pre_finalize_scene(uc));
+	ufbxi_stats_end(uc, pre_finalize, stats_begin);
 
 	// We can free `tmp_parse` already here as all parsing is done by now.
 	ufbxi_buf_free(&uc->tmp_parse);
 
+	stats_begin = ufbxi_stats_begin(uc);
 	ufbxi_check(ufbxi_finalize_scene(uc));
+	ufbxi_stats_end(uc, finalize, stats_begin);
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_compile_anim_curves(ufbxi_context *uc)
+{
+	double tolerance = uc->opts.compile_anim_curve_tolerance;
+	size_t memory = 0;
+
+	ufbxi_for_ptr_list(ufbx_anim_curve, p_curve, uc->scene.anim_curves) {
+		ufbx_anim_curve *curve = *p_curve;
+		size_t num_keys = curve->keyframes.count;
+		if (num_keys < 2) continue;
+
+		ufbx_curve_segment *segments = ufbxi_push(&uc->result, ufbx_curve_segment, num_keys - 1);
+		ufbxi_check(segments);
+
+		const ufbx_keyframe *keys = curve->keyframes.data;
+		for (size_t i = 0; i + 1 < num_keys; i++) {
+			ufbxi_compile_curve_segment(&segments[i], &keys[i], &keys[i + 1], tolerance);
+		}
+
+		curve->segments.data = segments;
+		curve->segments.count = num_keys - 1;
+		memory += (num_keys - 1) * sizeof(ufbx_curve_segment);
+	}
+
+	uc->scene.metadata.compiled_anim_curve_memory = memory;
+
+	return 1;
+}
 
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_post_process(ufbxi_context *uc)
+{
 	ufbxi_update_scene_settings(&uc->scene.settings);
 
 	// Axis conversion
@@ -21485,15 +24436,21 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 		ufbxi_check(ufbxi_scale_units(uc, uc->opts.target_unit_meters));
 	}
 
+	// Compile animation curves after they have been modified by unit scaling
+	if (uc->opts.compile_anim_curves) {
+		ufbxi_check(ufbxi_compile_anim_curves(uc));
+	}
+
 	// TODO: This could be done in evaluate as well with refactoring
 	ufbxi_update_adjust_transforms(uc, &uc->scene);
 
 	ufbxi_update_scene(&uc->scene, true);
 
-	if (uc->opts.load_external_files) {
-		ufbxi_check(ufbxi_load_external_files(uc));
-	}
+	return 1;
+}
 
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_skinning(ufbxi_context *uc)
+{
 	// Evaluate skinning if requested
 	if (uc->opts.evaluate_skinning) {
 		ufbx_geometry_cache_data_opts cache_opts = { 0 };
@@ -21502,6 +24459,11 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 			0.0, uc->opts.load_external_files && uc->opts.evaluate_caches, &cache_opts));
 	}
 
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_result(ufbxi_context *uc)
+{
 	// Pop warnings to metadata
 	ufbxi_check(ufbxi_pop_warnings(&uc->warnings, &uc->scene.metadata.warnings, uc->scene.metadata.has_warning));
 
@@ -21513,6 +24475,12 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 	uc->scene.metadata.animation_ignored = uc->opts.ignore_animation;
 	uc->scene.metadata.embedded_ignored = uc->opts.ignore_embedded;
 
+	ufbxi_lazy_range *lazy_ranges = NULL;
+	if (uc->lazy_geometry) {
+		lazy_ranges = ufbxi_collect_lazy_ranges(uc);
+		ufbxi_check(lazy_ranges);
+	}
+
 	// Retain the scene, this must be the final allocation as we copy
 	// `ator_result` to `ufbx_scene_imp`.
 	ufbxi_scene_imp *imp = ufbxi_push(&uc->result, ufbxi_scene_imp, 1);
@@ -21531,11 +24499,32 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 	imp->result_buf.ator = &imp->ator;
 	imp->string_buf = uc->string_pool.buf;
 	imp->string_buf.ator = &imp->ator;
+	imp->mapped_data = uc->mapped_data;
+	imp->mapped_size = uc->mapped_size;
+
+	if (uc->lazy_geometry) {
+		imp->lazy_data = uc->data_begin;
+		imp->lazy_size = ufbxi_to_size(uc->data - uc->data_begin) + uc->data_size + uc->yield_size;
+		imp->lazy_opts = uc->opts;
+		imp->lazy_ranges = lazy_ranges;
+	} else {
+		imp->lazy_data = NULL;
+		imp->lazy_size = 0;
+		imp->lazy_ranges = NULL;
+	}
+
+	imp->snapshot_data = NULL;
+	imp->snapshot_size = 0;
 
 	imp->scene.metadata.result_memory_used = imp->ator.current_size;
 	imp->scene.metadata.temp_memory_used = uc->ator_tmp.current_size;
 	imp->scene.metadata.result_allocs = imp->ator.num_allocs;
 	imp->scene.metadata.temp_allocs = uc->ator_tmp.num_allocs;
+	imp->scene.metadata.io_stats = uc->io_stats;
+	if (uc->opts.collect_stats) {
+		ufbxi_finish_load_stats(uc);
+		imp->scene.metadata.load_stats = uc->load_stats;
+	}
 
 	ufbxi_for_ptr_list(ufbx_element, p_elem, imp->scene.elements) {
 		(*p_elem)->scene = &imp->scene;
@@ -21546,23 +24535,297 @@ ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_imp(ufbxi_context *uc)
 	return 1;
 }
 
-static ufbxi_noinline void ufbxi_free_temp(ufbxi_context *uc)
+// Run the next phase in `uc->load_phase`, `UFBX_LOAD_PHASE_OBJECTS` is split into
+// multiple steps that each read roughly `budget` bytes of the file.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_step(ufbxi_context *uc, uint64_t budget)
 {
-	ufbxi_string_pool_temp_free(&uc->string_pool);
-	ufbxi_buf_free(&uc->warnings.tmp_stack);
-
-	ufbxi_map_free(&uc->prop_type_map);
-	ufbxi_map_free(&uc->fbx_id_map);
-	ufbxi_map_free(&uc->texture_file_map);
-	ufbxi_map_free(&uc->fbx_attr_map);
-	ufbxi_map_free(&uc->node_prop_set);
-	ufbxi_map_free(&uc->dom_node_map);
+	ufbxi_stats_timer step_begin = ufbxi_stats_begin(uc);
+	ufbxi_stats_timer stats_begin = step_begin;
 
-	ufbxi_buf_free(&uc->tmp);
-	ufbxi_buf_free(&uc->tmp_parse);
-	ufbxi_buf_free(&uc->tmp_stack);
-	ufbxi_buf_free(&uc->tmp_connections);
-	ufbxi_buf_free(&uc->tmp_node_ids);
+	switch (uc->load_phase) {
+	case UFBX_LOAD_PHASE_HEADER:
+		ufbxi_check(ufbxi_load_header(uc));
+		break;
+	case UFBX_LOAD_PHASE_OBJECTS: {
+		bool done = false;
+		ufbxi_check(ufbxi_read_objects(uc, budget, &done));
+		ufbxi_stats_end(uc, parse, stats_begin);
+		if (done) {
+			uc->load_phase = UFBX_LOAD_PHASE_CONNECTIONS;
+		}
+	} break;
+	case UFBX_LOAD_PHASE_CONNECTIONS:
+		ufbxi_check(ufbxi_load_connections(uc));
+		ufbxi_stats_end(uc, parse, stats_begin);
+		uc->load_phase = UFBX_LOAD_PHASE_FINALIZE;
+		break;
+	case UFBX_LOAD_PHASE_FINALIZE:
+		ufbxi_check(ufbxi_load_finalize(uc));
+		uc->load_phase = UFBX_LOAD_PHASE_POST_PROCESS;
+		break;
+	case UFBX_LOAD_PHASE_POST_PROCESS:
+		ufbxi_check(ufbxi_load_post_process(uc));
+		ufbxi_stats_end(uc, conversion, stats_begin);
+		uc->load_phase = UFBX_LOAD_PHASE_EXTERNAL_FILES;
+		break;
+	case UFBX_LOAD_PHASE_EXTERNAL_FILES:
+		if (uc->opts.load_external_files) {
+			ufbxi_check(ufbxi_load_external_files(uc));
+			ufbxi_stats_end(uc, external_files, stats_begin);
+		}
+		uc->load_phase = UFBX_LOAD_PHASE_SKINNING;
+		break;
+	case UFBX_LOAD_PHASE_SKINNING:
+		ufbxi_check(ufbxi_load_skinning(uc));
+		ufbxi_stats_end(uc, skinning, stats_begin);
+
+		// `ufbxi_load_result()` copies the statistics to the scene so finish timing first
+		ufbxi_stats_end(uc, total, step_begin);
+		ufbxi_check(ufbxi_load_result(uc));
+		uc->load_phase = UFBX_LOAD_PHASE_DONE;
+		return 1;
+	default:
+		ufbxi_fail("Bad load phase");
+	}
+
+	ufbxi_stats_end(uc, total, step_begin);
+	return 1;
+}
+
+// -- Load context
+
+#define ufbxi_swap_value(type, a, b) do { type ufbxi_tmp = (a); (a) = (b); (b) = ufbxi_tmp; } while (0)
+
+static ufbxi_noinline void ufbxi_load_context_set_ator(ufbx_load_context *lc, ufbxi_allocator *ator)
+{
+	ufbxi_map_set_ator(&lc->string_table, ator);
+	ufbxi_map_set_ator(&lc->string_map, ator);
+	ufbxi_map_set_ator(&lc->prop_type_map, ator);
+	ufbxi_map_set_ator(&lc->fbx_id_map, ator);
+	ufbxi_map_set_ator(&lc->texture_file_map, ator);
+	ufbxi_map_set_ator(&lc->fbx_attr_map, ator);
+	ufbxi_map_set_ator(&lc->node_prop_set, ator);
+	ufbxi_map_set_ator(&lc->dom_node_map, ator);
+
+	lc->tmp_parse.ator = ator;
+	lc->tmp_stack.ator = ator;
+	lc->tmp_connections.ator = ator;
+	lc->tmp_node_ids.ator = ator;
+	lc->tmp_elements.ator = ator;
+	lc->tmp_element_offsets.ator = ator;
+	lc->tmp_element_ptrs.ator = ator;
+	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
+		lc->tmp_typed_element_offsets[i].ator = ator;
+	}
+	lc->tmp_mesh_textures.ator = ator;
+	lc->tmp_full_weights.ator = ator;
+	lc->tmp_dom_nodes.ator = ator;
+	lc->tmp_deferred.ator = ator;
+	lc->tmp_warnings.ator = ator;
+}
+
+// Swap the retained state between `uc` and `lc`, used both for borrowing and returning it.
+static ufbxi_noinline void ufbxi_swap_load_context(ufbxi_context *uc, ufbx_load_context *lc)
+{
+	ufbxi_swap_value(ufbxi_map, uc->string_pool.map, lc->string_map);
+	ufbxi_swap_value(char*, uc->string_pool.temp_str, lc->string_temp_str);
+	ufbxi_swap_value(size_t, uc->string_pool.temp_cap, lc->string_temp_cap);
+
+	ufbxi_swap_value(ufbxi_map, uc->prop_type_map, lc->prop_type_map);
+	ufbxi_swap_value(ufbxi_map, uc->fbx_id_map, lc->fbx_id_map);
+	ufbxi_swap_value(ufbxi_map, uc->texture_file_map, lc->texture_file_map);
+	ufbxi_swap_value(ufbxi_map, uc->fbx_attr_map, lc->fbx_attr_map);
+	ufbxi_swap_value(ufbxi_map, uc->node_prop_set, lc->node_prop_set);
+	ufbxi_swap_value(ufbxi_map, uc->dom_node_map, lc->dom_node_map);
+
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_parse, lc->tmp_parse);
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_stack, lc->tmp_stack);
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_connections, lc->tmp_connections);
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_node_ids, lc->tmp_node_ids);
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_elements, lc->tmp_elements);
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_element_offsets, lc->tmp_element_offsets);
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_element_ptrs, lc->tmp_element_ptrs);
+	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
+		ufbxi_swap_value(ufbxi_buf, uc->tmp_typed_element_offsets[i], lc->tmp_typed_element_offsets[i]);
+	}
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_mesh_textures, lc->tmp_mesh_textures);
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_full_weights, lc->tmp_full_weights);
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_dom_nodes, lc->tmp_dom_nodes);
+	ufbxi_swap_value(ufbxi_buf, uc->tmp_deferred, lc->tmp_deferred);
+	ufbxi_swap_value(ufbxi_buf, uc->warnings.tmp_stack, lc->tmp_warnings);
+
+	ufbxi_swap_value(char*, uc->read_buffer, lc->read_buffer);
+	ufbxi_swap_value(size_t, uc->read_buffer_size, lc->read_buffer_size);
+	ufbxi_swap_value(char*, uc->tmp_arr, lc->tmp_arr);
+	ufbxi_swap_value(size_t, uc->tmp_arr_size, lc->tmp_arr_size);
+	ufbxi_swap_value(char*, uc->swap_arr, lc->swap_arr);
+	ufbxi_swap_value(size_t, uc->swap_arr_size, lc->swap_arr_size);
+	ufbxi_swap_value(ufbxi_node*, uc->top_nodes, lc->top_nodes);
+	ufbxi_swap_value(size_t, uc->top_nodes_cap, lc->top_nodes_cap);
+	ufbxi_swap_value(void**, uc->element_extra_arr, lc->element_extra_arr);
+	ufbxi_swap_value(size_t, uc->element_extra_cap, lc->element_extra_cap);
+	ufbxi_swap_value(char*, uc->ascii.token.str_data, lc->token_str_data);
+	ufbxi_swap_value(size_t, uc->ascii.token.str_cap, lc->token_str_cap);
+	ufbxi_swap_value(char*, uc->ascii.prev_token.str_data, lc->prev_token_str_data);
+	ufbxi_swap_value(size_t, uc->ascii.prev_token.str_cap, lc->prev_token_str_cap);
+	ufbxi_swap_value(ufbxi_deferred_array*, uc->deferred_arrays, lc->deferred_arrays);
+	ufbxi_swap_value(size_t, uc->deferred_arrays_cap, lc->deferred_arrays_cap);
+	ufbxi_swap_value(ufbx_inflate_retain*, uc->task_retains, lc->task_retains);
+	ufbxi_swap_value(size_t, uc->task_retains_cap, lc->task_retains_cap);
+}
+
+// Borrow the retained state of `lc` for loading, does nothing if it's already in use.
+static ufbxi_noinline void ufbxi_acquire_load_context(ufbxi_context *uc, ufbx_load_context *lc)
+{
+	ufbx_assert(lc->magic == UFBXI_LOAD_CONTEXT_IMP_MAGIC);
+	if (lc->magic != UFBXI_LOAD_CONTEXT_IMP_MAGIC) return;
+
+	// Loads on other threads may try to borrow the context at the same time, the one
+	// that increments `num_borrows` from zero owns it until `ufbxi_return_load_context()`.
+	if (ufbxi_atomic_counter_inc(&lc->num_borrows) != 0) {
+		ufbxi_atomic_counter_dec(&lc->num_borrows);
+		return;
+	}
+	ufbx_assert(!lc->in_use);
+	lc->in_use = true;
+	uc->load_context = lc;
+
+	// The retained memory counts towards `memory_limit` but allocations are counted per load
+	uc->ator_tmp = lc->ator;
+	uc->ator_tmp.error = &uc->error;
+	uc->ator_tmp.num_allocs = 0;
+
+	ufbxi_load_context_set_ator(lc, &uc->ator_tmp);
+	ufbxi_swap_load_context(uc, lc);
+}
+
+// Reset the retained state for the next load and move it back to the context.
+// `uc` is left with empty buffers that can be freed normally in `ufbxi_free_temp()`.
+static ufbxi_noinline void ufbxi_release_load_context(ufbxi_context *uc)
+{
+	ufbx_load_context *lc = uc->load_context;
+	ufbx_assert(lc && lc->in_use);
+
+	ufbxi_map_clear(&uc->string_pool.map);
+	if (!lc->has_tables) {
+		ufbxi_map_clear(&uc->prop_type_map);
+	}
+	ufbxi_map_clear(&uc->fbx_id_map);
+	ufbxi_map_clear(&uc->texture_file_map);
+	ufbxi_map_clear(&uc->fbx_attr_map);
+	ufbxi_map_clear(&uc->node_prop_set);
+	ufbxi_map_clear(&uc->dom_node_map);
+
+	ufbxi_buf_clear(&uc->tmp_parse);
+	ufbxi_buf_clear(&uc->tmp_stack);
+	ufbxi_buf_clear(&uc->tmp_connections);
+	ufbxi_buf_clear(&uc->tmp_node_ids);
+	ufbxi_buf_clear(&uc->tmp_elements);
+	ufbxi_buf_clear(&uc->tmp_element_offsets);
+	ufbxi_buf_clear(&uc->tmp_element_ptrs);
+	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
+		ufbxi_buf_clear(&uc->tmp_typed_element_offsets[i]);
+	}
+	ufbxi_buf_clear(&uc->tmp_mesh_textures);
+	ufbxi_buf_clear(&uc->tmp_full_weights);
+	ufbxi_buf_clear(&uc->tmp_dom_nodes);
+	ufbxi_buf_clear(&uc->tmp_deferred);
+	ufbxi_buf_clear(&uc->warnings.tmp_stack);
+
+	// `ufbxi_insert_element_extra()` expects unused slots to be `NULL`
+	if (uc->element_extra_cap > 0) {
+		memset(uc->element_extra_arr, 0, uc->element_extra_cap * sizeof(void*));
+	}
+
+	ufbxi_swap_load_context(uc, lc);
+	lc->maps_initialized = true;
+}
+
+// Return the allocator to the context after all the temporary memory has been freed.
+static ufbxi_noinline void ufbxi_return_load_context(ufbxi_context *uc)
+{
+	ufbx_load_context *lc = uc->load_context;
+	uc->load_context = NULL;
+
+	lc->ator = uc->ator_tmp;
+	lc->ator.error = &lc->error;
+	ufbxi_load_context_set_ator(lc, &lc->ator);
+	lc->in_use = false;
+	ufbxi_atomic_counter_dec(&lc->num_borrows);
+}
+
+static ufbxi_noinline void ufbxi_free_load_context(ufbx_load_context *lc)
+{
+	ufbx_assert(!lc->in_use);
+	lc->magic = 0;
+	ufbxi_atomic_counter_free(&lc->num_borrows);
+
+	ufbxi_map_free(&lc->string_table);
+	ufbxi_map_free(&lc->string_map);
+	ufbxi_free(&lc->ator, char, lc->string_temp_str, lc->string_temp_cap);
+
+	ufbxi_map_free(&lc->prop_type_map);
+	ufbxi_map_free(&lc->fbx_id_map);
+	ufbxi_map_free(&lc->texture_file_map);
+	ufbxi_map_free(&lc->fbx_attr_map);
+	ufbxi_map_free(&lc->node_prop_set);
+	ufbxi_map_free(&lc->dom_node_map);
+
+	ufbxi_buf_free(&lc->tmp_parse);
+	ufbxi_buf_free(&lc->tmp_stack);
+	ufbxi_buf_free(&lc->tmp_connections);
+	ufbxi_buf_free(&lc->tmp_node_ids);
+	ufbxi_buf_free(&lc->tmp_elements);
+	ufbxi_buf_free(&lc->tmp_element_offsets);
+	ufbxi_buf_free(&lc->tmp_element_ptrs);
+	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
+		ufbxi_buf_free(&lc->tmp_typed_element_offsets[i]);
+	}
+	ufbxi_buf_free(&lc->tmp_mesh_textures);
+	ufbxi_buf_free(&lc->tmp_full_weights);
+	ufbxi_buf_free(&lc->tmp_dom_nodes);
+	ufbxi_buf_free(&lc->tmp_deferred);
+	ufbxi_buf_free(&lc->tmp_warnings);
+
+	ufbxi_free(&lc->ator, char, lc->read_buffer, lc->read_buffer_size);
+	ufbxi_free(&lc->ator, char, lc->tmp_arr, lc->tmp_arr_size);
+	ufbxi_free(&lc->ator, char, lc->swap_arr, lc->swap_arr_size);
+	ufbxi_free(&lc->ator, ufbxi_node, lc->top_nodes, lc->top_nodes_cap);
+	ufbxi_free(&lc->ator, void*, lc->element_extra_arr, lc->element_extra_cap);
+	ufbxi_free(&lc->ator, char, lc->token_str_data, lc->token_str_cap);
+	ufbxi_free(&lc->ator, char, lc->prev_token_str_data, lc->prev_token_str_cap);
+	ufbxi_free(&lc->ator, ufbxi_deferred_array, lc->deferred_arrays, lc->deferred_arrays_cap);
+	ufbxi_free(&lc->ator, ufbx_inflate_retain, lc->task_retains, lc->task_retains_cap);
+
+	// The context itself is allocated from `lc->ator`
+	ufbxi_allocator ator = lc->ator;
+	ufbxi_free(&ator, ufbx_load_context, lc, 1);
+	ufbxi_free_ator(&ator);
+}
+
+static ufbxi_noinline void ufbxi_free_temp(ufbxi_context *uc)
+{
+	ufbxi_read_ahead_free(&uc->read_ahead);
+
+	if (uc->load_context) {
+		ufbxi_release_load_context(uc);
+	}
+
+	ufbxi_string_pool_temp_free(&uc->string_pool);
+	ufbxi_buf_free(&uc->warnings.tmp_stack);
+
+	ufbxi_map_free(&uc->prop_type_map);
+	ufbxi_map_free(&uc->fbx_id_map);
+	ufbxi_map_free(&uc->texture_file_map);
+	ufbxi_map_free(&uc->fbx_attr_map);
+	ufbxi_map_free(&uc->node_prop_set);
+	ufbxi_map_free(&uc->dom_node_map);
+
+	ufbxi_buf_free(&uc->tmp);
+	ufbxi_buf_free(&uc->tmp_parse);
+	ufbxi_buf_free(&uc->tmp_stack);
+	ufbxi_buf_free(&uc->tmp_connections);
+	ufbxi_buf_free(&uc->tmp_node_ids);
 	ufbxi_buf_free(&uc->tmp_elements);
 	ufbxi_buf_free(&uc->tmp_element_offsets);
 	ufbxi_buf_free(&uc->tmp_element_ptrs);
@@ -21572,6 +24835,7 @@ static ufbxi_noinline void ufbxi_free_temp(ufbxi_context *uc)
 	ufbxi_buf_free(&uc->tmp_mesh_textures);
 	ufbxi_buf_free(&uc->tmp_full_weights);
 	ufbxi_buf_free(&uc->tmp_dom_nodes);
+	ufbxi_buf_free(&uc->tmp_deferred);
 
 	ufbxi_free(&uc->ator_tmp, ufbxi_node, uc->top_nodes, uc->top_nodes_cap);
 	ufbxi_free(&uc->ator_tmp, void*, uc->element_extra_arr, uc->element_extra_cap);
@@ -21582,10 +24846,16 @@ static ufbxi_noinline void ufbxi_free_temp(ufbxi_context *uc)
 	ufbxi_free(&uc->ator_tmp, char, uc->read_buffer, uc->read_buffer_size);
 	ufbxi_free(&uc->ator_tmp, char, uc->tmp_arr, uc->tmp_arr_size);
 	ufbxi_free(&uc->ator_tmp, char, uc->swap_arr, uc->swap_arr_size);
+	ufbxi_free(&uc->ator_tmp, ufbxi_deferred_array, uc->deferred_arrays, uc->deferred_arrays_cap);
+	ufbxi_free(&uc->ator_tmp, ufbx_inflate_retain, uc->task_retains, uc->task_retains_cap);
 
 	ufbxi_obj_free(uc);
 
-	ufbxi_free_ator(&uc->ator_tmp);
+	if (uc->load_context) {
+		ufbxi_return_load_context(uc);
+	} else {
+		ufbxi_free_ator(&uc->ator_tmp);
+	}
 }
 
 static ufbxi_noinline void ufbxi_free_result(ufbxi_context *uc)
@@ -21594,9 +24864,13 @@ static ufbxi_noinline void ufbxi_free_result(ufbxi_context *uc)
 	ufbxi_buf_free(&uc->string_pool.buf);
 
 	ufbxi_free_ator(&uc->ator_result);
+
+	if (uc->mapped_data) {
+		ufbxi_unmap_file(uc->mapped_data, uc->mapped_size);
+	}
 }
 
-static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_opts *user_opts, ufbx_error *p_error)
+static ufbxi_noinline void ufbxi_load_init(ufbxi_context *uc, const ufbx_load_opts *user_opts, ufbx_inflate_retain *inflate_retain)
 {
 	// Test endianness
 	{
@@ -21622,9 +24896,6 @@ static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_
 		uc->opts.ignore_embedded = true;
 	}
 
-	ufbx_inflate_retain inflate_retain;
-	inflate_retain.initialized = false;
-
 	ufbxi_init_ator(&uc->error, &uc->ator_tmp, &uc->opts.temp_allocator, "temp");
 	ufbxi_init_ator(&uc->error, &uc->ator_result, &uc->opts.result_allocator, "result");
 
@@ -21654,19 +24925,45 @@ static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_
 		uc->opts.open_file_cb.fn = &ufbx_default_open_file;
 	}
 
+	if (uc->opts.thread_opts.num_tasks == 0) {
+		uc->opts.thread_opts.num_tasks = 64;
+	}
+
+	if (uc->opts.thread_opts.memory_limit == 0) {
+		uc->opts.thread_opts.memory_limit = 32*1024*1024;
+	}
+
+	if (uc->opts.obj_stream_memory_limit == 0) {
+		uc->opts.obj_stream_memory_limit = 16*1024*1024;
+	}
+
+	if (uc->opts.compile_anim_curve_tolerance == 0.0f) {
+		uc->opts.compile_anim_curve_tolerance = (ufbx_real)0.00001;
+	}
+
+	// Borrow retained temporary memory, the retained maps are initialized only once
+	if (uc->opts.load_context) {
+		ufbxi_acquire_load_context(uc, uc->opts.load_context);
+	}
+	bool init_maps = !uc->load_context || !uc->load_context->maps_initialized;
+
 	uc->string_pool.error = &uc->error;
-	ufbxi_map_init(&uc->string_pool.map, &uc->ator_tmp, &ufbxi_map_cmp_string, NULL);
+	if (init_maps) {
+		ufbxi_map_init(&uc->string_pool.map, &uc->ator_tmp, &ufbxi_map_cmp_string, NULL);
+	}
 	uc->string_pool.buf.ator = &uc->ator_result;
 	uc->string_pool.buf.unordered = true;
 	uc->string_pool.initial_size = 1024;
 	uc->string_pool.error_handling = uc->opts.unicode_error_handling;
 
-	ufbxi_map_init(&uc->prop_type_map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
-	ufbxi_map_init(&uc->fbx_id_map, &uc->ator_tmp, &ufbxi_map_cmp_uint64, NULL);
-	ufbxi_map_init(&uc->texture_file_map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
-	ufbxi_map_init(&uc->fbx_attr_map, &uc->ator_tmp, &ufbxi_map_cmp_uint64, NULL);
-	ufbxi_map_init(&uc->node_prop_set, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
-	ufbxi_map_init(&uc->dom_node_map, &uc->ator_tmp, &ufbxi_map_cmp_uintptr, NULL);
+	if (init_maps) {
+		ufbxi_map_init(&uc->prop_type_map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
+		ufbxi_map_init(&uc->fbx_id_map, &uc->ator_tmp, &ufbxi_map_cmp_uint64, NULL);
+		ufbxi_map_init(&uc->texture_file_map, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
+		ufbxi_map_init(&uc->fbx_attr_map, &uc->ator_tmp, &ufbxi_map_cmp_uint64, NULL);
+		ufbxi_map_init(&uc->node_prop_set, &uc->ator_tmp, &ufbxi_map_cmp_const_char_ptr, NULL);
+		ufbxi_map_init(&uc->dom_node_map, &uc->ator_tmp, &ufbxi_map_cmp_uintptr, NULL);
+	}
 
 	uc->tmp.ator = &uc->ator_tmp;
 	uc->tmp_parse.ator = &uc->ator_tmp;
@@ -21682,12 +24979,15 @@ static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_
 	uc->tmp_mesh_textures.ator = &uc->ator_tmp;
 	uc->tmp_full_weights.ator = &uc->ator_tmp;
 	uc->tmp_dom_nodes.ator = &uc->ator_tmp;
+	uc->tmp_deferred.ator = &uc->ator_tmp;
 
 	uc->result.ator = &uc->ator_result;
 
 	uc->tmp.unordered = true;
 	uc->tmp_parse.unordered = true;
 	uc->tmp_parse.clearable = true;
+	uc->tmp_deferred.unordered = true;
+	uc->tmp_deferred.clearable = true;
 	uc->result.unordered = true;
 
 	uc->warnings.error = &uc->error;
@@ -21697,14 +24997,26 @@ static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_
 
 	// Set zero size `swap_arr` to a non-NULL buffer so we can tell the difference between empty
 	// array and an allocation failure.
-	uc->swap_arr = (char*)ufbxi_zero_size_buffer;
+	if (uc->swap_arr_size == 0) {
+		uc->swap_arr = (char*)ufbxi_zero_size_buffer;
+	}
 
-	// NOTE: Though `inflate_retain` leaks out of the scope we don't use it outside this function.
-	// cppcheck-suppress autoVariables
-	uc->inflate_retain = &inflate_retain;
+	uc->inflate_retain = inflate_retain;
+	uc->load_phase = UFBX_LOAD_PHASE_HEADER;
 
-	int ok = ufbxi_load_imp(uc);
+	// Route all stream reads through `read_ahead`, it also measures the time spent waiting.
+	if (uc->read_fn) {
+		ufbx_stream stream = { uc->read_fn, uc->skip_fn, uc->close_fn, uc->read_user };
+		ufbxi_read_ahead_init(&uc->read_ahead, &stream, &uc->opts.read_ahead, uc->opts.read_buffer_size, &uc->ator_tmp, &uc->io_stats);
+		uc->read_fn = stream.read_fn;
+		uc->skip_fn = stream.skip_fn;
+		uc->close_fn = stream.close_fn;
+		uc->read_user = stream.user;
+	}
+}
 
+static ufbxi_noinline ufbx_scene *ufbxi_load_end(ufbxi_context *uc, int ok, ufbx_error *p_error)
+{
 	ufbxi_free_temp(uc);
 
 	if (uc->close_fn) {
@@ -21724,801 +25036,3478 @@ static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_
 	}
 }
 
-// -- Animation evaluation
-
-static int ufbxi_cmp_prop_override(const void *va, const void *vb)
+static ufbxi_noinline ufbx_scene *ufbxi_load(ufbxi_context *uc, const ufbx_load_opts *user_opts, ufbx_error *p_error)
 {
-	const ufbx_prop_override *a = (const ufbx_prop_override*)va, *b = (const ufbx_prop_override*)vb;
-	if (a->element_id != b->element_id) return a->element_id < b->element_id ? -1 : 1;
-	if (a->_internal_key != b->_internal_key) return a->_internal_key < b->_internal_key ? -1 : 1;
-	return strcmp(a->prop_name, b->prop_name);
-}
+	ufbx_inflate_retain inflate_retain;
+	inflate_retain.initialized = false;
 
-static ufbxi_forceinline bool ufbxi_override_less_than_prop(const ufbx_prop_override *over, uint32_t element_id, const ufbx_prop *prop)
-{
-	if (over->element_id != element_id) return over->element_id < element_id;
-	if (over->_internal_key != prop->_internal_key) return over->_internal_key < prop->_internal_key;
-	return strcmp(over->prop_name, prop->name.data);
-}
+	// NOTE: Though `inflate_retain` leaks out of the scope we don't use it outside this function.
+	// cppcheck-suppress autoVariables
+	ufbxi_load_init(uc, user_opts, &inflate_retain);
 
-static ufbxi_forceinline bool ufbxi_override_equals_to_prop(const ufbx_prop_override *over, uint32_t element_id, const ufbx_prop *prop)
-{
-	if (over->element_id != element_id) return false;
-	if (over->_internal_key != prop->_internal_key) return false;
-	return strcmp(over->prop_name, prop->name.data) == 0;
+	int ok = 1;
+	while (ok && uc->load_phase != UFBX_LOAD_PHASE_DONE) {
+		ok = ufbxi_load_step(uc, UINT64_MAX);
+	}
+
+	return ufbxi_load_end(uc, ok, p_error);
 }
 
-static ufbxi_forceinline ufbxi_unused bool ufbxi_prop_override_is_prepared(const ufbx_prop_override *over)
+static ufbxi_noinline int ufbxi_copy_result_string(ufbxi_context *uc, ufbx_string *str)
 {
-	if (over->_internal_key != ufbxi_get_name_key_c(over->prop_name)) return false;
-	if (over->value_str == NULL) return false;
-	return true;
+	if (str->length == 0) {
+		str->data = ufbxi_empty_char;
+		return 1;
+	}
+
+	char *data = ufbxi_push_copy(&uc->result, char, str->length + 1, str->data);
+	ufbxi_check(data);
+	str->data = data;
+	return 1;
 }
 
-static ufbxi_noinline bool ufbxi_find_prop_override(const ufbx_const_prop_override_list *overrides, uint32_t element_id, ufbx_prop *prop)
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_mesh_data_imp(ufbxi_context *uc, const ufbx_load_mesh_opts *opts, const ufbx_mesh *src, ufbxi_mesh_imp **p_imp)
 {
-	if (overrides->count > 0) {
-		// If this assert fails make sure to call `ufbx_prepare_prop_overrides()` first!
-		ufbx_assert(ufbxi_prop_override_is_prepared(&overrides->data[0]));
-	}
+	// `ufbx_load_mesh_opts` must be cleared to zero first!
+	ufbx_assert(opts->_begin_zero == 0 && opts->_end_zero == 0);
+	ufbxi_check_msg(opts->_begin_zero == 0 && opts->_end_zero == 0, "Uninitialized options");
 
-	size_t ix = SIZE_MAX;
-	ufbxi_macro_lower_bound_eq(ufbx_prop_override, 16, &ix, overrides->data, 0, overrides->count,
-		( ufbxi_override_less_than_prop(a, element_id, prop) ),
-		( ufbxi_override_equals_to_prop(a, element_id, prop) ));
+	ufbxi_scene_imp *scene_imp = ufbxi_get_imp(ufbxi_scene_imp, src->element.scene);
+	ufbxi_check(scene_imp->magic == UFBXI_SCENE_IMP_MAGIC);
+	ufbxi_check(scene_imp->lazy_data != NULL && scene_imp->lazy_ranges != NULL);
 
-	if (ix != SIZE_MAX) {
-		const ufbx_prop_override *over = &overrides->data[ix];
-		const uint32_t clear_flags = UFBX_PROP_FLAG_NO_VALUE | UFBX_PROP_FLAG_NOT_FOUND;
-		prop->flags = (ufbx_prop_flags)(((uint32_t)prop->flags & ~clear_flags) | UFBX_PROP_FLAG_OVERRIDDEN);
-		prop->value_vec3 = over->value;
-		prop->value_real_arr[3] = 0.0f;
-		prop->value_int = over->value_int;
-		prop->value_str = ufbxi_str_c(over->value_str);
-		prop->value_blob.data = prop->value_str.data;
-		prop->value_blob.size = prop->value_str.length;
-		return true;
-	} else {
-		return false;
+	const ufbx_mesh_list *meshes = &scene_imp->scene.meshes;
+	ufbxi_check(src->element.typed_id < meshes->count && meshes->data[src->element.typed_id] == src);
+	const ufbxi_lazy_range *range = &scene_imp->lazy_ranges[src->element.typed_id];
+	uint64_t begin = range->begin, end = range->end;
+	ufbxi_check(begin < end && end <= scene_imp->lazy_size);
+
+	ufbxi_check(ufbxi_load_strings(uc));
+
+	// Parse the `Geometry` node from the original data, the file must end in
+	// a NULL record so we can safely peek past the end of the node.
+	const ufbx_metadata *metadata = &src->element.scene->metadata;
+	uc->version = metadata->version;
+	uc->file_big_endian = metadata->big_endian;
+	uc->data_begin = scene_imp->lazy_data;
+	uc->data = scene_imp->lazy_data + (size_t)begin;
+	uc->data_size = scene_imp->lazy_size - (size_t)begin;
+	uc->mapped_data = scene_imp->mapped_data;
+	uc->mapped_size = scene_imp->mapped_size;
+
+	bool node_end = false;
+	ufbxi_check(ufbxi_binary_parse_node(uc, 0, UFBXI_PARSE_OBJECTS, &node_end, &uc->tmp, true));
+	ufbxi_check(!node_end && ufbxi_get_read_offset(uc) == end);
+
+	ufbxi_node node;
+	ufbxi_pop(&uc->tmp_stack, ufbxi_node, 1, &node);
+
+	ufbx_mesh mesh;
+	memset(&mesh, 0, sizeof(mesh));
+	mesh.element = src->element;
+	ufbxi_patch_mesh_reals(&mesh);
+
+	ufbxi_check(ufbxi_read_mesh_data(uc, &node, &mesh));
+	ufbxi_check(ufbxi_push_index_buffers(uc));
+	ufbxi_check(ufbxi_finalize_mesh_data(uc, &mesh));
+
+	// Set names are allocated from the temporary string pool
+	ufbxi_for_list(ufbx_uv_set, set, mesh.uv_sets) {
+		ufbxi_check(ufbxi_copy_result_string(uc, &set->name));
 	}
+	ufbxi_for_list(ufbx_color_set, set, mesh.color_sets) {
+		ufbxi_check(ufbxi_copy_result_string(uc, &set->name));
+	}
+	ufbxi_buf_free(&uc->string_pool.buf);
+
+	// Assign faces to the materials of the lazy mesh
+	mesh.materials.count = src->materials.count;
+	mesh.materials.data = ufbxi_push_zero(&uc->result, ufbx_mesh_material, src->materials.count);
+	ufbxi_check(mesh.materials.data);
+	for (size_t i = 0; i < src->materials.count; i++) {
+		mesh.materials.data[i].material = src->materials.data[i].material;
+	}
+	ufbxi_check(ufbxi_assign_mesh_material_faces(uc, &mesh));
+
+	// Elements referenced by the mesh are shared with the scene
+	mesh.instances = src->instances;
+	mesh.skin_deformers = src->skin_deformers;
+	mesh.blend_deformers = src->blend_deformers;
+	mesh.cache_deformers = src->cache_deformers;
+	mesh.all_deformers = src->all_deformers;
+
+	mesh.subdivision_preview_levels = src->subdivision_preview_levels;
+	mesh.subdivision_render_levels = src->subdivision_render_levels;
+	mesh.subdivision_display_mode = src->subdivision_display_mode;
+	mesh.subdivision_boundary = src->subdivision_boundary;
+	mesh.subdivision_uv_boundary = src->subdivision_uv_boundary;
+
+	ufbxi_mesh_imp *imp = ufbxi_push(&uc->result, ufbxi_mesh_imp, 1);
+	ufbxi_check(imp);
+
+	ufbxi_init_ref(&imp->refcount, UFBXI_MESH_IMP_MAGIC, &scene_imp->refcount);
+
+	imp->magic = UFBXI_MESH_IMP_MAGIC;
+	imp->mesh = mesh;
+	imp->ator = uc->ator_result;
+	imp->result_buf = uc->result;
+	imp->mesh.lazy_geometry_loaded = true;
+
+	*p_imp = imp;
+	return 1;
 }
 
-static ufbxi_noinline ufbx_const_prop_override_list ufbxi_find_element_prop_overrides(const ufbx_const_prop_override_list *overrides, uint32_t element_id)
+static ufbxi_noinline ufbx_mesh *ufbxi_load_mesh_data(const ufbx_mesh *mesh, const ufbx_load_mesh_opts *user_opts, ufbx_error *p_error)
 {
-	if (overrides->count > 0) {
-		// If this assert fails make sure to call `ufbx_prepare_prop_overrides()` first!
-		ufbx_assert(ufbxi_prop_override_is_prepared(&overrides->data[0]));
+	ufbx_load_mesh_opts opts;
+	if (user_opts) {
+		opts = *user_opts;
+	} else {
+		memset(&opts, 0, sizeof(opts));
 	}
 
-	size_t begin = overrides->count, end = begin;
+	// Re-use the relevant loading options of the original scene
+	const ufbxi_scene_imp *scene_imp = ufbxi_get_imp(ufbxi_scene_imp, mesh->element.scene);
+	const ufbx_load_opts *scene_opts = &scene_imp->lazy_opts;
+	ufbx_load_opts load_opts;
+	memset(&load_opts, 0, sizeof(load_opts));
+	load_opts.temp_allocator = opts.temp_allocator;
+	load_opts.result_allocator = opts.result_allocator;
+	load_opts.thread_opts = opts.thread_opts;
+	load_opts.strict = scene_opts->strict;
+	load_opts.allow_unsafe = scene_opts->allow_unsafe;
+	load_opts.index_error_handling = scene_opts->index_error_handling;
+	load_opts.unicode_error_handling = scene_opts->unicode_error_handling;
+	load_opts.generate_missing_normals = scene_opts->generate_missing_normals;
 
-	ufbxi_macro_lower_bound_eq(ufbx_prop_override, 32, &begin, overrides->data, 0, overrides->count,
-		(a->element_id < element_id),
-		(a->element_id == element_id));
+	ufbx_inflate_retain inflate_retain;
+	inflate_retain.initialized = false;
 
-	ufbxi_macro_upper_bound_eq(ufbx_prop_override, 32, &end, overrides->data, begin, overrides->count,
-		(a->element_id == element_id));
+	ufbxi_context uc = { UFBX_ERROR_NONE };
+	ufbxi_load_init(&uc, &load_opts, &inflate_retain);
 
-	ufbx_const_prop_override_list result = { overrides->data + begin, end - begin };
-	return result;
-}
+	ufbxi_mesh_imp *imp = NULL;
+	int ok = ufbxi_load_mesh_data_imp(&uc, &opts, mesh, &imp);
 
-typedef struct ufbxi_anim_layer_combine_ctx {
-	ufbx_anim anim;
-	const ufbx_element *element;
-	double time;
-	ufbx_rotation_order rotation_order;
-	bool has_rotation_order;
-} ufbxi_anim_layer_combine_ctx;
+	ufbxi_free_temp(&uc);
 
-static double ufbxi_pow_abs(double v, double e)
-{
-	if (e <= 0.0) return 1.0;
-	if (e >= 1.0) return v;
-	double sign = v < 0.0 ? -1.0 : 1.0;
-	return sign * ufbx_pow(v * sign, e);
+	if (ok) {
+		if (p_error) {
+			ufbxi_clear_error(p_error);
+		}
+		return &imp->mesh;
+	} else {
+		ufbxi_fix_error_type(&uc.error, "Failed to load mesh data");
+		if (p_error) *p_error = uc.error;
+		ufbxi_buf_free(&uc.string_pool.buf);
+		ufbxi_buf_free(&uc.result);
+		ufbxi_free_ator(&uc.ator_result);
+		return NULL;
+	}
 }
 
-// Recursion is limited by the fact that we recurse only when the property name is "Lcl Rotation"
-// and when recursing we always evaluate the property "RotationOrder"
-static ufbxi_noinline void ufbxi_combine_anim_layer(ufbxi_anim_layer_combine_ctx *ctx, ufbx_anim_layer *layer, ufbx_real weight, const char *prop_name, ufbx_vec3 *result, const ufbx_vec3 *value)
-	ufbxi_recursive_function_void(ufbxi_combine_anim_layer, (ctx, layer, weight, prop_name, result, value), 2,
-		(ufbxi_anim_layer_combine_ctx *ctx, ufbx_anim_layer *layer, ufbx_real weight, const char *prop_name, ufbx_vec3 *result, const ufbx_vec3 *value))
+// -- Probing
+
+typedef struct {
+	ufbxi_refcount refcount;
+	ufbx_probe probe;
+	uint32_t magic;
+
+	ufbxi_allocator ator;
+	ufbxi_buf result_buf;
+	ufbxi_buf string_buf;
+} ufbxi_probe_imp;
+
+ufbx_static_assert(probe_imp_offset, offsetof(ufbxi_probe_imp, probe) == sizeof(ufbxi_refcount));
+
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_probe_objects(ufbxi_context *uc, ufbx_probe *probe)
 {
-	if (layer->compose_rotation && layer->blended && prop_name == ufbxi_Lcl_Rotation && !ctx->has_rotation_order) {
-		ufbx_prop rp = ufbx_evaluate_prop_len(&ctx->anim, ctx->element, ufbxi_RotationOrder, sizeof(ufbxi_RotationOrder) - 1, ctx->time);
-		// NOTE: Defaults to 0 (UFBX_ROTATION_XYZ) gracefully if property is not found
-		if (rp.value_int >= 0 && rp.value_int <= UFBX_ROTATION_ORDER_SPHERIC) {
-			ctx->rotation_order = (ufbx_rotation_order)rp.value_int;
-		} else {
-			ctx->rotation_order = UFBX_ROTATION_ORDER_XYZ;
+	bool found_settings = false;
+
+	// Object contents are skipped in `ufbxi_binary_parse_node()`, see `ufbxi_context.probe`.
+	ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_Objects));
+	for (;;) {
+		ufbxi_node *node;
+		ufbxi_check(ufbxi_parse_toplevel_child(uc, &node));
+		if (!node) break;
+
+		if (node->name == ufbxi_GlobalSettings) {
+			ufbxi_check(ufbxi_read_global_settings(uc, node));
+			found_settings = true;
+			continue;
+		} else if (node->name == ufbxi_SceneInfo) {
+			ufbxi_check(ufbxi_read_scene_info(uc, node));
+			continue;
 		}
-		ctx->has_rotation_order = true;
-	}
 
-	if (layer->additive) {
-		if (layer->compose_scale && prop_name == ufbxi_Lcl_Scaling) {
-			result->x *= (ufbx_real)ufbxi_pow_abs(value->x, weight);
-			result->y *= (ufbx_real)ufbxi_pow_abs(value->y, weight);
-			result->z *= (ufbx_real)ufbxi_pow_abs(value->z, weight);
-		} else if (layer->compose_rotation && prop_name == ufbxi_Lcl_Rotation) {
-			ufbx_quat a = ufbx_euler_to_quat(*result, ctx->rotation_order);
-			ufbx_quat b = ufbx_euler_to_quat(*value, ctx->rotation_order);
-			b = ufbx_quat_slerp(ufbx_identity_quat, b, weight);
-			ufbx_quat res = ufbxi_mul_quat(a, b);
-			*result = ufbx_quat_to_euler(res, ctx->rotation_order);
+		// Match the object header parsing in `ufbxi_read_objects()`
+		ufbx_string type_and_name, sub_type_str;
+		if (uc->version >= 7000) {
+			if (!ufbxi_get_val3(node, "_ss", NULL, &type_and_name, &sub_type_str)) continue;
 		} else {
-			result->x += value->x * weight;
-			result->y += value->y * weight;
-			result->z += value->z * weight;
+			if (!ufbxi_get_val2(node, "ss", &type_and_name, &sub_type_str)) continue;
 		}
-	} else if (layer->blended) {
-		ufbx_real res_weight = 1.0f - weight;
-		if (layer->compose_scale && prop_name == ufbxi_Lcl_Scaling) {
-			result->x = (ufbx_real)(ufbxi_pow_abs(result->x, res_weight) * ufbxi_pow_abs(value->x, weight));
-			result->y = (ufbx_real)(ufbxi_pow_abs(result->y, res_weight) * ufbxi_pow_abs(value->y, weight));
-			result->z = (ufbx_real)(ufbxi_pow_abs(result->z, res_weight) * ufbxi_pow_abs(value->z, weight));
-		} else if (layer->compose_rotation && prop_name == ufbxi_Lcl_Rotation) {
-			ufbx_quat a = ufbx_euler_to_quat(*result, ctx->rotation_order);
-			ufbx_quat b = ufbx_euler_to_quat(*value, ctx->rotation_order);
-			ufbx_quat res = ufbx_quat_slerp(a, b, weight);
-			*result = ufbx_quat_to_euler(res, ctx->rotation_order);
-		} else {
-			result->x = result->x * res_weight + value->x * weight;
-			result->y = result->y * res_weight + value->y * weight;
-			result->z = result->z * res_weight + value->z * weight;
+
+		if (sub_type_str.length > 3 && !memcmp(sub_type_str.data, "Fbx", 3)) {
+			sub_type_str.data += 3;
+			sub_type_str.length -= 3;
+			ufbxi_check(ufbxi_push_string_place_str(&uc->string_pool, &sub_type_str, false));
+		}
+
+		const char *name = node->name, *sub_type = sub_type_str.data;
+		ufbx_element_type type;
+		if (ufbxi_object_element_type(&type, name, sub_type)) {
+			probe->element_counts[type]++;
+		}
+
+		// Pre-7000 models contain their attributes
+		if (uc->version < 7000 && name == ufbxi_Model && sub_type != ufbxi_empty_char && sub_type != ufbxi_Model) {
+			probe->element_counts[ufbxi_attribute_element_type(sub_type, true)]++;
+		}
+
+		probe->num_objects++;
+	}
+
+	// Top-level GlobalSettings is usually before objects so it should be cached
+	if (!found_settings) {
+		ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_GlobalSettings));
+		if (uc->top_node) {
+			ufbxi_check(ufbxi_read_global_settings(uc, uc->top_node));
 		}
-	} else {
-		*result = *value;
 	}
+
+	return 1;
 }
 
-static ufbxi_forceinline bool ufbxi_anim_layer_might_contain_id(const ufbx_anim_layer *layer, uint32_t id)
+ufbxi_nodiscard ufbxi_noinline static int ufbxi_read_probe(ufbxi_context *uc, ufbxi_probe_imp **p_imp)
 {
-	uint32_t id_mask = ufbxi_arraycount(layer->_element_id_bitmask) - 1;
-	bool ok = id - layer->_min_element_id <= (layer->_max_element_id - layer->_min_element_id);
-	ok &= (layer->_element_id_bitmask[(id >> 5) & id_mask] & (1u << (id & 31))) != 0;
-	return ok;
+	// `ufbx_load_opts` must be cleared to zero first!
+	ufbx_assert(uc->opts._begin_zero == 0 && uc->opts._end_zero == 0);
+	ufbxi_check_msg(uc->opts._begin_zero == 0 && uc->opts._end_zero == 0, "Uninitialized options");
+	ufbxi_check(ufbxi_fixup_opts_string(uc, &uc->opts.filename, false));
+
+	ufbx_probe probe;
+	memset(&probe, 0, sizeof(probe));
+
+	uc->scene.metadata.creator.data = ufbxi_empty_char;
+	uc->probe = true;
+
+	ufbxi_check(ufbxi_load_tables(uc));
+	ufbxi_check(ufbxi_determine_format(uc));
+
+	if (uc->scene.metadata.file_format == UFBX_FILE_FORMAT_FBX) {
+		ufbxi_check(ufbxi_begin_parse(uc));
+
+		// Pre-6000 files don't have the object structure, only report the header.
+		if (uc->version >= 6000) {
+			ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_FBXHeaderExtension));
+			ufbxi_check(ufbxi_read_header_extension(uc));
+
+			// See `ufbxi_read_root_begin()`
+			if (uc->exporter == UFBX_EXPORTER_BLENDER_ASCII) {
+				ufbxi_check(ufbxi_parse_toplevel(uc, ufbxi_Creator));
+				if (uc->top_node) {
+					ufbxi_ignore(ufbxi_get_val1(uc->top_node, "S", &uc->scene.metadata.creator));
+				}
+			}
+
+			ufbxi_check(ufbxi_match_exporter(uc));
+			ufbxi_check(ufbxi_probe_objects(uc, &probe));
+		}
+	}
+
+	ufbxi_update_scene_metadata(&uc->scene.metadata);
+	ufbxi_update_scene_settings(&uc->scene.settings);
+
+	probe.metadata = uc->scene.metadata;
+	probe.metadata.version = uc->version;
+	probe.metadata.ascii = uc->from_ascii;
+	probe.metadata.big_endian = uc->file_big_endian;
+	probe.settings = uc->scene.settings;
+
+	// Retain the probe, this must be the final allocation as we copy
+	// `ator_result` to `ufbxi_probe_imp`.
+	ufbxi_probe_imp *imp = ufbxi_push(&uc->result, ufbxi_probe_imp, 1);
+	ufbxi_check(imp);
+
+	ufbxi_init_ref(&imp->refcount, UFBXI_PROBE_IMP_MAGIC, NULL);
+
+	imp->magic = UFBXI_PROBE_IMP_MAGIC;
+	imp->probe = probe;
+	imp->ator = uc->ator_result;
+	imp->ator.error = NULL;
+
+	imp->result_buf = uc->result;
+	imp->result_buf.ator = &imp->ator;
+	imp->string_buf = uc->string_pool.buf;
+	imp->string_buf.ator = &imp->ator;
+
+	*p_imp = imp;
+	return 1;
 }
 
-static ufbxi_noinline void ufbxi_evaluate_props(const ufbx_anim *anim, const ufbx_element *element, double time, ufbx_prop *props, size_t num_props)
+static ufbxi_noinline ufbx_probe *ufbxi_probe(ufbxi_context *uc, const ufbx_load_opts *user_opts, ufbx_error *p_error)
 {
-	ufbxi_anim_layer_combine_ctx combine_ctx = { *anim, element, time };
+	ufbx_load_opts opts;
+	if (user_opts) {
+		opts = *user_opts;
+	} else {
+		memset(&opts, 0, sizeof(opts));
+	}
 
-	uint32_t element_id = element->element_id;
-	ufbxi_for_list(const ufbx_anim_layer_desc, layer_desc, anim->layers) {
-		ufbx_anim_layer *layer = layer_desc->layer;
-		if (!ufbxi_anim_layer_might_contain_id(layer, element_id)) continue;
+	// Never load any content or retain data that would not be returned
+	opts.ignore_all_content = true;
+	opts.retain_dom = false;
+	opts.lazy_geometry = false;
 
-		// Find the weight for the current layer
-		// TODO: Should this be searched from multiple layers?
-		// TODO: Use weight from layer_desc
-		ufbx_real weight = layer->weight;
-		if (layer->weight_is_animated && layer->blended) {
-			ufbx_anim_prop *weight_aprop = ufbxi_find_anim_prop_start(layer, &layer->element);
-			if (weight_aprop) {
-				weight = ufbx_evaluate_anim_value_real(weight_aprop->anim_value, time) / (ufbx_real)100.0;
-				if (weight < 0.0f) weight = 0.0f;
-				if (weight > 0.99999f) weight = 1.0f;
-			}
+	ufbx_inflate_retain inflate_retain;
+	inflate_retain.initialized = false;
+
+	ufbxi_load_init(uc, &opts, &inflate_retain);
+
+	ufbxi_probe_imp *imp = NULL;
+	int ok = ufbxi_read_probe(uc, &imp);
+
+	ufbxi_free_temp(uc);
+
+	if (uc->close_fn) {
+		uc->close_fn(uc->read_user);
+	}
+
+	if (ok) {
+		if (p_error) {
+			ufbxi_clear_error(p_error);
 		}
+		return &imp->probe;
+	} else {
+		ufbxi_fix_error_type(&uc->error, "Failed to probe");
+		if (p_error) *p_error = uc->error;
+		ufbxi_free_result(uc);
+		return NULL;
+	}
+}
 
-		ufbx_anim_prop *aprop = ufbxi_find_anim_prop_start(layer, element);
-		if (!aprop) continue;
+// -- Scene snapshots
 
-		for (size_t i = 0; i < num_props; i++) {
-			ufbx_prop *prop = &props[i];
+#if UFBXI_FEATURE_SNAPSHOT
 
-			// Don't evaluate on top of overridden properties
-			if ((prop->flags & UFBX_PROP_FLAG_OVERRIDDEN) != 0) continue;
+// Snapshots consist of a header, a copy of all the memory owned by the scene, and
+// a list of pointers in that memory. Pointers are stored as offsets to the start
+// of the data which are relocated in a single pass when loading. Pointers are found
+// by walking the public scene structs described by `ufbxi_snapshot_types[]`.
 
-			// Connections override animation by default
-			if ((prop->flags & UFBX_PROP_FLAG_CONNECTED) != 0 && !anim->ignore_connections) continue;
+#define UFBXI_SNAPSHOT_VERSION 1
 
-			// Skip until we reach `aprop >= prop`
-			while (aprop->element == element && aprop->_internal_key < prop->_internal_key) aprop++;
-			if (aprop->prop_name.data != prop->name.data) {
-				while (aprop->element == element && strcmp(aprop->prop_name.data, prop->name.data) < 0) aprop++;
-			}
+static const char ufbxi_snapshot_magic[8] = { 'u', 'f', 'b', 'x', 's', 'n', 'a', 'p' };
 
-			// TODO: Should we skip the blending for the first layer _per property_
-			// This could be done by having `UFBX_PROP_FLAG_ANIMATION_EVALUATED`
-			// that gets set for the first layer of animation that is applied.
-			if (aprop->prop_name.data == prop->name.data) {
-				ufbx_vec3 v = ufbx_evaluate_anim_value_vec3(aprop->anim_value, time);
-				if (layer_desc == anim->layers.data) {
-					prop->value_vec3 = v;
-				} else {
-					ufbxi_combine_anim_layer(&combine_ctx, layer, weight, prop->name.data, &prop->value_vec3, &v);
-				}
+typedef enum {
+	UFBXI_SNAPSHOT_RAW,    // < Data without any pointers, used only for list items
+	UFBXI_SNAPSHOT_STRING, // < `ufbx_string`
+	UFBXI_SNAPSHOT_BLOB,   // < `ufbx_blob`
+	UFBXI_SNAPSHOT_PTR,    // < Pointer to an element or data walked through some other field
+	UFBXI_SNAPSHOT_REF,    // < Pointer to a struct `type` that is walked through the pointer
+	UFBXI_SNAPSHOT_STRUCT, // < Inline struct `type`
+	UFBXI_SNAPSHOT_LIST,   // < List of `item_kind` values of `item_size` bytes
+} ufbxi_snapshot_kind;
+
+typedef struct {
+	uint32_t offset;
+	uint8_t kind;
+	uint8_t item_kind;
+	uint16_t type;
+	uint32_t count;
+	uint32_t item_size;
+} ufbxi_snapshot_field;
+
+typedef struct {
+	uint32_t size;
+	uint32_t first_field;
+	uint32_t num_fields;
+} ufbxi_snapshot_type;
+
+// Generated by `misc/gen_snapshot_layout.py`
+enum {
+	UFBXI_SNAPSHOT_TYPE_SCENE,
+	UFBXI_SNAPSHOT_TYPE_UNKNOWN,
+	UFBXI_SNAPSHOT_TYPE_NODE,
+	UFBXI_SNAPSHOT_TYPE_MESH,
+	UFBXI_SNAPSHOT_TYPE_LIGHT,
+	UFBXI_SNAPSHOT_TYPE_CAMERA,
+	UFBXI_SNAPSHOT_TYPE_BONE,
+	UFBXI_SNAPSHOT_TYPE_EMPTY,
+	UFBXI_SNAPSHOT_TYPE_LINE_CURVE,
+	UFBXI_SNAPSHOT_TYPE_NURBS_CURVE,
+	UFBXI_SNAPSHOT_TYPE_NURBS_SURFACE,
+	UFBXI_SNAPSHOT_TYPE_NURBS_TRIM_SURFACE,
+	UFBXI_SNAPSHOT_TYPE_NURBS_TRIM_BOUNDARY,
+	UFBXI_SNAPSHOT_TYPE_PROCEDURAL_GEOMETRY,
+	UFBXI_SNAPSHOT_TYPE_STEREO_CAMERA,
+	UFBXI_SNAPSHOT_TYPE_CAMERA_SWITCHER,
+	UFBXI_SNAPSHOT_TYPE_MARKER,
+	UFBXI_SNAPSHOT_TYPE_LOD_GROUP,
+	UFBXI_SNAPSHOT_TYPE_SKIN_DEFORMER,
+	UFBXI_SNAPSHOT_TYPE_SKIN_CLUSTER,
+	UFBXI_SNAPSHOT_TYPE_BLEND_DEFORMER,
+	UFBXI_SNAPSHOT_TYPE_BLEND_CHANNEL,
+	UFBXI_SNAPSHOT_TYPE_BLEND_SHAPE,
+	UFBXI_SNAPSHOT_TYPE_CACHE_DEFORMER,
+	UFBXI_SNAPSHOT_TYPE_CACHE_FILE,
+	UFBXI_SNAPSHOT_TYPE_MATERIAL,
+	UFBXI_SNAPSHOT_TYPE_TEXTURE,
+	UFBXI_SNAPSHOT_TYPE_VIDEO,
+	UFBXI_SNAPSHOT_TYPE_SHADER,
+	UFBXI_SNAPSHOT_TYPE_SHADER_BINDING,
+	UFBXI_SNAPSHOT_TYPE_ANIM_STACK,
+	UFBXI_SNAPSHOT_TYPE_ANIM_LAYER,
+	UFBXI_SNAPSHOT_TYPE_ANIM_VALUE,
+	UFBXI_SNAPSHOT_TYPE_ANIM_CURVE,
+	UFBXI_SNAPSHOT_TYPE_DISPLAY_LAYER,
+	UFBXI_SNAPSHOT_TYPE_SELECTION_SET,
+	UFBXI_SNAPSHOT_TYPE_SELECTION_NODE,
+	UFBXI_SNAPSHOT_TYPE_CHARACTER,
+	UFBXI_SNAPSHOT_TYPE_CONSTRAINT,
+	UFBXI_SNAPSHOT_TYPE_POSE,
+	UFBXI_SNAPSHOT_TYPE_METADATA_OBJECT,
+	UFBXI_SNAPSHOT_TYPE_METADATA,
+	UFBXI_SNAPSHOT_TYPE_SCENE_SETTINGS,
+	UFBXI_SNAPSHOT_TYPE_ANIM,
+	UFBXI_SNAPSHOT_TYPE_TEXTURE_FILE,
+	UFBXI_SNAPSHOT_TYPE_CONNECTION,
+	UFBXI_SNAPSHOT_TYPE_NAME_ELEMENT,
+	UFBXI_SNAPSHOT_TYPE_DOM_NODE,
+	UFBXI_SNAPSHOT_TYPE_ELEMENT,
+	UFBXI_SNAPSHOT_TYPE_VERTEX_VEC3,
+	UFBXI_SNAPSHOT_TYPE_VERTEX_VEC2,
+	UFBXI_SNAPSHOT_TYPE_VERTEX_VEC4,
+	UFBXI_SNAPSHOT_TYPE_VERTEX_REAL,
+	UFBXI_SNAPSHOT_TYPE_UV_SET,
+	UFBXI_SNAPSHOT_TYPE_COLOR_SET,
+	UFBXI_SNAPSHOT_TYPE_MESH_MATERIAL,
+	UFBXI_SNAPSHOT_TYPE_FACE_GROUP,
+	UFBXI_SNAPSHOT_TYPE_SUBDIVISION_RESULT,
+	UFBXI_SNAPSHOT_TYPE_NURBS_BASIS,
+	UFBXI_SNAPSHOT_TYPE_BLEND_KEYFRAME,
+	UFBXI_SNAPSHOT_TYPE_GEOMETRY_CACHE,
+	UFBXI_SNAPSHOT_TYPE_CACHE_CHANNEL,
+	UFBXI_SNAPSHOT_TYPE_MATERIAL_FBX_MAPS,
+	UFBXI_SNAPSHOT_TYPE_MATERIAL_PBR_MAPS,
+	UFBXI_SNAPSHOT_TYPE_MATERIAL_TEXTURE,
+	UFBXI_SNAPSHOT_TYPE_TEXTURE_LAYER,
+	UFBXI_SNAPSHOT_TYPE_SHADER_TEXTURE,
+	UFBXI_SNAPSHOT_TYPE_SHADER_PROP_BINDING,
+	UFBXI_SNAPSHOT_TYPE_ANIM_PROP,
+	UFBXI_SNAPSHOT_TYPE_CONSTRAINT_TARGET,
+	UFBXI_SNAPSHOT_TYPE_BONE_POSE,
+	UFBXI_SNAPSHOT_TYPE_WARNING,
+	UFBXI_SNAPSHOT_TYPE_PROPS,
+	UFBXI_SNAPSHOT_TYPE_APPLICATION,
+	UFBXI_SNAPSHOT_TYPE_ANIM_LAYER_DESC,
+	UFBXI_SNAPSHOT_TYPE_PROP_OVERRIDE,
+	UFBXI_SNAPSHOT_TYPE_DOM_VALUE,
+	UFBXI_SNAPSHOT_TYPE_CACHE_FRAME,
+	UFBXI_SNAPSHOT_TYPE_MATERIAL_MAP,
+	UFBXI_SNAPSHOT_TYPE_SHADER_TEXTURE_INPUT,
+	UFBXI_SNAPSHOT_TYPE_PROP,
+	UFBXI_SNAPSHOT_TYPE_COUNT,
+};
+
+static const ufbxi_snapshot_field ufbxi_snapshot_fields[] = {
+	{ offsetof(ufbx_scene, metadata), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_METADATA, 1, 0 },
+	{ offsetof(ufbx_scene, settings), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_SCENE_SETTINGS, 1, 0 },
+	{ offsetof(ufbx_scene, root_node), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_scene, anim), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ANIM, 1, 0 },
+	{ offsetof(ufbx_scene, combined_anim), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ANIM, 1, 0 },
+	{ offsetof(ufbx_scene, unknowns), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, nodes), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, meshes), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, lights), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, cameras), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, bones), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, empties), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, line_curves), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, nurbs_curves), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, nurbs_surfaces), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, nurbs_trim_surfaces), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, nurbs_trim_boundaries), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, procedural_geometries), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, stereo_cameras), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, camera_switchers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, markers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, lod_groups), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, skin_deformers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, skin_clusters), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, blend_deformers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, blend_channels), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, blend_shapes), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, cache_deformers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, cache_files), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, materials), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, textures), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, videos), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, shaders), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, shader_bindings), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, anim_stacks), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, anim_layers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, anim_values), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, anim_curves), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, display_layers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, selection_sets), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, selection_nodes), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, characters), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, constraints), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, poses), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, metadata_objects), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, texture_files), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_TEXTURE_FILE, 1, sizeof(ufbx_texture_file) },
+	{ offsetof(ufbx_scene, elements), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_scene, connections_src), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_CONNECTION, 1, sizeof(ufbx_connection) },
+	{ offsetof(ufbx_scene, connections_dst), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_CONNECTION, 1, sizeof(ufbx_connection) },
+	{ offsetof(ufbx_scene, elements_by_name), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_NAME_ELEMENT, 1, sizeof(ufbx_name_element) },
+	{ offsetof(ufbx_scene, dom_root), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_DOM_NODE, 1, 0 },
+	{ offsetof(ufbx_unknown, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_unknown, type), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_unknown, super_type), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_unknown, sub_type), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_node, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_node, parent), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_node, children), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_node, mesh), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_node, light), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_node, camera), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_node, bone), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_node, attrib), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_node, geometry_transform_helper), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_node, all_attribs), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_node, materials), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_mesh, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_mesh, faces), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_face) },
+	{ offsetof(ufbx_mesh, face_smoothing), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(bool) },
+	{ offsetof(ufbx_mesh, face_material), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_mesh, face_group), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_mesh, face_hole), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(bool) },
+	{ offsetof(ufbx_mesh, edges), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_edge) },
+	{ offsetof(ufbx_mesh, edge_smoothing), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(bool) },
+	{ offsetof(ufbx_mesh, edge_crease), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_real) },
+	{ offsetof(ufbx_mesh, edge_visibility), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(bool) },
+	{ offsetof(ufbx_mesh, vertex_indices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_mesh, vertices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_vec3) },
+	{ offsetof(ufbx_mesh, vertex_first_index), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_mesh, vertex_position), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC3, 1, 0 },
+	{ offsetof(ufbx_mesh, vertex_normal), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC3, 1, 0 },
+	{ offsetof(ufbx_mesh, vertex_uv), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC2, 1, 0 },
+	{ offsetof(ufbx_mesh, vertex_tangent), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC3, 1, 0 },
+	{ offsetof(ufbx_mesh, vertex_bitangent), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC3, 1, 0 },
+	{ offsetof(ufbx_mesh, vertex_color), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC4, 1, 0 },
+	{ offsetof(ufbx_mesh, vertex_crease), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_REAL, 1, 0 },
+	{ offsetof(ufbx_mesh, uv_sets), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_UV_SET, 1, sizeof(ufbx_uv_set) },
+	{ offsetof(ufbx_mesh, color_sets), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_COLOR_SET, 1, sizeof(ufbx_color_set) },
+	{ offsetof(ufbx_mesh, materials), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_MESH_MATERIAL, 1, sizeof(ufbx_mesh_material) },
+	{ offsetof(ufbx_mesh, face_groups), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_FACE_GROUP, 1, sizeof(ufbx_face_group) },
+	{ offsetof(ufbx_mesh, skinned_position), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC3, 1, 0 },
+	{ offsetof(ufbx_mesh, skinned_normal), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC3, 1, 0 },
+	{ offsetof(ufbx_mesh, skin_deformers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_mesh, blend_deformers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_mesh, cache_deformers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_mesh, all_deformers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_mesh, subdivision_result), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_SUBDIVISION_RESULT, 1, 0 },
+	{ offsetof(ufbx_light, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_camera, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_bone, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_empty, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_line_curve, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_line_curve, control_points), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_vec3) },
+	{ offsetof(ufbx_line_curve, point_indices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_line_curve, segments), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_line_segment) },
+	{ offsetof(ufbx_nurbs_curve, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_nurbs_curve, basis), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_NURBS_BASIS, 1, 0 },
+	{ offsetof(ufbx_nurbs_curve, control_points), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_vec4) },
+	{ offsetof(ufbx_nurbs_surface, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_nurbs_surface, basis_u), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_NURBS_BASIS, 1, 0 },
+	{ offsetof(ufbx_nurbs_surface, basis_v), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_NURBS_BASIS, 1, 0 },
+	{ offsetof(ufbx_nurbs_surface, control_points), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_vec4) },
+	{ offsetof(ufbx_nurbs_surface, material), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_nurbs_trim_surface, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_nurbs_trim_boundary, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_procedural_geometry, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_stereo_camera, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_stereo_camera, left), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_stereo_camera, right), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_camera_switcher, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_marker, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_lod_group, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_lod_group, lod_levels), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_lod_level) },
+	{ offsetof(ufbx_skin_deformer, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_skin_deformer, clusters), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_skin_deformer, vertices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_skin_vertex) },
+	{ offsetof(ufbx_skin_deformer, weights), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_skin_weight) },
+	{ offsetof(ufbx_skin_deformer, dq_vertices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_skin_deformer, dq_weights), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_real) },
+	{ offsetof(ufbx_skin_cluster, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_skin_cluster, bone_node), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_skin_cluster, vertices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_skin_cluster, weights), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_real) },
+	{ offsetof(ufbx_blend_deformer, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_blend_deformer, channels), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_blend_channel, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_blend_channel, keyframes), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_BLEND_KEYFRAME, 1, sizeof(ufbx_blend_keyframe) },
+	{ offsetof(ufbx_blend_shape, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_blend_shape, offset_vertices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_blend_shape, position_offsets), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_vec3) },
+	{ offsetof(ufbx_blend_shape, normal_offsets), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_vec3) },
+	{ offsetof(ufbx_cache_deformer, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_cache_deformer, channel), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_deformer, file), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_deformer, external_cache), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_GEOMETRY_CACHE, 1, 0 },
+	{ offsetof(ufbx_cache_deformer, external_channel), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_CACHE_CHANNEL, 1, 0 },
+	{ offsetof(ufbx_cache_file, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_cache_file, filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_file, absolute_filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_file, relative_filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_file, raw_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_file, raw_absolute_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_file, raw_relative_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_file, external_cache), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_GEOMETRY_CACHE, 1, 0 },
+	{ offsetof(ufbx_material, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_material, fbx), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_MATERIAL_FBX_MAPS, 1, 0 },
+	{ offsetof(ufbx_material, pbr), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_MATERIAL_PBR_MAPS, 1, 0 },
+	{ offsetof(ufbx_material, shader), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_material, shading_model_name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_material, shader_prop_prefix), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_material, textures), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_MATERIAL_TEXTURE, 1, sizeof(ufbx_material_texture) },
+	{ offsetof(ufbx_texture, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_texture, filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture, absolute_filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture, relative_filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture, raw_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture, raw_absolute_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture, raw_relative_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture, content), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture, video), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture, layers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_TEXTURE_LAYER, 1, sizeof(ufbx_texture_layer) },
+	{ offsetof(ufbx_texture, shader), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_SHADER_TEXTURE, 1, 0 },
+	{ offsetof(ufbx_texture, file_textures), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_texture, uv_set), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_video, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_video, filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_video, absolute_filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_video, relative_filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_video, raw_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_video, raw_absolute_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_video, raw_relative_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_video, content), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_shader, bindings), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_shader_binding, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_shader_binding, prop_bindings), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_SHADER_PROP_BINDING, 1, sizeof(ufbx_shader_prop_binding) },
+	{ offsetof(ufbx_anim_stack, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_anim_stack, layers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_anim_stack, anim), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ANIM, 1, 0 },
+	{ offsetof(ufbx_anim_layer, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_anim_layer, anim_values), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_anim_layer, anim_props), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_ANIM_PROP, 1, sizeof(ufbx_anim_prop) },
+	{ offsetof(ufbx_anim_layer, anim), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ANIM, 1, 0 },
+	{ offsetof(ufbx_anim_value, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_anim_value, curves), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 3, 0 },
+	{ offsetof(ufbx_anim_curve, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_anim_curve, keyframes), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_keyframe) },
+	{ offsetof(ufbx_anim_curve, segments), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_curve_segment) },
+	{ offsetof(ufbx_display_layer, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_display_layer, nodes), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_selection_set, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_selection_set, nodes), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_selection_node, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_selection_node, target_node), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_selection_node, target_mesh), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_selection_node, vertices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_selection_node, edges), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_selection_node, faces), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_character, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_constraint, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_constraint, type_name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_constraint, node), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_constraint, targets), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_CONSTRAINT_TARGET, 1, sizeof(ufbx_constraint_target) },
+	{ offsetof(ufbx_constraint, aim_up_node), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_constraint, ik_effector), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_constraint, ik_end_node), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_pose, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_pose, bone_poses), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_BONE_POSE, 1, sizeof(ufbx_bone_pose) },
+	{ offsetof(ufbx_metadata_object, element), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_ELEMENT, 1, 0 },
+	{ offsetof(ufbx_metadata, warnings), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_WARNING, 1, sizeof(ufbx_warning) },
+	{ offsetof(ufbx_metadata, creator), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_metadata, filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_metadata, relative_root), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_metadata, raw_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_metadata, raw_relative_root), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_metadata, scene_props), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_PROPS, 1, 0 },
+	{ offsetof(ufbx_metadata, original_application), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_APPLICATION, 1, 0 },
+	{ offsetof(ufbx_metadata, latest_application), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_APPLICATION, 1, 0 },
+	{ offsetof(ufbx_metadata, original_file_path), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_metadata, raw_original_file_path), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_scene_settings, props), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_PROPS, 1, 0 },
+	{ offsetof(ufbx_scene_settings, default_camera), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_anim, layers), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_ANIM_LAYER_DESC, 1, sizeof(ufbx_anim_layer_desc) },
+	{ offsetof(ufbx_anim, prop_overrides), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_PROP_OVERRIDE, 1, sizeof(ufbx_prop_override) },
+	{ offsetof(ufbx_texture_file, filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture_file, absolute_filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture_file, relative_filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture_file, raw_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture_file, raw_absolute_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture_file, raw_relative_filename), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture_file, content), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_connection, src), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_connection, dst), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_connection, src_prop), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_connection, dst_prop), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_name_element, name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_name_element, element), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_dom_node, name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_dom_node, children), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_TYPE_DOM_NODE, 1, sizeof(void*) },
+	{ offsetof(ufbx_dom_node, values), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_DOM_VALUE, 1, sizeof(ufbx_dom_value) },
+	{ offsetof(ufbx_element, name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_element, props), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_PROPS, 1, 0 },
+	{ offsetof(ufbx_element, instances), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_PTR, 0, 1, sizeof(void*) },
+	{ offsetof(ufbx_element, connections_src), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_CONNECTION, 1, sizeof(ufbx_connection) },
+	{ offsetof(ufbx_element, connections_dst), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_CONNECTION, 1, sizeof(ufbx_connection) },
+	{ offsetof(ufbx_element, dom_node), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_DOM_NODE, 1, 0 },
+	{ offsetof(ufbx_element, scene), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_vertex_vec3, values), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_vec3) },
+	{ offsetof(ufbx_vertex_vec3, indices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_vertex_vec2, values), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_vec2) },
+	{ offsetof(ufbx_vertex_vec2, indices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_vertex_vec4, values), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_vec4) },
+	{ offsetof(ufbx_vertex_vec4, indices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_vertex_real, values), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_real) },
+	{ offsetof(ufbx_vertex_real, indices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_uv_set, name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_uv_set, vertex_uv), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC2, 1, 0 },
+	{ offsetof(ufbx_uv_set, vertex_tangent), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC3, 1, 0 },
+	{ offsetof(ufbx_uv_set, vertex_bitangent), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC3, 1, 0 },
+	{ offsetof(ufbx_color_set, name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_color_set, vertex_color), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_VERTEX_VEC4, 1, 0 },
+	{ offsetof(ufbx_mesh_material, material), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_mesh_material, face_indices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_face_group, name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_face_group, face_indices), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(uint32_t) },
+	{ offsetof(ufbx_subdivision_result, source_vertex_ranges), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_subdivision_weight_range) },
+	{ offsetof(ufbx_subdivision_result, source_vertex_weights), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_subdivision_weight) },
+	{ offsetof(ufbx_subdivision_result, skin_cluster_ranges), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_subdivision_weight_range) },
+	{ offsetof(ufbx_subdivision_result, skin_cluster_weights), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_subdivision_weight) },
+	{ offsetof(ufbx_nurbs_basis, knot_vector), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_real) },
+	{ offsetof(ufbx_nurbs_basis, spans), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_RAW, 0, 1, sizeof(ufbx_real) },
+	{ offsetof(ufbx_blend_keyframe, shape), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_geometry_cache, root_filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_geometry_cache, channels), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_CACHE_CHANNEL, 1, sizeof(ufbx_cache_channel) },
+	{ offsetof(ufbx_geometry_cache, frames), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_CACHE_FRAME, 1, sizeof(ufbx_cache_frame) },
+	{ offsetof(ufbx_geometry_cache, extra_info), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRING, 0, 1, sizeof(ufbx_string) },
+	{ offsetof(ufbx_cache_channel, name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_channel, interpretation_name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_channel, frames), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_CACHE_FRAME, 1, sizeof(ufbx_cache_frame) },
+	{ offsetof(ufbx_material_fbx_maps, maps), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_MATERIAL_MAP, UFBX_MATERIAL_FBX_MAP_COUNT, 0 },
+	{ offsetof(ufbx_material_pbr_maps, maps), UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_MATERIAL_MAP, UFBX_MATERIAL_PBR_MAP_COUNT, 0 },
+	{ offsetof(ufbx_material_texture, material_prop), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_material_texture, shader_prop), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_material_texture, texture), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_texture_layer, texture), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_texture, shader_name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_texture, inputs), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_SHADER_TEXTURE_INPUT, 1, sizeof(ufbx_shader_texture_input) },
+	{ offsetof(ufbx_shader_texture, shader_source), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_texture, raw_shader_source), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_texture, main_texture), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_texture, prop_prefix), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_prop_binding, shader_prop), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_prop_binding, material_prop), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_anim_prop, element), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_anim_prop, prop_name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_anim_prop, anim_value), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_constraint_target, node), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_bone_pose, bone_node), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_warning, description), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_props, props), UFBXI_SNAPSHOT_LIST, UFBXI_SNAPSHOT_STRUCT, UFBXI_SNAPSHOT_TYPE_PROP, 1, sizeof(ufbx_prop) },
+	{ offsetof(ufbx_props, defaults), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_PROPS, 1, 0 },
+	{ offsetof(ufbx_application, vendor), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_application, name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_application, version), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_anim_layer_desc, layer), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_prop_override, prop_name), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_prop_override, value_str), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_dom_value, value_str), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_dom_value, value_blob), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_frame, channel), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_cache_frame, filename), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_material_map, texture), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_texture_input, name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_texture_input, value_str), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_texture_input, value_blob), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_texture_input, texture), UFBXI_SNAPSHOT_PTR, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_shader_texture_input, prop), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_PROP, 1, 0 },
+	{ offsetof(ufbx_shader_texture_input, texture_prop), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_PROP, 1, 0 },
+	{ offsetof(ufbx_shader_texture_input, texture_enabled_prop), UFBXI_SNAPSHOT_REF, UFBXI_SNAPSHOT_RAW, UFBXI_SNAPSHOT_TYPE_PROP, 1, 0 },
+	{ offsetof(ufbx_prop, name), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_prop, value_str), UFBXI_SNAPSHOT_STRING, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+	{ offsetof(ufbx_prop, value_blob), UFBXI_SNAPSHOT_BLOB, UFBXI_SNAPSHOT_RAW, 0, 1, 0 },
+};
+
+static const ufbxi_snapshot_type ufbxi_snapshot_types[] = {
+	{ sizeof(ufbx_scene), 0, 51 },
+	{ sizeof(ufbx_unknown), 51, 4 },
+	{ sizeof(ufbx_node), 55, 11 },
+	{ sizeof(ufbx_mesh), 66, 31 },
+	{ sizeof(ufbx_light), 97, 1 },
+	{ sizeof(ufbx_camera), 98, 1 },
+	{ sizeof(ufbx_bone), 99, 1 },
+	{ sizeof(ufbx_empty), 100, 1 },
+	{ sizeof(ufbx_line_curve), 101, 4 },
+	{ sizeof(ufbx_nurbs_curve), 105, 3 },
+	{ sizeof(ufbx_nurbs_surface), 108, 5 },
+	{ sizeof(ufbx_nurbs_trim_surface), 113, 1 },
+	{ sizeof(ufbx_nurbs_trim_boundary), 114, 1 },
+	{ sizeof(ufbx_procedural_geometry), 115, 1 },
+	{ sizeof(ufbx_stereo_camera), 116, 3 },
+	{ sizeof(ufbx_camera_switcher), 119, 1 },
+	{ sizeof(ufbx_marker), 120, 1 },
+	{ sizeof(ufbx_lod_group), 121, 2 },
+	{ sizeof(ufbx_skin_deformer), 123, 6 },
+	{ sizeof(ufbx_skin_cluster), 129, 4 },
+	{ sizeof(ufbx_blend_deformer), 133, 2 },
+	{ sizeof(ufbx_blend_channel), 135, 2 },
+	{ sizeof(ufbx_blend_shape), 137, 4 },
+	{ sizeof(ufbx_cache_deformer), 141, 5 },
+	{ sizeof(ufbx_cache_file), 146, 8 },
+	{ sizeof(ufbx_material), 154, 7 },
+	{ sizeof(ufbx_texture), 161, 13 },
+	{ sizeof(ufbx_video), 174, 8 },
+	{ sizeof(ufbx_shader), 182, 2 },
+	{ sizeof(ufbx_shader_binding), 184, 2 },
+	{ sizeof(ufbx_anim_stack), 186, 3 },
+	{ sizeof(ufbx_anim_layer), 189, 4 },
+	{ sizeof(ufbx_anim_value), 193, 2 },
+	{ sizeof(ufbx_anim_curve), 195, 3 },
+	{ sizeof(ufbx_display_layer), 198, 2 },
+	{ sizeof(ufbx_selection_set), 200, 2 },
+	{ sizeof(ufbx_selection_node), 202, 6 },
+	{ sizeof(ufbx_character), 208, 1 },
+	{ sizeof(ufbx_constraint), 209, 7 },
+	{ sizeof(ufbx_pose), 216, 2 },
+	{ sizeof(ufbx_metadata_object), 218, 1 },
+	{ sizeof(ufbx_metadata), 219, 11 },
+	{ sizeof(ufbx_scene_settings), 230, 2 },
+	{ sizeof(ufbx_anim), 232, 2 },
+	{ sizeof(ufbx_texture_file), 234, 7 },
+	{ sizeof(ufbx_connection), 241, 4 },
+	{ sizeof(ufbx_name_element), 245, 2 },
+	{ sizeof(ufbx_dom_node), 247, 3 },
+	{ sizeof(ufbx_element), 250, 7 },
+	{ sizeof(ufbx_vertex_vec3), 257, 2 },
+	{ sizeof(ufbx_vertex_vec2), 259, 2 },
+	{ sizeof(ufbx_vertex_vec4), 261, 2 },
+	{ sizeof(ufbx_vertex_real), 263, 2 },
+	{ sizeof(ufbx_uv_set), 265, 4 },
+	{ sizeof(ufbx_color_set), 269, 2 },
+	{ sizeof(ufbx_mesh_material), 271, 2 },
+	{ sizeof(ufbx_face_group), 273, 2 },
+	{ sizeof(ufbx_subdivision_result), 275, 4 },
+	{ sizeof(ufbx_nurbs_basis), 279, 2 },
+	{ sizeof(ufbx_blend_keyframe), 281, 1 },
+	{ sizeof(ufbx_geometry_cache), 282, 4 },
+	{ sizeof(ufbx_cache_channel), 286, 3 },
+	{ sizeof(ufbx_material_fbx_maps), 289, 1 },
+	{ sizeof(ufbx_material_pbr_maps), 290, 1 },
+	{ sizeof(ufbx_material_texture), 291, 3 },
+	{ sizeof(ufbx_texture_layer), 294, 1 },
+	{ sizeof(ufbx_shader_texture), 295, 6 },
+	{ sizeof(ufbx_shader_prop_binding), 301, 2 },
+	{ sizeof(ufbx_anim_prop), 303, 3 },
+	{ sizeof(ufbx_constraint_target), 306, 1 },
+	{ sizeof(ufbx_bone_pose), 307, 1 },
+	{ sizeof(ufbx_warning), 308, 1 },
+	{ sizeof(ufbx_props), 309, 2 },
+	{ sizeof(ufbx_application), 311, 3 },
+	{ sizeof(ufbx_anim_layer_desc), 314, 1 },
+	{ sizeof(ufbx_prop_override), 315, 2 },
+	{ sizeof(ufbx_dom_value), 317, 2 },
+	{ sizeof(ufbx_cache_frame), 319, 2 },
+	{ sizeof(ufbx_material_map), 321, 1 },
+	{ sizeof(ufbx_shader_texture_input), 322, 7 },
+	{ sizeof(ufbx_prop), 329, 3 },
+};
+
+static const uint8_t ufbxi_snapshot_element_types[] = {
+	UFBXI_SNAPSHOT_TYPE_UNKNOWN,
+	UFBXI_SNAPSHOT_TYPE_NODE,
+	UFBXI_SNAPSHOT_TYPE_MESH,
+	UFBXI_SNAPSHOT_TYPE_LIGHT,
+	UFBXI_SNAPSHOT_TYPE_CAMERA,
+	UFBXI_SNAPSHOT_TYPE_BONE,
+	UFBXI_SNAPSHOT_TYPE_EMPTY,
+	UFBXI_SNAPSHOT_TYPE_LINE_CURVE,
+	UFBXI_SNAPSHOT_TYPE_NURBS_CURVE,
+	UFBXI_SNAPSHOT_TYPE_NURBS_SURFACE,
+	UFBXI_SNAPSHOT_TYPE_NURBS_TRIM_SURFACE,
+	UFBXI_SNAPSHOT_TYPE_NURBS_TRIM_BOUNDARY,
+	UFBXI_SNAPSHOT_TYPE_PROCEDURAL_GEOMETRY,
+	UFBXI_SNAPSHOT_TYPE_STEREO_CAMERA,
+	UFBXI_SNAPSHOT_TYPE_CAMERA_SWITCHER,
+	UFBXI_SNAPSHOT_TYPE_MARKER,
+	UFBXI_SNAPSHOT_TYPE_LOD_GROUP,
+	UFBXI_SNAPSHOT_TYPE_SKIN_DEFORMER,
+	UFBXI_SNAPSHOT_TYPE_SKIN_CLUSTER,
+	UFBXI_SNAPSHOT_TYPE_BLEND_DEFORMER,
+	UFBXI_SNAPSHOT_TYPE_BLEND_CHANNEL,
+	UFBXI_SNAPSHOT_TYPE_BLEND_SHAPE,
+	UFBXI_SNAPSHOT_TYPE_CACHE_DEFORMER,
+	UFBXI_SNAPSHOT_TYPE_CACHE_FILE,
+	UFBXI_SNAPSHOT_TYPE_MATERIAL,
+	UFBXI_SNAPSHOT_TYPE_TEXTURE,
+	UFBXI_SNAPSHOT_TYPE_VIDEO,
+	UFBXI_SNAPSHOT_TYPE_SHADER,
+	UFBXI_SNAPSHOT_TYPE_SHADER_BINDING,
+	UFBXI_SNAPSHOT_TYPE_ANIM_STACK,
+	UFBXI_SNAPSHOT_TYPE_ANIM_LAYER,
+	UFBXI_SNAPSHOT_TYPE_ANIM_VALUE,
+	UFBXI_SNAPSHOT_TYPE_ANIM_CURVE,
+	UFBXI_SNAPSHOT_TYPE_DISPLAY_LAYER,
+	UFBXI_SNAPSHOT_TYPE_SELECTION_SET,
+	UFBXI_SNAPSHOT_TYPE_SELECTION_NODE,
+	UFBXI_SNAPSHOT_TYPE_CHARACTER,
+	UFBXI_SNAPSHOT_TYPE_CONSTRAINT,
+	UFBXI_SNAPSHOT_TYPE_POSE,
+	UFBXI_SNAPSHOT_TYPE_METADATA_OBJECT,
+};
+
+ufbx_static_assert(snapshot_element_types, ufbxi_arraycount(ufbxi_snapshot_element_types) == UFBX_ELEMENT_TYPE_COUNT);
+
+typedef struct {
+	char magic[8];
+	uint32_t version;
+	uint32_t layout_hash;
+	uint64_t key;
+	uint64_t data_size;
+	uint64_t num_relocs;
+	uint64_t scene_offset;
+} ufbxi_snapshot_header;
+
+ufbx_static_assert(snapshot_header_size, sizeof(ufbxi_snapshot_header) % 16 == 0);
+
+// Hash of everything that affects the binary layout of the scene, snapshots
+// can only be loaded by builds that have a matching hash.
+static ufbxi_noinline uint32_t ufbxi_snapshot_layout_hash(void)
+{
+	const uint8_t endian_bytes[4] = { 1, 2, 3, 4 };
+	uint32_t endian;
+	memcpy(&endian, endian_bytes, sizeof(endian));
+
+	uint32_t hash = ufbxi_hash32(UFBXI_SNAPSHOT_VERSION);
+	hash = ufbxi_hash64((uint64_t)hash << 32u | ufbx_source_version);
+	hash = ufbxi_hash64((uint64_t)hash << 32u | endian);
+	hash = ufbxi_hash64((uint64_t)hash << 32u | (uint32_t)sizeof(void*));
+	hash = ufbxi_hash64((uint64_t)hash << 32u | (uint32_t)sizeof(ufbx_real));
+	hash = ufbxi_hash64((uint64_t)hash << 32u | (uint32_t)sizeof(ufbxi_scene_imp));
+	ufbxi_nounroll for (size_t i = 0; i < ufbxi_arraycount(ufbxi_snapshot_types); i++) {
+		const ufbxi_snapshot_type *type = &ufbxi_snapshot_types[i];
+		hash = ufbxi_hash64((uint64_t)hash << 32u | type->size);
+		hash = ufbxi_hash64((uint64_t)hash << 32u | type->num_fields);
+	}
+	ufbxi_nounroll for (size_t i = 0; i < ufbxi_arraycount(ufbxi_snapshot_fields); i++) {
+		const ufbxi_snapshot_field *field = &ufbxi_snapshot_fields[i];
+		hash = ufbxi_hash64((uint64_t)hash << 32u | field->offset);
+		hash = ufbxi_hash64((uint64_t)hash << 32u | (uint32_t)field->kind << 24u | (uint32_t)field->item_kind << 16u | field->type);
+		hash = ufbxi_hash64((uint64_t)hash << 32u | field->count);
+		hash = ufbxi_hash64((uint64_t)hash << 32u | field->item_size);
+	}
+	return hash;
+}
+
+typedef struct {
+	ufbxi_refcount refcount;
+	ufbx_snapshot snapshot;
+	uint32_t magic;
+
+	ufbxi_allocator ator;
+	char *data;
+	size_t data_size;
+} ufbxi_snapshot_imp;
+
+ufbx_static_assert(snapshot_imp_offset, offsetof(ufbxi_snapshot_imp, snapshot) == sizeof(ufbxi_refcount));
+
+// Memory block owned by the scene, copied to `offset` in the snapshot data
+typedef struct {
+	uintptr_t begin;
+	size_t size;
+	size_t offset;
+} ufbxi_snapshot_region;
+
+// Data outside of the scene memory that is copied to the snapshot
+typedef struct {
+	uintptr_t address; // < Must be first for `ufbxi_map_cmp_uintptr()`
+	size_t size;
+	size_t offset;
+} ufbxi_snapshot_external;
+
+typedef struct {
+	ufbx_error error;
+	ufbx_snapshot_opts opts;
+
+	ufbxi_allocator ator_tmp;
+	ufbxi_allocator ator_result;
+
+	ufbxi_buf tmp;
+	ufbxi_buf tmp_externals;
+	ufbxi_map external_map;
+	ufbxi_map ref_map;
+	size_t num_externals;
+
+	ufbxi_snapshot_region *regions;
+	size_t num_regions;
+	size_t region_hint;
+
+	// Bit per pointer sized word in the copied regions set for every relocated pointer
+	uint8_t *reloc_bits;
+	size_t num_words;
+
+	// Snapshot being written, `data` points past the header
+	char *dst;
+	size_t dst_size;
+	char *data;
+	size_t regions_size;
+	size_t data_size;
+
+	ufbxi_snapshot_imp *imp;
+} ufbxi_snapshot_context;
+
+// Find the index of the region containing `address`, checking the previous index `*p_hint` first.
+static ufbxi_noinline bool ufbxi_snapshot_find_region(const ufbxi_snapshot_region *regions, size_t num_regions, size_t *p_hint, uintptr_t address)
+{
+	// Pointers tend to be local so check the previously found region first.
+	// NOTE: Regions are inclusive at the end to allow for one-past-end pointers.
+	size_t ix = *p_hint;
+	if (!(address >= regions[ix].begin && address - regions[ix].begin <= regions[ix].size)) {
+		size_t lo = 0, hi = num_regions;
+		while (hi - lo > 1) {
+			size_t mid = lo + (hi - lo) / 2;
+			if (address >= regions[mid].begin) {
+				lo = mid;
+			} else {
+				hi = mid;
 			}
 		}
+		ix = lo;
+		if (!(address >= regions[ix].begin && address - regions[ix].begin <= regions[ix].size)) return false;
+		*p_hint = ix;
 	}
+	return true;
+}
 
-	ufbxi_for(ufbx_prop, prop, props, num_props) {
-		prop->value_int = ufbxi_f64_to_i64(prop->value_real);
-	}
+static ufbxi_noinline bool ufbxi_snapshot_find(ufbxi_snapshot_context *sc, const void *ptr, size_t *p_offset)
+{
+	uintptr_t address = (uintptr_t)ptr;
+	if (!ufbxi_snapshot_find_region(sc->regions, sc->num_regions, &sc->region_hint, address)) return false;
+
+	const ufbxi_snapshot_region *region = &sc->regions[sc->region_hint];
+	*p_offset = region->offset + (size_t)(address - region->begin);
+	return true;
 }
 
-// Recursion limited by not calling `ufbx_evaluate_prop_len()` with a connected property,
-// meaning it will never call `ufbxi_evaluate_connected_prop()` again indirectly.
-static ufbxi_noinline void ufbxi_evaluate_connected_prop(ufbx_prop *prop, const ufbx_anim *anim, const ufbx_element *element, const char *name, double time)
-	ufbxi_recursive_function_void(ufbxi_evaluate_connected_prop, (prop, anim, element, name, time), 3,
-		(ufbx_prop *prop, const ufbx_anim *anim, const ufbx_element *element, const char *name, double time))
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_add_external(ufbxi_snapshot_context *sc, const void *ptr, size_t size, size_t *p_offset)
 {
-	ufbx_connection *conn = ufbxi_find_prop_connection(element, name);
+	uintptr_t address = (uintptr_t)ptr;
+	uint32_t hash = ufbxi_hash_uptr(address);
 
-	for (size_t i = 0; i < 1000 && conn; i++) {
-		ufbx_connection *next_conn = ufbxi_find_prop_connection(conn->src, conn->src_prop.data);
-		if (!next_conn) break;
-		conn = next_conn;
+	ufbxi_snapshot_external *entry = ufbxi_map_find(&sc->external_map, ufbxi_snapshot_external, hash, &address);
+	if (entry && entry->size >= size) {
+		*p_offset = entry->offset;
+		return 1;
 	}
 
-	// Found a non-cyclic connection
-	if (conn && !ufbxi_find_prop_connection(conn->src, conn->src_prop.data)) {
-		ufbx_prop ep = ufbx_evaluate_prop_len(anim, conn->src, conn->src_prop.data, conn->src_prop.length, time);
-		prop->value_vec4 = ep.value_vec4;
-		prop->value_int = ep.value_int;
-		prop->value_str = ep.value_str;
-		prop->value_blob = ep.value_blob;
-	} else {
-		// Connection not found, maybe it's animated?
-		prop->flags = (ufbx_prop_flags)((uint32_t)prop->flags & ~(uint32_t)UFBX_PROP_FLAG_CONNECTED);
+	ufbxi_snapshot_external external;
+	external.address = address;
+	external.size = size;
+	external.offset = ufbxi_align_to_mask(sc->data_size, 0xf);
+	ufbxi_check_err(&sc->error, external.offset <= SIZE_MAX - size);
+	sc->data_size = external.offset + size;
+
+	if (!entry) {
+		entry = ufbxi_map_insert(&sc->external_map, ufbxi_snapshot_external, hash, &address);
+		ufbxi_check_err(&sc->error, entry);
 	}
+	*entry = external;
+
+	ufbxi_check_err(&sc->error, ufbxi_push_copy(&sc->tmp_externals, ufbxi_snapshot_external, 1, &external));
+	sc->num_externals++;
+
+	*p_offset = external.offset;
+	return 1;
 }
 
-static ufbxi_noinline ufbx_props ufbxi_evaluate_selected_props(const ufbx_anim *anim, const ufbx_element *element, double time, ufbx_prop *props, const char **prop_names, size_t max_props)
+// Store `target` to the pointer at `slot` in the snapshot data. Data outside of
+// the scene is copied if `copy_size != SIZE_MAX`.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_pointer(ufbxi_snapshot_context *sc, size_t slot, const void *target, size_t copy_size, size_t *p_offset)
 {
-	const char *name = prop_names[0];
-	uint32_t key = ufbxi_get_name_key_c(name);
-	size_t num_props = 0;
+	if (!target) return 1;
 
-	const ufbx_prop_override *over = NULL, *over_end = NULL;
-	if (anim->prop_overrides.count > 0) {
-		ufbx_const_prop_override_list list = ufbxi_find_element_prop_overrides(&anim->prop_overrides, element->element_id);
-		over = list.data;
-		over_end = over + list.count;
+	size_t offset = 0;
+	if (!ufbxi_snapshot_find(sc, target, &offset)) {
+		ufbxi_check_err_msg(&sc->error, copy_size != SIZE_MAX, "Pointer outside of the scene");
+		ufbxi_check_err(&sc->error, ufbxi_snapshot_add_external(sc, target, copy_size, &offset));
 	}
 
-#if defined(UFBX_REGRESSION)
-	for (size_t i = 1; i < max_props; i++) {
-		ufbx_assert(strcmp(prop_names[i - 1], prop_names[i]) < 0);
-	}
-#endif
+	ufbx_assert(slot % sizeof(void*) == 0 && slot < sc->regions_size);
+	size_t word = slot / sizeof(void*);
+	sc->reloc_bits[word >> 3] |= (uint8_t)(1u << (word & 7));
 
-	size_t name_ix = 0;
-	for (size_t i = 0; i < element->props.props.count; i++) {
-		ufbx_prop *prop = &element->props.props.data[i];
+	uintptr_t value = (uintptr_t)offset;
+	memcpy(sc->data + slot, &value, sizeof(uintptr_t));
 
-		while (name_ix < max_props) {
-			if (key > prop->_internal_key) break;
+	if (p_offset) *p_offset = offset;
+	return 1;
+}
 
-			if (over) {
-				bool found_override = false;
-				for (; over != over_end; over++) {
-					ufbx_prop *dst = &props[num_props];
-					if (over->_internal_key < key || strcmp(over->prop_name, name) < 0) {
-						continue;
-					} else if (over->_internal_key == key && strcmp(over->prop_name, name) == 0) {
-						dst->name = ufbxi_str_c(name);
-						dst->_internal_key = key;
-						dst->type = UFBX_PROP_UNKNOWN;
-						dst->flags = UFBX_PROP_FLAG_OVERRIDDEN;
-					} else {
-						break;
-					}
-					dst->value_str = ufbxi_str_c(over->value_str);
-					dst->value_blob.data = dst->value_str.data;
-					dst->value_blob.size = dst->value_str.length;
-					dst->value_int = over->value_int;
-					dst->value_vec3 = over->value;
-					dst->value_real_arr[3] = 0.0f;
-					num_props++;
-					found_override = true;
-				}
-				if (found_override) break;
-			}
+// Size of a single value of `field`, arrays of `field->count` values are laid out with this stride
+static ufbxi_noinline size_t ufbxi_snapshot_field_stride(const ufbxi_snapshot_field *field)
+{
+	switch (field->kind) {
+	case UFBXI_SNAPSHOT_STRING: return sizeof(ufbx_string);
+	case UFBXI_SNAPSHOT_BLOB: return sizeof(ufbx_blob);
+	case UFBXI_SNAPSHOT_PTR: return sizeof(void*);
+	case UFBXI_SNAPSHOT_REF: return sizeof(void*);
+	case UFBXI_SNAPSHOT_STRUCT: return ufbxi_snapshot_types[field->type].size;
+	case UFBXI_SNAPSHOT_LIST: return sizeof(ufbx_void_list);
+	default: ufbx_assert(0 && "Unhandled snapshot kind"); return 0;
+	}
+}
 
-			if (name == prop->name.data) {
-				if ((prop->flags & UFBX_PROP_FLAG_CONNECTED) != 0 && !anim->ignore_connections) {
-					ufbx_prop *dst = &props[num_props++];
-					*dst = *prop;
-					ufbxi_evaluate_connected_prop(dst, anim, element, name, time);
-				} else if (prop->flags & UFBX_PROP_FLAG_ANIMATED) {
-					props[num_props++] = *prop;
-				}
-				break;
-			} else if (strcmp(name, prop->name.data) < 0) {
-				name_ix++;
-				if (name_ix < max_props) {
-					name = prop_names[name_ix];
-					key = ufbxi_get_name_key_c(name);
-				}
-			} else {
-				break;
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_walk(ufbxi_snapshot_context *sc, const char *ptr, size_t offset, uint32_t type_ix);
+
+// Relocate the value of `kind` at `ptr` which is copied to `offset` in the snapshot
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_value(ufbxi_snapshot_context *sc, const char *ptr, size_t offset, uint32_t kind, uint32_t type_ix)
+{
+	switch (kind) {
+
+	case UFBXI_SNAPSHOT_STRING: {
+		const ufbx_string *str = (const ufbx_string*)ptr;
+		ufbxi_check_err(&sc->error, ufbxi_snapshot_pointer(sc, offset + offsetof(ufbx_string, data), str->data, str->length + 1, NULL));
+	} break;
+
+	case UFBXI_SNAPSHOT_BLOB: {
+		const ufbx_blob *blob = (const ufbx_blob*)ptr;
+		ufbxi_check_err(&sc->error, ufbxi_snapshot_pointer(sc, offset + offsetof(ufbx_blob, data), blob->data, blob->size, NULL));
+	} break;
+
+	case UFBXI_SNAPSHOT_PTR: {
+		const void *target = *(const void*const*)ptr;
+		ufbxi_check_err(&sc->error, ufbxi_snapshot_pointer(sc, offset, target, SIZE_MAX, NULL));
+	} break;
+
+	case UFBXI_SNAPSHOT_REF: {
+		const char *target = *(const char*const*)ptr;
+		size_t target_offset = 0;
+		ufbxi_check_err(&sc->error, ufbxi_snapshot_pointer(sc, offset, target, SIZE_MAX, &target_offset));
+		if (target) {
+			// Walk each referenced struct only once
+			uint64_t key = (uint64_t)target_offset << 16u | type_ix;
+			uint32_t hash = ufbxi_hash64(key);
+			if (!ufbxi_map_find(&sc->ref_map, uint64_t, hash, &key)) {
+				uint64_t *entry = ufbxi_map_insert(&sc->ref_map, uint64_t, hash, &key);
+				ufbxi_check_err(&sc->error, entry);
+				*entry = key;
+				ufbxi_check_err(&sc->error, ufbxi_snapshot_walk(sc, target, target_offset, type_ix));
 			}
 		}
+	} break;
+
+	case UFBXI_SNAPSHOT_STRUCT: {
+		ufbxi_check_err(&sc->error, ufbxi_snapshot_walk(sc, ptr, offset, type_ix));
+	} break;
+
+	default:
+		ufbx_assert(0 && "Unhandled snapshot kind");
+		break;
+
 	}
 
-	if (over) {
-		for (; over != over_end && name_ix < max_props; over++) {
-			ufbx_prop *dst = &props[num_props];
-			if (over->_internal_key < key || strcmp(over->prop_name, name) < 0) {
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_walk(ufbxi_snapshot_context *sc, const char *ptr, size_t offset, uint32_t type_ix)
+{
+	ufbx_assert(type_ix < UFBXI_SNAPSHOT_TYPE_COUNT);
+	const ufbxi_snapshot_type *type = &ufbxi_snapshot_types[type_ix];
+
+	const ufbxi_snapshot_field *fields = ufbxi_snapshot_fields + type->first_field;
+	ufbxi_nounroll for (size_t field_ix = 0; field_ix < type->num_fields; field_ix++) {
+		const ufbxi_snapshot_field *field = &fields[field_ix];
+
+		size_t stride = ufbxi_snapshot_field_stride(field);
+		for (size_t i = 0; i < field->count; i++) {
+			const char *field_ptr = ptr + field->offset + i * stride;
+			size_t field_offset = offset + field->offset + i * stride;
+
+			if (field->kind != UFBXI_SNAPSHOT_LIST) {
+				ufbxi_check_err(&sc->error, ufbxi_snapshot_value(sc, field_ptr, field_offset, field->kind, field->type));
 				continue;
-			} else if (over->_internal_key == key && strcmp(over->prop_name, name) == 0) {
-				dst->name = ufbxi_str_c(name);
-				dst->_internal_key = key;
-				dst->type = UFBX_PROP_UNKNOWN;
-				dst->flags = UFBX_PROP_FLAG_OVERRIDDEN;
-			} else {
-				name_ix++;
-				if (name_ix < max_props) {
-					name = prop_names[name_ix];
-					key = ufbxi_get_name_key_c(name);
-				}
 			}
-			dst->value_str = ufbxi_str_c(over->value_str);
-			dst->value_blob.data = dst->value_str.data;
-			dst->value_blob.size = dst->value_str.length;
-			dst->value_int = over->value_int;
-			dst->value_vec3 = over->value;
-			dst->value_real_arr[3] = 0.0f;
-			num_props++;
+
+			// Lists of plain data can be copied from outside of the scene memory, others
+			// need their items to be relocated in place.
+			const ufbx_void_list *list = (const ufbx_void_list*)field_ptr;
+			bool raw = field->item_kind == UFBXI_SNAPSHOT_RAW || list->count == 0;
+			size_t copy_size = SIZE_MAX;
+			if (raw) {
+				ufbxi_check_err(&sc->error, !ufbxi_does_overflow(list->count * field->item_size, list->count, field->item_size));
+				copy_size = list->count * field->item_size;
+			}
+
+			size_t data_offset = 0;
+			ufbxi_check_err(&sc->error, ufbxi_snapshot_pointer(sc, field_offset + offsetof(ufbx_void_list, data), list->data, copy_size, &data_offset));
+			if (raw) continue;
+
+			const char *items = (const char*)list->data;
+			for (size_t item_ix = 0; item_ix < list->count; item_ix++) {
+				size_t item_offset = item_ix * field->item_size;
+				ufbxi_check_err(&sc->error, ufbxi_snapshot_value(sc, items + item_offset, data_offset + item_offset, field->item_kind, field->type));
+			}
+		}
+	}
+
+	// DOM raw string arrays are stored as a blob containing an array of blobs
+	if (type_ix == UFBXI_SNAPSHOT_TYPE_DOM_VALUE) {
+		const ufbx_dom_value *value = (const ufbx_dom_value*)ptr;
+		size_t num_blobs = value->value_blob.size / sizeof(ufbx_blob);
+		if (value->type == UFBX_DOM_VALUE_ARRAY_RAW_STRING && num_blobs > 0) {
+			size_t blobs_offset = 0;
+			ufbxi_check_err_msg(&sc->error, ufbxi_snapshot_find(sc, value->value_blob.data, &blobs_offset), "Pointer outside of the scene");
+			const ufbx_blob *blobs = (const ufbx_blob*)value->value_blob.data;
+			for (size_t i = 0; i < num_blobs; i++) {
+				ufbxi_check_err(&sc->error, ufbxi_snapshot_value(sc, (const char*)&blobs[i], blobs_offset + i * sizeof(ufbx_blob), UFBXI_SNAPSHOT_BLOB, 0));
+			}
+		}
+	}
+
+	return 1;
+}
+
+// Append the used memory of the chunks in `buf` to `regions` (if non-`NULL`), returns the new number of regions.
+static ufbxi_noinline size_t ufbxi_snapshot_buf_regions(ufbxi_snapshot_region *regions, size_t num_regions, const ufbxi_buf *buf)
+{
+	ufbxi_nounroll for (size_t i = 0; i < 2; i++) {
+		ufbxi_buf_chunk *chunk = buf->chunks[i];
+		if (!chunk) continue;
+		for (chunk = chunk->root; chunk; chunk = chunk->next) {
+			// The active chunk tracks its position in the buffer
+			size_t used = chunk == buf->chunks[0] ? buf->pos : chunk->pushed_pos;
+			if (used == 0) continue;
+			if (regions) {
+				ufbxi_snapshot_region *region = &regions[num_regions];
+				region->begin = (uintptr_t)chunk->data;
+				region->size = used;
+				region->offset = 0;
+			}
+			num_regions++;
+		}
+	}
+	return num_regions;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_save_snapshot_imp(ufbxi_snapshot_context *sc, const ufbx_scene *scene)
+{
+	ufbx_assert(sc->opts._begin_zero == 0 && sc->opts._end_zero == 0);
+	ufbxi_check_err_msg(&sc->error, sc->opts._begin_zero == 0 && sc->opts._end_zero == 0, "Uninitialized options");
+
+	const ufbxi_scene_imp *scene_imp = ufbxi_get_imp(ufbxi_scene_imp, scene);
+	ufbxi_check_err(&sc->error, scene_imp->magic == UFBXI_SCENE_IMP_MAGIC);
+
+	// Lazy meshes refer to the original file that is not part of the snapshot
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, scene->meshes) {
+		ufbxi_check_err_msg(&sc->error, !(*p_mesh)->lazy_geometry, "Lazy geometry in snapshot");
+	}
+
+	// Collect all the chunks owned by the scene sorted by address
+	size_t num_regions = ufbxi_snapshot_buf_regions(NULL, 0, &scene_imp->result_buf);
+	num_regions = ufbxi_snapshot_buf_regions(NULL, num_regions, &scene_imp->string_buf);
+	ufbxi_check_err(&sc->error, num_regions > 0);
+
+	sc->regions = ufbxi_alloc(&sc->ator_tmp, ufbxi_snapshot_region, num_regions * 2);
+	ufbxi_check_err(&sc->error, sc->regions);
+
+	sc->num_regions = ufbxi_snapshot_buf_regions(sc->regions, 0, &scene_imp->result_buf);
+	sc->num_regions = ufbxi_snapshot_buf_regions(sc->regions, sc->num_regions, &scene_imp->string_buf);
+	ufbx_assert(sc->num_regions == num_regions);
+
+	ufbxi_macro_stable_sort(ufbxi_snapshot_region, 16, sc->regions, sc->regions + num_regions, num_regions, ( a->begin < b->begin ));
+
+	size_t regions_size = 0;
+	for (size_t i = 0; i < num_regions; i++) {
+		ufbxi_snapshot_region *region = &sc->regions[i];
+		region->offset = ufbxi_align_to_mask(regions_size, 0xf);
+		regions_size = region->offset + region->size;
+	}
+	regions_size = ufbxi_align_to_mask(regions_size, 0xf);
+
+	// Relocations are stored as 32-bit word indices
+	ufbxi_check_err_msg(&sc->error, regions_size / sizeof(void*) < UINT32_MAX, "Snapshot too large");
+
+	sc->regions_size = regions_size;
+	sc->data_size = regions_size;
+	sc->num_words = regions_size / sizeof(void*);
+	sc->reloc_bits = ufbxi_alloc(&sc->ator_tmp, uint8_t, (sc->num_words + 7) / 8);
+	ufbxi_check_err(&sc->error, sc->reloc_bits);
+	memset(sc->reloc_bits, 0, (sc->num_words + 7) / 8);
+
+	sc->imp = ufbxi_alloc(&sc->ator_result, ufbxi_snapshot_imp, 1);
+	ufbxi_check_err(&sc->error, sc->imp);
+	memset(sc->imp, 0, sizeof(ufbxi_snapshot_imp));
+
+	sc->dst_size = sizeof(ufbxi_snapshot_header) + regions_size;
+	sc->dst = ufbxi_alloc(&sc->ator_result, char, sc->dst_size);
+	ufbxi_check_err(&sc->error, sc->dst);
+	sc->data = sc->dst + sizeof(ufbxi_snapshot_header);
+
+	for (size_t i = 0; i < num_regions; i++) {
+		const ufbxi_snapshot_region *region = &sc->regions[i];
+		memcpy(sc->data + region->offset, (const void*)region->begin, region->size);
+	}
+
+	// Walk the scene and all of its elements, overwriting the pointers in the copy
+	size_t scene_offset = 0;
+	ufbxi_check_err(&sc->error, ufbxi_snapshot_find(sc, scene, &scene_offset));
+	ufbxi_check_err(&sc->error, scene_offset >= sizeof(ufbxi_refcount));
+	ufbxi_check_err(&sc->error, ufbxi_snapshot_walk(sc, (const char*)scene, scene_offset, UFBXI_SNAPSHOT_TYPE_SCENE));
+
+	ufbxi_for_ptr_list(ufbx_element, p_elem, scene->elements) {
+		ufbx_element *elem = *p_elem;
+		size_t elem_offset = 0;
+		ufbxi_check_err_msg(&sc->error, ufbxi_snapshot_find(sc, elem, &elem_offset), "Pointer outside of the scene");
+		ufbxi_check_err(&sc->error, (uint32_t)elem->type < UFBX_ELEMENT_TYPE_COUNT);
+		ufbxi_check_err(&sc->error, ufbxi_snapshot_walk(sc, (const char*)elem, elem_offset, ufbxi_snapshot_element_types[elem->type]));
+	}
+
+	size_t num_relocs = 0;
+	for (size_t i = 0; i < (sc->num_words + 7) / 8; i++) {
+		uint32_t bits = sc->reloc_bits[i];
+		for (; bits; bits &= bits - 1) num_relocs++;
+	}
+
+	// Grow the snapshot to fit the copied external data and relocations
+	size_t data_size = ufbxi_align_to_mask(sc->data_size, 0xf);
+	ufbxi_check_err(&sc->error, data_size <= SIZE_MAX / 2 && num_relocs <= (SIZE_MAX / 2 - data_size) / sizeof(uint32_t));
+	size_t dst_size = sizeof(ufbxi_snapshot_header) + data_size + num_relocs * sizeof(uint32_t);
+
+	char *dst = ufbxi_realloc(&sc->ator_result, char, sc->dst, sc->dst_size, dst_size);
+	ufbxi_check_err(&sc->error, dst);
+	sc->dst = dst;
+	sc->dst_size = dst_size;
+	sc->data = dst + sizeof(ufbxi_snapshot_header);
+	memset(sc->data + regions_size, 0, data_size - regions_size);
+
+	ufbxi_snapshot_external *externals = ufbxi_push_pop(&sc->tmp, &sc->tmp_externals, ufbxi_snapshot_external, sc->num_externals);
+	ufbxi_check_err(&sc->error, externals);
+	for (size_t i = 0; i < sc->num_externals; i++) {
+		const ufbxi_snapshot_external *external = &externals[i];
+		if (external->size > 0) {
+			memcpy(sc->data + external->offset, (const void*)external->address, external->size);
+		}
+	}
+
+	uint32_t *relocs = (uint32_t*)(sc->data + data_size);
+	size_t reloc_ix = 0;
+	for (size_t i = 0; i < (sc->num_words + 7) / 8; i++) {
+		uint32_t bits = sc->reloc_bits[i];
+		for (uint32_t bit = 0; bits; bit++, bits >>= 1) {
+			if (bits & 1) {
+				relocs[reloc_ix++] = (uint32_t)(i * 8 + bit);
+			}
+		}
+	}
+	ufbx_assert(reloc_ix == num_relocs);
+
+	ufbxi_snapshot_header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, ufbxi_snapshot_magic, sizeof(header.magic));
+	header.version = UFBXI_SNAPSHOT_VERSION;
+	header.layout_hash = ufbxi_snapshot_layout_hash();
+	header.key = sc->opts.key;
+	header.data_size = data_size;
+	header.num_relocs = num_relocs;
+	header.scene_offset = scene_offset;
+	memcpy(sc->dst, &header, sizeof(header));
+
+	ufbxi_snapshot_imp *imp = sc->imp;
+	ufbxi_init_ref(&imp->refcount, UFBXI_SNAPSHOT_IMP_MAGIC, NULL);
+	imp->magic = UFBXI_SNAPSHOT_IMP_MAGIC;
+	imp->data = sc->dst;
+	imp->data_size = sc->dst_size;
+	imp->snapshot.data = sc->dst;
+	imp->snapshot.size = sc->dst_size;
+	imp->ator = sc->ator_result;
+	imp->ator.error = NULL;
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline ufbx_snapshot *ufbxi_save_snapshot(ufbxi_snapshot_context *sc, const ufbx_scene *scene, const ufbx_snapshot_opts *user_opts, ufbx_error *p_error)
+{
+	if (user_opts) {
+		sc->opts = *user_opts;
+	} else {
+		memset(&sc->opts, 0, sizeof(sc->opts));
+	}
+
+	ufbxi_init_ator(&sc->error, &sc->ator_tmp, &sc->opts.temp_allocator, "temp");
+	ufbxi_init_ator(&sc->error, &sc->ator_result, &sc->opts.result_allocator, "result");
+
+	sc->tmp.ator = &sc->ator_tmp;
+	sc->tmp_externals.ator = &sc->ator_tmp;
+	ufbxi_map_init(&sc->external_map, &sc->ator_tmp, &ufbxi_map_cmp_uintptr, NULL);
+	ufbxi_map_init(&sc->ref_map, &sc->ator_tmp, &ufbxi_map_cmp_uint64, NULL);
+
+	int ok = ufbxi_save_snapshot_imp(sc, scene);
+
+	ufbxi_buf_free(&sc->tmp);
+	ufbxi_buf_free(&sc->tmp_externals);
+	ufbxi_map_free(&sc->external_map);
+	ufbxi_map_free(&sc->ref_map);
+	if (sc->regions) ufbxi_free(&sc->ator_tmp, ufbxi_snapshot_region, sc->regions, sc->num_regions * 2);
+	if (sc->reloc_bits) ufbxi_free(&sc->ator_tmp, uint8_t, sc->reloc_bits, (sc->num_words + 7) / 8);
+	ufbxi_free_ator(&sc->ator_tmp);
+
+	if (ok) {
+		if (p_error) {
+			ufbxi_clear_error(p_error);
+		}
+		return &sc->imp->snapshot;
+	} else {
+		ufbxi_fix_error_type(&sc->error, "Failed to save snapshot");
+		if (p_error) *p_error = sc->error;
+		if (sc->dst) ufbxi_free(&sc->ator_result, char, sc->dst, sc->dst_size);
+		if (sc->imp) ufbxi_free(&sc->ator_result, ufbxi_snapshot_imp, sc->imp, 1);
+		ufbxi_free_ator(&sc->ator_result);
+		return NULL;
+	}
+}
+
+typedef struct {
+	ufbx_error error;
+	ufbx_snapshot_opts opts;
+
+	ufbxi_allocator ator_tmp;
+	ufbxi_allocator ator_result;
+
+	// Input, either a stream or memory
+	ufbx_read_fn *read_fn;
+	void *read_user;
+	const char *src;
+	size_t src_size;
+
+	char *data;
+	size_t data_size;
+
+	ufbxi_scene_imp *scene_imp;
+} ufbxi_snapshot_load_context;
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_snapshot_read(ufbxi_snapshot_load_context *lc, void *dst, size_t size)
+{
+	if (lc->read_fn) {
+		char *ptr = (char*)dst;
+		while (size > 0) {
+			size_t num_read = lc->read_fn(lc->read_user, ptr, size);
+			ufbxi_check_err_msg(&lc->error, num_read != SIZE_MAX, "IO error");
+			ufbxi_check_err_msg(&lc->error, num_read > 0 && num_read <= size, "Truncated file");
+			ptr += num_read;
+			size -= num_read;
+		}
+	} else {
+		ufbxi_check_err_msg(&lc->error, size <= lc->src_size, "Truncated file");
+		memcpy(dst, lc->src, size);
+		lc->src += size;
+		lc->src_size -= size;
+	}
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_snapshot_imp(ufbxi_snapshot_load_context *lc)
+{
+	ufbx_assert(lc->opts._begin_zero == 0 && lc->opts._end_zero == 0);
+	ufbxi_check_err_msg(&lc->error, lc->opts._begin_zero == 0 && lc->opts._end_zero == 0, "Uninitialized options");
+
+	ufbxi_snapshot_header header;
+	ufbxi_check_err(&lc->error, ufbxi_snapshot_read(lc, &header, sizeof(header)));
+	ufbxi_check_err_msg(&lc->error, !memcmp(header.magic, ufbxi_snapshot_magic, sizeof(header.magic)), "Unrecognized file format");
+	ufbxi_check_err_msg(&lc->error, header.version == UFBXI_SNAPSHOT_VERSION, "Snapshot mismatch");
+	ufbxi_check_err_msg(&lc->error, header.layout_hash == ufbxi_snapshot_layout_hash(), "Snapshot mismatch");
+	ufbxi_check_err_msg(&lc->error, header.key == lc->opts.key, "Snapshot mismatch");
+
+	ufbxi_check_err(&lc->error, header.data_size <= SIZE_MAX / 2 && header.data_size % 16 == 0);
+	ufbxi_check_err(&lc->error, header.scene_offset % sizeof(void*) == 0);
+	ufbxi_check_err(&lc->error, header.scene_offset >= sizeof(ufbxi_refcount));
+	ufbxi_check_err(&lc->error, header.data_size >= sizeof(ufbxi_scene_imp));
+	ufbxi_check_err(&lc->error, header.scene_offset - sizeof(ufbxi_refcount) <= header.data_size - sizeof(ufbxi_scene_imp));
+
+	size_t data_size = (size_t)header.data_size;
+	lc->data = ufbxi_alloc(&lc->ator_result, char, data_size);
+	ufbxi_check_err(&lc->error, lc->data);
+	lc->data_size = data_size;
+	ufbxi_check_err(&lc->error, ufbxi_snapshot_read(lc, lc->data, data_size));
+
+	// Relocate all pointers in a single pass, values are offsets from the start of the data
+	char *data = lc->data;
+	size_t num_words = data_size / sizeof(uintptr_t);
+	uint64_t relocs_left = header.num_relocs;
+	uint32_t relocs[1024];
+	while (relocs_left > 0) {
+		size_t num_relocs = (size_t)ufbxi_min64(relocs_left, ufbxi_arraycount(relocs));
+		ufbxi_check_err(&lc->error, ufbxi_snapshot_read(lc, relocs, num_relocs * sizeof(uint32_t)));
+		for (size_t i = 0; i < num_relocs; i++) {
+			size_t word = relocs[i];
+			ufbxi_check_err(&lc->error, word < num_words);
+			uintptr_t value;
+			memcpy(&value, data + word * sizeof(uintptr_t), sizeof(uintptr_t));
+			ufbxi_check_err(&lc->error, value <= data_size);
+			value += (uintptr_t)data;
+			memcpy(data + word * sizeof(uintptr_t), &value, sizeof(uintptr_t));
+		}
+		relocs_left -= num_relocs;
+	}
+
+	// The scene imp is included in the snapshot, reset everything but the scene itself
+	ufbxi_scene_imp *imp = (ufbxi_scene_imp*)(data + (size_t)header.scene_offset - sizeof(ufbxi_refcount));
+	ufbxi_init_ref(&imp->refcount, UFBXI_SCENE_IMP_MAGIC, NULL);
+
+	imp->magic = UFBXI_SCENE_IMP_MAGIC;
+	imp->ator = lc->ator_result;
+	imp->ator.error = NULL;
+
+	memset(&imp->result_buf, 0, sizeof(imp->result_buf));
+	imp->result_buf.ator = &imp->ator;
+	imp->result_buf.unordered = true;
+	memset(&imp->string_buf, 0, sizeof(imp->string_buf));
+	imp->string_buf.ator = &imp->ator;
+	imp->string_buf.unordered = true;
+
+	imp->mapped_data = NULL;
+	imp->mapped_size = 0;
+	imp->lazy_data = NULL;
+	imp->lazy_size = 0;
+	memset(&imp->lazy_opts, 0, sizeof(imp->lazy_opts));
+	imp->lazy_ranges = NULL;
+	imp->snapshot_data = data;
+	imp->snapshot_size = data_size;
+
+	imp->scene.metadata.result_memory_used = imp->ator.current_size;
+	imp->scene.metadata.temp_memory_used = lc->ator_tmp.current_size;
+	imp->scene.metadata.result_allocs = imp->ator.num_allocs;
+	imp->scene.metadata.temp_allocs = lc->ator_tmp.num_allocs;
+
+	lc->scene_imp = imp;
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline ufbx_scene *ufbxi_load_snapshot(ufbxi_snapshot_load_context *lc, const ufbx_snapshot_opts *user_opts, ufbx_error *p_error)
+{
+	if (user_opts) {
+		lc->opts = *user_opts;
+	} else {
+		memset(&lc->opts, 0, sizeof(lc->opts));
+	}
+
+	ufbxi_init_ator(&lc->error, &lc->ator_tmp, &lc->opts.temp_allocator, "temp");
+	ufbxi_init_ator(&lc->error, &lc->ator_result, &lc->opts.result_allocator, "result");
+
+	int ok = ufbxi_load_snapshot_imp(lc);
+
+	ufbxi_free_ator(&lc->ator_tmp);
+
+	if (ok) {
+		if (p_error) {
+			ufbxi_clear_error(p_error);
 		}
+		return &lc->scene_imp->scene;
+	} else {
+		ufbxi_fix_error_type(&lc->error, "Failed to load snapshot");
+		if (p_error) *p_error = lc->error;
+		if (lc->data) ufbxi_free(&lc->ator_result, char, lc->data, lc->data_size);
+		ufbxi_free_ator(&lc->ator_result);
+		return NULL;
+	}
+}
+
+#endif
+
+// -- Batch loading
+
+typedef struct {
+	ufbxi_refcount refcount;
+	ufbx_batch_result result;
+	uint32_t magic;
+
+	ufbxi_allocator ator;
+} ufbxi_batch_imp;
+
+ufbx_static_assert(batch_imp_offset, offsetof(ufbxi_batch_imp, result) == sizeof(ufbxi_refcount));
+
+#if UFBXI_FEATURE_SNAPSHOT
+
+// String data shared by the scenes loaded using `ufbx_batch_load_opts.share_strings`.
+// Each scene retains the table as the parent of its own refcount.
+typedef struct {
+	ufbxi_refcount refcount;
+	uint32_t magic;
+
+	ufbxi_allocator ator;
+	ufbxi_buf buf;
+} ufbxi_string_table_imp;
+
+// Strings are interned by walking the scenes using the snapshot layout tables and
+// replacing any string data owned by the scene with a copy in the shared table.
+typedef struct {
+	ufbx_error error;
+
+	ufbxi_allocator *ator_tmp;
+	ufbxi_string_table_imp *table;
+	ufbxi_map string_map; // < Map of `ufbx_string` in `table->buf`
+	ufbxi_map ref_map;    // < Set of `uintptr_t` addresses of the walked references
+
+	// Memory of the `string_buf` of the current scene sorted by address
+	ufbxi_snapshot_region *regions;
+	size_t regions_cap;
+	size_t num_regions;
+	size_t region_hint;
+} ufbxi_intern_context;
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_intern_data(ufbxi_intern_context *ic, const char **p_data, size_t length)
+{
+	const char *data = *p_data;
+	if (!data || !ufbxi_snapshot_find_region(ic->regions, ic->num_regions, &ic->region_hint, (uintptr_t)data)) return 1;
+
+	ufbx_string key = { data, length };
+	uint32_t hash = ufbxi_hash_string(data, length, ic->string_map.seed);
+	ufbx_string *entry = ufbxi_map_find(&ic->string_map, ufbx_string, hash, &key);
+	if (!entry) {
+		ufbxi_check_err(&ic->error, length < SIZE_MAX);
+		char *copy = ufbxi_push(&ic->table->buf, char, length + 1);
+		ufbxi_check_err(&ic->error, copy);
+		if (length > 0) memcpy(copy, data, length);
+		copy[length] = '\0';
+
+		entry = ufbxi_map_insert(&ic->string_map, ufbx_string, hash, &key);
+		ufbxi_check_err(&ic->error, entry);
+		entry->data = copy;
+		entry->length = length;
 	}
 
-	ufbxi_evaluate_props(anim, element, time, props, num_props);
+	*p_data = entry->data;
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_intern_walk(ufbxi_intern_context *ic, char *ptr, uint32_t type_ix);
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_intern_value(ufbxi_intern_context *ic, char *ptr, uint32_t kind, uint32_t type_ix)
+{
+	switch (kind) {
+
+	case UFBXI_SNAPSHOT_STRING: {
+		ufbx_string *str = (ufbx_string*)ptr;
+		ufbxi_check_err(&ic->error, ufbxi_intern_data(ic, &str->data, str->length));
+	} break;
+
+	case UFBXI_SNAPSHOT_BLOB: {
+		ufbx_blob *blob = (ufbx_blob*)ptr;
+		const char *data = (const char*)blob->data;
+		ufbxi_check_err(&ic->error, ufbxi_intern_data(ic, &data, blob->size));
+		blob->data = data;
+	} break;
+
+	case UFBXI_SNAPSHOT_REF: {
+		char *target = *(char**)ptr;
+		if (!target) break;
+
+		uintptr_t address = (uintptr_t)target;
+		uint32_t hash = ufbxi_hash_uptr(address);
+		if (!ufbxi_map_find(&ic->ref_map, uintptr_t, hash, &address)) {
+			uintptr_t *entry = ufbxi_map_insert(&ic->ref_map, uintptr_t, hash, &address);
+			ufbxi_check_err(&ic->error, entry);
+			*entry = address;
+			ufbxi_check_err(&ic->error, ufbxi_intern_walk(ic, target, type_ix));
+		}
+	} break;
+
+	case UFBXI_SNAPSHOT_STRUCT: {
+		ufbxi_check_err(&ic->error, ufbxi_intern_walk(ic, ptr, type_ix));
+	} break;
+
+	default:
+		// Plain pointers refer to elements that are walked separately
+		break;
+
+	}
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_intern_walk(ufbxi_intern_context *ic, char *ptr, uint32_t type_ix)
+{
+	ufbx_assert(type_ix < UFBXI_SNAPSHOT_TYPE_COUNT);
+	const ufbxi_snapshot_type *type = &ufbxi_snapshot_types[type_ix];
+
+	const ufbxi_snapshot_field *fields = ufbxi_snapshot_fields + type->first_field;
+	ufbxi_nounroll for (size_t field_ix = 0; field_ix < type->num_fields; field_ix++) {
+		const ufbxi_snapshot_field *field = &fields[field_ix];
+		size_t stride = ufbxi_snapshot_field_stride(field);
+
+		for (size_t i = 0; i < field->count; i++) {
+			char *field_ptr = ptr + field->offset + i * stride;
+			if (field->kind != UFBXI_SNAPSHOT_LIST) {
+				ufbxi_check_err(&ic->error, ufbxi_intern_value(ic, field_ptr, field->kind, field->type));
+				continue;
+			}
+
+			const ufbx_void_list *list = (const ufbx_void_list*)field_ptr;
+			if (field->item_kind == UFBXI_SNAPSHOT_RAW || field->item_kind == UFBXI_SNAPSHOT_PTR) continue;
+
+			char *items = (char*)list->data;
+			for (size_t item_ix = 0; item_ix < list->count; item_ix++) {
+				ufbxi_check_err(&ic->error, ufbxi_intern_value(ic, items + item_ix * field->item_size, field->item_kind, field->type));
+			}
+		}
+	}
+
+	// See `ufbxi_snapshot_walk()`
+	if (type_ix == UFBXI_SNAPSHOT_TYPE_DOM_VALUE) {
+		ufbx_dom_value *value = (ufbx_dom_value*)ptr;
+		if (value->type == UFBX_DOM_VALUE_ARRAY_RAW_STRING) {
+			ufbx_blob *blobs = (ufbx_blob*)value->value_blob.data;
+			size_t num_blobs = value->value_blob.size / sizeof(ufbx_blob);
+			for (size_t i = 0; i < num_blobs; i++) {
+				ufbxi_check_err(&ic->error, ufbxi_intern_value(ic, (char*)&blobs[i], UFBXI_SNAPSHOT_BLOB, 0));
+			}
+		}
+	}
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_intern_scene_strings(ufbxi_intern_context *ic, ufbxi_scene_imp *imp)
+{
+	ufbx_assert(imp->magic == UFBXI_SCENE_IMP_MAGIC && imp->refcount.parent == NULL);
+
+	size_t num_regions = ufbxi_snapshot_buf_regions(NULL, 0, &imp->string_buf);
+	if (num_regions == 0) return 1;
+
+	ufbxi_check_err(&ic->error, ufbxi_grow_array(ic->ator_tmp, &ic->regions, &ic->regions_cap, num_regions * 2));
+	ic->num_regions = ufbxi_snapshot_buf_regions(ic->regions, 0, &imp->string_buf);
+	ic->region_hint = 0;
+	ufbxi_macro_stable_sort(ufbxi_snapshot_region, 16, ic->regions, ic->regions + num_regions, num_regions, ( a->begin < b->begin ));
+
+	// Retain the table before touching any strings so the scene stays valid
+	// even if we fail halfway through.
+	ufbxi_retain_ref(&ic->table->refcount);
+	imp->refcount.parent = &ic->table->refcount;
+
+	ufbx_scene *scene = &imp->scene;
+	ufbxi_map_clear(&ic->ref_map);
+	ufbxi_check_err(&ic->error, ufbxi_intern_walk(ic, (char*)scene, UFBXI_SNAPSHOT_TYPE_SCENE));
+	ufbxi_for_ptr_list(ufbx_element, p_elem, scene->elements) {
+		ufbx_element *elem = *p_elem;
+		ufbxi_check_err(&ic->error, (uint32_t)elem->type < UFBX_ELEMENT_TYPE_COUNT);
+		ufbxi_check_err(&ic->error, ufbxi_intern_walk(ic, (char*)elem, ufbxi_snapshot_element_types[elem->type]));
+	}
+
+	ufbxi_buf_free(&imp->string_buf);
+	ic->num_regions = 0;
+
+	scene->metadata.result_memory_used = imp->ator.current_size;
+	scene->metadata.result_allocs = imp->ator.num_allocs;
+
+	return 1;
+}
+
+#endif
+
+typedef struct {
+	ufbx_error error;
+	ufbx_batch_load_opts opts;
+	ufbx_load_opts load_opts;
+
+	ufbxi_allocator ator_tmp;
+	ufbxi_allocator ator_result;
+
+	const char *const *filenames;
+	size_t num_files;
+	ufbxi_atomic_counter next_file;
+
+	ufbx_load_context **workers;
+	size_t num_workers;
+
+	ufbxi_batch_imp *imp;
+	ufbx_scene **scenes;
+	ufbx_error *errors;
+} ufbxi_batch_context;
+
+// Worker task that keeps loading files until there are none left.
+static void ufbxi_batch_load_task(void *user, uint32_t index)
+{
+	ufbxi_batch_context *bc = (ufbxi_batch_context*)user;
+
+	ufbx_load_opts opts = bc->load_opts;
+	opts.load_context = bc->workers[index];
+
+	for (;;) {
+		size_t file_ix = ufbxi_atomic_counter_inc(&bc->next_file);
+		if (file_ix >= bc->num_files) break;
+		bc->scenes[file_ix] = ufbx_load_file(bc->filenames[file_ix], &opts, &bc->errors[file_ix]);
+	}
+}
+
+#if UFBXI_FEATURE_SNAPSHOT
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_batch_share_strings(ufbxi_batch_context *bc)
+{
+	ufbxi_allocator ator = { 0 };
+	ufbxi_init_ator(&bc->error, &ator, &bc->opts.result_allocator, "string_table");
+
+	ufbxi_string_table_imp *table = ufbxi_alloc(&ator, ufbxi_string_table_imp, 1);
+	if (!table) {
+		ufbxi_free_ator(&ator);
+		return 0;
+	}
+
+	memset(table, 0, sizeof(ufbxi_string_table_imp));
+	ufbxi_init_ref(&table->refcount, UFBXI_STRING_TABLE_IMP_MAGIC, NULL);
+	table->magic = UFBXI_STRING_TABLE_IMP_MAGIC;
+	table->ator = ator;
+	table->buf.ator = &table->ator;
+	table->buf.unordered = true;
+
+	ufbxi_intern_context ic = { UFBX_ERROR_NONE };
+	ic.ator_tmp = &bc->ator_tmp;
+	ic.table = table;
+	table->ator.error = &ic.error;
+	ufbxi_map_init(&ic.string_map, &bc->ator_tmp, &ufbxi_map_cmp_string, NULL);
+	ufbxi_map_init(&ic.ref_map, &bc->ator_tmp, &ufbxi_map_cmp_uintptr, NULL);
+
+	int ok = 1;
+	for (size_t i = 0; i < bc->num_files && ok; i++) {
+		if (!bc->scenes[i]) continue;
+		ok = ufbxi_intern_scene_strings(&ic, ufbxi_get_imp(ufbxi_scene_imp, bc->scenes[i]));
+	}
+
+	size_t shared_size = table->ator.current_size;
+	table->ator.error = NULL;
+
+	ufbxi_map_free(&ic.string_map);
+	ufbxi_map_free(&ic.ref_map);
+	ufbxi_free(&bc->ator_tmp, ufbxi_snapshot_region, ic.regions, ic.regions_cap);
+
+	// Release our reference, the table is freed with the last scene that uses it
+	ufbxi_release_ref(&table->refcount);
+
+	if (!ok) {
+		bc->error = ic.error;
+		return 0;
+	}
+
+	bc->imp->result.shared_string_size = shared_size;
+	return 1;
+}
+#endif
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_load_batch_imp(ufbxi_batch_context *bc)
+{
+	ufbx_assert(bc->opts._begin_zero == 0 && bc->opts._end_zero == 0);
+	ufbxi_check_err_msg(&bc->error, bc->opts._begin_zero == 0 && bc->opts._end_zero == 0, "Uninitialized options");
+	ufbxi_check_err(&bc->error, !bc->opts.pool.run_fn || bc->opts.pool.wait_fn);
+	ufbxi_check_err(&bc->error, bc->filenames || bc->num_files == 0);
+
+	size_t num_files = bc->num_files;
+	size_t num_workers = 1;
+	if (bc->opts.pool.run_fn) {
+		num_workers = bc->opts.num_workers ? bc->opts.num_workers : 8;
+		num_workers = ufbxi_min_sz(num_workers, ufbxi_max_sz(num_files, 1));
+		num_workers = ufbxi_min_sz(num_workers, UINT32_MAX);
+
+		// Running the loads on `pool` already keeps all the threads busy, the loads must
+		// not dispatch work of their own as tasks are never run from inside tasks.
+		memset(&bc->load_opts.thread_opts.pool, 0, sizeof(ufbx_thread_pool));
+		memset(&bc->load_opts.read_ahead.pool, 0, sizeof(ufbx_thread_pool));
+	}
+
+	bc->imp = ufbxi_alloc(&bc->ator_result, ufbxi_batch_imp, 1);
+	ufbxi_check_err(&bc->error, bc->imp);
+	memset(bc->imp, 0, sizeof(ufbxi_batch_imp));
+
+	bc->scenes = ufbxi_alloc(&bc->ator_result, ufbx_scene*, num_files);
+	ufbxi_check_err(&bc->error, bc->scenes);
+	bc->errors = ufbxi_alloc(&bc->ator_result, ufbx_error, num_files);
+	ufbxi_check_err(&bc->error, bc->errors);
+	memset(bc->scenes, 0, num_files * sizeof(ufbx_scene*));
+	memset(bc->errors, 0, num_files * sizeof(ufbx_error));
+
+	bc->workers = ufbxi_alloc(&bc->ator_tmp, ufbx_load_context*, num_workers);
+	ufbxi_check_err(&bc->error, bc->workers);
+	memset(bc->workers, 0, num_workers * sizeof(ufbx_load_context*));
+	bc->num_workers = num_workers;
+
+	ufbx_load_context_opts context_opts = { 0 };
+	context_opts.temp_allocator = bc->opts.temp_allocator;
+	for (size_t i = 0; i < num_workers; i++) {
+		bc->workers[i] = ufbx_create_load_context(&context_opts, &bc->error);
+		ufbxi_check_err(&bc->error, bc->workers[i]);
+	}
+
+	ufbxi_atomic_counter_init(&bc->next_file);
+	if (bc->opts.pool.run_fn) {
+		ufbx_thread_pool *pool = &bc->opts.pool;
+		pool->run_fn(pool->user, &ufbxi_batch_load_task, bc, (uint32_t)num_workers);
+		pool->wait_fn(pool->user);
+	} else {
+		ufbxi_batch_load_task(bc, 0);
+	}
+	ufbxi_atomic_counter_free(&bc->next_file);
+
+	ufbx_batch_result *result = &bc->imp->result;
+	result->num_files = num_files;
+	result->scenes = bc->scenes;
+	result->errors = bc->errors;
+	for (size_t i = 0; i < num_files; i++) {
+		if (!bc->scenes[i]) result->num_failed++;
+	}
+
+#if UFBXI_FEATURE_SNAPSHOT
+	if (bc->opts.share_strings) {
+		ufbxi_check_err(&bc->error, ufbxi_batch_share_strings(bc));
+	}
+#endif
+
+	ufbxi_init_ref(&bc->imp->refcount, UFBXI_BATCH_IMP_MAGIC, NULL);
+	bc->imp->magic = UFBXI_BATCH_IMP_MAGIC;
+	bc->imp->ator = bc->ator_result;
+	bc->imp->ator.error = NULL;
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline ufbx_batch_result *ufbxi_load_batch(ufbxi_batch_context *bc, const ufbx_load_opts *load_opts, const ufbx_batch_load_opts *user_opts, ufbx_error *p_error)
+{
+	if (user_opts) {
+		bc->opts = *user_opts;
+	} else {
+		memset(&bc->opts, 0, sizeof(bc->opts));
+	}
+	if (load_opts) {
+		bc->load_opts = *load_opts;
+	} else {
+		memset(&bc->load_opts, 0, sizeof(bc->load_opts));
+	}
+
+	ufbxi_init_ator(&bc->error, &bc->ator_tmp, &bc->opts.temp_allocator, "temp");
+	ufbxi_init_ator(&bc->error, &bc->ator_result, &bc->opts.result_allocator, "result");
+
+	int ok = ufbxi_load_batch_imp(bc);
+
+	if (bc->workers) {
+		for (size_t i = 0; i < bc->num_workers; i++) {
+			ufbx_free_load_context(bc->workers[i]);
+		}
+		ufbxi_free(&bc->ator_tmp, ufbx_load_context*, bc->workers, bc->num_workers);
+	}
+	ufbxi_free_ator(&bc->ator_tmp);
+
+	if (ok) {
+		if (p_error) {
+			ufbxi_clear_error(p_error);
+		}
+		return &bc->imp->result;
+	} else {
+		ufbxi_fix_error_type(&bc->error, "Failed to load batch");
+		if (p_error) *p_error = bc->error;
+		if (bc->scenes) {
+			for (size_t i = 0; i < bc->num_files; i++) {
+				ufbx_free_scene(bc->scenes[i]);
+			}
+			ufbxi_free(&bc->ator_result, ufbx_scene*, bc->scenes, bc->num_files);
+		}
+		if (bc->errors) ufbxi_free(&bc->ator_result, ufbx_error, bc->errors, bc->num_files);
+		if (bc->imp) ufbxi_free(&bc->ator_result, ufbxi_batch_imp, bc->imp, 1);
+		ufbxi_free_ator(&bc->ator_result);
+		return NULL;
+	}
+}
+
+// -- Animation evaluation
+
+static int ufbxi_cmp_prop_override(const void *va, const void *vb)
+{
+	const ufbx_prop_override *a = (const ufbx_prop_override*)va, *b = (const ufbx_prop_override*)vb;
+	if (a->element_id != b->element_id) return a->element_id < b->element_id ? -1 : 1;
+	if (a->_internal_key != b->_internal_key) return a->_internal_key < b->_internal_key ? -1 : 1;
+	return strcmp(a->prop_name, b->prop_name);
+}
+
+static ufbxi_forceinline bool ufbxi_override_less_than_prop(const ufbx_prop_override *over, uint32_t element_id, const ufbx_prop *prop)
+{
+	if (over->element_id != element_id) return over->element_id < element_id;
+	if (over->_internal_key != prop->_internal_key) return over->_internal_key < prop->_internal_key;
+	return strcmp(over->prop_name, prop->name.data);
+}
+
+static ufbxi_forceinline bool ufbxi_override_equals_to_prop(const ufbx_prop_override *over, uint32_t element_id, const ufbx_prop *prop)
+{
+	if (over->element_id != element_id) return false;
+	if (over->_internal_key != prop->_internal_key) return false;
+	return strcmp(over->prop_name, prop->name.data) == 0;
+}
+
+static ufbxi_forceinline ufbxi_unused bool ufbxi_prop_override_is_prepared(const ufbx_prop_override *over)
+{
+	if (over->_internal_key != ufbxi_get_name_key_c(over->prop_name)) return false;
+	if (over->value_str == NULL) return false;
+	return true;
+}
+
+static ufbxi_noinline bool ufbxi_find_prop_override(const ufbx_const_prop_override_list *overrides, uint32_t element_id, ufbx_prop *prop)
+{
+	if (overrides->count > 0) {
+		// If this assert fails make sure to call `ufbx_prepare_prop_overrides()` first!
+		ufbx_assert(ufbxi_prop_override_is_prepared(&overrides->data[0]));
+	}
+
+	size_t ix = SIZE_MAX;
+	ufbxi_macro_lower_bound_eq(ufbx_prop_override, 16, &ix, overrides->data, 0, overrides->count,
+		( ufbxi_override_less_than_prop(a, element_id, prop) ),
+		( ufbxi_override_equals_to_prop(a, element_id, prop) ));
+
+	if (ix != SIZE_MAX) {
+		const ufbx_prop_override *over = &overrides->data[ix];
+		const uint32_t clear_flags = UFBX_PROP_FLAG_NO_VALUE | UFBX_PROP_FLAG_NOT_FOUND;
+		prop->flags = (ufbx_prop_flags)(((uint32_t)prop->flags & ~clear_flags) | UFBX_PROP_FLAG_OVERRIDDEN);
+		prop->value_vec3 = over->value;
+		prop->value_real_arr[3] = 0.0f;
+		prop->value_int = over->value_int;
+		prop->value_str = ufbxi_str_c(over->value_str);
+		prop->value_blob.data = prop->value_str.data;
+		prop->value_blob.size = prop->value_str.length;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+static ufbxi_noinline ufbx_const_prop_override_list ufbxi_find_element_prop_overrides(const ufbx_const_prop_override_list *overrides, uint32_t element_id)
+{
+	if (overrides->count > 0) {
+		// If this assert fails make sure to call `ufbx_prepare_prop_overrides()` first!
+		ufbx_assert(ufbxi_prop_override_is_prepared(&overrides->data[0]));
+	}
+
+	size_t begin = overrides->count, end = begin;
+
+	ufbxi_macro_lower_bound_eq(ufbx_prop_override, 32, &begin, overrides->data, 0, overrides->count,
+		(a->element_id < element_id),
+		(a->element_id == element_id));
+
+	ufbxi_macro_upper_bound_eq(ufbx_prop_override, 32, &end, overrides->data, begin, overrides->count,
+		(a->element_id == element_id));
+
+	ufbx_const_prop_override_list result = { overrides->data + begin, end - begin };
+	return result;
+}
+
+typedef struct ufbxi_anim_layer_combine_ctx {
+	ufbx_anim anim;
+	const ufbx_element *element;
+	double time;
+	ufbx_rotation_order rotation_order;
+	bool has_rotation_order;
+} ufbxi_anim_layer_combine_ctx;
+
+static double ufbxi_pow_abs(double v, double e)
+{
+	if (e <= 0.0) return 1.0;
+	if (e >= 1.0) return v;
+	double sign = v < 0.0 ? -1.0 : 1.0;
+	return sign * ufbx_pow(v * sign, e);
+}
+
+// Recursion is limited by the fact that we recurse only when the property name is "Lcl Rotation"
+// and when recursing we always evaluate the property "RotationOrder"
+static ufbxi_noinline void ufbxi_combine_anim_layer(ufbxi_anim_layer_combine_ctx *ctx, ufbx_anim_layer *layer, ufbx_real weight, const char *prop_name, ufbx_vec3 *result, const ufbx_vec3 *value)
+	ufbxi_recursive_function_void(ufbxi_combine_anim_layer, (ctx, layer, weight, prop_name, result, value), 2,
+		(ufbxi_anim_layer_combine_ctx *ctx, ufbx_anim_layer *layer, ufbx_real weight, const char *prop_name, ufbx_vec3 *result, const ufbx_vec3 *value))
+{
+	if (layer->compose_rotation && layer->blended && prop_name == ufbxi_Lcl_Rotation && !ctx->has_rotation_order) {
+		ufbx_prop rp = ufbx_evaluate_prop_len(&ctx->anim, ctx->element, ufbxi_RotationOrder, sizeof(ufbxi_RotationOrder) - 1, ctx->time);
+		// NOTE: Defaults to 0 (UFBX_ROTATION_XYZ) gracefully if property is not found
+		if (rp.value_int >= 0 && rp.value_int <= UFBX_ROTATION_ORDER_SPHERIC) {
+			ctx->rotation_order = (ufbx_rotation_order)rp.value_int;
+		} else {
+			ctx->rotation_order = UFBX_ROTATION_ORDER_XYZ;
+		}
+		ctx->has_rotation_order = true;
+	}
+
+	if (layer->additive) {
+		if (layer->compose_scale && prop_name == ufbxi_Lcl_Scaling) {
+			result->x *= (ufbx_real)ufbxi_pow_abs(value->x, weight);
+			result->y *= (ufbx_real)ufbxi_pow_abs(value->y, weight);
+			result->z *= (ufbx_real)ufbxi_pow_abs(value->z, weight);
+		} else if (layer->compose_rotation && prop_name == ufbxi_Lcl_Rotation) {
+			ufbx_quat a = ufbx_euler_to_quat(*result, ctx->rotation_order);
+			ufbx_quat b = ufbx_euler_to_quat(*value, ctx->rotation_order);
+			b = ufbx_quat_slerp(ufbx_identity_quat, b, weight);
+			ufbx_quat res = ufbxi_mul_quat(a, b);
+			*result = ufbx_quat_to_euler(res, ctx->rotation_order);
+		} else {
+			result->x += value->x * weight;
+			result->y += value->y * weight;
+			result->z += value->z * weight;
+		}
+	} else if (layer->blended) {
+		ufbx_real res_weight = 1.0f - weight;
+		if (layer->compose_scale && prop_name == ufbxi_Lcl_Scaling) {
+			result->x = (ufbx_real)(ufbxi_pow_abs(result->x, res_weight) * ufbxi_pow_abs(value->x, weight));
+			result->y = (ufbx_real)(ufbxi_pow_abs(result->y, res_weight) * ufbxi_pow_abs(value->y, weight));
+			result->z = (ufbx_real)(ufbxi_pow_abs(result->z, res_weight) * ufbxi_pow_abs(value->z, weight));
+		} else if (layer->compose_rotation && prop_name == ufbxi_Lcl_Rotation) {
+			ufbx_quat a = ufbx_euler_to_quat(*result, ctx->rotation_order);
+			ufbx_quat b = ufbx_euler_to_quat(*value, ctx->rotation_order);
+			ufbx_quat res = ufbx_quat_slerp(a, b, weight);
+			*result = ufbx_quat_to_euler(res, ctx->rotation_order);
+		} else {
+			result->x = result->x * res_weight + value->x * weight;
+			result->y = result->y * res_weight + value->y * weight;
+			result->z = result->z * res_weight + value->z * weight;
+		}
+	} else {
+		*result = *value;
+	}
+}
+
+static ufbxi_forceinline bool ufbxi_anim_layer_might_contain_id(const ufbx_anim_layer *layer, uint32_t id)
+{
+	uint32_t id_mask = ufbxi_arraycount(layer->_element_id_bitmask) - 1;
+	bool ok = id - layer->_min_element_id <= (layer->_max_element_id - layer->_min_element_id);
+	ok &= (layer->_element_id_bitmask[(id >> 5) & id_mask] & (1u << (id & 31))) != 0;
+	return ok;
+}
+
+static ufbxi_noinline void ufbxi_evaluate_props(const ufbx_anim *anim, const ufbx_element *element, double time, ufbx_prop *props, size_t num_props)
+{
+	ufbxi_anim_layer_combine_ctx combine_ctx = { *anim, element, time };
+
+	uint32_t element_id = element->element_id;
+	ufbxi_for_list(const ufbx_anim_layer_desc, layer_desc, anim->layers) {
+		ufbx_anim_layer *layer = layer_desc->layer;
+		if (!ufbxi_anim_layer_might_contain_id(layer, element_id)) continue;
+
+		// Find the weight for the current layer
+		// TODO: Should this be searched from multiple layers?
+		// TODO: Use weight from layer_desc
+		ufbx_real weight = layer->weight;
+		if (layer->weight_is_animated && layer->blended) {
+			ufbx_anim_prop *weight_aprop = ufbxi_find_anim_prop_start(layer, &layer->element);
+			if (weight_aprop) {
+				weight = ufbx_evaluate_anim_value_real(weight_aprop->anim_value, time) / (ufbx_real)100.0;
+				if (weight < 0.0f) weight = 0.0f;
+				if (weight > 0.99999f) weight = 1.0f;
+			}
+		}
+
+		ufbx_anim_prop *aprop = ufbxi_find_anim_prop_start(layer, element);
+		if (!aprop) continue;
+
+		for (size_t i = 0; i < num_props; i++) {
+			ufbx_prop *prop = &props[i];
+
+			// Don't evaluate on top of overridden properties
+			if ((prop->flags & UFBX_PROP_FLAG_OVERRIDDEN) != 0) continue;
+
+			// Connections override animation by default
+			if ((prop->flags & UFBX_PROP_FLAG_CONNECTED) != 0 && !anim->ignore_connections) continue;
+
+			// Skip until we reach `aprop >= prop`
+			while (aprop->element == element && aprop->_internal_key < prop->_internal_key) aprop++;
+			if (aprop->prop_name.data != prop->name.data) {
+				while (aprop->element == element && strcmp(aprop->prop_name.data, prop->name.data) < 0) aprop++;
+			}
+
+			// TODO: Should we skip the blending for the first layer _per property_
+			// This could be done by having `UFBX_PROP_FLAG_ANIMATION_EVALUATED`
+			// that gets set for the first layer of animation that is applied.
+			if (aprop->prop_name.data == prop->name.data) {
+				ufbx_vec3 v = ufbx_evaluate_anim_value_vec3(aprop->anim_value, time);
+				if (layer_desc == anim->layers.data) {
+					prop->value_vec3 = v;
+				} else {
+					ufbxi_combine_anim_layer(&combine_ctx, layer, weight, prop->name.data, &prop->value_vec3, &v);
+				}
+			}
+		}
+	}
+
+	ufbxi_for(ufbx_prop, prop, props, num_props) {
+		prop->value_int = ufbxi_f64_to_i64(prop->value_real);
+	}
+}
+
+// Recursion limited by not calling `ufbx_evaluate_prop_len()` with a connected property,
+// meaning it will never call `ufbxi_evaluate_connected_prop()` again indirectly.
+static ufbxi_noinline void ufbxi_evaluate_connected_prop(ufbx_prop *prop, const ufbx_anim *anim, const ufbx_element *element, const char *name, double time)
+	ufbxi_recursive_function_void(ufbxi_evaluate_connected_prop, (prop, anim, element, name, time), 3,
+		(ufbx_prop *prop, const ufbx_anim *anim, const ufbx_element *element, const char *name, double time))
+{
+	ufbx_connection *conn = ufbxi_find_prop_connection(element, name);
+
+	for (size_t i = 0; i < 1000 && conn; i++) {
+		ufbx_connection *next_conn = ufbxi_find_prop_connection(conn->src, conn->src_prop.data);
+		if (!next_conn) break;
+		conn = next_conn;
+	}
+
+	// Found a non-cyclic connection
+	if (conn && !ufbxi_find_prop_connection(conn->src, conn->src_prop.data)) {
+		ufbx_prop ep = ufbx_evaluate_prop_len(anim, conn->src, conn->src_prop.data, conn->src_prop.length, time);
+		prop->value_vec4 = ep.value_vec4;
+		prop->value_int = ep.value_int;
+		prop->value_str = ep.value_str;
+		prop->value_blob = ep.value_blob;
+	} else {
+		// Connection not found, maybe it's animated?
+		prop->flags = (ufbx_prop_flags)((uint32_t)prop->flags & ~(uint32_t)UFBX_PROP_FLAG_CONNECTED);
+	}
+}
+
+static ufbxi_noinline ufbx_props ufbxi_evaluate_selected_props(const ufbx_anim *anim, const ufbx_element *element, double time, ufbx_prop *props, const char *const *prop_names, size_t max_props)
+{
+	const char *name = prop_names[0];
+	uint32_t key = ufbxi_get_name_key_c(name);
+	size_t num_props = 0;
+
+	const ufbx_prop_override *over = NULL, *over_end = NULL;
+	if (anim->prop_overrides.count > 0) {
+		ufbx_const_prop_override_list list = ufbxi_find_element_prop_overrides(&anim->prop_overrides, element->element_id);
+		over = list.data;
+		over_end = over + list.count;
+	}
+
+#if defined(UFBX_REGRESSION)
+	for (size_t i = 1; i < max_props; i++) {
+		ufbx_assert(strcmp(prop_names[i - 1], prop_names[i]) < 0);
+	}
+#endif
+
+	size_t name_ix = 0;
+	for (size_t i = 0; i < element->props.props.count; i++) {
+		ufbx_prop *prop = &element->props.props.data[i];
+
+		while (name_ix < max_props) {
+			if (key > prop->_internal_key) break;
+
+			if (over) {
+				bool found_override = false;
+				for (; over != over_end; over++) {
+					ufbx_prop *dst = &props[num_props];
+					if (over->_internal_key < key || strcmp(over->prop_name, name) < 0) {
+						continue;
+					} else if (over->_internal_key == key && strcmp(over->prop_name, name) == 0) {
+						dst->name = ufbxi_str_c(name);
+						dst->_internal_key = key;
+						dst->type = UFBX_PROP_UNKNOWN;
+						dst->flags = UFBX_PROP_FLAG_OVERRIDDEN;
+					} else {
+						break;
+					}
+					dst->value_str = ufbxi_str_c(over->value_str);
+					dst->value_blob.data = dst->value_str.data;
+					dst->value_blob.size = dst->value_str.length;
+					dst->value_int = over->value_int;
+					dst->value_vec3 = over->value;
+					dst->value_real_arr[3] = 0.0f;
+					num_props++;
+					found_override = true;
+				}
+				if (found_override) break;
+			}
+
+			if (name == prop->name.data) {
+				if ((prop->flags & UFBX_PROP_FLAG_CONNECTED) != 0 && !anim->ignore_connections) {
+					ufbx_prop *dst = &props[num_props++];
+					*dst = *prop;
+					ufbxi_evaluate_connected_prop(dst, anim, element, name, time);
+				} else if (prop->flags & UFBX_PROP_FLAG_ANIMATED) {
+					props[num_props++] = *prop;
+				}
+				break;
+			} else if (strcmp(name, prop->name.data) < 0) {
+				name_ix++;
+				if (name_ix < max_props) {
+					name = prop_names[name_ix];
+					key = ufbxi_get_name_key_c(name);
+				}
+			} else {
+				break;
+			}
+		}
+	}
+
+	if (over) {
+		for (; over != over_end && name_ix < max_props; over++) {
+			ufbx_prop *dst = &props[num_props];
+			if (over->_internal_key < key || strcmp(over->prop_name, name) < 0) {
+				continue;
+			} else if (over->_internal_key == key && strcmp(over->prop_name, name) == 0) {
+				dst->name = ufbxi_str_c(name);
+				dst->_internal_key = key;
+				dst->type = UFBX_PROP_UNKNOWN;
+				dst->flags = UFBX_PROP_FLAG_OVERRIDDEN;
+			} else {
+				name_ix++;
+				if (name_ix < max_props) {
+					name = prop_names[name_ix];
+					key = ufbxi_get_name_key_c(name);
+				}
+			}
+			dst->value_str = ufbxi_str_c(over->value_str);
+			dst->value_blob.data = dst->value_str.data;
+			dst->value_blob.size = dst->value_str.length;
+			dst->value_int = over->value_int;
+			dst->value_vec3 = over->value;
+			dst->value_real_arr[3] = 0.0f;
+			num_props++;
+		}
+	}
+
+	ufbxi_evaluate_props(anim, element, time, props, num_props);
+
+	ufbx_props prop_list;
+	prop_list.props.data = props;
+	prop_list.props.count = prop_list.num_animated = num_props;
+	prop_list.defaults = (ufbx_props*)&element->props;
+	return prop_list;
+}
+
+// Properties used by `ufbxi_get_transform()` sorted for `ufbxi_evaluate_selected_props()`
+static const char *const ufbxi_transform_props[] = {
+	ufbxi_Lcl_Rotation,
+	ufbxi_Lcl_Scaling,
+	ufbxi_Lcl_Translation,
+	ufbxi_PostRotation,
+	ufbxi_PreRotation,
+	ufbxi_RotationOffset,
+	ufbxi_RotationOrder,
+	ufbxi_RotationPivot,
+	ufbxi_ScalingOffset,
+	ufbxi_ScalingPivot,
+};
+
+// World rotation and scale of `node` as in `ufbxi_update_node()` from the local transforms
+// in `local`, used by `ufbx_evaluate_pose()` if there is no `world_transform_out` to carry
+// them from the parents. Accumulated from the root down in the same order to get identical
+// results, gathering up to `UFBXI_POSE_ANCESTOR_STACK` ancestors at a time so this is linear
+// in the depth of the node unless the hierarchy is deeper than the stack.
+static ufbxi_noinline void ufbxi_pose_world_rotation_scale(const ufbx_node *node, const ufbx_transform *local, ufbx_quat *p_rotation, ufbx_vec3 *p_scale)
+{
+	const ufbx_node *stack[UFBXI_POSE_ANCESTOR_STACK];
+	ufbx_quat rotation = ufbx_identity_quat;
+	ufbx_vec3 scale = { 1.0f, 1.0f, 1.0f };
+
+	uint32_t depth = 0, num_nodes = node->node_depth + 1;
+	while (depth < num_nodes) {
+		uint32_t count = ufbxi_min32(num_nodes - depth, UFBXI_POSE_ANCESTOR_STACK);
+
+		// Gather ancestors at depths `[depth, depth + count)` in root-down order
+		const ufbx_node *ancestor = node;
+		for (uint32_t i = depth + count; i < num_nodes && ancestor; i++) {
+			ancestor = ancestor->parent;
+		}
+		uint32_t first = count;
+		while (first > 0 && ancestor) {
+			stack[--first] = ancestor;
+			ancestor = ancestor->parent;
+		}
+
+		for (uint32_t i = first; i < count; i++) {
+			const ufbx_node *n = stack[i];
+			const ufbx_transform *t = &local[n->typed_id];
+			if (depth + i == 0) {
+				rotation = t->rotation;
+				scale = t->scale;
+				continue;
+			}
+
+			rotation = ufbxi_mul_quat(rotation, t->rotation);
+			if (n->inherit_type != UFBX_INHERIT_NO_SCALE) {
+				scale.x *= t->scale.x;
+				scale.y *= t->scale.y;
+				scale.z *= t->scale.z;
+			} else {
+				scale = t->scale;
+			}
+		}
+
+		depth += count;
+	}
+
+	*p_rotation = rotation;
+	*p_scale = scale;
+}
+
+#if UFBXI_FEATURE_SCENE_EVALUATION
+
+typedef struct {
+	char *src_element;
+	char *dst_element;
+
+	ufbxi_scene_imp *src_imp;
+	ufbx_scene src_scene;
+	ufbx_evaluate_opts opts;
+	ufbx_anim anim;
+	double time;
+
+	ufbx_error error;
+
+	// Allocators
+	ufbxi_allocator ator_result;
+	ufbxi_allocator ator_tmp;
+
+	ufbxi_buf result;
+	ufbxi_buf tmp;
+
+	ufbx_scene scene;
+
+	ufbxi_scene_imp *scene_imp;
+} ufbxi_eval_context;
+
+static ufbxi_forceinline ufbx_element *ufbxi_translate_element(ufbxi_eval_context *ec, void *elem)
+{
+	return elem ? (ufbx_element*)(ec->dst_element + ((char*)elem - ec->src_element)) : NULL;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_translate_element_list(ufbxi_eval_context *ec, void *p_list)
+{
+	ufbx_element_list *list = (ufbx_element_list*)p_list;
+	size_t count = list->count;
+	ufbx_element **src = list->data;
+	ufbx_element **dst = ufbxi_push(&ec->result, ufbx_element*, count);
+	ufbxi_check_err(&ec->error, dst);
+	list->data = dst;
+	for (size_t i = 0; i < count; i++) {
+		dst[i] = ufbxi_translate_element(ec, src[i]);
+	}
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_translate_anim(ufbxi_eval_context *ec, ufbx_anim *anim)
+{
+	ufbx_anim_layer_desc *layers = ufbxi_push(&ec->result, ufbx_anim_layer_desc, anim->layers.count);
+	ufbxi_check_err(&ec->error, layers);
+	for (size_t i = 0; i < anim->layers.count; i++) {
+		layers[i] = anim->layers.data[i];
+		layers[i].layer = (ufbx_anim_layer*)ufbxi_translate_element(ec, layers[i].layer);
+	}
+	anim->layers.data = layers;
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_imp(ufbxi_eval_context *ec)
+{
+	// `ufbx_evaluate_opts` must be cleared to zero first!
+	ufbx_assert(ec->opts._begin_zero == 0 && ec->opts._end_zero == 0);
+	ufbxi_check_err_msg(&ec->error, ec->opts._begin_zero == 0 && ec->opts._end_zero == 0, "Uninitialized options");
+
+	ec->scene = ec->src_scene;
+	size_t num_elements = ec->scene.elements.count;
+
+	char *element_data = (char*)ufbxi_push(&ec->result, uint64_t, ec->scene.metadata.element_buffer_size/8);
+	ufbxi_check_err(&ec->error, element_data);
+
+	ec->scene.elements.data = ufbxi_push(&ec->result, ufbx_element*, num_elements);
+	ufbxi_check_err(&ec->error, ec->scene.elements.data);
+
+	ec->src_element = (char*)ec->src_scene.elements.data[0];
+	ec->dst_element = element_data;
+
+	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
+		ec->scene.elements_by_type[i].data = ufbxi_push(&ec->result, ufbx_element*, ec->scene.elements_by_type[i].count);
+		ufbxi_check_err(&ec->error, ec->scene.elements_by_type[i].data);
+	}
+
+	size_t num_connections = ec->scene.connections_dst.count;
+	ec->scene.connections_src.data = ufbxi_push(&ec->result, ufbx_connection, num_connections);
+	ec->scene.connections_dst.data = ufbxi_push(&ec->result, ufbx_connection, num_connections);
+	ufbxi_check_err(&ec->error, ec->scene.connections_src.data);
+	ufbxi_check_err(&ec->error, ec->scene.connections_dst.data);
+	for (size_t i = 0; i < num_connections; i++) {
+		ufbx_connection *src = &ec->scene.connections_src.data[i];
+		ufbx_connection *dst = &ec->scene.connections_dst.data[i];
+		*src = ec->src_scene.connections_src.data[i];
+		*dst = ec->src_scene.connections_dst.data[i];
+		src->src = ufbxi_translate_element(ec, src->src);
+		src->dst = ufbxi_translate_element(ec, src->dst);
+		dst->src = ufbxi_translate_element(ec, dst->src);
+		dst->dst = ufbxi_translate_element(ec, dst->dst);
+	}
+
+	ec->scene.elements_by_name.data = ufbxi_push(&ec->result, ufbx_name_element, num_elements);
+	ufbxi_check_err(&ec->error, ec->scene.elements_by_name.data);
+
+	ec->scene.root_node = (ufbx_node*)ufbxi_translate_element(ec, ec->scene.root_node);
+	ufbxi_check_err(&ec->error, ufbxi_translate_anim(ec, &ec->scene.anim));
+	ufbxi_check_err(&ec->error, ufbxi_translate_anim(ec, &ec->scene.combined_anim));
+
+	for (size_t i = 0; i < num_elements; i++) {
+		ufbx_element *src = ec->src_scene.elements.data[i];
+		ufbx_element *dst = ufbxi_translate_element(ec, src);
+		size_t size = ufbx_element_type_size[src->type];
+		ufbx_assert(size > 0);
+		memcpy(dst, src, size);
+
+		ec->scene.elements.data[i] = dst;
+		ec->scene.elements_by_type[src->type].data[src->typed_id] = dst;
+
+		dst->connections_src.data = ec->scene.connections_src.data + (dst->connections_src.data - ec->src_scene.connections_src.data);
+		dst->connections_dst.data = ec->scene.connections_dst.data + (dst->connections_dst.data - ec->src_scene.connections_dst.data);
+		if (dst->instances.count > 0) {
+			ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &dst->instances));
+		}
+
+		ufbx_name_element named = ec->src_scene.elements_by_name.data[i];
+		named.element = ufbxi_translate_element(ec, named.element);
+		ec->scene.elements_by_name.data[i] = named;
+	}
+
+	ufbxi_for_ptr_list(ufbx_node, p_node, ec->scene.nodes) {
+		ufbx_node *node = *p_node;
+		node->parent = (ufbx_node*)ufbxi_translate_element(ec, node->parent);
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &node->children));
+
+		node->attrib = ufbxi_translate_element(ec, node->attrib);
+		node->mesh = (ufbx_mesh*)ufbxi_translate_element(ec, node->mesh);
+		node->light = (ufbx_light*)ufbxi_translate_element(ec, node->light);
+		node->camera = (ufbx_camera*)ufbxi_translate_element(ec, node->camera);
+		node->bone = (ufbx_bone*)ufbxi_translate_element(ec, node->bone);
+
+		if (node->all_attribs.count > 1) {
+			ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &node->all_attribs));
+		} else if (node->all_attribs.count == 1) {
+			node->all_attribs.data = &node->attrib;
+		}
+
+		node->geometry_transform_helper = (ufbx_node*)ufbxi_translate_element(ec, node->geometry_transform_helper);
+
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &node->materials));
+	}
+
+	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, ec->scene.meshes) {
+		ufbx_mesh *mesh = *p_mesh;
+
+		ufbx_mesh_material *materials = ufbxi_push(&ec->result, ufbx_mesh_material, mesh->materials.count);
+		ufbxi_check_err(&ec->error, materials);
+		for (size_t i = 0; i < mesh->materials.count; i++) {
+			materials[i] = mesh->materials.data[i];
+			materials[i].material = (ufbx_material*)ufbxi_translate_element(ec, materials[i].material);
+		}
+		mesh->materials.data = materials;
+
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &mesh->skin_deformers));
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &mesh->blend_deformers));
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &mesh->cache_deformers));
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &mesh->all_deformers));
+	}
+
+	ufbxi_for_ptr_list(ufbx_stereo_camera, p_stereo, ec->scene.stereo_cameras) {
+		ufbx_stereo_camera *stereo = *p_stereo;
+		stereo->left = (ufbx_camera*)ufbxi_translate_element(ec, stereo->left);
+		stereo->right = (ufbx_camera*)ufbxi_translate_element(ec, stereo->right);
+	}
+
+	ufbxi_for_ptr_list(ufbx_skin_deformer, p_skin, ec->scene.skin_deformers) {
+		ufbx_skin_deformer *skin = *p_skin;
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &skin->clusters));
+	}
+
+	ufbxi_for_ptr_list(ufbx_skin_cluster, p_cluster, ec->scene.skin_clusters) {
+		ufbx_skin_cluster *cluster = *p_cluster;
+		cluster->bone_node = (ufbx_node*)ufbxi_translate_element(ec, cluster->bone_node);
+	}
+
+	ufbxi_for_ptr_list(ufbx_blend_deformer, p_blend, ec->scene.blend_deformers) {
+		ufbx_blend_deformer *blend = *p_blend;
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &blend->channels));
+	}
+
+	ufbxi_for_ptr_list(ufbx_blend_channel, p_chan, ec->scene.blend_channels) {
+		ufbx_blend_channel *chan = *p_chan;
+
+		ufbx_blend_keyframe *keys = ufbxi_push(&ec->result, ufbx_blend_keyframe, chan->keyframes.count);
+		ufbxi_check_err(&ec->error, keys);
+		for (size_t i = 0; i < chan->keyframes.count; i++) {
+			keys[i] = chan->keyframes.data[i];
+			keys[i].shape = (ufbx_blend_shape*)ufbxi_translate_element(ec, keys[i].shape);
+		}
+		chan->keyframes.data = keys;
+	}
+
+	ufbxi_for_ptr_list(ufbx_cache_deformer, p_deformer, ec->scene.cache_deformers) {
+		ufbx_cache_deformer *deformer = *p_deformer;
+		deformer->file = (ufbx_cache_file*)ufbxi_translate_element(ec, deformer->file);
+	}
+
+	ufbxi_for_ptr_list(ufbx_material, p_material, ec->scene.materials) {
+		ufbx_material *material = *p_material;
+
+		material->shader = (ufbx_shader*)ufbxi_translate_element(ec, material->shader);
+		for (size_t i = 0; i < UFBX_MATERIAL_FBX_MAP_COUNT; i++) {
+			ufbx_material_map *map = &material->fbx.maps[i];
+			map->texture = (ufbx_texture*)ufbxi_translate_element(ec, map->texture);
+		}
+		for (size_t i = 0; i < UFBX_MATERIAL_PBR_MAP_COUNT; i++) {
+			ufbx_material_map *map = &material->pbr.maps[i];
+			map->texture = (ufbx_texture*)ufbxi_translate_element(ec, map->texture);
+		}
+
+		ufbx_material_texture *textures = ufbxi_push(&ec->result, ufbx_material_texture, material->textures.count);
+		ufbxi_check_err(&ec->error, textures);
+		for (size_t i = 0; i < material->textures.count; i++) {
+			textures[i] = material->textures.data[i];
+			textures[i].texture = (ufbx_texture*)ufbxi_translate_element(ec, textures[i].texture);
+		}
+		material->textures.data = textures;
+	}
+
+	ufbxi_for_ptr_list(ufbx_texture, p_texture, ec->scene.textures) {
+		ufbx_texture *texture = *p_texture;
+		texture->video = (ufbx_video*)ufbxi_translate_element(ec, texture->video);
+
+		ufbx_texture_layer *layers = ufbxi_push(&ec->result, ufbx_texture_layer, texture->layers.count);
+		ufbxi_check_err(&ec->error, layers);
+		for (size_t i = 0; i < texture->layers.count; i++) {
+			layers[i] = texture->layers.data[i];
+			layers[i].texture = (ufbx_texture*)ufbxi_translate_element(ec, layers[i].texture);
+		}
+		texture->layers.data = layers;
+
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &texture->file_textures));
+
+		if (texture->shader) {
+			ufbx_shader_texture *shader = texture->shader;
+			shader = ufbxi_push_copy(&ec->result, ufbx_shader_texture, 1, shader);
+			ufbxi_check_err(&ec->error, shader);
+			texture->shader = shader;
+
+			ufbx_shader_texture_input *inputs = ufbxi_push_copy(&ec->result, ufbx_shader_texture_input, shader->inputs.count, shader->inputs.data);
+			ufbxi_check_err(&ec->error, inputs);
+			shader->inputs.data = inputs;
+		}
+	}
+
+	ufbxi_for_ptr_list(ufbx_shader, p_shader, ec->scene.shaders) {
+		ufbx_shader *shader = *p_shader;
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &shader->bindings));
+	}
+
+	ufbxi_for_ptr_list(ufbx_display_layer, p_layer, ec->scene.display_layers) {
+		ufbx_display_layer *layer = *p_layer;
+
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &layer->nodes));
+	}
+
+	ufbxi_for_ptr_list(ufbx_selection_set, p_set, ec->scene.selection_sets) {
+		ufbx_selection_set *set = *p_set;
+
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &set->nodes));
+	}
+
+	ufbxi_for_ptr_list(ufbx_selection_node, p_node, ec->scene.selection_nodes) {
+		ufbx_selection_node *node = *p_node;
+
+		node->target_node = (ufbx_node*)ufbxi_translate_element(ec, node->target_node);
+		node->target_mesh = (ufbx_mesh*)ufbxi_translate_element(ec, node->target_mesh);
+	}
+
+	ufbxi_for_ptr_list(ufbx_constraint, p_constraint, ec->scene.constraints) {
+		ufbx_constraint *constraint = *p_constraint;
+
+		constraint->node = (ufbx_node*)ufbxi_translate_element(ec, constraint->node);
+		constraint->aim_up_node = (ufbx_node*)ufbxi_translate_element(ec, constraint->aim_up_node);
+		constraint->ik_effector = (ufbx_node*)ufbxi_translate_element(ec, constraint->ik_effector);
+		constraint->ik_end_node = (ufbx_node*)ufbxi_translate_element(ec, constraint->ik_end_node);
+
+		ufbx_constraint_target *targets = ufbxi_push(&ec->result, ufbx_constraint_target, constraint->targets.count);
+		ufbxi_check_err(&ec->error, targets);
+		for (size_t i = 0; i < constraint->targets.count; i++) {
+			targets[i] = constraint->targets.data[i];
+			targets[i].node = (ufbx_node*)ufbxi_translate_element(ec, targets[i].node);
+		}
+		constraint->targets.data = targets;
+	}
+
+	ufbxi_for_ptr_list(ufbx_anim_stack, p_stack, ec->scene.anim_stacks) {
+		ufbx_anim_stack *stack = *p_stack;
+
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &stack->layers));
+		ufbxi_check_err(&ec->error, ufbxi_translate_anim(ec, &stack->anim));
+	}
+
+	ufbxi_for_ptr_list(ufbx_anim_layer, p_layer, ec->scene.anim_layers) {
+		ufbx_anim_layer *layer = *p_layer;
+
+		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &layer->anim_values));
+		ufbx_anim_prop *props = ufbxi_push(&ec->result, ufbx_anim_prop, layer->anim_props.count);
+		ufbxi_check_err(&ec->error, props);
+		for (size_t i = 0; i < layer->anim_props.count; i++) {
+			props[i] = layer->anim_props.data[i];
+			props[i].element = ufbxi_translate_element(ec, props[i].element);
+			props[i].anim_value = (ufbx_anim_value*)ufbxi_translate_element(ec, props[i].anim_value);
+		}
+		layer->anim_props.data = props;
+	}
+
+	ufbxi_for_ptr_list(ufbx_pose, p_pose, ec->scene.poses) {
+		ufbx_pose *pose = *p_pose;
+
+		ufbx_bone_pose *bones = ufbxi_push(&ec->result, ufbx_bone_pose, pose->bone_poses.count);
+		ufbxi_check_err(&ec->error, bones);
+		for (size_t i = 0; i < pose->bone_poses.count; i++) {
+			bones[i] = pose->bone_poses.data[i];
+			bones[i].bone_node = (ufbx_node*)ufbxi_translate_element(ec, bones[i].bone_node);
+		}
+		pose->bone_poses.data = bones;
+	}
+
+	ufbxi_check_err(&ec->error, ufbxi_translate_anim(ec, &ec->anim));
+
+	ufbxi_for_ptr_list(ufbx_anim_value, p_value, ec->scene.anim_values) {
+		ufbx_anim_value *value = *p_value;
+		value->curves[0] = (ufbx_anim_curve*)ufbxi_translate_element(ec, value->curves[0]);
+		value->curves[1] = (ufbx_anim_curve*)ufbxi_translate_element(ec, value->curves[1]);
+		value->curves[2] = (ufbx_anim_curve*)ufbxi_translate_element(ec, value->curves[2]);
+	}
+
+	ufbx_anim anim = ec->anim;
+	ufbx_const_prop_override_list overrides_left = ec->anim.prop_overrides;
+
+	// Evaluate the properties
+	ufbxi_for_ptr_list(ufbx_element, p_elem, ec->scene.elements) {
+		ufbx_element *elem = *p_elem;
+		size_t num_animated = elem->props.num_animated;
+
+		// Setup the overrides for this element if found
+		if (overrides_left.count > 0) {
+			if (overrides_left.data[0].element_id <= elem->element_id) {
+				anim.prop_overrides = ufbxi_find_element_prop_overrides(&overrides_left, elem->element_id);
+				overrides_left.data = anim.prop_overrides.data + anim.prop_overrides.count;
+				overrides_left.count = ufbxi_to_size((ec->anim.prop_overrides.data + ec->anim.prop_overrides.count) - overrides_left.data);
+				num_animated += anim.prop_overrides.count;
+			}
+		}
+
+		if (num_animated == 0) continue;
+
+		ufbx_prop *props = ufbxi_push(&ec->result, ufbx_prop, num_animated);
+		ufbxi_check_err(&ec->error, props);
+
+		elem->props = ufbx_evaluate_props(&anim, elem, ec->time, props, num_animated);
+		elem->props.defaults = &ec->src_scene.elements.data[elem->element_id]->props;
+
+		anim.prop_overrides.count = 0;
+	}
+
+	// Update all derived values
+	ufbxi_update_scene(&ec->scene, false);
+
+	// Evaluate skinning if requested
+	if (ec->opts.evaluate_skinning) {
+		ufbx_geometry_cache_data_opts cache_opts = { 0 };
+		cache_opts.open_file_cb = ec->opts.open_file_cb;
+		ufbxi_check_err(&ec->error, ufbxi_evaluate_skinning(&ec->scene, &ec->error, &ec->result, &ec->tmp,
+			ec->time, ec->opts.load_external_files && ec->opts.evaluate_caches, &cache_opts));
+	}
+
+	// Retain the scene, this must be the final allocation as we copy
+	// `ator_result` to `ufbx_scene_imp`.
+	ufbxi_scene_imp *imp = ufbxi_push_zero(&ec->result, ufbxi_scene_imp, 1);
+	ufbxi_check_err(&ec->error, imp);
+
+	ufbx_assert(ec->src_imp->magic == UFBXI_SCENE_IMP_MAGIC);
+	ufbxi_init_ref(&imp->refcount, UFBXI_SCENE_IMP_MAGIC, &ec->src_imp->refcount);
+
+	imp->magic = UFBXI_SCENE_IMP_MAGIC;
+	imp->scene = ec->scene;
+	imp->ator = ec->ator_result;
+	imp->ator.error = NULL;
+
+	// Copy retained buffers and translate the allocator struct to the one
+	// contained within `ufbxi_scene_imp`
+	imp->result_buf = ec->result;
+	imp->result_buf.ator = &imp->ator;
+
+	imp->scene.metadata.result_memory_used = imp->ator.current_size;
+	imp->scene.metadata.temp_memory_used = ec->ator_tmp.current_size;
+	imp->scene.metadata.result_allocs = imp->ator.num_allocs;
+	imp->scene.metadata.temp_allocs = ec->ator_tmp.num_allocs;
+
+	ufbxi_for_ptr_list(ufbx_element, p_elem, imp->scene.elements) {
+		(*p_elem)->scene = &imp->scene;
+	}
+
+	ec->scene_imp = imp;
+	ec->result.ator = &ec->ator_result;
+
+	return 1;
+}
+
+ufbxi_nodiscard static ufbxi_noinline ufbx_scene *ufbxi_evaluate_scene(ufbxi_eval_context *ec, ufbx_scene *scene, const ufbx_anim *anim, double time, const ufbx_evaluate_opts *user_opts, ufbx_error *p_error)
+{
+	if (user_opts) {
+		ec->opts = *user_opts;
+	} else {
+		memset(&ec->opts, 0, sizeof(ec->opts));
+	}
+
+	ec->src_imp = ufbxi_get_imp(ufbxi_scene_imp, scene);
+	ec->src_scene = *scene;
+	ec->anim = anim ? *anim : scene->anim;
+	ec->time = time;
+
+	ufbxi_init_ator(&ec->error, &ec->ator_tmp, &ec->opts.temp_allocator, "temp");
+	ufbxi_init_ator(&ec->error, &ec->ator_result, &ec->opts.result_allocator, "result");
+
+	ec->result.ator = &ec->ator_result;
+	ec->tmp.ator = &ec->ator_tmp;
+
+	ec->result.unordered = true;
+	ec->tmp.unordered = true;
+
+	if (ufbxi_evaluate_imp(ec)) {
+		ufbxi_buf_free(&ec->tmp);
+		ufbxi_free_ator(&ec->ator_tmp);
+		if (p_error) {
+			ufbxi_clear_error(p_error);
+		}
+		return &ec->scene_imp->scene;
+	} else {
+		ufbxi_fix_error_type(&ec->error, "Failed to evaluate");
+		if (p_error) *p_error = ec->error;
+		ufbxi_buf_free(&ec->tmp);
+		ufbxi_buf_free(&ec->result);
+		ufbxi_free_ator(&ec->ator_tmp);
+		ufbxi_free_ator(&ec->ator_result);
+		return NULL;
+	}
+}
+
+#endif
+
+// -- Animation baking
+
+typedef struct {
+	ufbxi_refcount refcount;
+	ufbx_baked_anim bake;
+	uint32_t magic;
+
+	ufbxi_allocator ator;
+	ufbxi_buf result_buf;
+} ufbxi_baked_anim_imp;
+
+ufbx_static_assert(baked_anim_imp_offset, offsetof(ufbxi_baked_anim_imp, bake) == sizeof(ufbxi_refcount));
+
+#if UFBXI_FEATURE_ANIMATION_BAKING
+
+typedef enum {
+	UFBXI_BAKE_NODE,
+	UFBXI_BAKE_BLEND_CHANNEL,
+	UFBXI_BAKE_PROP,
+} ufbxi_bake_type;
+
+// Keys of a single output track, `values` has `num_components` reals per key.
+// Both are filled for every sample time and reduced in place.
+typedef struct {
+	double *times;
+	ufbx_real *values;
+	size_t num_components;
+	size_t num_keys;
+} ufbxi_bake_track;
+
+typedef struct {
+	ufbxi_bake_type type;
+	const ufbx_element *element;
+	ufbx_string prop_name;
 
-	ufbx_props prop_list;
-	prop_list.props.data = props;
-	prop_list.props.count = prop_list.num_animated = num_props;
-	prop_list.defaults = (ufbx_props*)&element->props;
-	return prop_list;
-}
+	const double *times;
+	size_t num_times;
 
-#if UFBXI_FEATURE_SCENE_EVALUATION
+	ufbxi_bake_track tracks[3];
+	size_t num_tracks;
+} ufbxi_bake_job;
 
 typedef struct {
-	char *src_element;
-	char *dst_element;
-
-	ufbxi_scene_imp *src_imp;
-	ufbx_scene src_scene;
-	ufbx_evaluate_opts opts;
-	ufbx_anim anim;
-	double time;
+	const ufbx_anim *anim;
+	ufbxi_bake_job *jobs;
+	size_t num_jobs;
+	uint32_t num_tasks;
+	bool reduce_keys;
+	ufbx_real tolerance;
+} ufbxi_bake_tasks;
 
+typedef struct {
 	ufbx_error error;
 
-	// Allocators
-	ufbxi_allocator ator_result;
+	ufbx_bake_opts opts;
+
+	const ufbx_scene *scene;
+	ufbx_anim anim;
+
 	ufbxi_allocator ator_tmp;
+	ufbxi_allocator ator_result;
 
-	ufbxi_buf result;
 	ufbxi_buf tmp;
+	ufbxi_buf tmp_stack;
+	ufbxi_buf tmp_times;
+	ufbxi_buf result;
 
-	ufbx_scene scene;
+	double *tmp_sort;
+	size_t tmp_sort_cap;
 
-	ufbxi_scene_imp *scene_imp;
-} ufbxi_eval_context;
+	double time_begin;
+	double time_end;
 
-static ufbxi_forceinline ufbx_element *ufbxi_translate_element(ufbxi_eval_context *ec, void *elem)
-{
-	return elem ? (ufbx_element*)(ec->dst_element + ((char*)elem - ec->src_element)) : NULL;
-}
+	double *fixed_times;
+	size_t num_fixed_times;
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_translate_element_list(ufbxi_eval_context *ec, void *p_list)
+	ufbxi_bake_job *jobs;
+	size_t num_jobs;
+	size_t num_samples;
+
+	ufbx_baked_anim bake;
+
+	ufbxi_baked_anim_imp *imp;
+
+} ufbxi_bake_context;
+
+static bool ufbxi_bake_is_transform_prop(const char *name)
 {
-	ufbx_element_list *list = (ufbx_element_list*)p_list;
-	size_t count = list->count;
-	ufbx_element **src = list->data;
-	ufbx_element **dst = ufbxi_push(&ec->result, ufbx_element*, count);
-	ufbxi_check_err(&ec->error, dst);
-	list->data = dst;
-	for (size_t i = 0; i < count; i++) {
-		dst[i] = ufbxi_translate_element(ec, src[i]);
+	for (size_t i = 0; i < ufbxi_arraycount(ufbxi_transform_props); i++) {
+		if (!strcmp(name, ufbxi_transform_props[i])) return true;
 	}
-	return 1;
+	return false;
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_translate_anim(ufbxi_eval_context *ec, ufbx_anim *anim)
+static bool ufbxi_bake_is_rotation_prop(const char *name)
 {
-	ufbx_anim_layer_desc *layers = ufbxi_push(&ec->result, ufbx_anim_layer_desc, anim->layers.count);
-	ufbxi_check_err(&ec->error, layers);
-	for (size_t i = 0; i < anim->layers.count; i++) {
-		layers[i] = anim->layers.data[i];
-		layers[i].layer = (ufbx_anim_layer*)ufbxi_translate_element(ec, layers[i].layer);
-	}
-	anim->layers.data = layers;
-	return 1;
+	return !strcmp(name, ufbxi_Lcl_Rotation) || !strcmp(name, ufbxi_PreRotation) || !strcmp(name, ufbxi_PostRotation);
 }
 
-ufbxi_nodiscard static ufbxi_noinline int ufbxi_evaluate_imp(ufbxi_eval_context *ec)
+// Find the property that is evaluated in place of `element.name`, see `ufbxi_evaluate_connected_prop()`
+static ufbxi_noinline void ufbxi_bake_resolve_prop(const ufbxi_bake_context *bc, const ufbx_element **p_element, const char **p_name)
 {
-	// `ufbx_evaluate_opts` must be cleared to zero first!
-	ufbx_assert(ec->opts._begin_zero == 0 && ec->opts._end_zero == 0);
-	ufbxi_check_err_msg(&ec->error, ec->opts._begin_zero == 0 && ec->opts._end_zero == 0, "Uninitialized options");
-
-	ec->scene = ec->src_scene;
-	size_t num_elements = ec->scene.elements.count;
-
-	char *element_data = (char*)ufbxi_push(&ec->result, uint64_t, ec->scene.metadata.element_buffer_size/8);
-	ufbxi_check_err(&ec->error, element_data);
-
-	ec->scene.elements.data = ufbxi_push(&ec->result, ufbx_element*, num_elements);
-	ufbxi_check_err(&ec->error, ec->scene.elements.data);
-
-	ec->src_element = (char*)ec->src_scene.elements.data[0];
-	ec->dst_element = element_data;
+	const ufbx_element *element = *p_element;
+	ufbx_prop *prop = ufbx_find_prop(&element->props, *p_name);
+	if (!prop || (prop->flags & UFBX_PROP_FLAG_CONNECTED) == 0 || bc->anim.ignore_connections) return;
 
-	for (size_t i = 0; i < UFBX_ELEMENT_TYPE_COUNT; i++) {
-		ec->scene.elements_by_type[i].data = ufbxi_push(&ec->result, ufbx_element*, ec->scene.elements_by_type[i].count);
-		ufbxi_check_err(&ec->error, ec->scene.elements_by_type[i].data);
+	ufbx_connection *conn = ufbxi_find_prop_connection(element, prop->name.data);
+	for (size_t i = 0; i < 1000 && conn; i++) {
+		ufbx_connection *next_conn = ufbxi_find_prop_connection(conn->src, conn->src_prop.data);
+		if (!next_conn) break;
+		conn = next_conn;
 	}
 
-	size_t num_connections = ec->scene.connections_dst.count;
-	ec->scene.connections_src.data = ufbxi_push(&ec->result, ufbx_connection, num_connections);
-	ec->scene.connections_dst.data = ufbxi_push(&ec->result, ufbx_connection, num_connections);
-	ufbxi_check_err(&ec->error, ec->scene.connections_src.data);
-	ufbxi_check_err(&ec->error, ec->scene.connections_dst.data);
-	for (size_t i = 0; i < num_connections; i++) {
-		ufbx_connection *src = &ec->scene.connections_src.data[i];
-		ufbx_connection *dst = &ec->scene.connections_dst.data[i];
-		*src = ec->src_scene.connections_src.data[i];
-		*dst = ec->src_scene.connections_dst.data[i];
-		src->src = ufbxi_translate_element(ec, src->src);
-		src->dst = ufbxi_translate_element(ec, src->dst);
-		dst->src = ufbxi_translate_element(ec, dst->src);
-		dst->dst = ufbxi_translate_element(ec, dst->dst);
+	if (conn && !ufbxi_find_prop_connection(conn->src, conn->src_prop.data)) {
+		*p_element = conn->src;
+		*p_name = conn->src_prop.data;
 	}
+}
 
-	ec->scene.elements_by_name.data = ufbxi_push(&ec->result, ufbx_name_element, num_elements);
-	ufbxi_check_err(&ec->error, ec->scene.elements_by_name.data);
-
-	ec->scene.root_node = (ufbx_node*)ufbxi_translate_element(ec, ec->scene.root_node);
-	ufbxi_check_err(&ec->error, ufbxi_translate_anim(ec, &ec->scene.anim));
-	ufbxi_check_err(&ec->error, ufbxi_translate_anim(ec, &ec->scene.combined_anim));
-
-	for (size_t i = 0; i < num_elements; i++) {
-		ufbx_element *src = ec->src_scene.elements.data[i];
-		ufbx_element *dst = ufbxi_translate_element(ec, src);
-		size_t size = ufbx_element_type_size[src->type];
-		ufbx_assert(size > 0);
-		memcpy(dst, src, size);
+static ufbxi_noinline bool ufbxi_bake_is_animated(const ufbxi_bake_context *bc, const ufbx_element *element, const char *name)
+{
+	ufbxi_bake_resolve_prop(bc, &element, &name);
+	ufbxi_for_list(const ufbx_anim_layer_desc, desc, bc->anim.layers) {
+		if (ufbx_find_anim_prop_len(desc->layer, element, name, strlen(name))) return true;
+	}
+	return false;
+}
 
-		ec->scene.elements.data[i] = dst;
-		ec->scene.elements_by_type[src->type].data[src->typed_id] = dst;
+ufbxi_nodiscard static ufbxi_forceinline int ufbxi_bake_push_time(ufbxi_bake_context *bc, double time)
+{
+	if (!(time >= bc->time_begin && time <= bc->time_end)) return 1;
+	double *dst = ufbxi_push(&bc->tmp_times, double, 1);
+	ufbxi_check_err(&bc->error, dst);
+	*dst = time;
+	return 1;
+}
 
-		dst->connections_src.data = ec->scene.connections_src.data + (dst->connections_src.data - ec->src_scene.connections_src.data);
-		dst->connections_dst.data = ec->scene.connections_dst.data + (dst->connections_dst.data - ec->src_scene.connections_dst.data);
-		if (dst->instances.count > 0) {
-			ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &dst->instances));
-		}
+// Push the keyframe times of `curve` and additional samples for the spans that
+// cannot be represented by linearly interpolating the keyframes.
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_push_curve_times(ufbxi_bake_context *bc, const ufbx_anim_curve *curve, bool resample_linear)
+{
+	double rate = bc->opts.resample_rate, step = bc->opts.step_time;
 
-		ufbx_name_element named = ec->src_scene.elements_by_name.data[i];
-		named.element = ufbxi_translate_element(ec, named.element);
-		ec->scene.elements_by_name.data[i] = named;
-	}
+	// Grid samples closer than this to a keyframe are redundant
+	double epsilon = 0.01 / rate;
 
-	ufbxi_for_ptr_list(ufbx_node, p_node, ec->scene.nodes) {
-		ufbx_node *node = *p_node;
-		node->parent = (ufbx_node*)ufbxi_translate_element(ec, node->parent);
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &node->children));
+	size_t num_keys = curve->keyframes.count;
+	for (size_t i = 0; i < num_keys; i++) {
+		const ufbx_keyframe *key = &curve->keyframes.data[i];
+		ufbxi_check_err(&bc->error, ufbxi_bake_push_time(bc, key->time));
+		if (i + 1 == num_keys) break;
 
-		node->attrib = ufbxi_translate_element(ec, node->attrib);
-		node->mesh = (ufbx_mesh*)ufbxi_translate_element(ec, node->mesh);
-		node->light = (ufbx_light*)ufbxi_translate_element(ec, node->light);
-		node->camera = (ufbx_camera*)ufbxi_translate_element(ec, node->camera);
-		node->bone = (ufbx_bone*)ufbxi_translate_element(ec, node->bone);
+		double t0 = key->time, t1 = key[1].time;
+		if (!(t1 > t0)) continue;
 
-		if (node->all_attribs.count > 1) {
-			ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &node->all_attribs));
-		} else if (node->all_attribs.count == 1) {
-			node->all_attribs.data = &node->attrib;
+		bool resample = false;
+		switch (key->interpolation) {
+		case UFBX_INTERPOLATION_CONSTANT_PREV:
+			if (t1 - step > t0) ufbxi_check_err(&bc->error, ufbxi_bake_push_time(bc, t1 - step));
+			break;
+		case UFBX_INTERPOLATION_CONSTANT_NEXT:
+			if (t0 + step < t1) ufbxi_check_err(&bc->error, ufbxi_bake_push_time(bc, t0 + step));
+			break;
+		case UFBX_INTERPOLATION_LINEAR:
+			resample = resample_linear;
+			break;
+		default:
+			resample = true;
+			break;
 		}
+		if (!resample) continue;
 
-		node->geometry_transform_helper = (ufbx_node*)ufbxi_translate_element(ec, node->geometry_transform_helper);
-
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &node->materials));
-	}
-
-	ufbxi_for_ptr_list(ufbx_mesh, p_mesh, ec->scene.meshes) {
-		ufbx_mesh *mesh = *p_mesh;
+		// Sample the span on the same grid as `ufbx_bake_opts.fixed_rate`
+		double lo = ufbx_fmax(t0, bc->time_begin) + epsilon;
+		double hi = ufbx_fmin(t1, bc->time_end) - epsilon;
+		if (!(hi > lo)) continue;
 
-		ufbx_mesh_material *materials = ufbxi_push(&ec->result, ufbx_mesh_material, mesh->materials.count);
-		ufbxi_check_err(&ec->error, materials);
-		for (size_t i = 0; i < mesh->materials.count; i++) {
-			materials[i] = mesh->materials.data[i];
-			materials[i].material = (ufbx_material*)ufbxi_translate_element(ec, materials[i].material);
+		double first = (lo - bc->time_begin) * rate;
+		for (uint64_t ix = (uint64_t)first; ; ix++) {
+			double time = bc->time_begin + (double)ix / rate;
+			if (time >= hi) break;
+			if (time > lo) {
+				ufbxi_check_err(&bc->error, ufbxi_bake_push_time(bc, time));
+			}
 		}
-		mesh->materials.data = materials;
-
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &mesh->skin_deformers));
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &mesh->blend_deformers));
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &mesh->cache_deformers));
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &mesh->all_deformers));
 	}
 
-	ufbxi_for_ptr_list(ufbx_stereo_camera, p_stereo, ec->scene.stereo_cameras) {
-		ufbx_stereo_camera *stereo = *p_stereo;
-		stereo->left = (ufbx_camera*)ufbxi_translate_element(ec, stereo->left);
-		stereo->right = (ufbx_camera*)ufbxi_translate_element(ec, stereo->right);
-	}
+	return 1;
+}
 
-	ufbxi_for_ptr_list(ufbx_skin_deformer, p_skin, ec->scene.skin_deformers) {
-		ufbx_skin_deformer *skin = *p_skin;
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &skin->clusters));
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_push_value_times(ufbxi_bake_context *bc, const ufbx_anim_value *value, bool resample_linear)
+{
+	for (size_t i = 0; i < 3; i++) {
+		if (value->curves[i]) {
+			ufbxi_check_err(&bc->error, ufbxi_bake_push_curve_times(bc, value->curves[i], resample_linear));
+		}
 	}
+	return 1;
+}
 
-	ufbxi_for_ptr_list(ufbx_skin_cluster, p_cluster, ec->scene.skin_clusters) {
-		ufbx_skin_cluster *cluster = *p_cluster;
-		cluster->bone_node = (ufbx_node*)ufbxi_translate_element(ec, cluster->bone_node);
-	}
+// Push the sample times of a single property evaluated for `job`
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_push_prop_times(ufbxi_bake_context *bc, const ufbx_element *element, const char *name, bool is_rotation)
+{
+	ufbxi_bake_resolve_prop(bc, &element, &name);
+	size_t name_len = strlen(name);
 
-	ufbxi_for_ptr_list(ufbx_blend_deformer, p_blend, ec->scene.blend_deformers) {
-		ufbx_blend_deformer *blend = *p_blend;
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &blend->channels));
+	// Blending multiple layers or evaluating rotations does not preserve linearity
+	size_t num_layers = 0;
+	ufbxi_for_list(const ufbx_anim_layer_desc, desc, bc->anim.layers) {
+		if (ufbx_find_anim_prop_len(desc->layer, element, name, name_len)) num_layers++;
 	}
 
-	ufbxi_for_ptr_list(ufbx_blend_channel, p_chan, ec->scene.blend_channels) {
-		ufbx_blend_channel *chan = *p_chan;
+	ufbxi_for_list(const ufbx_anim_layer_desc, desc, bc->anim.layers) {
+		ufbx_anim_layer *layer = desc->layer;
+		ufbx_anim_prop *aprop = ufbx_find_anim_prop_len(layer, element, name, name_len);
+		if (!aprop) continue;
 
-		ufbx_blend_keyframe *keys = ufbxi_push(&ec->result, ufbx_blend_keyframe, chan->keyframes.count);
-		ufbxi_check_err(&ec->error, keys);
-		for (size_t i = 0; i < chan->keyframes.count; i++) {
-			keys[i] = chan->keyframes.data[i];
-			keys[i].shape = (ufbx_blend_shape*)ufbxi_translate_element(ec, keys[i].shape);
+		if (layer->weight_is_animated && layer->blended) {
+			ufbxi_for_list(ufbx_anim_prop, weight_aprop, ufbx_find_anim_props(layer, &layer->element)) {
+				ufbxi_check_err(&bc->error, ufbxi_bake_push_value_times(bc, weight_aprop->anim_value, true));
+			}
 		}
-		chan->keyframes.data = keys;
-	}
 
-	ufbxi_for_ptr_list(ufbx_cache_deformer, p_deformer, ec->scene.cache_deformers) {
-		ufbx_cache_deformer *deformer = *p_deformer;
-		deformer->file = (ufbx_cache_file*)ufbxi_translate_element(ec, deformer->file);
+		ufbxi_check_err(&bc->error, ufbxi_bake_push_value_times(bc, aprop->anim_value, num_layers > 1 || is_rotation));
 	}
 
-	ufbxi_for_ptr_list(ufbx_material, p_material, ec->scene.materials) {
-		ufbx_material *material = *p_material;
-
-		material->shader = (ufbx_shader*)ufbxi_translate_element(ec, material->shader);
-		for (size_t i = 0; i < UFBX_MATERIAL_FBX_MAP_COUNT; i++) {
-			ufbx_material_map *map = &material->fbx.maps[i];
-			map->texture = (ufbx_texture*)ufbxi_translate_element(ec, map->texture);
-		}
-		for (size_t i = 0; i < UFBX_MATERIAL_PBR_MAP_COUNT; i++) {
-			ufbx_material_map *map = &material->pbr.maps[i];
-			map->texture = (ufbx_texture*)ufbxi_translate_element(ec, map->texture);
-		}
+	return 1;
+}
 
-		ufbx_material_texture *textures = ufbxi_push(&ec->result, ufbx_material_texture, material->textures.count);
-		ufbxi_check_err(&ec->error, textures);
-		for (size_t i = 0; i < material->textures.count; i++) {
-			textures[i] = material->textures.data[i];
-			textures[i].texture = (ufbx_texture*)ufbxi_translate_element(ec, textures[i].texture);
-		}
-		material->textures.data = textures;
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_job_times(ufbxi_bake_context *bc, ufbxi_bake_job *job)
+{
+	if (bc->opts.fixed_rate) {
+		job->times = bc->fixed_times;
+		job->num_times = bc->num_fixed_times;
+		return 1;
 	}
 
-	ufbxi_for_ptr_list(ufbx_texture, p_texture, ec->scene.textures) {
-		ufbx_texture *texture = *p_texture;
-		texture->video = (ufbx_video*)ufbxi_translate_element(ec, texture->video);
+	ufbxi_check_err(&bc->error, ufbxi_bake_push_time(bc, bc->time_begin));
+	ufbxi_check_err(&bc->error, ufbxi_bake_push_time(bc, bc->time_end));
 
-		ufbx_texture_layer *layers = ufbxi_push(&ec->result, ufbx_texture_layer, texture->layers.count);
-		ufbxi_check_err(&ec->error, layers);
-		for (size_t i = 0; i < texture->layers.count; i++) {
-			layers[i] = texture->layers.data[i];
-			layers[i].texture = (ufbx_texture*)ufbxi_translate_element(ec, layers[i].texture);
+	if (job->type == UFBXI_BAKE_NODE) {
+		for (size_t i = 0; i < ufbxi_arraycount(ufbxi_transform_props); i++) {
+			const char *name = ufbxi_transform_props[i];
+			ufbxi_check_err(&bc->error, ufbxi_bake_push_prop_times(bc, job->element, name, ufbxi_bake_is_rotation_prop(name)));
 		}
-		texture->layers.data = layers;
-
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &texture->file_textures));
+	} else if (job->type == UFBXI_BAKE_BLEND_CHANNEL) {
+		ufbxi_check_err(&bc->error, ufbxi_bake_push_prop_times(bc, job->element, ufbxi_DeformPercent, false));
+	} else {
+		ufbxi_check_err(&bc->error, ufbxi_bake_push_prop_times(bc, job->element, job->prop_name.data, false));
+	}
 
-		if (texture->shader) {
-			ufbx_shader_texture *shader = texture->shader;
-			shader = ufbxi_push_copy(&ec->result, ufbx_shader_texture, 1, shader);
-			ufbxi_check_err(&ec->error, shader);
-			texture->shader = shader;
+	size_t num_times = bc->tmp_times.num_items;
+	double *times = ufbxi_push_pop(&bc->tmp, &bc->tmp_times, double, num_times);
+	ufbxi_check_err(&bc->error, times);
 
-			ufbx_shader_texture_input *inputs = ufbxi_push_copy(&ec->result, ufbx_shader_texture_input, shader->inputs.count, shader->inputs.data);
-			ufbxi_check_err(&ec->error, inputs);
-			shader->inputs.data = inputs;
+	ufbxi_check_err(&bc->error, ufbxi_grow_array(&bc->ator_tmp, &bc->tmp_sort, &bc->tmp_sort_cap, num_times));
+	ufbxi_macro_stable_sort(double, 32, times, bc->tmp_sort, num_times, ( *a < *b ));
+
+	// Merge keys from different curves that are practically at the same time
+	size_t num_unique = 1;
+	for (size_t i = 1; i < num_times; i++) {
+		if (times[i] - times[num_unique - 1] > 1e-9) {
+			times[num_unique++] = times[i];
 		}
 	}
 
-	ufbxi_for_ptr_list(ufbx_shader, p_shader, ec->scene.shaders) {
-		ufbx_shader *shader = *p_shader;
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &shader->bindings));
-	}
+	job->times = times;
+	job->num_times = num_unique;
+	return 1;
+}
 
-	ufbxi_for_ptr_list(ufbx_display_layer, p_layer, ec->scene.display_layers) {
-		ufbx_display_layer *layer = *p_layer;
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_push_job(ufbxi_bake_context *bc, ufbxi_bake_type type, const ufbx_element *element, ufbx_string prop_name)
+{
+	ufbxi_bake_job *job = ufbxi_push_zero(&bc->tmp_stack, ufbxi_bake_job, 1);
+	ufbxi_check_err(&bc->error, job);
+	job->type = type;
+	job->element = element;
+	job->prop_name = prop_name;
 
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &layer->nodes));
-	}
+	ufbxi_check_err(&bc->error, ufbxi_bake_job_times(bc, job));
 
-	ufbxi_for_ptr_list(ufbx_selection_set, p_set, ec->scene.selection_sets) {
-		ufbx_selection_set *set = *p_set;
+	static const size_t node_components[] = { 3, 4, 3 };
+	if (type == UFBXI_BAKE_NODE) {
+		job->num_tracks = 3;
+		for (size_t i = 0; i < 3; i++) {
+			job->tracks[i].num_components = node_components[i];
+		}
+	} else {
+		job->num_tracks = 1;
+		job->tracks[0].num_components = type == UFBXI_BAKE_BLEND_CHANNEL ? 1 : 3;
+	}
 
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &set->nodes));
+	size_t num_times = job->num_times;
+	ufbxi_check_err(&bc->error, !ufbxi_does_overflow(num_times * 4, num_times, 4));
+	for (size_t i = 0; i < job->num_tracks; i++) {
+		ufbxi_bake_track *track = &job->tracks[i];
+		track->times = ufbxi_push(&bc->tmp, double, num_times);
+		track->values = ufbxi_push(&bc->tmp, ufbx_real, num_times * track->num_components);
+		ufbxi_check_err(&bc->error, track->times && track->values);
 	}
 
-	ufbxi_for_ptr_list(ufbx_selection_node, p_node, ec->scene.selection_nodes) {
-		ufbx_selection_node *node = *p_node;
+	bc->num_jobs++;
+	bc->num_samples += num_times;
+	return 1;
+}
 
-		node->target_node = (ufbx_node*)ufbxi_translate_element(ec, node->target_node);
-		node->target_mesh = (ufbx_mesh*)ufbxi_translate_element(ec, node->target_mesh);
+static ufbxi_forceinline bool ufbxi_bake_keys_close(const ufbx_real *a, const ufbx_real *b, size_t num_components, ufbx_real tolerance)
+{
+	for (size_t i = 0; i < num_components; i++) {
+		if (!(ufbx_fabs(a[i] - b[i]) <= tolerance)) return false;
 	}
+	return true;
+}
 
-	ufbxi_for_ptr_list(ufbx_constraint, p_constraint, ec->scene.constraints) {
-		ufbx_constraint *constraint = *p_constraint;
+// Remove keys that can be interpolated from the surrounding kept keys within `tolerance`,
+// four component tracks are quaternions and interpolated with `ufbx_quat_slerp()`.
+// Keys are compacted in place, the kept keys never overwrite the ones still being tested.
+static ufbxi_noinline size_t ufbxi_bake_reduce_keys(double *times, ufbx_real *values, size_t num_keys, size_t num_components, ufbx_real tolerance)
+{
+	if (num_keys <= 1) return num_keys;
 
-		constraint->node = (ufbx_node*)ufbxi_translate_element(ec, constraint->node);
-		constraint->aim_up_node = (ufbx_node*)ufbxi_translate_element(ec, constraint->aim_up_node);
-		constraint->ik_effector = (ufbx_node*)ufbxi_translate_element(ec, constraint->ik_effector);
-		constraint->ik_end_node = (ufbx_node*)ufbxi_translate_element(ec, constraint->ik_end_node);
+	size_t nc = num_components;
+	size_t num_kept = 1, anchor = 0;
+	for (size_t i = 1; i + 1 < num_keys; i++) {
+		const ufbx_real *a = values + (num_kept - 1) * nc, *b = values + (i + 1) * nc;
+		double ta = times[num_kept - 1], tb = times[i + 1];
 
-		ufbx_constraint_target *targets = ufbxi_push(&ec->result, ufbx_constraint_target, constraint->targets.count);
-		ufbxi_check_err(&ec->error, targets);
-		for (size_t i = 0; i < constraint->targets.count; i++) {
-			targets[i] = constraint->targets.data[i];
-			targets[i].node = (ufbx_node*)ufbxi_translate_element(ec, targets[i].node);
+		bool redundant = i - anchor < UFBXI_BAKE_MAX_REDUCE_SPAN;
+		for (size_t j = anchor + 1; j <= i && redundant; j++) {
+			ufbx_real t = (ufbx_real)((times[j] - ta) / (tb - ta));
+			ufbx_real ref[4];
+			if (nc == 4) {
+				ufbx_quat qa = { a[0], a[1], a[2], a[3] }, qb = { b[0], b[1], b[2], b[3] };
+				ufbx_quat q = ufbx_quat_slerp(qa, qb, t);
+				ref[0] = q.x; ref[1] = q.y; ref[2] = q.z; ref[3] = q.w;
+			} else {
+				for (size_t c = 0; c < nc; c++) {
+					ref[c] = a[c] + (b[c] - a[c]) * t;
+				}
+			}
+			redundant = ufbxi_bake_keys_close(ref, values + j * nc, nc, tolerance);
+		}
+
+		if (!redundant) {
+			times[num_kept] = times[i];
+			memmove(values + num_kept * nc, values + i * nc, nc * sizeof(ufbx_real));
+			num_kept++;
+			anchor = i;
 		}
-		constraint->targets.data = targets;
 	}
 
-	ufbxi_for_ptr_list(ufbx_anim_stack, p_stack, ec->scene.anim_stacks) {
-		ufbx_anim_stack *stack = *p_stack;
+	times[num_kept] = times[num_keys - 1];
+	memmove(values + num_kept * nc, values + (num_keys - 1) * nc, nc * sizeof(ufbx_real));
+	num_kept++;
 
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &stack->layers));
-		ufbxi_check_err(&ec->error, ufbxi_translate_anim(ec, &stack->anim));
+	// Collapse constant tracks into a single key
+	if (num_kept == 2 && ufbxi_bake_keys_close(values, values + nc, nc, tolerance)) {
+		num_kept = 1;
 	}
 
-	ufbxi_for_ptr_list(ufbx_anim_layer, p_layer, ec->scene.anim_layers) {
-		ufbx_anim_layer *layer = *p_layer;
+	return num_kept;
+}
 
-		ufbxi_check_err(&ec->error, ufbxi_translate_element_list(ec, &layer->anim_values));
-		ufbx_anim_prop *props = ufbxi_push(&ec->result, ufbx_anim_prop, layer->anim_props.count);
-		ufbxi_check_err(&ec->error, props);
-		for (size_t i = 0; i < layer->anim_props.count; i++) {
-			props[i] = layer->anim_props.data[i];
-			props[i].element = ufbxi_translate_element(ec, props[i].element);
-			props[i].anim_value = (ufbx_anim_value*)ufbxi_translate_element(ec, props[i].anim_value);
-		}
-		layer->anim_props.data = props;
-	}
+static ufbxi_noinline void ufbxi_bake_evaluate_job(const ufbxi_bake_tasks *tasks, ufbxi_bake_job *job)
+{
+	const ufbx_anim *anim = tasks->anim;
+	size_t num_times = job->num_times;
 
-	ufbxi_for_ptr_list(ufbx_pose, p_pose, ec->scene.poses) {
-		ufbx_pose *pose = *p_pose;
+	for (size_t i = 0; i < num_times; i++) {
+		double time = job->times[i];
+		if (job->type == UFBXI_BAKE_NODE) {
+			ufbx_transform t = ufbx_evaluate_transform(anim, (const ufbx_node*)job->element, time);
+			ufbx_real *tv = job->tracks[0].values + i * 3;
+			ufbx_real *rv = job->tracks[1].values + i * 4;
+			ufbx_real *sv = job->tracks[2].values + i * 3;
 
-		ufbx_bone_pose *bones = ufbxi_push(&ec->result, ufbx_bone_pose, pose->bone_poses.count);
-		ufbxi_check_err(&ec->error, bones);
-		for (size_t i = 0; i < pose->bone_poses.count; i++) {
-			bones[i] = pose->bone_poses.data[i];
-			bones[i].bone_node = (ufbx_node*)ufbxi_translate_element(ec, bones[i].bone_node);
+			// Keep consecutive rotations in the same hemisphere
+			ufbx_quat q = t.rotation;
+			if (i > 0 && q.x*rv[-4] + q.y*rv[-3] + q.z*rv[-2] + q.w*rv[-1] < 0.0f) {
+				q.x = -q.x; q.y = -q.y; q.z = -q.z; q.w = -q.w;
+			}
+
+			tv[0] = t.translation.x; tv[1] = t.translation.y; tv[2] = t.translation.z;
+			rv[0] = q.x; rv[1] = q.y; rv[2] = q.z; rv[3] = q.w;
+			sv[0] = t.scale.x; sv[1] = t.scale.y; sv[2] = t.scale.z;
+		} else if (job->type == UFBXI_BAKE_BLEND_CHANNEL) {
+			job->tracks[0].values[i] = ufbx_evaluate_blend_weight(anim, (const ufbx_blend_channel*)job->element, time);
+		} else {
+			ufbx_prop prop = ufbx_evaluate_prop_len(anim, job->element, job->prop_name.data, job->prop_name.length, time);
+			ufbx_real *v = job->tracks[0].values + i * 3;
+			v[0] = prop.value_vec3.x; v[1] = prop.value_vec3.y; v[2] = prop.value_vec3.z;
 		}
-		pose->bone_poses.data = bones;
 	}
 
-	ufbxi_check_err(&ec->error, ufbxi_translate_anim(ec, &ec->anim));
+	for (size_t i = 0; i < job->num_tracks; i++) {
+		ufbxi_bake_track *track = &job->tracks[i];
+		memcpy(track->times, job->times, num_times * sizeof(double));
+		track->num_keys = num_times;
+		if (tasks->reduce_keys) {
+			track->num_keys = ufbxi_bake_reduce_keys(track->times, track->values, num_times, track->num_components, tasks->tolerance);
+		}
+	}
+}
 
-	ufbxi_for_ptr_list(ufbx_anim_value, p_value, ec->scene.anim_values) {
-		ufbx_anim_value *value = *p_value;
-		value->curves[0] = (ufbx_anim_curve*)ufbxi_translate_element(ec, value->curves[0]);
-		value->curves[1] = (ufbx_anim_curve*)ufbxi_translate_element(ec, value->curves[1]);
-		value->curves[2] = (ufbx_anim_curve*)ufbxi_translate_element(ec, value->curves[2]);
+static void ufbxi_bake_task(void *user, uint32_t index)
+{
+	ufbxi_bake_tasks *tasks = (ufbxi_bake_tasks*)user;
+	for (size_t i = index; i < tasks->num_jobs; i += tasks->num_tasks) {
+		ufbxi_bake_evaluate_job(tasks, &tasks->jobs[i]);
 	}
+}
 
-	ufbx_anim anim = ec->anim;
-	ufbx_const_prop_override_list overrides_left = ec->anim.prop_overrides;
+// Copy the reduced keys of `track` to the result, returns the values as `num_components` reals per key.
+static ufbxi_noinline ufbx_real *ufbxi_bake_copy_track(ufbxi_bake_context *bc, const ufbxi_bake_track *track, ufbx_double_list *p_times)
+{
+	size_t num_keys = track->num_keys;
+	double *times = ufbxi_push_copy(&bc->result, double, num_keys, track->times);
+	ufbx_real *values = ufbxi_push_copy(&bc->result, ufbx_real, num_keys * track->num_components, track->values);
+	if (!times || !values) return NULL;
 
-	// Evaluate the properties
-	ufbxi_for_ptr_list(ufbx_element, p_elem, ec->scene.elements) {
-		ufbx_element *elem = *p_elem;
-		size_t num_animated = elem->props.num_animated;
+	p_times->data = times;
+	p_times->count = num_keys;
+	bc->bake.num_keys += num_keys;
+	return values;
+}
 
-		// Setup the overrides for this element if found
-		if (overrides_left.count > 0) {
-			if (overrides_left.data[0].element_id <= elem->element_id) {
-				anim.prop_overrides = ufbxi_find_element_prop_overrides(&overrides_left, elem->element_id);
-				overrides_left.data = anim.prop_overrides.data + anim.prop_overrides.count;
-				overrides_left.count = ufbxi_to_size((ec->anim.prop_overrides.data + ec->anim.prop_overrides.count) - overrides_left.data);
-				num_animated += anim.prop_overrides.count;
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_time_range(ufbxi_bake_context *bc)
+{
+	if (bc->anim.time_end > bc->anim.time_begin) {
+		bc->time_begin = bc->anim.time_begin;
+		bc->time_end = bc->anim.time_end;
+		return 1;
+	}
+
+	// No explicit time range, use the range of the keyframes
+	bool found = false;
+	double begin = 0.0, end = 0.0;
+	ufbxi_for_list(const ufbx_anim_layer_desc, desc, bc->anim.layers) {
+		ufbxi_for_list(ufbx_anim_prop, aprop, desc->layer->anim_props) {
+			for (size_t i = 0; i < 3; i++) {
+				ufbx_anim_curve *curve = aprop->anim_value->curves[i];
+				if (!curve || curve->keyframes.count == 0) continue;
+				double first = curve->keyframes.data[0].time;
+				double last = curve->keyframes.data[curve->keyframes.count - 1].time;
+				if (!found || first < begin) begin = first;
+				if (!found || last > end) end = last;
+				found = true;
 			}
 		}
+	}
 
-		if (num_animated == 0) continue;
+	bc->time_begin = begin;
+	bc->time_end = end;
+	return 1;
+}
 
-		ufbx_prop *props = ufbxi_push(&ec->result, ufbx_prop, num_animated);
-		ufbxi_check_err(&ec->error, props);
+ufbxi_nodiscard static ufbxi_noinline int ufbxi_bake_anim_imp(ufbxi_bake_context *bc)
+{
+	// `ufbx_bake_opts` must be cleared to zero first!
+	ufbx_assert(bc->opts._begin_zero == 0 && bc->opts._end_zero == 0);
+	ufbxi_check_err_msg(&bc->error, bc->opts._begin_zero == 0 && bc->opts._end_zero == 0, "Uninitialized options");
+	ufbxi_check_err(&bc->error, !bc->opts.thread_opts.pool.run_fn || bc->opts.thread_opts.pool.wait_fn);
 
-		elem->props = ufbx_evaluate_props(&anim, elem, ec->time, props, num_animated);
-		elem->props.defaults = &ec->src_scene.elements.data[elem->element_id]->props;
+	if (bc->opts.resample_rate <= 0.0) bc->opts.resample_rate = 30.0;
+	if (bc->opts.step_time <= 0.0) bc->opts.step_time = 0.001;
+	if (bc->opts.key_reduction_tolerance <= 0.0f) bc->opts.key_reduction_tolerance = (ufbx_real)0.00001;
+	if (bc->opts.thread_opts.num_tasks == 0) bc->opts.thread_opts.num_tasks = 64;
 
-		anim.prop_overrides.count = 0;
-	}
+	ufbxi_init_ator(&bc->error, &bc->ator_tmp, &bc->opts.temp_allocator, "temp");
+	ufbxi_init_ator(&bc->error, &bc->ator_result, &bc->opts.result_allocator, "result");
 
-	// Update all derived values
-	ufbxi_update_scene(&ec->scene, false);
+	bc->tmp.ator = &bc->ator_tmp;
+	bc->tmp_stack.ator = &bc->ator_tmp;
+	bc->tmp_times.ator = &bc->ator_tmp;
+	bc->result.ator = &bc->ator_result;
 
-	// Evaluate skinning if requested
-	if (ec->opts.evaluate_skinning) {
-		ufbx_geometry_cache_data_opts cache_opts = { 0 };
-		cache_opts.open_file_cb = ec->opts.open_file_cb;
-		ufbxi_check_err(&ec->error, ufbxi_evaluate_skinning(&ec->scene, &ec->error, &ec->result, &ec->tmp,
-			ec->time, ec->opts.load_external_files && ec->opts.evaluate_caches, &cache_opts));
-	}
+	bc->tmp.unordered = true;
+	bc->result.unordered = true;
 
-	// Retain the scene, this must be the final allocation as we copy
-	// `ator_result` to `ufbx_scene_imp`.
-	ufbxi_scene_imp *imp = ufbxi_push_zero(&ec->result, ufbxi_scene_imp, 1);
-	ufbxi_check_err(&ec->error, imp);
+	ufbxi_check_err(&bc->error, ufbxi_bake_time_range(bc));
 
-	ufbx_assert(ec->src_imp->magic == UFBXI_SCENE_IMP_MAGIC);
-	ufbxi_init_ref(&imp->refcount, UFBXI_SCENE_IMP_MAGIC, &ec->src_imp->refcount);
+	double rate = bc->opts.resample_rate;
+	double max_samples = (bc->time_end - bc->time_begin) * rate;
+	ufbxi_check_err_msg(&bc->error, max_samples < (double)UINT32_MAX, "Too many samples");
 
-	imp->magic = UFBXI_SCENE_IMP_MAGIC;
-	imp->scene = ec->scene;
-	imp->ator = ec->ator_result;
-	imp->ator.error = NULL;
+	if (bc->opts.fixed_rate) {
+		// `ceil(max_samples - 0.01)` intervals, a trailing interval shorter than the epsilon
+		// in `ufbxi_bake_push_curve_times()` is merged to the previous one. The last sample
+		// is always at `time_end` even if the duration is not a multiple of the rate.
+		size_t num_intervals = (size_t)max_samples;
+		if ((double)num_intervals < max_samples - 0.01) num_intervals++;
+		size_t num_samples = num_intervals + 1;
+		bc->fixed_times = ufbxi_push(&bc->tmp, double, num_samples);
+		ufbxi_check_err(&bc->error, bc->fixed_times);
+		for (size_t i = 0; i < num_intervals; i++) {
+			double time = bc->time_begin + (double)i / rate;
+			bc->fixed_times[i] = time < bc->time_end ? time : bc->time_end;
+		}
+		bc->fixed_times[num_intervals] = bc->time_end;
+		bc->num_fixed_times = num_samples;
+	}
 
-	// Copy retained buffers and translate the allocator struct to the one
-	// contained within `ufbxi_scene_imp`
-	imp->result_buf = ec->result;
-	imp->result_buf.ator = &imp->ator;
+	const ufbx_scene *scene = bc->scene;
+	const ufbx_string no_name = { ufbxi_empty_char, 0 };
 
-	imp->scene.metadata.result_memory_used = imp->ator.current_size;
-	imp->scene.metadata.temp_memory_used = ec->ator_tmp.current_size;
-	imp->scene.metadata.result_allocs = imp->ator.num_allocs;
-	imp->scene.metadata.temp_allocs = ec->ator_tmp.num_allocs;
+	size_t num_nodes = 0, num_blend_channels = 0, num_props = 0;
 
-	ufbxi_for_ptr_list(ufbx_element, p_elem, imp->scene.elements) {
-		(*p_elem)->scene = &imp->scene;
+	ufbxi_for_ptr_list(ufbx_node, p_node, scene->nodes) {
+		ufbx_node *node = *p_node;
+		if (node->is_root) continue;
+		bool animated = false;
+		for (size_t i = 0; i < ufbxi_arraycount(ufbxi_transform_props) && !animated; i++) {
+			animated = ufbxi_bake_is_animated(bc, &node->element, ufbxi_transform_props[i]);
+		}
+		if (!animated) continue;
+		ufbxi_check_err(&bc->error, ufbxi_bake_push_job(bc, UFBXI_BAKE_NODE, &node->element, no_name));
+		num_nodes++;
 	}
 
-	ec->scene_imp = imp;
-	ec->result.ator = &ec->ator_result;
+	ufbxi_for_ptr_list(ufbx_blend_channel, p_chan, scene->blend_channels) {
+		ufbx_blend_channel *chan = *p_chan;
+		if (!ufbxi_bake_is_animated(bc, &chan->element, ufbxi_DeformPercent)) continue;
+		ufbxi_check_err(&bc->error, ufbxi_bake_push_job(bc, UFBXI_BAKE_BLEND_CHANNEL, &chan->element, no_name));
+		num_blend_channels++;
+	}
 
-	return 1;
-}
+	ufbxi_for_ptr_list(ufbx_element, p_elem, scene->elements) {
+		ufbx_element *elem = *p_elem;
+		ufbxi_for_list(ufbx_prop, prop, elem->props.props) {
+			if ((prop->flags & (UFBX_PROP_FLAG_ANIMATED|UFBX_PROP_FLAG_CONNECTED)) == 0) continue;
+			if (elem->type == UFBX_ELEMENT_NODE && ufbxi_bake_is_transform_prop(prop->name.data)) continue;
+			if (elem->type == UFBX_ELEMENT_BLEND_CHANNEL && !strcmp(prop->name.data, ufbxi_DeformPercent)) continue;
+			if (!ufbxi_bake_is_animated(bc, elem, prop->name.data)) continue;
+			ufbxi_check_err(&bc->error, ufbxi_bake_push_job(bc, UFBXI_BAKE_PROP, elem, prop->name));
+			num_props++;
+		}
+	}
 
-ufbxi_nodiscard static ufbxi_noinline ufbx_scene *ufbxi_evaluate_scene(ufbxi_eval_context *ec, ufbx_scene *scene, const ufbx_anim *anim, double time, const ufbx_evaluate_opts *user_opts, ufbx_error *p_error)
-{
-	if (user_opts) {
-		ec->opts = *user_opts;
+	bc->jobs = ufbxi_push_pop(&bc->tmp, &bc->tmp_stack, ufbxi_bake_job, bc->num_jobs);
+	ufbxi_check_err(&bc->error, bc->jobs);
+
+	// Evaluate and reduce the tracks, this does not allocate so the jobs can run in parallel
+	ufbxi_bake_tasks tasks;
+	tasks.anim = &bc->anim;
+	tasks.jobs = bc->jobs;
+	tasks.num_jobs = bc->num_jobs;
+	tasks.reduce_keys = !bc->opts.no_key_reduction;
+	tasks.tolerance = bc->opts.key_reduction_tolerance;
+
+	ufbx_thread_pool *pool = &bc->opts.thread_opts.pool;
+	if (pool->run_fn && bc->num_jobs > 1 && bc->num_samples >= UFBXI_MIN_THREADED_BAKE_SAMPLES) {
+		tasks.num_tasks = (uint32_t)ufbxi_min_sz(bc->num_jobs, bc->opts.thread_opts.num_tasks);
+		pool->run_fn(pool->user, &ufbxi_bake_task, &tasks, tasks.num_tasks);
+		pool->wait_fn(pool->user);
 	} else {
-		memset(&ec->opts, 0, sizeof(ec->opts));
+		tasks.num_tasks = 1;
+		ufbxi_bake_task(&tasks, 0);
+	}
+
+	ufbx_baked_anim *bake = &bc->bake;
+	bake->time_begin = bc->time_begin;
+	bake->time_end = bc->time_end;
+
+	bake->nodes.data = ufbxi_push_zero(&bc->result, ufbx_baked_node, num_nodes);
+	bake->blend_channels.data = ufbxi_push_zero(&bc->result, ufbx_baked_blend_channel, num_blend_channels);
+	bake->props.data = ufbxi_push_zero(&bc->result, ufbx_baked_prop, num_props);
+	ufbxi_check_err(&bc->error, bake->nodes.data && bake->blend_channels.data && bake->props.data);
+
+	ufbxi_for(ufbxi_bake_job, job, bc->jobs, bc->num_jobs) {
+		if (job->type == UFBXI_BAKE_NODE) {
+			ufbx_baked_node *dst = &bake->nodes.data[bake->nodes.count++];
+			dst->typed_id = job->element->typed_id;
+			dst->element_id = job->element->element_id;
+			ufbx_real *translation = ufbxi_bake_copy_track(bc, &job->tracks[0], &dst->translation.times);
+			ufbx_real *rotation = ufbxi_bake_copy_track(bc, &job->tracks[1], &dst->rotation.times);
+			ufbx_real *scale = ufbxi_bake_copy_track(bc, &job->tracks[2], &dst->scale.times);
+			ufbxi_check_err(&bc->error, translation && rotation && scale);
+			dst->translation.values.data = (ufbx_vec3*)translation;
+			dst->translation.values.count = dst->translation.times.count;
+			dst->rotation.values.data = (ufbx_quat*)rotation;
+			dst->rotation.values.count = dst->rotation.times.count;
+			dst->scale.values.data = (ufbx_vec3*)scale;
+			dst->scale.values.count = dst->scale.times.count;
+		} else if (job->type == UFBXI_BAKE_BLEND_CHANNEL) {
+			ufbx_baked_blend_channel *dst = &bake->blend_channels.data[bake->blend_channels.count++];
+			dst->typed_id = job->element->typed_id;
+			dst->element_id = job->element->element_id;
+			ufbx_real *weight = ufbxi_bake_copy_track(bc, &job->tracks[0], &dst->weight.times);
+			ufbxi_check_err(&bc->error, weight);
+			dst->weight.values.data = weight;
+			dst->weight.values.count = dst->weight.times.count;
+		} else {
+			ufbx_baked_prop *dst = &bake->props.data[bake->props.count++];
+			dst->element_id = job->element->element_id;
+			dst->name = job->prop_name;
+			ufbx_real *value = ufbxi_bake_copy_track(bc, &job->tracks[0], &dst->value.times);
+			ufbxi_check_err(&bc->error, value);
+			dst->value.values.data = (ufbx_vec3*)value;
+			dst->value.values.count = dst->value.times.count;
+		}
 	}
 
-	ec->src_imp = ufbxi_get_imp(ufbxi_scene_imp, scene);
-	ec->src_scene = *scene;
-	ec->anim = anim ? *anim : scene->anim;
-	ec->time = time;
-
-	ufbxi_init_ator(&ec->error, &ec->ator_tmp, &ec->opts.temp_allocator, "temp");
-	ufbxi_init_ator(&ec->error, &ec->ator_result, &ec->opts.result_allocator, "result");
+	bc->imp = ufbxi_push(&bc->result, ufbxi_baked_anim_imp, 1);
+	ufbxi_check_err(&bc->error, bc->imp);
 
-	ec->result.ator = &ec->ator_result;
-	ec->tmp.ator = &ec->ator_tmp;
+	ufbxi_init_ref(&bc->imp->refcount, UFBXI_BAKED_ANIM_IMP_MAGIC, &(ufbxi_get_imp(ufbxi_scene_imp, scene))->refcount);
 
-	ec->result.unordered = true;
-	ec->tmp.unordered = true;
+	bc->imp->magic = UFBXI_BAKED_ANIM_IMP_MAGIC;
+	bc->imp->bake = bc->bake;
+	bc->imp->ator = bc->ator_result;
+	bc->imp->result_buf = bc->result;
 
-	if (ufbxi_evaluate_imp(ec)) {
-		ufbxi_buf_free(&ec->tmp);
-		ufbxi_free_ator(&ec->ator_tmp);
-		if (p_error) {
-			ufbxi_clear_error(p_error);
-		}
-		return &ec->scene_imp->scene;
-	} else {
-		ufbxi_fix_error_type(&ec->error, "Failed to evaluate");
-		if (p_error) *p_error = ec->error;
-		ufbxi_buf_free(&ec->tmp);
-		ufbxi_buf_free(&ec->result);
-		ufbxi_free_ator(&ec->ator_tmp);
-		ufbxi_free_ator(&ec->ator_result);
-		return NULL;
-	}
+	return 1;
 }
 
 #endif
@@ -24934,7 +30923,7 @@ static ufbxi_noinline size_t ufbxi_generate_indices(const ufbx_vertex_stream *us
 				streams[si].ptr = ptr + size;
 			}
 
-			uint32_t hash = ufbxi_hash_string(packed_vertex, packed_size);
+			uint32_t hash = ufbxi_hash_string(packed_vertex, packed_size, map.seed);
 			void *entry = ufbxi_map_find_size(&map, packed_size, hash, packed_vertex);
 			if (!entry) {
 				entry = ufbxi_map_insert_size(&map, packed_size, hash, packed_vertex);
@@ -25008,16 +30997,102 @@ static ufbxi_noinline void ufbxi_free_scene_imp(ufbxi_scene_imp *imp)
 	// the stack since the `ufbxi_scene_imp` that contains it is allocated
 	// from the same result buffer!
 	ufbxi_allocator ator = imp->ator;
-	ufbxi_buf result = imp->result_buf;
-	result.ator = &ator;
-	ufbxi_buf_free(&result);
+	ufbxi_buf result = imp->result_buf;
+	void *mapped_data = imp->mapped_data;
+	size_t mapped_size = imp->mapped_size;
+	void *snapshot_data = imp->snapshot_data;
+	size_t snapshot_size = imp->snapshot_size;
+	result.ator = &ator;
+	ufbxi_buf_free(&result);
+	ufbxi_free(&ator, char, snapshot_data, snapshot_size);
+	ufbxi_free_ator(&ator);
+
+	if (mapped_data) {
+		ufbxi_unmap_file(mapped_data, mapped_size);
+	}
+}
+
+static ufbxi_noinline void ufbxi_free_mesh_imp(ufbxi_mesh_imp *imp)
+{
+	ufbx_assert(imp->magic == UFBXI_MESH_IMP_MAGIC);
+	if (imp->magic != UFBXI_MESH_IMP_MAGIC) return;
+	imp->magic = 0;
+
+	// See `ufbxi_free_scene()` for more information
+	ufbxi_allocator ator = imp->ator;
+	ufbxi_buf result = imp->result_buf;
+	result.ator = &ator;
+	ufbxi_buf_free(&result);
+	ufbxi_free_ator(&ator);
+}
+
+static ufbxi_noinline void ufbxi_free_probe_imp(ufbxi_probe_imp *imp)
+{
+	ufbx_assert(imp->magic == UFBXI_PROBE_IMP_MAGIC);
+	if (imp->magic != UFBXI_PROBE_IMP_MAGIC) return;
+	imp->magic = 0;
+
+	ufbxi_buf_free(&imp->string_buf);
+
+	// See `ufbxi_free_scene()` for more information
+	ufbxi_allocator ator = imp->ator;
+	ufbxi_buf result = imp->result_buf;
+	result.ator = &ator;
+	ufbxi_buf_free(&result);
+	ufbxi_free_ator(&ator);
+}
+
+#if UFBXI_FEATURE_SNAPSHOT
+static ufbxi_noinline void ufbxi_free_snapshot_imp(ufbxi_snapshot_imp *imp)
+{
+	ufbx_assert(imp->magic == UFBXI_SNAPSHOT_IMP_MAGIC);
+	if (imp->magic != UFBXI_SNAPSHOT_IMP_MAGIC) return;
+	imp->magic = 0;
+
+	ufbxi_allocator ator = imp->ator;
+	ufbxi_free(&ator, char, imp->data, imp->data_size);
+	ufbxi_free(&ator, ufbxi_snapshot_imp, imp, 1);
+	ufbxi_free_ator(&ator);
+}
+
+static ufbxi_noinline void ufbxi_free_string_table_imp(ufbxi_string_table_imp *imp)
+{
+	ufbx_assert(imp->magic == UFBXI_STRING_TABLE_IMP_MAGIC);
+	if (imp->magic != UFBXI_STRING_TABLE_IMP_MAGIC) return;
+	imp->magic = 0;
+
+	// See `ufbxi_free_scene()` for more information
+	ufbxi_allocator ator = imp->ator;
+	ufbxi_buf buf = imp->buf;
+	buf.ator = &ator;
+	ufbxi_buf_free(&buf);
+	ufbxi_free(&ator, ufbxi_string_table_imp, imp, 1);
+	ufbxi_free_ator(&ator);
+}
+#endif
+
+static ufbxi_noinline void ufbxi_free_batch_imp(ufbxi_batch_imp *imp)
+{
+	ufbx_assert(imp->magic == UFBXI_BATCH_IMP_MAGIC);
+	if (imp->magic != UFBXI_BATCH_IMP_MAGIC) return;
+	imp->magic = 0;
+
+	size_t num_files = imp->result.num_files;
+	for (size_t i = 0; i < num_files; i++) {
+		ufbx_free_scene(imp->result.scenes[i]);
+	}
+
+	ufbxi_allocator ator = imp->ator;
+	ufbxi_free(&ator, ufbx_scene*, imp->result.scenes, num_files);
+	ufbxi_free(&ator, ufbx_error, imp->result.errors, num_files);
+	ufbxi_free(&ator, ufbxi_batch_imp, imp, 1);
 	ufbxi_free_ator(&ator);
 }
 
-static ufbxi_noinline void ufbxi_free_mesh_imp(ufbxi_mesh_imp *imp)
+static ufbxi_noinline void ufbxi_free_line_curve_imp(ufbxi_line_curve_imp *imp)
 {
-	ufbx_assert(imp->magic == UFBXI_MESH_IMP_MAGIC);
-	if (imp->magic != UFBXI_MESH_IMP_MAGIC) return;
+	ufbx_assert(imp->magic == UFBXI_LINE_CURVE_IMP_MAGIC);
+	if (imp->magic != UFBXI_LINE_CURVE_IMP_MAGIC) return;
 	imp->magic = 0;
 
 	// See `ufbxi_free_scene()` for more information
@@ -25028,10 +31103,10 @@ static ufbxi_noinline void ufbxi_free_mesh_imp(ufbxi_mesh_imp *imp)
 	ufbxi_free_ator(&ator);
 }
 
-static ufbxi_noinline void ufbxi_free_line_curve_imp(ufbxi_line_curve_imp *imp)
+static ufbxi_noinline void ufbxi_free_baked_anim_imp(ufbxi_baked_anim_imp *imp)
 {
-	ufbx_assert(imp->magic == UFBXI_LINE_CURVE_IMP_MAGIC);
-	if (imp->magic != UFBXI_LINE_CURVE_IMP_MAGIC) return;
+	ufbx_assert(imp->magic == UFBXI_BAKED_ANIM_IMP_MAGIC);
+	if (imp->magic != UFBXI_BAKED_ANIM_IMP_MAGIC) return;
 	imp->magic = 0;
 
 	// See `ufbxi_free_scene()` for more information
@@ -25078,7 +31153,14 @@ static ufbxi_noinline void ufbxi_release_ref(ufbxi_refcount *refcount)
 		case UFBXI_SCENE_IMP_MAGIC: ufbxi_free_scene_imp((ufbxi_scene_imp*)refcount); break;
 		case UFBXI_MESH_IMP_MAGIC: ufbxi_free_mesh_imp((ufbxi_mesh_imp*)refcount); break;
 		case UFBXI_LINE_CURVE_IMP_MAGIC: ufbxi_free_line_curve_imp((ufbxi_line_curve_imp*)refcount); break;
+		case UFBXI_BAKED_ANIM_IMP_MAGIC: ufbxi_free_baked_anim_imp((ufbxi_baked_anim_imp*)refcount); break;
 		case UFBXI_CACHE_IMP_MAGIC: ufbxi_free_geometry_cache_imp((ufbxi_geometry_cache_imp*)refcount); break;
+		case UFBXI_PROBE_IMP_MAGIC: ufbxi_free_probe_imp((ufbxi_probe_imp*)refcount); break;
+#if UFBXI_FEATURE_SNAPSHOT
+		case UFBXI_SNAPSHOT_IMP_MAGIC: ufbxi_free_snapshot_imp((ufbxi_snapshot_imp*)refcount); break;
+		case UFBXI_STRING_TABLE_IMP_MAGIC: ufbxi_free_string_table_imp((ufbxi_string_table_imp*)refcount); break;
+#endif
+		case UFBXI_BATCH_IMP_MAGIC: ufbxi_free_batch_imp((ufbxi_batch_imp*)refcount); break;
 		default: ufbx_assert(0 && "Bad refcount type_magic"); break;
 		}
 
@@ -25226,34 +31308,430 @@ ufbx_abi bool ufbx_open_memory(ufbx_stream *stream, const void *data, size_t dat
 	mem->ator = ator;
 	mem->ator.error = &mem->error;
 
-	stream->read_fn = ufbxi_memory_read;
-	stream->skip_fn = ufbxi_memory_skip;
-	stream->close_fn = ufbxi_memory_close;
-	stream->user = mem;
+	stream->read_fn = ufbxi_memory_read;
+	stream->skip_fn = ufbxi_memory_skip;
+	stream->close_fn = ufbxi_memory_close;
+	stream->user = mem;
+
+	return true;
+}
+
+ufbx_abi bool ufbx_is_thread_safe(void)
+{
+	return UFBXI_THREAD_SAFE != 0;
+}
+
+ufbx_abi ufbx_scene *ufbx_load_memory(const void *data, size_t size, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbxi_context uc = { UFBX_ERROR_NONE };
+	uc.data_begin = uc.data = (const char *)data;
+	uc.data_size = size;
+	uc.progress_bytes_total = size;
+	return ufbxi_load(&uc, opts, error);
+}
+
+ufbx_abi ufbx_scene *ufbx_load_file(const char *filename, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	return ufbx_load_file_len(filename, SIZE_MAX, opts, error);
+}
+
+ufbx_abi ufbx_scene *ufbx_load_file_len(const char *filename, size_t filename_len, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbx_load_opts opts_copy;
+	if (opts) {
+		opts_copy = *opts;
+	} else {
+		memset(&opts_copy, 0, sizeof(opts_copy));
+		opts = &opts_copy;
+	}
+	if (opts_copy.filename.length == 0 || opts_copy.filename.data == NULL) {
+		opts_copy.filename.data = filename;
+		opts_copy.filename.length = filename_len;
+	}
+
+	// Defer to `ufbx_load_stream()` if the user so prefers.
+	if (!opts->open_main_file_with_default && opts->open_file_cb.fn) {
+		ufbx_stream stream = { 0 };
+		if (ufbxi_open_file(&opts->open_file_cb, &stream, filename, filename_len, NULL, NULL, UFBX_OPEN_FILE_MAIN_MODEL)) {
+			return ufbx_load_stream_prefix(&stream, NULL, 0, &opts_copy, error);
+		} else {
+			ufbxi_file_not_found_error(error, filename, filename_len, ufbxi_function, ufbxi_line);
+			return NULL;
+		}
+	}
+
+	ufbxi_allocator tmp_ator = { 0 };
+	ufbx_error tmp_error = { UFBX_ERROR_NONE };
+	ufbxi_init_ator(&tmp_error, &tmp_ator, opts ? &opts->temp_allocator : NULL, "filename");
+
+	// Load directly from a file mapping if possible, the scene takes ownership of the mapping.
+	if (opts->memory_map_file) {
+		size_t mapped_size = 0;
+		void *mapped_data = ufbxi_map_file(filename, filename_len, &mapped_size, &tmp_ator);
+		if (mapped_data) {
+			ufbxi_context uc = { UFBX_ERROR_NONE };
+			uc.data_begin = uc.data = (const char *)mapped_data;
+			uc.data_size = mapped_size;
+			uc.progress_bytes_total = mapped_size;
+			uc.mapped_data = mapped_data;
+			uc.mapped_size = mapped_size;
+			return ufbxi_load(&uc, &opts_copy, error);
+		}
+	}
+
+	FILE *file = ufbxi_fopen(filename, filename_len, &tmp_ator);
+	if (!file) {
+		ufbxi_file_not_found_error(error, filename, filename_len, ufbxi_function, ufbxi_line);
+		return NULL;
+	}
+
+	ufbx_scene *scene = ufbx_load_stdio(file, &opts_copy, error);
+
+	fclose(file);
+
+	return scene;
+}
+
+ufbx_abi ufbx_scene *ufbx_load_stdio(void *file_void, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	return ufbx_load_stdio_prefix(file_void, NULL, 0, opts, error);
+}
+
+ufbx_abi ufbx_scene *ufbx_load_stdio_prefix(void *file_void, const void *prefix, size_t prefix_size, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	FILE *file = (FILE*)file_void;
+
+	ufbxi_context uc = { UFBX_ERROR_NONE };
+	uc.data_begin = uc.data = (const char *)prefix;
+	uc.data_size = prefix_size;
+	uc.read_fn = &ufbxi_file_read;
+	uc.skip_fn = &ufbxi_file_skip;
+	uc.read_user = file;
+
+	if (opts && opts->progress_cb.fn && opts->file_size_estimate == 0) {
+		uint64_t begin = ufbxi_ftell(file);
+		if (begin < UINT64_MAX) {
+			fpos_t pos;
+			if (fgetpos(file, &pos) == 0) {
+				if (fseek(file, 0, SEEK_END) == 0) {
+					uint64_t end = ufbxi_ftell(file);
+					if (end != UINT64_MAX && begin < end) {
+						uc.progress_bytes_total = end - begin;
+					}
+
+					// Both `rewind()` and `fsetpos()` to reset error and EOF
+					rewind(file);
+					fsetpos(file, &pos);
+				}
+			}
+		}
+	}
+
+	ufbx_scene *scene = ufbxi_load(&uc, opts, error);
+	return scene;
+}
+
+ufbx_abi ufbx_scene *ufbx_load_stream(const ufbx_stream *stream, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	return ufbx_load_stream_prefix(stream, NULL, 0, opts, error);
+}
+
+ufbx_abi ufbx_scene *ufbx_load_stream_prefix(const ufbx_stream *stream, const void *prefix, size_t prefix_size, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbxi_context uc = { UFBX_ERROR_NONE };
+	uc.data_begin = uc.data = (const char *)prefix;
+	uc.data_size = prefix_size;
+	uc.read_fn = stream->read_fn;
+	uc.skip_fn = stream->skip_fn;
+	uc.close_fn = stream->close_fn;
+	uc.read_user = stream->user;
+	ufbx_scene *scene = ufbxi_load(&uc, opts, error);
+	return scene;
+}
+
+ufbx_abi ufbx_load_context *ufbx_create_load_context(const ufbx_load_context_opts *user_opts, ufbx_error *error)
+{
+	ufbx_load_context_opts opts;
+	if (user_opts) {
+		opts = *user_opts;
+	} else {
+		memset(&opts, 0, sizeof(opts));
+	}
+
+	ufbx_error local_error = { UFBX_ERROR_NONE };
+	ufbxi_allocator ator = { 0 };
+	ufbxi_init_ator(&local_error, &ator, &opts.temp_allocator, "load_context");
+
+	ufbx_load_context *lc = NULL;
+	ufbx_assert(opts._begin_zero == 0 && opts._end_zero == 0);
+	if (opts._begin_zero == 0 && opts._end_zero == 0) {
+		lc = ufbxi_alloc(&ator, ufbx_load_context, 1);
+	} else {
+		ufbxi_report_err_msg(&local_error, "opts._begin_zero == 0 && opts._end_zero == 0", "Uninitialized options");
+	}
+
+	if (!lc) {
+		ufbxi_free_ator(&ator);
+		ufbxi_fix_error_type(&local_error, "Failed to create load context");
+		if (error) *error = local_error;
+		return NULL;
+	}
+
+	memset(lc, 0, sizeof(ufbx_load_context));
+	lc->magic = UFBXI_LOAD_CONTEXT_IMP_MAGIC;
+	ufbxi_atomic_counter_init(&lc->num_borrows);
+
+	// Transplant the allocator in the context
+	lc->ator = ator;
+	lc->ator.error = &lc->error;
+	ufbxi_load_context_set_ator(lc, &lc->ator);
+
+	if (error) {
+		ufbxi_clear_error(error);
+	}
+	return lc;
+}
+
+ufbx_abi void ufbx_free_load_context(ufbx_load_context *context)
+{
+	if (!context) return;
+	ufbx_assert(context->magic == UFBXI_LOAD_CONTEXT_IMP_MAGIC);
+	if (context->magic != UFBXI_LOAD_CONTEXT_IMP_MAGIC) return;
+	ufbxi_free_load_context(context);
+}
+
+ufbx_abi ufbx_batch_result *ufbx_load_files_batch(const char *const *filenames, size_t num_files, const ufbx_load_opts *load_opts, const ufbx_batch_load_opts *opts, ufbx_error *error)
+{
+	ufbxi_batch_context bc = { UFBX_ERROR_NONE };
+	bc.filenames = filenames;
+	bc.num_files = num_files;
+	return ufbxi_load_batch(&bc, load_opts, opts, error);
+}
+
+ufbx_abi void ufbx_free_batch_result(ufbx_batch_result *result)
+{
+	if (!result) return;
+
+	ufbxi_batch_imp *imp = ufbxi_get_imp(ufbxi_batch_imp, result);
+	ufbx_assert(imp->magic == UFBXI_BATCH_IMP_MAGIC);
+	if (imp->magic != UFBXI_BATCH_IMP_MAGIC) return;
+	ufbxi_release_ref(&imp->refcount);
+}
+
+struct ufbx_loader {
+	uint32_t magic;
+	bool failed;
+
+	ufbxi_context uc;
+	ufbx_inflate_retain inflate_retain;
+
+	// Own allocation information
+	size_t self_size;
+	ufbxi_allocator ator;
+	ufbx_error error;
+	char filename_copy[];
+};
+
+static ufbxi_noinline ufbx_loader *ufbxi_alloc_loader(const ufbx_load_opts *opts, size_t filename_len, ufbx_error *error)
+{
+	ufbx_error local_error = { UFBX_ERROR_NONE };
+	if (!error) error = &local_error;
+	ufbxi_clear_error(error);
+
+	ufbxi_allocator ator = { 0 };
+	ufbxi_init_ator(error, &ator, opts ? &opts->temp_allocator : NULL, "loader");
+
+	size_t self_size = sizeof(ufbx_loader) + filename_len + 1;
+	void *memory = ufbxi_alloc(&ator, char, self_size);
+	if (!memory) {
+		ufbxi_free_ator(&ator);
+		ufbxi_fix_error_type(error, "Failed to begin loading");
+		return NULL;
+	}
+
+	ufbx_loader *loader = (ufbx_loader*)memory;
+	memset(loader, 0, sizeof(ufbx_loader));
+	loader->magic = UFBXI_LOADER_IMP_MAGIC;
+	loader->self_size = self_size;
+
+	// Transplant the allocator in the result blob
+	loader->ator = ator;
+	loader->ator.error = &loader->error;
+
+	return loader;
+}
+
+static ufbxi_noinline void ufbxi_free_loader(ufbx_loader *loader)
+{
+	loader->magic = 0;
+
+	ufbxi_allocator ator = loader->ator;
+	ufbxi_free(&ator, char, loader, loader->self_size);
+	ufbxi_free_ator(&ator);
+}
+
+ufbx_abi ufbx_loader *ufbx_load_begin_memory(const void *data, size_t data_size, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbx_loader *loader = ufbxi_alloc_loader(opts, 0, error);
+	if (!loader) return NULL;
+
+	ufbxi_context *uc = &loader->uc;
+	uc->data_begin = uc->data = (const char *)data;
+	uc->data_size = data_size;
+	uc->progress_bytes_total = data_size;
+	ufbxi_load_init(uc, opts, &loader->inflate_retain);
+	return loader;
+}
+
+ufbx_abi ufbx_loader *ufbx_load_begin_file(const char *filename, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	return ufbx_load_begin_file_len(filename, SIZE_MAX, opts, error);
+}
+
+ufbx_abi ufbx_loader *ufbx_load_begin_file_len(const char *filename, size_t filename_len, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbx_load_opts opts_copy;
+	if (opts) {
+		opts_copy = *opts;
+	} else {
+		memset(&opts_copy, 0, sizeof(opts_copy));
+	}
+	if (filename_len == SIZE_MAX) {
+		filename_len = strlen(filename);
+	}
+
+	ufbx_loader *loader = ufbxi_alloc_loader(&opts_copy, filename_len, error);
+	if (!loader) return NULL;
+
+	// Copy the filename as it's needed for resolving paths later during loading.
+	memcpy(loader->filename_copy, filename, filename_len);
+	loader->filename_copy[filename_len] = '\0';
+	filename = loader->filename_copy;
+
+	if (opts_copy.filename.length == 0 || opts_copy.filename.data == NULL) {
+		opts_copy.filename.data = filename;
+		opts_copy.filename.length = filename_len;
+	}
+
+	ufbxi_context *uc = &loader->uc;
+
+	if (opts_copy.memory_map_file) {
+		ufbxi_allocator tmp_ator = { 0 };
+		ufbx_error tmp_error = { UFBX_ERROR_NONE };
+		ufbxi_init_ator(&tmp_error, &tmp_ator, &opts_copy.temp_allocator, "filename");
+
+		size_t mapped_size = 0;
+		void *mapped_data = ufbxi_map_file(filename, filename_len, &mapped_size, &tmp_ator);
+		if (mapped_data) {
+			uc->data_begin = uc->data = (const char *)mapped_data;
+			uc->data_size = mapped_size;
+			uc->progress_bytes_total = mapped_size;
+			uc->mapped_data = mapped_data;
+			uc->mapped_size = mapped_size;
+			ufbxi_load_init(uc, &opts_copy, &loader->inflate_retain);
+			return loader;
+		}
+	}
+
+	// Open the file as a stream using the default callback if necessary.
+	ufbx_open_file_cb open_file_cb = opts_copy.open_file_cb;
+	if (opts_copy.open_main_file_with_default || !open_file_cb.fn) {
+		open_file_cb.fn = &ufbx_default_open_file;
+		open_file_cb.user = NULL;
+	}
+
+	ufbx_stream stream = { 0 };
+	if (!ufbxi_open_file(&open_file_cb, &stream, filename, filename_len, NULL, NULL, UFBX_OPEN_FILE_MAIN_MODEL)) {
+		ufbxi_free_loader(loader);
+		ufbxi_file_not_found_error(error, filename, filename_len, ufbxi_function, ufbxi_line);
+		return NULL;
+	}
+
+	uc->read_fn = stream.read_fn;
+	uc->skip_fn = stream.skip_fn;
+	uc->close_fn = stream.close_fn;
+	uc->read_user = stream.user;
+	ufbxi_load_init(uc, &opts_copy, &loader->inflate_retain);
+	return loader;
+}
+
+ufbx_abi ufbx_loader *ufbx_load_begin_stream(const ufbx_stream *stream, const ufbx_load_opts *opts, ufbx_error *error)
+{
+	ufbx_loader *loader = ufbxi_alloc_loader(opts, 0, error);
+	if (!loader) {
+		if (stream->close_fn) {
+			stream->close_fn(stream->user);
+		}
+		return NULL;
+	}
+
+	ufbxi_context *uc = &loader->uc;
+	uc->read_fn = stream->read_fn;
+	uc->skip_fn = stream->skip_fn;
+	uc->close_fn = stream->close_fn;
+	uc->read_user = stream->user;
+	ufbxi_load_init(uc, opts, &loader->inflate_retain);
+	return loader;
+}
+
+ufbx_abi bool ufbx_load_step(ufbx_loader *loader, size_t budget, ufbx_load_status *status)
+{
+	ufbx_assert(loader && loader->magic == UFBXI_LOADER_IMP_MAGIC);
+	ufbxi_context *uc = &loader->uc;
+
+	if (!loader->failed && uc->load_phase != UFBX_LOAD_PHASE_DONE) {
+		if (!ufbxi_load_step(uc, (uint64_t)budget)) {
+			loader->failed = true;
+		}
+	}
+
+	if (status) {
+		uint64_t bytes_read = ufbxi_get_read_offset(uc);
+		status->phase = uc->load_phase;
+		status->failed = loader->failed;
+		status->progress.bytes_read = bytes_read;
+		status->progress.bytes_total = ufbxi_max64(uc->progress_bytes_total, bytes_read);
+	}
 
-	return true;
+	return !loader->failed && uc->load_phase != UFBX_LOAD_PHASE_DONE;
 }
 
-ufbx_abi bool ufbx_is_thread_safe(void)
+static ufbxi_noinline int ufbxi_cancel_load(ufbxi_context *uc)
 {
-	return UFBXI_THREAD_SAFE != 0;
+	ufbxi_fail_msg("Load not finished", "Cancelled");
 }
 
-ufbx_abi ufbx_scene *ufbx_load_memory(const void *data, size_t size, const ufbx_load_opts *opts, ufbx_error *error)
+ufbx_abi ufbx_scene *ufbx_load_finish(ufbx_loader *loader, ufbx_error *error)
+{
+	if (!loader) return NULL;
+	ufbx_assert(loader->magic == UFBXI_LOADER_IMP_MAGIC);
+
+	ufbxi_context *uc = &loader->uc;
+	int ok = loader->failed ? 0 : 1;
+	if (ok && uc->load_phase != UFBX_LOAD_PHASE_DONE) {
+		ok = ufbxi_cancel_load(uc);
+	}
+
+	ufbx_scene *scene = ufbxi_load_end(uc, ok, error);
+	ufbxi_free_loader(loader);
+	return scene;
+}
+
+ufbx_abi ufbx_probe *ufbx_probe_memory(const void *data, size_t data_size, const ufbx_load_opts *opts, ufbx_error *error)
 {
 	ufbxi_context uc = { UFBX_ERROR_NONE };
 	uc.data_begin = uc.data = (const char *)data;
-	uc.data_size = size;
-	uc.progress_bytes_total = size;
-	return ufbxi_load(&uc, opts, error);
+	uc.data_size = data_size;
+	uc.progress_bytes_total = data_size;
+	return ufbxi_probe(&uc, opts, error);
 }
 
-ufbx_abi ufbx_scene *ufbx_load_file(const char *filename, const ufbx_load_opts *opts, ufbx_error *error)
+ufbx_abi ufbx_probe *ufbx_probe_file(const char *filename, const ufbx_load_opts *opts, ufbx_error *error)
 {
-	return ufbx_load_file_len(filename, SIZE_MAX, opts, error);
+	return ufbx_probe_file_len(filename, SIZE_MAX, opts, error);
 }
 
-ufbx_abi ufbx_scene *ufbx_load_file_len(const char *filename, size_t filename_len, const ufbx_load_opts *opts, ufbx_error *error)
+ufbx_abi ufbx_probe *ufbx_probe_file_len(const char *filename, size_t filename_len, const ufbx_load_opts *opts, ufbx_error *error)
 {
 	ufbx_load_opts opts_copy;
 	if (opts) {
@@ -25267,110 +31745,142 @@ ufbx_abi ufbx_scene *ufbx_load_file_len(const char *filename, size_t filename_le
 		opts_copy.filename.length = filename_len;
 	}
 
-	// Defer to `ufbx_load_stream()` if the user so prefers.
+	ufbxi_context uc = { UFBX_ERROR_NONE };
+
+	// Use the user stream if preferred, see `ufbx_load_file_len()`.
 	if (!opts->open_main_file_with_default && opts->open_file_cb.fn) {
 		ufbx_stream stream = { 0 };
 		if (ufbxi_open_file(&opts->open_file_cb, &stream, filename, filename_len, NULL, NULL, UFBX_OPEN_FILE_MAIN_MODEL)) {
-			return ufbx_load_stream_prefix(&stream, NULL, 0, &opts_copy, error);
+			uc.read_fn = stream.read_fn;
+			uc.skip_fn = stream.skip_fn;
+			uc.close_fn = stream.close_fn;
+			uc.read_user = stream.user;
+			return ufbxi_probe(&uc, &opts_copy, error);
 		} else {
-			// TODO: Factor this?
-			ufbxi_set_err_info(error, filename, filename_len);
-			error->stack_size = 1;
-			error->type = UFBX_ERROR_FILE_NOT_FOUND;
-			error->description.data = "File not found";
-			error->description.length = strlen(error->description.data);
-			error->stack[0].description.data = "File not found";
-			error->stack[0].description.length = strlen(error->stack[0].description.data);
-			error->stack[0].function.data = ufbxi_function;
-			error->stack[0].function.length = strlen(ufbxi_function);
-			error->stack[0].source_line = ufbxi_line;
+			ufbxi_file_not_found_error(error, filename, filename_len, ufbxi_function, ufbxi_line);
 			return NULL;
 		}
 	}
 
 	ufbxi_allocator tmp_ator = { 0 };
 	ufbx_error tmp_error = { UFBX_ERROR_NONE };
-	ufbxi_init_ator(&tmp_error, &tmp_ator, opts ? &opts->temp_allocator : NULL, "filename");
+	ufbxi_init_ator(&tmp_error, &tmp_ator, &opts->temp_allocator, "filename");
 
 	FILE *file = ufbxi_fopen(filename, filename_len, &tmp_ator);
 	if (!file) {
-		if (error) {
-			ufbxi_set_err_info(error, filename, filename_len);
-			error->stack_size = 1;
-			error->type = UFBX_ERROR_FILE_NOT_FOUND;
-			error->description.data = "File not found";
-			error->description.length = strlen(error->description.data);
-			error->stack[0].description.data = "File not found";
-			error->stack[0].description.length = strlen(error->stack[0].description.data);
-			error->stack[0].function.data = ufbxi_function;
-			error->stack[0].function.length = strlen(ufbxi_function);
-			error->stack[0].source_line = ufbxi_line;
-		}
+		ufbxi_file_not_found_error(error, filename, filename_len, ufbxi_function, ufbxi_line);
 		return NULL;
 	}
 
-	ufbx_scene *scene = ufbx_load_stdio(file, &opts_copy, error);
+	// Objects are skipped with `fseek()` so only the headers are read from disk.
+	uc.read_fn = &ufbxi_file_read;
+	uc.skip_fn = &ufbxi_file_skip;
+	uc.read_user = file;
+	ufbx_probe *probe = ufbxi_probe(&uc, &opts_copy, error);
 
 	fclose(file);
 
-	return scene;
+	return probe;
 }
 
-ufbx_abi ufbx_scene *ufbx_load_stdio(void *file_void, const ufbx_load_opts *opts, ufbx_error *error)
+ufbx_abi void ufbx_free_probe(ufbx_probe *probe)
 {
-	return ufbx_load_stdio_prefix(file_void, NULL, 0, opts, error);
+	if (!probe) return;
+
+	ufbxi_probe_imp *imp = ufbxi_get_imp(ufbxi_probe_imp, probe);
+	ufbx_assert(imp->magic == UFBXI_PROBE_IMP_MAGIC);
+	if (imp->magic != UFBXI_PROBE_IMP_MAGIC) return;
+	ufbxi_release_ref(&imp->refcount);
 }
 
-ufbx_abi ufbx_scene *ufbx_load_stdio_prefix(void *file_void, const void *prefix, size_t prefix_size, const ufbx_load_opts *opts, ufbx_error *error)
+ufbx_abi ufbx_snapshot *ufbx_save_scene_snapshot(const ufbx_scene *scene, const ufbx_snapshot_opts *opts, ufbx_error *error)
 {
-	FILE *file = (FILE*)file_void;
+#if UFBXI_FEATURE_SNAPSHOT
+	ufbxi_snapshot_context sc = { UFBX_ERROR_NONE };
+	return ufbxi_save_snapshot(&sc, scene, opts, error);
+#else
+	ufbxi_ignore(scene);
+	ufbxi_ignore(opts);
+	if (error) {
+		memset(error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(error, "UFBX_ENABLE_SNAPSHOT");
+		ufbxi_report_err_msg(error, "UFBXI_FEATURE_SNAPSHOT", "Feature disabled");
+	}
+	return NULL;
+#endif
+}
 
-	ufbxi_context uc = { UFBX_ERROR_NONE };
-	uc.data_begin = uc.data = (const char *)prefix;
-	uc.data_size = prefix_size;
-	uc.read_fn = &ufbxi_file_read;
-	uc.skip_fn = &ufbxi_file_skip;
-	uc.read_user = file;
+ufbx_abi void ufbx_free_snapshot(ufbx_snapshot *snapshot)
+{
+#if UFBXI_FEATURE_SNAPSHOT
+	if (!snapshot) return;
 
-	if (opts && opts->progress_cb.fn && opts->file_size_estimate == 0) {
-		uint64_t begin = ufbxi_ftell(file);
-		if (begin < UINT64_MAX) {
-			fpos_t pos;
-			if (fgetpos(file, &pos) == 0) {
-				if (fseek(file, 0, SEEK_END) == 0) {
-					uint64_t end = ufbxi_ftell(file);
-					if (end != UINT64_MAX && begin < end) {
-						uc.progress_bytes_total = end - begin;
-					}
+	ufbxi_snapshot_imp *imp = ufbxi_get_imp(ufbxi_snapshot_imp, snapshot);
+	ufbx_assert(imp->magic == UFBXI_SNAPSHOT_IMP_MAGIC);
+	if (imp->magic != UFBXI_SNAPSHOT_IMP_MAGIC) return;
+	ufbxi_release_ref(&imp->refcount);
+#else
+	ufbxi_ignore(snapshot);
+#endif
+}
 
-					// Both `rewind()` and `fsetpos()` to reset error and EOF
-					rewind(file);
-					fsetpos(file, &pos);
-				}
-			}
-		}
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot_memory(const void *data, size_t data_size, const ufbx_snapshot_opts *opts, ufbx_error *error)
+{
+#if UFBXI_FEATURE_SNAPSHOT
+	ufbxi_snapshot_load_context lc = { UFBX_ERROR_NONE };
+	lc.src = (const char*)data;
+	lc.src_size = data_size;
+	return ufbxi_load_snapshot(&lc, opts, error);
+#else
+	ufbxi_ignore(data);
+	ufbxi_ignore(data_size);
+	ufbxi_ignore(opts);
+	if (error) {
+		memset(error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(error, "UFBX_ENABLE_SNAPSHOT");
+		ufbxi_report_err_msg(error, "UFBXI_FEATURE_SNAPSHOT", "Feature disabled");
 	}
-
-	ufbx_scene *scene = ufbxi_load(&uc, opts, error);
-	return scene;
+	return NULL;
+#endif
 }
 
-ufbx_abi ufbx_scene *ufbx_load_stream(const ufbx_stream *stream, const ufbx_load_opts *opts, ufbx_error *error)
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot(const char *filename, const ufbx_snapshot_opts *opts, ufbx_error *error)
 {
-	return ufbx_load_stream_prefix(stream, NULL, 0, opts, error);
+	return ufbx_load_scene_snapshot_len(filename, SIZE_MAX, opts, error);
 }
 
-ufbx_abi ufbx_scene *ufbx_load_stream_prefix(const ufbx_stream *stream, const void *prefix, size_t prefix_size, const ufbx_load_opts *opts, ufbx_error *error)
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot_len(const char *filename, size_t filename_len, const ufbx_snapshot_opts *opts, ufbx_error *error)
 {
-	ufbxi_context uc = { UFBX_ERROR_NONE };
-	uc.data_begin = uc.data = (const char *)prefix;
-	uc.data_size = prefix_size;
-	uc.read_fn = stream->read_fn;
-	uc.skip_fn = stream->skip_fn;
-	uc.close_fn = stream->close_fn;
-	uc.read_user = stream->user;
-	ufbx_scene *scene = ufbxi_load(&uc, opts, error);
+#if UFBXI_FEATURE_SNAPSHOT
+	ufbxi_allocator tmp_ator = { 0 };
+	ufbx_error tmp_error = { UFBX_ERROR_NONE };
+	ufbxi_init_ator(&tmp_error, &tmp_ator, opts ? &opts->temp_allocator : NULL, "filename");
+
+	FILE *file = ufbxi_fopen(filename, filename_len, &tmp_ator);
+	if (!file) {
+		ufbxi_file_not_found_error(error, filename, filename_len, ufbxi_function, ufbxi_line);
+		return NULL;
+	}
+
+	ufbxi_snapshot_load_context lc = { UFBX_ERROR_NONE };
+	lc.read_fn = &ufbxi_file_read;
+	lc.read_user = file;
+	ufbx_scene *scene = ufbxi_load_snapshot(&lc, opts, error);
+
+	fclose(file);
+
 	return scene;
+#else
+	ufbxi_ignore(filename);
+	ufbxi_ignore(filename_len);
+	ufbxi_ignore(opts);
+	if (error) {
+		memset(error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(error, "UFBX_ENABLE_SNAPSHOT");
+		ufbxi_report_err_msg(error, "UFBXI_FEATURE_SNAPSHOT", "Feature disabled");
+	}
+	return NULL;
+#endif
 }
 
 ufbx_abi void ufbx_free_scene(ufbx_scene *scene)
@@ -25622,71 +32132,60 @@ ufbx_abi ufbx_real ufbx_evaluate_curve(const ufbx_anim_curve *curve, double time
 		}
 	}
 
-	size_t begin = 0;
-	size_t end = curve->keyframes.count;
 	const ufbx_keyframe *keys = curve->keyframes.data;
-	while (end - begin >= 8) {
-		size_t mid = (begin + end) >> 1;
-		if (keys[mid].time <= time) {
-			begin = mid + 1;
-		} else {
-			end = mid;
-		}
-	}
+	size_t num_keys = curve->keyframes.count;
 
-	end = curve->keyframes.count;
-	for (; begin < end; begin++) {
-		const ufbx_keyframe *next = &keys[begin];
-		if (next->time <= time) continue;
+	size_t index = ufbxi_find_next_time(&keys[0].time, ufbxi_keyframe_time_stride, 0, num_keys, time);
 
-		// First keyframe
-		if (begin == 0) return next->value;
+	// First and last keyframe
+	if (index == 0) return keys[0].value;
+	if (index == num_keys) return keys[num_keys - 1].value;
 
-		const ufbx_keyframe *prev = next - 1;
+	const ufbx_keyframe *next = &keys[index];
+	const ufbx_keyframe *prev = next - 1;
 
-		// Exact keyframe
-		if (prev->time == time) return prev->value;
+	// Exact keyframe
+	if (prev->time == time) return prev->value;
 
-		double rcp_delta = 1.0 / (next->time - prev->time);
-		double t = (time - prev->time) * rcp_delta;
+	double rcp_delta = 1.0 / (next->time - prev->time);
+	if (curve->segments.count > 0) {
+		return ufbxi_evaluate_curve_segment(&curve->segments.data[index - 1], prev->time, rcp_delta, prev->value, next->value, time);
+	}
+	double t = (time - prev->time) * rcp_delta;
 
-		switch (prev->interpolation) {
+	switch (prev->interpolation) {
 
-		case UFBX_INTERPOLATION_CONSTANT_PREV:
-			return prev->value;
+	case UFBX_INTERPOLATION_CONSTANT_PREV:
+		return prev->value;
 
-		case UFBX_INTERPOLATION_CONSTANT_NEXT:
-			return next->value;
+	case UFBX_INTERPOLATION_CONSTANT_NEXT:
+		return next->value;
 
-		case UFBX_INTERPOLATION_LINEAR:
-			return (ufbx_real)(prev->value*(1.0 - t) + next->value*t);
+	case UFBX_INTERPOLATION_LINEAR:
+		return (ufbx_real)(prev->value*(1.0 - t) + next->value*t);
 
-		case UFBX_INTERPOLATION_CUBIC:
-		{
-			double x1 = prev->right.dx * rcp_delta;
-			double x2 = 1.0 - next->left.dx * rcp_delta;
-			t = ufbxi_find_cubic_bezier_t(x1, x2, t);
+	case UFBX_INTERPOLATION_CUBIC:
+	{
+		double x1 = prev->right.dx * rcp_delta;
+		double x2 = 1.0 - next->left.dx * rcp_delta;
+		t = ufbxi_find_cubic_bezier_t(x1, x2, t);
 
-			double t2 = t*t, t3 = t2*t;
-			double u = 1.0 - t, u2 = u*u, u3 = u2*u;
+		double t2 = t*t, t3 = t2*t;
+		double u = 1.0 - t, u2 = u*u, u3 = u2*u;
 
-			double y0 = prev->value;
-			double y3 = next->value;
-			double y1 = y0 + prev->right.dy;
-			double y2 = y3 - next->left.dy;
+		double y0 = prev->value;
+		double y3 = next->value;
+		double y1 = y0 + prev->right.dy;
+		double y2 = y3 - next->left.dy;
 
-			return (ufbx_real)(u3*y0 + 3.0 * (u2*t*y1 + u*t2*y2) + t3*y3);
-		}
+		return (ufbx_real)(u3*y0 + 3.0 * (u2*t*y1 + u*t2*y2) + t3*y3);
+	}
 
-		default:
-			ufbx_assert(0 && "Bad interpolation mode");
-			return 0.0f;
+	default:
+		ufbx_assert(0 && "Bad interpolation mode");
+		return 0.0f;
 
-		}
 	}
-
-	// Last keyframe
-	return curve->keyframes.data[curve->keyframes.count - 1].value;
 }
 
 ufbx_abi ufbx_real ufbx_evaluate_anim_value_real(const ufbx_anim_value *anim_value, double time)
@@ -25727,6 +32226,110 @@ ufbx_abi ufbxi_noinline ufbx_vec3 ufbx_evaluate_anim_value_vec3(const ufbx_anim_
 	return res;
 }
 
+ufbx_abi void ufbx_init_curve_cursor(ufbx_curve_cursor *cursor, const ufbx_anim_curve *curve)
+{
+	if (!cursor) return;
+	memset(cursor, 0, sizeof(ufbx_curve_cursor));
+	cursor->curve = curve;
+
+	// Empty range to force a seek on the first evaluation
+	cursor->_time_begin = UFBX_INFINITY;
+	cursor->_time_end = -UFBX_INFINITY;
+}
+
+ufbx_abi ufbx_real ufbx_evaluate_curve_cursor(ufbx_curve_cursor *cursor, double time, ufbx_real default_value)
+{
+	if (!cursor || !cursor->curve) return default_value;
+	const ufbx_anim_curve *curve = cursor->curve;
+	if (curve->keyframes.count <= 1) {
+		if (curve->keyframes.count == 1) {
+			return curve->keyframes.data[0].value;
+		} else {
+			return default_value;
+		}
+	}
+
+	if (!(time >= cursor->_time_begin && time < cursor->_time_end)) {
+		ufbxi_curve_cursor_seek(cursor, time);
+	}
+	return ufbxi_evaluate_curve_cursor_at(cursor, time);
+}
+
+ufbx_abi void ufbx_evaluate_curve_batch(const ufbx_anim_curve *curve, const double *times, size_t count, ufbx_real *values, ufbx_real default_value)
+{
+	if (count == 0) return;
+	ufbx_assert(times && values);
+	ufbxi_evaluate_curve_batch(curve, times, count, values, 1, default_value);
+}
+
+ufbx_abi void ufbx_evaluate_anim_value_batch_real(const ufbx_anim_value *anim_value, const double *times, size_t count, ufbx_real *values)
+{
+	if (count == 0) return;
+	ufbx_assert(times && values);
+	ufbxi_evaluate_anim_value_batch(anim_value, times, count, values, 1);
+}
+
+ufbx_abi void ufbx_evaluate_anim_value_batch_vec2(const ufbx_anim_value *anim_value, const double *times, size_t count, ufbx_vec2 *values)
+{
+	if (count == 0) return;
+	ufbx_assert(times && values);
+	ufbxi_evaluate_anim_value_batch(anim_value, times, count, values->v, 2);
+}
+
+ufbx_abi void ufbx_evaluate_anim_value_batch_vec3(const ufbx_anim_value *anim_value, const double *times, size_t count, ufbx_vec3 *values)
+{
+	if (count == 0) return;
+	ufbx_assert(times && values);
+	ufbxi_evaluate_anim_value_batch(anim_value, times, count, values->v, 3);
+}
+
+ufbx_abi void ufbx_init_anim_value_cursor(ufbx_anim_value_cursor *cursor, const ufbx_anim_value *anim_value)
+{
+	if (!cursor) return;
+	cursor->anim_value = anim_value;
+	for (size_t i = 0; i < 3; i++) {
+		ufbx_init_curve_cursor(&cursor->curves[i], anim_value ? anim_value->curves[i] : NULL);
+	}
+}
+
+ufbx_abi ufbx_real ufbx_evaluate_anim_value_cursor_real(ufbx_anim_value_cursor *cursor, double time)
+{
+	if (!cursor || !cursor->anim_value) {
+		return 0.0f;
+	}
+
+	ufbx_real res = cursor->anim_value->default_value.x;
+	if (cursor->curves[0].curve) res = ufbx_evaluate_curve_cursor(&cursor->curves[0], time, res);
+	return res;
+}
+
+ufbx_abi ufbxi_noinline ufbx_vec2 ufbx_evaluate_anim_value_cursor_vec2(ufbx_anim_value_cursor *cursor, double time)
+{
+	if (!cursor || !cursor->anim_value) {
+		ufbx_vec2 zero = { 0.0f };
+		return zero;
+	}
+
+	ufbx_vec2 res = { cursor->anim_value->default_value.x, cursor->anim_value->default_value.y };
+	if (cursor->curves[0].curve) res.x = ufbx_evaluate_curve_cursor(&cursor->curves[0], time, res.x);
+	if (cursor->curves[1].curve) res.y = ufbx_evaluate_curve_cursor(&cursor->curves[1], time, res.y);
+	return res;
+}
+
+ufbx_abi ufbxi_noinline ufbx_vec3 ufbx_evaluate_anim_value_cursor_vec3(ufbx_anim_value_cursor *cursor, double time)
+{
+	if (!cursor || !cursor->anim_value) {
+		ufbx_vec3 zero = { 0.0f };
+		return zero;
+	}
+
+	ufbx_vec3 res = cursor->anim_value->default_value;
+	if (cursor->curves[0].curve) res.x = ufbx_evaluate_curve_cursor(&cursor->curves[0], time, res.x);
+	if (cursor->curves[1].curve) res.y = ufbx_evaluate_curve_cursor(&cursor->curves[1], time, res.y);
+	if (cursor->curves[2].curve) res.z = ufbx_evaluate_curve_cursor(&cursor->curves[2], time, res.z);
+	return res;
+}
+
 ufbx_abi ufbxi_noinline ufbx_prop ufbx_evaluate_prop_len(const ufbx_anim *anim, const ufbx_element *element, const char *name, size_t name_len, double time)
 {
 	ufbx_prop result;
@@ -25843,21 +32446,8 @@ ufbx_abi ufbxi_noinline ufbx_transform ufbx_evaluate_transform(const ufbx_anim *
 	if (!anim) return node->local_transform;
 	if (node->is_root) return node->local_transform;
 
-	const char *prop_names[] = {
-		ufbxi_Lcl_Rotation,
-		ufbxi_Lcl_Scaling,
-		ufbxi_Lcl_Translation,
-		ufbxi_PostRotation,
-		ufbxi_PreRotation,
-		ufbxi_RotationOffset,
-		ufbxi_RotationOrder,
-		ufbxi_RotationPivot,
-		ufbxi_ScalingOffset,
-		ufbxi_ScalingPivot,
-	};
-
-	ufbx_prop buf[ufbxi_arraycount(prop_names)];
-	ufbx_props props = ufbxi_evaluate_selected_props(anim, &node->element, time, buf, prop_names, ufbxi_arraycount(prop_names));
+	ufbx_prop buf[ufbxi_arraycount(ufbxi_transform_props)];
+	ufbx_props props = ufbxi_evaluate_selected_props(anim, &node->element, time, buf, ufbxi_transform_props, ufbxi_arraycount(ufbxi_transform_props));
 	ufbx_rotation_order order = (ufbx_rotation_order)ufbxi_find_enum(&props, ufbxi_RotationOrder, UFBX_ROTATION_ORDER_XYZ, UFBX_ROTATION_ORDER_SPHERIC);
 	return ufbxi_get_transform(&props, order, node);
 }
@@ -25917,6 +32507,145 @@ ufbx_abi ufbx_scene *ufbx_evaluate_scene(const ufbx_scene *scene, const ufbx_ani
 #endif
 }
 
+ufbx_abi ufbxi_noinline void ufbx_evaluate_pose(const ufbx_scene *scene, const ufbx_anim *anim, double time, ufbx_transform *local_out, ufbx_matrix *world_out, const ufbx_evaluate_pose_opts *opts)
+{
+	ufbx_assert(scene);
+	ufbx_assert(local_out);
+	if (!scene || !local_out) return;
+	if (!anim) anim = &scene->anim;
+
+	ufbx_matrix *geometry_out = opts && world_out ? opts->geometry_to_world_out : NULL;
+	ufbx_transform *world_transform_out = opts && world_out ? opts->world_transform_out : NULL;
+
+	// `scene->nodes` is sorted by depth so parents are always evaluated before their children.
+	ufbxi_for_ptr_list(ufbx_node, p_node, scene->nodes) {
+		const ufbx_node *node = *p_node;
+		ufbx_transform *local = &local_out[node->typed_id];
+
+		ufbx_prop buf[ufbxi_arraycount(ufbxi_transform_props)];
+		ufbx_props props = { 0 };
+		if (!node->is_root) {
+			props = ufbxi_evaluate_selected_props(anim, &node->element, time, buf, ufbxi_transform_props, ufbxi_arraycount(ufbxi_transform_props));
+		}
+
+		// Static nodes can use the transforms computed during loading directly.
+		bool animated = props.props.count > 0;
+		if (animated) {
+			ufbx_rotation_order order = (ufbx_rotation_order)ufbxi_find_enum(&props, ufbxi_RotationOrder, UFBX_ROTATION_ORDER_XYZ, UFBX_ROTATION_ORDER_SPHERIC);
+			*local = ufbxi_get_transform(&props, order, node);
+		} else {
+			*local = node->local_transform;
+		}
+
+		if (!world_out) continue;
+
+		ufbx_matrix node_to_parent = animated ? ufbx_transform_to_matrix(local) : node->node_to_parent;
+		ufbx_matrix *node_to_world = &world_out[node->typed_id];
+		const ufbx_node *parent = node->parent;
+		if (!parent) {
+			*node_to_world = node_to_parent;
+			if (world_transform_out) world_transform_out[node->typed_id] = *local;
+		} else if (world_transform_out) {
+			// Carry the world rotation and scale from the parent, see `ufbxi_update_node()`.
+			const ufbx_transform *parent_transform = &world_transform_out[parent->typed_id];
+			ufbx_transform *world_transform = &world_transform_out[node->typed_id];
+			world_transform->rotation = ufbxi_mul_quat(parent_transform->rotation, local->rotation);
+			world_transform->translation = ufbx_transform_position(&world_out[parent->typed_id], local->translation);
+			if (node->inherit_type != UFBX_INHERIT_NO_SCALE) {
+				world_transform->scale.x = parent_transform->scale.x * local->scale.x;
+				world_transform->scale.y = parent_transform->scale.y * local->scale.y;
+				world_transform->scale.z = parent_transform->scale.z * local->scale.z;
+			} else {
+				world_transform->scale = local->scale;
+			}
+
+			if (node->inherit_type == UFBX_INHERIT_NORMAL) {
+				*node_to_world = ufbx_matrix_mul(&world_out[parent->typed_id], &node_to_parent);
+			} else {
+				*node_to_world = ufbx_transform_to_matrix(world_transform);
+			}
+		} else if (node->inherit_type == UFBX_INHERIT_NORMAL) {
+			*node_to_world = ufbx_matrix_mul(&world_out[parent->typed_id], &node_to_parent);
+		} else {
+			ufbx_transform world_transform;
+			ufbxi_pose_world_rotation_scale(node, local_out, &world_transform.rotation, &world_transform.scale);
+			world_transform.translation = ufbx_transform_position(&world_out[parent->typed_id], local->translation);
+			*node_to_world = ufbx_transform_to_matrix(&world_transform);
+		}
+
+		if (geometry_out) {
+			if (node->has_geometry_transform) {
+				geometry_out[node->typed_id] = ufbx_matrix_mul(node_to_world, &node->geometry_to_node);
+			} else {
+				geometry_out[node->typed_id] = *node_to_world;
+			}
+		}
+	}
+}
+
+ufbx_abi ufbx_baked_anim *ufbx_bake_anim(const ufbx_scene *scene, const ufbx_anim *anim, const ufbx_bake_opts *opts, ufbx_error *error)
+{
+#if UFBXI_FEATURE_ANIMATION_BAKING
+	ufbx_assert(scene);
+	if (!scene) return NULL;
+
+	ufbxi_bake_context bc = { UFBX_ERROR_NONE };
+	if (opts) {
+		bc.opts = *opts;
+	}
+
+	bc.scene = scene;
+	bc.anim = anim ? *anim : scene->anim;
+
+	int ok = ufbxi_bake_anim_imp(&bc);
+
+	ufbxi_buf_free(&bc.tmp);
+	ufbxi_buf_free(&bc.tmp_stack);
+	ufbxi_buf_free(&bc.tmp_times);
+	ufbxi_free(&bc.ator_tmp, double, bc.tmp_sort, bc.tmp_sort_cap);
+	ufbxi_free_ator(&bc.ator_tmp);
+
+	if (ok) {
+		ufbxi_clear_error(error);
+		ufbxi_baked_anim_imp *imp = bc.imp;
+		return &imp->bake;
+	} else {
+		ufbxi_fix_error_type(&bc.error, "Failed to bake animation");
+		if (error) *error = bc.error;
+		ufbxi_buf_free(&bc.result);
+		ufbxi_free_ator(&bc.ator_result);
+		return NULL;
+	}
+#else
+	if (error) {
+		memset(error, 0, sizeof(ufbx_error));
+		ufbxi_fmt_err_info(error, "UFBX_ENABLE_ANIMATION_BAKING");
+		ufbxi_report_err_msg(error, "UFBXI_FEATURE_ANIMATION_BAKING", "Feature disabled");
+	}
+	return NULL;
+#endif
+}
+
+ufbx_abi void ufbx_free_baked_anim(ufbx_baked_anim *bake)
+{
+	if (!bake) return;
+
+	ufbxi_baked_anim_imp *imp = ufbxi_get_imp(ufbxi_baked_anim_imp, bake);
+	ufbx_assert(imp->magic == UFBXI_BAKED_ANIM_IMP_MAGIC);
+	if (imp->magic != UFBXI_BAKED_ANIM_IMP_MAGIC) return;
+	ufbxi_release_ref(&imp->refcount);
+}
+
+ufbx_abi void ufbx_retain_baked_anim(ufbx_baked_anim *bake)
+{
+	if (!bake) return;
+
+	ufbxi_baked_anim_imp *imp = ufbxi_get_imp(ufbxi_baked_anim_imp, bake);
+	ufbx_assert(imp->magic == UFBXI_BAKED_ANIM_IMP_MAGIC);
+	if (imp->magic != UFBXI_BAKED_ANIM_IMP_MAGIC) return;
+	ufbxi_retain_ref(&imp->refcount);
+}
+
 ufbx_abi ufbx_texture *ufbx_find_prop_texture_len(const ufbx_material *material, const char *name, size_t name_len)
 {
 	ufbx_string name_str = ufbxi_safe_string(name, name_len);
@@ -27129,10 +33858,17 @@ ufbx_abi ufbx_mesh *ufbx_subdivide_mesh(const ufbx_mesh *mesh, size_t level, con
 	return ufbxi_subdivide_mesh(mesh, level, opts, error);
 }
 
+ufbx_abi ufbx_mesh *ufbx_load_mesh_data(const ufbx_mesh *mesh, const ufbx_load_mesh_opts *opts, ufbx_error *error)
+{
+	if (!mesh) return NULL;
+	if (!mesh->lazy_geometry) return (ufbx_mesh*)mesh;
+	return ufbxi_load_mesh_data(mesh, opts, error);
+}
+
 ufbx_abi void ufbx_free_mesh(ufbx_mesh *mesh)
 {
 	if (!mesh) return;
-	if (!mesh->subdivision_evaluated && !mesh->from_tessellated_nurbs) return;
+	if (!mesh->subdivision_evaluated && !mesh->from_tessellated_nurbs && !mesh->lazy_geometry_loaded) return;
 
 	ufbxi_mesh_imp *imp = ufbxi_get_imp(ufbxi_mesh_imp, mesh);
 	ufbx_assert(imp->magic == UFBXI_MESH_IMP_MAGIC);
@@ -27143,7 +33879,7 @@ ufbx_abi void ufbx_free_mesh(ufbx_mesh *mesh)
 ufbx_abi void ufbx_retain_mesh(ufbx_mesh *mesh)
 {
 	if (!mesh) return;
-	if (!mesh->subdivision_evaluated && !mesh->from_tessellated_nurbs) return;
+	if (!mesh->subdivision_evaluated && !mesh->from_tessellated_nurbs && !mesh->lazy_geometry_loaded) return;
 
 	ufbxi_mesh_imp *imp = ufbxi_get_imp(ufbxi_mesh_imp, mesh);
 	ufbx_assert(imp->magic == UFBXI_MESH_IMP_MAGIC);
@@ -281,8 +281,18 @@ UFBX_LIST_TYPE(ufbx_real_list, ufbx_real);
 UFBX_LIST_TYPE(ufbx_vec2_list, ufbx_vec2);
 UFBX_LIST_TYPE(ufbx_vec3_list, ufbx_vec3);
 UFBX_LIST_TYPE(ufbx_vec4_list, ufbx_vec4);
+UFBX_LIST_TYPE(ufbx_quat_list, ufbx_quat);
+UFBX_LIST_TYPE(ufbx_double_list, double);
 UFBX_LIST_TYPE(ufbx_string_list, ufbx_string);
 
+// Statistics of reading a file through `ufbx_stream`, see `ufbx_read_ahead_opts`.
+typedef struct ufbx_io_stats {
+	uint64_t bytes_read; // < Total number of bytes read from the stream
+	size_t num_reads;    // < Number of calls to `ufbx_stream.read_fn`
+	size_t num_waits;    // < Number of times the parser had to wait for data
+	double wait_time;    // < Total time in seconds the parser spent waiting for data
+} ufbx_io_stats;
+
 // -- Document object model
 
 typedef enum ufbx_dom_value_type UFBX_ENUM_REPR {
@@ -1160,6 +1170,13 @@ struct ufbx_mesh {
 
 	// Tessellation (result)
 	bool from_tessellated_nurbs;
+
+	// Topology and vertex attributes have not been loaded, see `ufbx_load_opts.lazy_geometry`.
+	// Only `vertices` are available, use `ufbx_load_mesh_data()` to load the rest.
+	bool lazy_geometry;
+
+	// Lazy geometry (result)
+	bool lazy_geometry_loaded;
 };
 
 // The kind of light source
@@ -1994,6 +2011,9 @@ typedef struct ufbx_geometry_cache {
 	ufbx_cache_channel_list channels;
 	ufbx_cache_frame_list frames;
 	ufbx_string_list extra_info;
+
+	// Reading the cache headers, frame data is read on demand.
+	ufbx_io_stats io_stats;
 } ufbx_geometry_cache;
 
 struct ufbx_cache_deformer {
@@ -2867,6 +2887,39 @@ typedef struct ufbx_keyframe {
 
 UFBX_LIST_TYPE(ufbx_keyframe_list, ufbx_keyframe);
 
+// How to evaluate a precompiled `ufbx_curve_segment`.
+// `t` is the normalized time `(time - begin) / (end - begin)` between the keyframes
+// of the segment and `y0` is the value of the first keyframe.
+typedef enum ufbx_curve_segment_type UFBX_ENUM_REPR {
+	// `y0 + coeffs[0]*t + coeffs[1]*t^2 + coeffs[2]*t^3`
+	// Used for constant, linear and cubic segments with evenly spaced tangents.
+	UFBX_CURVE_SEGMENT_POLYNOMIAL,
+
+	// Cubic bezier segment with uneven tangent weights: `t` is first remapped by
+	// solving `s` from `bezier_x[0]*s^3 + bezier_x[1]*s^2 + bezier_x[2]*s = t`,
+	// after which `coeffs[]` is evaluated like in `UFBX_CURVE_SEGMENT_POLYNOMIAL`.
+	UFBX_CURVE_SEGMENT_BEZIER,
+
+	// Value of the second keyframe, except `y0` exactly at the beginning of the segment.
+	UFBX_CURVE_SEGMENT_STEP,
+
+	UFBX_ENUM_FORCE_WIDTH(UFBX_CURVE_SEGMENT_TYPE)
+} ufbx_curve_segment_type;
+
+UFBX_ENUM_TYPE(ufbx_curve_segment_type, UFBX_CURVE_SEGMENT_TYPE, UFBX_CURVE_SEGMENT_STEP);
+
+// Span between two keyframes precompiled to a polynomial form.
+// Only stores what is not already in the keyframes, the times and the value `y0`
+// are read from the keyframes at both ends: 40 bytes, or 28 with `UFBX_REAL_IS_FLOAT`.
+// See `ufbx_load_opts.compile_anim_curves` and `ufbx_anim_curve.segments`.
+typedef struct ufbx_curve_segment {
+	ufbx_real coeffs[3]; // < Value polynomial in the normalized time, excluding the constant `y0`
+	float bezier_x[3];   // < Time polynomial for `UFBX_CURVE_SEGMENT_BEZIER`
+	ufbx_curve_segment_type type;
+} ufbx_curve_segment;
+
+UFBX_LIST_TYPE(ufbx_curve_segment_list, ufbx_curve_segment);
+
 struct ufbx_anim_curve {
 	union { ufbx_element element; struct {
 		ufbx_string name;
@@ -2876,8 +2929,108 @@ struct ufbx_anim_curve {
 	}; };
 
 	ufbx_keyframe_list keyframes;
+
+	// Precompiled keyframes, only if `ufbx_load_opts.compile_anim_curves` is set
+	// and the curve has at least two keyframes. `segments.data[i]` spans from
+	// `keyframes.data[i]` to `keyframes.data[i + 1]`.
+	// HINT: These are used automatically by `ufbx_evaluate_curve()` etc.
+	ufbx_curve_segment_list segments;
 };
 
+// Cursor for evaluating an `ufbx_anim_curve` at (mostly) increasing times, eg. during playback.
+// Remembers the current keyframe segment and its cubic coefficients so consecutive
+// evaluations don't need to search the keyframes or set up the segment again.
+// Initialize using `ufbx_init_curve_cursor()`, the rest of the fields are internal.
+typedef struct ufbx_curve_cursor {
+	ufbx_nullable const ufbx_anim_curve *curve;
+
+	// Internal: Cached segment `[_time_begin, _time_end)` ending at keyframe `_index`.
+	// Refers to `_segment` if the curve has been precompiled.
+	size_t _index;
+	const ufbx_curve_segment *_segment;
+	double _time_begin;
+	double _time_end;
+	double _rcp_delta;
+	double _bezier_x[3];
+	double _bezier_y[4];
+	ufbx_interpolation _interpolation;
+} ufbx_curve_cursor;
+
+// Cursors for the curves of an `ufbx_anim_value`, see `ufbx_curve_cursor`.
+typedef struct ufbx_anim_value_cursor {
+	ufbx_nullable const ufbx_anim_value *anim_value;
+	ufbx_curve_cursor curves[3];
+} ufbx_anim_value_cursor;
+
+// -- Baked animation
+
+// Baked keys of a single value stored as structure-of-arrays, `values.data[i]` is
+// the value at `times.data[i]`. Values between keys should be linearly interpolated.
+typedef struct ufbx_baked_vec3_track {
+	ufbx_double_list times;
+	ufbx_vec3_list values;
+} ufbx_baked_vec3_track;
+
+// Baked rotation keys, interpolate the values with `ufbx_quat_slerp()`.
+// Consecutive quaternions are always in the same hemisphere.
+typedef struct ufbx_baked_quat_track {
+	ufbx_double_list times;
+	ufbx_quat_list values;
+} ufbx_baked_quat_track;
+
+typedef struct ufbx_baked_real_track {
+	ufbx_double_list times;
+	ufbx_real_list values;
+} ufbx_baked_real_track;
+
+// Local transform of an animated node, see `ufbx_evaluate_transform()`.
+typedef struct ufbx_baked_node {
+	uint32_t typed_id;   // < Index to `ufbx_scene.nodes`
+	uint32_t element_id; // < Index to `ufbx_scene.elements`
+
+	ufbx_baked_vec3_track translation;
+	ufbx_baked_quat_track rotation;
+	ufbx_baked_vec3_track scale;
+} ufbx_baked_node;
+
+UFBX_LIST_TYPE(ufbx_baked_node_list, ufbx_baked_node);
+
+// Weight of an animated blend channel, see `ufbx_evaluate_blend_weight()`.
+typedef struct ufbx_baked_blend_channel {
+	uint32_t typed_id;   // < Index to `ufbx_scene.blend_channels`
+	uint32_t element_id; // < Index to `ufbx_scene.elements`
+
+	ufbx_baked_real_track weight;
+} ufbx_baked_blend_channel;
+
+UFBX_LIST_TYPE(ufbx_baked_blend_channel_list, ufbx_baked_blend_channel);
+
+// Any other animated property, see `ufbx_evaluate_prop()`.
+// NOTE: Does not contain the properties baked into `ufbx_baked_node`
+// or `ufbx_baked_blend_channel`.
+typedef struct ufbx_baked_prop {
+	uint32_t element_id; // < Index to `ufbx_scene.elements`
+	ufbx_string name;
+
+	ufbx_baked_vec3_track value;
+} ufbx_baked_prop;
+
+UFBX_LIST_TYPE(ufbx_baked_prop_list, ufbx_baked_prop);
+
+// Animation resampled by `ufbx_bake_anim()`.
+typedef struct ufbx_baked_anim {
+	ufbx_baked_node_list nodes;                   // < Sorted by `typed_id`
+	ufbx_baked_blend_channel_list blend_channels; // < Sorted by `typed_id`
+	ufbx_baked_prop_list props;                   // < Sorted by `element_id` and property order
+
+	// Time range of the baked keys.
+	double time_begin;
+	double time_end;
+
+	// Total number of keys in all the tracks.
+	size_t num_keys;
+} ufbx_baked_anim;
+
 // -- Collections
 
 // Collection of nodes to hide/freeze
@@ -3167,6 +3320,58 @@ typedef struct ufbx_warning {
 
 UFBX_LIST_TYPE(ufbx_warning_list, ufbx_warning);
 
+// Timing and counters of a single load, see `ufbx_load_opts.collect_stats`.
+// Times are in seconds, phases that don't apply to the file are left as zero.
+typedef struct ufbx_load_stats {
+
+	// Set if the statistics were collected.
+	bool collected;
+
+	// Wall clock time of each phase.
+	double total_time;          // < Time spent inside ufbx during the load
+	double detect_format_time;  // < Reading the header and detecting the file format
+	double parse_time;          // < Parsing the file, includes `inflate_time` and `ascii_number_time`
+	double inflate_time;        // < Decompressing DEFLATE arrays, includes reading them if streaming
+	double ascii_number_time;   // < Parsing numeric arrays in ASCII files
+	double pre_finalize_time;   // < Resolving connections and element types
+	double finalize_time;       // < Building the final scene elements
+	double conversion_time;     // < Axis/unit conversion and updating transforms
+	double external_files_time; // < Loading external files such as geometry caches
+	double skinning_time;       // < Evaluating skinning, see `ufbx_load_opts.evaluate_skinning`
+
+	// Process CPU time of the same phases. This is summed over all threads of the process,
+	// so it exceeds the wall clock time if work runs on `ufbx_load_opts.thread_opts`, and
+	// includes unrelated threads of the application running at the same time.
+	// A CPU time well below the wall clock time means the phase was waiting, eg. for I/O.
+	// NOTE: Uses `clock()` if `clock_gettime(CLOCK_PROCESS_CPUTIME_ID)` is not available,
+	// which measures wall clock time on Windows.
+	double total_cpu_time;
+	double detect_format_cpu_time;
+	double parse_cpu_time;
+	double inflate_cpu_time;
+	double ascii_number_cpu_time;
+	double pre_finalize_cpu_time;
+	double finalize_cpu_time;
+	double conversion_cpu_time;
+	double external_files_cpu_time;
+	double skinning_cpu_time;
+
+	uint64_t inflate_compressed_bytes;   // < Total size of DEFLATE compressed array data
+	uint64_t inflate_decompressed_bytes; // < Total size of the arrays after decompression
+
+	size_t num_arrays;            // < Number of arrays decoded from the file
+	size_t num_compressed_arrays; // < Number of DEFLATE compressed arrays
+
+	size_t string_pool_hits;   // < Strings already found in the string pool
+	size_t string_pool_misses; // < Strings added to the string pool
+
+	// Probe lengths of the internal hash maps, sampled at the end of the load.
+	size_t map_entries;
+	double map_avg_probe_length;
+	size_t map_max_probe_length;
+
+} ufbx_load_stats;
+
 // Miscellaneous data related to the loaded file
 typedef struct ufbx_metadata {
 
@@ -3239,6 +3444,10 @@ typedef struct ufbx_metadata {
 	size_t element_buffer_size;
 	size_t num_shader_textures;
 
+	// Memory used by precompiled animation curves in bytes,
+	// see `ufbx_load_opts.compile_anim_curves`.
+	size_t compiled_anim_curve_memory;
+
 	ufbx_real bone_prop_size_unit;
 	bool bone_prop_limb_length_relative;
 	double ktime_to_sec;
@@ -3246,6 +3455,12 @@ typedef struct ufbx_metadata {
 	ufbx_string original_file_path;
 	ufbx_blob raw_original_file_path;
 
+	// Reading the file and external geometry caches, zero if loaded from memory.
+	ufbx_io_stats io_stats;
+
+	// Only if `ufbx_load_opts.collect_stats` is set.
+	ufbx_load_stats load_stats;
+
 } ufbx_metadata;
 
 typedef enum ufbx_time_mode UFBX_ENUM_REPR {
@@ -3677,10 +3892,14 @@ typedef enum ufbx_error_type UFBX_ENUM_REPR {
 	// Unsafe options specified without enabling `ufbx_load_opts.allow_unsafe`.
 	UFBX_ERROR_UNSAFE_OPTIONS,
 
+	// Snapshot was saved by a different build of ufbx or with a different
+	// `ufbx_snapshot_opts.key`, see `ufbx_load_scene_snapshot()`.
+	UFBX_ERROR_SNAPSHOT_MISMATCH,
+
 	UFBX_ENUM_FORCE_WIDTH(UFBX_ERROR_TYPE)
 } ufbx_error_type;
 
-UFBX_ENUM_TYPE(ufbx_error_type, UFBX_ERROR_TYPE, UFBX_ERROR_UNSAFE_OPTIONS);
+UFBX_ENUM_TYPE(ufbx_error_type, UFBX_ERROR_TYPE, UFBX_ERROR_SNAPSHOT_MISMATCH);
 
 // Error description with detailed stack trace
 // HINT: You can use `ufbx_format_error()` for formatting the error
@@ -3720,6 +3939,109 @@ typedef struct ufbx_progress_cb {
 		(progress))
 } ufbx_progress_cb;
 
+// -- Thread pool
+
+// Task to run, called with `index` in `[0, count)` as passed to `ufbx_thread_pool_run_fn()`.
+typedef void ufbx_thread_pool_task_fn(void *task_user, uint32_t index);
+
+// Start running `count` tasks by calling `task_fn(task_user, index)` for each `index` in `[0, count)`.
+// The tasks may run concurrently in any order on any threads, or even on the calling thread.
+typedef void ufbx_thread_pool_run_fn(void *user, ufbx_thread_pool_task_fn *task_fn, void *task_user, uint32_t count);
+
+// Wait until all the tasks started by the preceding `ufbx_thread_pool_run_fn()` call have completed.
+typedef void ufbx_thread_pool_wait_fn(void *user);
+
+// User-provided thread pool, ufbx never creates threads by itself.
+typedef struct ufbx_thread_pool {
+	ufbx_thread_pool_run_fn *run_fn;   // < Required
+	ufbx_thread_pool_wait_fn *wait_fn; // < Required
+	void *user;
+} ufbx_thread_pool;
+
+typedef struct ufbx_thread_opts {
+	// Thread pool to run tasks in, work is done serially if `run_fn` is `NULL`.
+	ufbx_thread_pool pool;
+
+	// Maximum number of tasks to run at once, defaults to 64.
+	size_t num_tasks;
+
+	// Maximum amount of memory in bytes to use for deferred work, defaults to 32MB.
+	size_t memory_limit;
+} ufbx_thread_opts;
+
+typedef struct ufbx_read_ahead_opts {
+	// Thread pool to read files in the background while parsing, the files are read
+	// synchronously if `run_fn` is `NULL`. Reading blocks a task in `ufbx_stream.read_fn()`
+	// for the duration of the load so `pool` should have a thread to spare.
+	ufbx_thread_pool pool;
+
+	// Number of chunks to read ahead of the parser, defaults to 4.
+	size_t num_chunks;
+
+	// Size of a single chunk in bytes, defaults to `ufbx_load_opts.read_buffer_size` or 16kB.
+	size_t chunk_size;
+} ufbx_read_ahead_opts;
+
+// -- .obj streaming
+
+// Batch of geometry streamed from an .obj file, see `ufbx_load_opts.obj_stream_cb`.
+// Vertex attributes are appended to streams spanning the whole file: the values in this
+// batch start at `first_position` etc. and face indices refer to these whole-file streams.
+// All data in the batch is only valid for the duration of the callback.
+typedef struct ufbx_obj_batch {
+
+	// Vertex attribute values defined since the previous batch.
+	ufbx_vec3_list positions;
+	ufbx_vec2_list uvs;
+	ufbx_vec3_list normals;
+
+	// Vertex colors matching `positions` once the file has defined any,
+	// vertices without a color are zero.
+	ufbx_vec4_list colors;
+
+	// Index of the first value of the lists above in the whole file.
+	size_t first_position;
+	size_t first_uv;
+	size_t first_normal;
+	size_t first_color;
+
+	// Mesh that `faces` belong to, meshes are split by objects and groups as usual.
+	// `ufbx_element.element_id` of the mesh in the resulting scene and its name.
+	// `UFBX_NO_INDEX` if the batch contains only vertices.
+	uint32_t mesh_element_id;
+	ufbx_string mesh_name;
+
+	// Faces in this batch, `ufbx_face.index_begin` is relative to the index lists below.
+	ufbx_face_list faces;
+
+	// Per-face material index into `ufbx_mesh.materials` of the mesh in the resulting scene,
+	// `UFBX_NO_INDEX` if the face has no material.
+	ufbx_uint32_list face_material;
+
+	// Per-face smoothing and group indices into `ufbx_mesh.face_groups`, empty if not used.
+	ufbx_bool_list face_smoothing;
+	ufbx_uint32_list face_group;
+
+	// Indices into the whole-file attribute streams, `UFBX_NO_INDEX` if missing.
+	// NOTE: Indices are not validated, they may refer to values that are defined later or never.
+	ufbx_uint32_list position_indices;
+	ufbx_uint32_list uv_indices;
+	ufbx_uint32_list normal_indices;
+
+} ufbx_obj_batch;
+
+// Called with batches of .obj geometry, return `false` to cancel loading.
+typedef bool ufbx_obj_stream_fn(void *user, const ufbx_obj_batch *batch);
+
+typedef struct ufbx_obj_stream_cb {
+	ufbx_obj_stream_fn *fn;
+	void *user;
+
+	UFBX_CALLBACK_IMPL(ufbx_obj_stream_cb, ufbx_obj_stream_fn, bool,
+		(void *user, const ufbx_obj_batch *batch),
+		(batch))
+} ufbx_obj_stream_cb;
+
 // -- Inflate
 
 typedef struct ufbx_inflate_input ufbx_inflate_input;
@@ -3865,6 +4187,9 @@ UFBX_ENUM_TYPE(ufbx_space_conversion, UFBX_SPACE_CONVERSION, UFBX_SPACE_CONVERSI
 
 // -- Main API
 
+// Temporary memory and tables retained between loads, see `ufbx_create_load_context()`.
+typedef struct ufbx_load_context ufbx_load_context;
+
 // Options for `ufbx_load_file/memory/stream/stdio()`
 // NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
 typedef struct ufbx_load_opts {
@@ -3907,6 +4232,11 @@ typedef struct ufbx_load_opts {
 	// Don't allow partially broken FBX files to load
 	bool strict;
 
+	// Don't verify the Adler-32 checksums of DEFLATE compressed binary arrays.
+	// Corrupted data is still detected if it fails to decompress, but may otherwise
+	// result in garbage values. Use only for files that have been verified by other means.
+	bool skip_deflate_checksums;
+
 	// UNSAFE: If enabled allows using unsafe options that may fundamentally
 	// break the API guarantees.
 	ufbx_unsafe bool allow_unsafe;
@@ -3942,6 +4272,9 @@ typedef struct ufbx_load_opts {
 	// Ignore `open_file_cb` when loading the main file.
 	bool open_main_file_with_default;
 
+	// Measure the time spent in each phase of loading, see `ufbx_metadata.load_stats`.
+	bool collect_stats;
+
 	// Path separator character, defaults to '\' on Windows and '/' otherwise.
 	char path_separator;
 
@@ -3951,6 +4284,21 @@ typedef struct ufbx_load_opts {
 	// Buffer size in bytes to use for reading from files or IO callbacks
 	size_t read_buffer_size;
 
+	// Memory map the file in `ufbx_load_file()` and refer to uncompressed arrays and
+	// embedded content directly in the mapping instead of copying them.
+	// The mapping is retained by the scene and released in `ufbx_free_scene()`.
+	// NOTE: Falls back to reading the file normally if mapping is not supported.
+	bool memory_map_file;
+
+	// Skip the topology and vertex attributes of meshes during loading, only vertex
+	// positions are loaded. Call `ufbx_load_mesh_data()` to load the full mesh later.
+	// Meshes that were not loaded fully have `ufbx_mesh.lazy_geometry` set.
+	// NOTE: Only supported for binary FBX files of version 7200 or newer loaded via
+	// `ufbx_load_memory()` or `ufbx_load_file()` with `memory_map_file`, otherwise
+	// or if geometry is modified during loading (eg. `normalize_normals`) this is ignored.
+	// NOTE: Memory passed to `ufbx_load_memory()` must outlive the scene!
+	bool lazy_geometry;
+
 	// Filename to use as a base for relative file paths if not specified using
 	// `ufbx_load_file()`. Use `length = SIZE_MAX` for NULL-terminated strings.
 	// `raw_filename` will be derived from this if empty.
@@ -3967,6 +4315,20 @@ typedef struct ufbx_load_opts {
 	// External file callbacks (defaults to stdio.h)
 	ufbx_open_file_cb open_file_cb;
 
+	// Thread pool to use for decompressing binary FBX arrays and parsing large
+	// ASCII FBX arrays and runs of `.obj` vertex lines in parallel.
+	// NOTE: ASCII data is parsed in parallel only if the whole array or run is buffered,
+	// ie. when using `ufbx_load_memory()` or `ufbx_load_file()` with `memory_map_file`.
+	ufbx_thread_opts thread_opts;
+
+	// Read the file and external geometry caches ahead of the parser in the background.
+	// Applies only when reading from streams, see `ufbx_metadata.io_stats`.
+	ufbx_read_ahead_opts read_ahead;
+
+	// Reuse the temporary memory of previous loads, see `ufbx_create_load_context()`.
+	// If set, temporary memory is allocated using the context instead of `temp_allocator`.
+	ufbx_load_context *load_context;
+
 	// How to handle geometry transforms in the nodes.
 	// See `ufbx_geometry_transform_handling` for an explanation.
 	ufbx_geometry_transform_handling geometry_transform_handling;
@@ -4005,6 +4367,17 @@ typedef struct ufbx_load_opts {
 	// Used only if `space_conversion == UFBX_SPACE_CONVERSION_TRANSFORM_ROOT`.
 	bool no_anim_curve_unit_scaling;
 
+	// Precompile animation curves to `ufbx_anim_curve.segments` for faster
+	// evaluation, see `ufbx_metadata.compiled_anim_curve_memory`.
+	// NOTE: Cubic segments with tangent weights within `compile_anim_curve_tolerance`
+	// of even spacing are evaluated directly as polynomials of time, so values
+	// may differ slightly from non-compiled evaluation.
+	bool compile_anim_curves;
+
+	// Tolerance for evaluating cubic segments as direct polynomials, defaults to 0.00001.
+	// Use a negative value to always solve the exact Bezier curve parameter.
+	ufbx_real compile_anim_curve_tolerance;
+
 	// Normalize vertex normals.
 	bool normalize_normals;
 
@@ -4060,9 +4433,144 @@ typedef struct ufbx_load_opts {
 	// (.obj) Data for the .mtl file.
 	ufbx_blob obj_mtl_data;
 
+	// (.obj) Stream geometry to `obj_stream_cb` in batches instead of storing it in the scene.
+	// The resulting scene contains nodes, materials and meshes without any geometry.
+	// Batches are emitted whenever the mesh changes or `obj_stream_memory_limit` is exceeded,
+	// so temporary geometry memory does not depend on the size of the file.
+	ufbx_obj_stream_cb obj_stream_cb;
+
+	// (.obj) Maximum amount of geometry in bytes to buffer before calling `obj_stream_cb`.
+	// Default: 16MB
+	size_t obj_stream_memory_limit;
+
 	uint32_t _end_zero;
 } ufbx_load_opts;
 
+// Incremental scene loader, see `ufbx_load_begin_file/memory/stream()`.
+typedef struct ufbx_loader ufbx_loader;
+
+// Phases of loading a scene in the order they are processed.
+typedef enum ufbx_load_phase UFBX_ENUM_REPR {
+	UFBX_LOAD_PHASE_HEADER,         // < Options, file format detection, and file headers
+	UFBX_LOAD_PHASE_OBJECTS,        // < Scene objects, split into multiple steps by `budget`
+	UFBX_LOAD_PHASE_CONNECTIONS,    // < Rest of the file after objects
+	UFBX_LOAD_PHASE_FINALIZE,       // < Resolving connections and creating scene elements
+	UFBX_LOAD_PHASE_POST_PROCESS,   // < Axis/unit conversion and transform evaluation
+	UFBX_LOAD_PHASE_EXTERNAL_FILES, // < Loading external files, see `ufbx_load_opts.load_external_files`
+	UFBX_LOAD_PHASE_SKINNING,       // < Evaluating skinning, see `ufbx_load_opts.evaluate_skinning`
+	UFBX_LOAD_PHASE_DONE,           // < Finished, call `ufbx_load_finish()` to get the result
+
+	UFBX_ENUM_FORCE_WIDTH(UFBX_LOAD_PHASE)
+} ufbx_load_phase;
+
+UFBX_ENUM_TYPE(ufbx_load_phase, UFBX_LOAD_PHASE, UFBX_LOAD_PHASE_DONE);
+
+// Status of an incremental load returned by `ufbx_load_step()`.
+typedef struct ufbx_load_status {
+	// Phase to be processed by the next call to `ufbx_load_step()`.
+	ufbx_load_phase phase;
+
+	// Loading has failed, `ufbx_load_finish()` returns the error.
+	bool failed;
+
+	// Bytes of the input file processed so far.
+	ufbx_progress progress;
+} ufbx_load_status;
+
+// File information read by `ufbx_probe_file/memory()` without loading the scene.
+typedef struct ufbx_probe {
+
+	// File format, version, and exporter information.
+	// NOTE: Only fields describing the file itself are filled in: `ascii`, `version`,
+	// `file_format`, `big_endian`, `creator`, `exporter`, `exporter_version`,
+	// `scene_props`, `original_application`, and `latest_application`.
+	ufbx_metadata metadata;
+
+	// Global settings, eg. axes, units, and frame rate.
+	ufbx_scene_settings settings;
+
+	// Number of objects in the file by the type of element they would be loaded as.
+	// NOTE: These are counted directly from the file so they may differ slightly
+	// from the loaded scene, eg. the root node and synthetic elements are not counted.
+	size_t element_counts[UFBX_ELEMENT_TYPE_COUNT];
+
+	// Total number of objects in the file.
+	size_t num_objects;
+
+} ufbx_probe;
+
+// Options for `ufbx_save_scene_snapshot()` and `ufbx_load_scene_snapshot*()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_snapshot_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts temp_allocator;   // < Allocator used during saving or loading
+	ufbx_allocator_opts result_allocator; // < Allocator used for the snapshot or the loaded scene
+
+	// User defined value stored in the snapshot, loading fails with
+	// `UFBX_ERROR_SNAPSHOT_MISMATCH` unless it matches the saved value.
+	// Use this to reject stale snapshots, eg. by the modification time or hash of the source file.
+	uint64_t key;
+
+	uint32_t _end_zero;
+} ufbx_snapshot_opts;
+
+// Options for `ufbx_create_load_context()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_load_context_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts temp_allocator; // < Allocator used for all temporary memory of the loads
+
+	uint32_t _end_zero;
+} ufbx_load_context_opts;
+
+// Options for `ufbx_load_files_batch()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_batch_load_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts temp_allocator;   // < Allocator used for the per-worker load contexts
+	ufbx_allocator_opts result_allocator; // < Allocator used for the result and the shared strings
+
+	// Thread pool to distribute the files to, files are loaded serially if `run_fn` is `NULL`.
+	// NOTE: `ufbx_load_opts.thread_opts.pool` and `ufbx_load_opts.read_ahead.pool` are
+	// ignored for the individual loads if this is set.
+	ufbx_thread_pool pool;
+
+	// Number of tasks to run in `pool`, each with its own `ufbx_load_context`, defaults to 8.
+	size_t num_workers;
+
+	// Move the strings of all the loaded scenes to a single read-only table shared by the scenes.
+	// Names of nodes, properties and types are usually heavily duplicated between files.
+	// NOTE: Requires `UFBX_ENABLE_SNAPSHOT` in minimal builds, ignored otherwise.
+	bool share_strings;
+
+	uint32_t _end_zero;
+} ufbx_batch_load_opts;
+
+// Serialized scene returned by `ufbx_save_scene_snapshot()`.
+typedef struct ufbx_snapshot {
+	const void *data;
+	size_t size;
+} ufbx_snapshot;
+
+// Scenes and errors returned by `ufbx_load_files_batch()` in the order of the input files.
+typedef struct ufbx_batch_result {
+	size_t num_files;
+	size_t num_failed;
+
+	// Loaded scenes, `NULL` for the files that failed to load.
+	// NOTE: Owned by the result, use `ufbx_retain_scene()` to keep scenes alive after `ufbx_free_batch_result()`.
+	ufbx_scene **scenes;
+
+	// Error for each file, `type == UFBX_ERROR_NONE` for the scenes that loaded successfully.
+	ufbx_error *errors;
+
+	// Size of the strings shared by the scenes, see `ufbx_batch_load_opts.share_strings`.
+	size_t shared_string_size;
+} ufbx_batch_result;
+
 // Options for `ufbx_evaluate_scene()`
 // NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
 typedef struct ufbx_evaluate_opts {
@@ -4083,6 +4591,57 @@ typedef struct ufbx_evaluate_opts {
 	uint32_t _end_zero;
 } ufbx_evaluate_opts;
 
+// Options for `ufbx_evaluate_pose()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_evaluate_pose_opts {
+	uint32_t _begin_zero;
+
+	// Optional output for `ufbx_node.geometry_to_world` of every node, indexed
+	// by `ufbx_node.typed_id`. Requires `world_out` in `ufbx_evaluate_pose()`.
+	ufbx_matrix *geometry_to_world_out;
+
+	// Optional output for `ufbx_node.world_transform` of every node, indexed
+	// by `ufbx_node.typed_id`. Requires `world_out` in `ufbx_evaluate_pose()`.
+	// Nodes with a non-normal `ufbx_node.inherit_type` need the world rotation and
+	// scale of their parents, providing this array lets them reuse the values instead
+	// of accumulating them from the root for every such node.
+	ufbx_transform *world_transform_out;
+
+	uint32_t _end_zero;
+} ufbx_evaluate_pose_opts;
+
+// Options for `ufbx_bake_anim()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_bake_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts temp_allocator;   // < Allocator used during baking
+	ufbx_allocator_opts result_allocator; // < Allocator used for the baked animation
+
+	// Thread pool to evaluate the animated elements in parallel, see `ufbx_load_opts.thread_opts`.
+	ufbx_thread_opts thread_opts;
+
+	// Samples per second, defaults to 30.
+	double resample_rate;
+
+	// Sample all the tracks at `resample_rate` over the whole time range.
+	// By default the original keyframe times are preserved and only the spans
+	// that cannot be represented by linear interpolation are resampled.
+	bool fixed_rate;
+
+	// Time from a stepped key to the extra key emulating the step, defaults to 0.001 seconds.
+	double step_time;
+
+	// Keep keys that can be linearly interpolated from their neighbors.
+	bool no_key_reduction;
+
+	// Maximum error of a key that is removed, defaults to 0.00001.
+	// Rotations are compared as quaternion components.
+	ufbx_real key_reduction_tolerance;
+
+	uint32_t _end_zero;
+} ufbx_bake_opts;
+
 // Options for `ufbx_tessellate_nurbs_curve()`
 // NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
 typedef struct ufbx_tessellate_curve_opts {
@@ -4157,6 +4716,20 @@ typedef struct ufbx_subdivide_opts {
 	uint32_t _end_zero;
 } ufbx_subdivide_opts;
 
+// Options for `ufbx_load_mesh_data()`
+// NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
+typedef struct ufbx_load_mesh_opts {
+	uint32_t _begin_zero;
+
+	ufbx_allocator_opts temp_allocator;   // < Allocator used during loading
+	ufbx_allocator_opts result_allocator; // < Allocator used for the final mesh
+
+	// Thread pool for decoding compressed arrays, see `ufbx_load_opts.thread_opts`.
+	ufbx_thread_opts thread_opts;
+
+	uint32_t _end_zero;
+} ufbx_load_mesh_opts;
+
 // Options for `ufbx_load_geometry_cache()`
 // NOTE: Initialize to zero with `{ 0 }` (C) or `{ }` (C++)
 typedef struct ufbx_geometry_cache_opts {
@@ -4171,6 +4744,9 @@ typedef struct ufbx_geometry_cache_opts {
 	// FPS value for converting frame times to seconds
 	double frames_per_second;
 
+	// Read the cache files ahead of the parser in the background.
+	ufbx_read_ahead_opts read_ahead;
+
 	uint32_t _end_zero;
 } ufbx_geometry_cache_opts;
 
@@ -4236,6 +4812,7 @@ extern const uint32_t ufbx_source_version;
 //   ufbx_free_scene()
 //   ufbx_subdivide_mesh()
 //   ufbx_tessellate_nurbs_surface()
+//   ufbx_load_mesh_data()
 //   ufbx_free_mesh()
 ufbx_abi bool ufbx_is_thread_safe(void);
 
@@ -4276,6 +4853,99 @@ ufbx_abi ufbx_scene *ufbx_load_stream_prefix(
 	const void *prefix, size_t prefix_size,
 	const ufbx_load_opts *opts, ufbx_error *error);
 
+// Incremental loading: Begin loading a scene without doing any work yet.
+// Call `ufbx_load_step()` until it returns `false` and `ufbx_load_finish()` to get the result.
+// `ufbx_load_finish()` must be called for every returned loader, even if `ufbx_load_step()` fails.
+// Returns `NULL` on failure to allocate the loader or open the file.
+// NOTE: `data`, `stream`, and any data referenced by `opts` must stay valid until `ufbx_load_finish()`.
+ufbx_abi ufbx_loader *ufbx_load_begin_memory(
+	const void *data, size_t data_size,
+	const ufbx_load_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_loader *ufbx_load_begin_file(
+	const char *filename,
+	const ufbx_load_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_loader *ufbx_load_begin_file_len(
+	const char *filename, size_t filename_len,
+	const ufbx_load_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_loader *ufbx_load_begin_stream(
+	const ufbx_stream *stream,
+	const ufbx_load_opts *opts, ufbx_error *error);
+
+// Perform a bounded amount of loading work, parsing roughly `budget` bytes of the file.
+// Phases other than `UFBX_LOAD_PHASE_OBJECTS` are processed whole, one per call.
+// Returns `true` if there is more work to do, `status` (optional) receives the current state.
+ufbx_abi bool ufbx_load_step(ufbx_loader *loader, size_t budget, ufbx_load_status *status);
+
+// Finish loading and free `loader`, returns the loaded scene or `NULL` on failure.
+// Calling this before `ufbx_load_step()` has returned `false` cancels the load
+// and fails with `UFBX_ERROR_CANCELLED`.
+ufbx_abi ufbx_scene *ufbx_load_finish(ufbx_loader *loader, ufbx_error *error);
+
+// Create a context that retains temporary memory, hash maps, and the internal string and
+// property type tables between loads that set `ufbx_load_opts.load_context`.
+// Use this when loading many small files to skip most of the per-load setup.
+// NOTE: A context can be used by one load at a time, typically you'd want one per thread.
+// Loads that find the context already in use, also on other threads if `ufbx_is_thread_safe()`,
+// fall back to allocating as usual.
+ufbx_abi ufbx_load_context *ufbx_create_load_context(const ufbx_load_context_opts *opts, ufbx_error *error);
+
+// Free a context returned by `ufbx_create_load_context()` and all the memory it retains.
+// Scenes loaded using the context stay valid.
+ufbx_abi void ufbx_free_load_context(ufbx_load_context *context);
+
+// Load `num_files` files distributed over the workers of `opts->pool` using `load_opts` for each file.
+// Individual files failing to load do not fail the batch, see `ufbx_batch_result.errors`.
+// Returns `NULL` only if the batch itself could not be set up.
+// NOTE: Allocators in `load_opts` and `opts` must be thread-safe if a thread pool is used.
+ufbx_abi ufbx_batch_result *ufbx_load_files_batch(
+	const char *const *filenames, size_t num_files,
+	const ufbx_load_opts *load_opts, const ufbx_batch_load_opts *opts, ufbx_error *error);
+
+// Free a result returned by `ufbx_load_files_batch()` and release the scenes it contains.
+ufbx_abi void ufbx_free_batch_result(ufbx_batch_result *result);
+
+// Probe the header, global settings, and object types of a file without loading the scene.
+// In binary FBX files the contents of objects are skipped entirely, ASCII files still need
+// to be tokenized but no scene elements are created. Other formats report only `metadata`.
+// Relevant fields of `opts` are used as in `ufbx_load_*()`, content is always ignored.
+ufbx_abi ufbx_probe *ufbx_probe_memory(
+	const void *data, size_t data_size,
+	const ufbx_load_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_probe *ufbx_probe_file(
+	const char *filename,
+	const ufbx_load_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_probe *ufbx_probe_file_len(
+	const char *filename, size_t filename_len,
+	const ufbx_load_opts *opts, ufbx_error *error);
+
+// Free a probe returned by `ufbx_probe_file/memory()`
+ufbx_abi void ufbx_free_probe(ufbx_probe *probe);
+
+// Serialize `scene` into a position independent snapshot that can be loaded with
+// `ufbx_load_scene_snapshot*()` much faster than the original file can be parsed.
+// Snapshots are only valid for the exact same version and build configuration of ufbx.
+// Scenes referring to memory they don't own cannot be saved, this includes scenes
+// loaded with `ufbx_load_opts.lazy_geometry` and external geometry caches.
+ufbx_abi ufbx_snapshot *ufbx_save_scene_snapshot(const ufbx_scene *scene, const ufbx_snapshot_opts *opts, ufbx_error *error);
+
+// Free a snapshot returned by `ufbx_save_scene_snapshot()`
+ufbx_abi void ufbx_free_snapshot(ufbx_snapshot *snapshot);
+
+// Load a scene from a snapshot written by `ufbx_save_scene_snapshot()`.
+// The snapshot is copied to a single allocation so `data` does not need to outlive the scene.
+// Fails with `UFBX_ERROR_SNAPSHOT_MISMATCH` if the snapshot is from a different build of ufbx
+// or `opts->key` does not match, in which case you should fall back to loading the original file.
+// NOTE: Only the snapshot header and pointers are validated, do not load untrusted snapshots!
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot_memory(
+	const void *data, size_t data_size,
+	const ufbx_snapshot_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot(
+	const char *filename,
+	const ufbx_snapshot_opts *opts, ufbx_error *error);
+ufbx_abi ufbx_scene *ufbx_load_scene_snapshot_len(
+	const char *filename, size_t filename_len,
+	const ufbx_snapshot_opts *opts, ufbx_error *error);
+
 // Free a previously loaded or evaluated scene
 ufbx_abi void ufbx_free_scene(ufbx_scene *scene);
 
@@ -4378,6 +5048,27 @@ ufbx_abi ufbx_real ufbx_evaluate_anim_value_real(const ufbx_anim_value *anim_val
 ufbx_abi ufbx_vec2 ufbx_evaluate_anim_value_vec2(const ufbx_anim_value *anim_value, double time);
 ufbx_abi ufbx_vec3 ufbx_evaluate_anim_value_vec3(const ufbx_anim_value *anim_value, double time);
 
+// Evaluate curves using a cursor that caches the previously evaluated segment.
+// Returns exactly the same values as `ufbx_evaluate_curve()` and `ufbx_evaluate_anim_value_*()`
+// but is faster when consecutive `time` values are close to each other.
+// HINT: Use one cursor per curve per thread, the cursor is modified on evaluation.
+ufbx_abi void ufbx_init_curve_cursor(ufbx_curve_cursor *cursor, const ufbx_anim_curve *curve);
+ufbx_abi ufbx_real ufbx_evaluate_curve_cursor(ufbx_curve_cursor *cursor, double time, ufbx_real default_value);
+
+ufbx_abi void ufbx_init_anim_value_cursor(ufbx_anim_value_cursor *cursor, const ufbx_anim_value *anim_value);
+ufbx_abi ufbx_real ufbx_evaluate_anim_value_cursor_real(ufbx_anim_value_cursor *cursor, double time);
+ufbx_abi ufbx_vec2 ufbx_evaluate_anim_value_cursor_vec2(ufbx_anim_value_cursor *cursor, double time);
+ufbx_abi ufbx_vec3 ufbx_evaluate_anim_value_cursor_vec3(ufbx_anim_value_cursor *cursor, double time);
+
+// Evaluate curves at `count` different `times`, writing `values[i]` for `times[i]`.
+// Returns exactly the same values as `ufbx_evaluate_curve()` and `ufbx_evaluate_anim_value_*()`.
+// HINT: Sort `times` in increasing order, this lets the keyframes be processed only once.
+ufbx_abi void ufbx_evaluate_curve_batch(const ufbx_anim_curve *curve, const double *times, size_t count, ufbx_real *values, ufbx_real default_value);
+
+ufbx_abi void ufbx_evaluate_anim_value_batch_real(const ufbx_anim_value *anim_value, const double *times, size_t count, ufbx_real *values);
+ufbx_abi void ufbx_evaluate_anim_value_batch_vec2(const ufbx_anim_value *anim_value, const double *times, size_t count, ufbx_vec2 *values);
+ufbx_abi void ufbx_evaluate_anim_value_batch_vec3(const ufbx_anim_value *anim_value, const double *times, size_t count, ufbx_vec3 *values);
+
 // Evaluate an animated property `name` from `element` at `time`.
 // NOTE: If the property is not found it will have the flag `UFBX_PROP_FLAG_NOT_FOUND`.
 ufbx_abi ufbx_prop ufbx_evaluate_prop_len(const ufbx_anim *anim, const ufbx_element *element, const char *name, size_t name_len, double time);
@@ -4404,6 +5095,25 @@ ufbx_abi ufbx_const_prop_override_list ufbx_prepare_prop_overrides(ufbx_prop_ove
 // scene cannot be freed until all evaluated scenes are freed.
 ufbx_abi ufbx_scene *ufbx_evaluate_scene(const ufbx_scene *scene, const ufbx_anim *anim, double time, const ufbx_evaluate_opts *opts, ufbx_error *error);
 
+// Evaluate the transforms of all nodes in `scene` at `time` in the animation `anim`
+// without allocating any memory. The results are written to caller-provided arrays
+// indexed by `ufbx_node.typed_id`, both must have space for `scene->nodes.count` items.
+// `local_out` receives the local transforms, see `ufbx_evaluate_transform()`, and the
+// optional `world_out` the `ufbx_node.node_to_world` matrices, matching the nodes of
+// `ufbx_evaluate_scene()` with the same arguments.
+// NOTE: Inherit types and geometry transforms are not animated, the values in `scene` are used.
+// HINT: Does not modify `scene` so it's safe to call concurrently from multiple threads.
+ufbx_abi void ufbx_evaluate_pose(const ufbx_scene *scene, const ufbx_anim *anim, double time, ufbx_transform *local_out, ufbx_matrix *world_out, const ufbx_evaluate_pose_opts *opts);
+
+// Resample the animation `anim` into linearly interpolated keys for every animated node,
+// blend channel and property. The time range is `ufbx_anim.time_begin/end` if specified,
+// otherwise the range of the keyframes.
+// NOTE: The returned animation refers to the original `scene` so the original
+// scene cannot be freed until all baked animations are freed.
+ufbx_abi ufbx_baked_anim *ufbx_bake_anim(const ufbx_scene *scene, const ufbx_anim *anim, const ufbx_bake_opts *opts, ufbx_error *error);
+ufbx_abi void ufbx_free_baked_anim(ufbx_baked_anim *bake);
+ufbx_abi void ufbx_retain_baked_anim(ufbx_baked_anim *bake);
+
 // Materials
 
 ufbx_abi ufbx_texture *ufbx_find_prop_texture_len(const ufbx_material *material, const char *name, size_t name_len);
@@ -4521,6 +5231,12 @@ ufbx_abi void ufbx_compute_normals(const ufbx_mesh *mesh, const ufbx_vertex_vec3
 
 ufbx_abi ufbx_mesh *ufbx_subdivide_mesh(const ufbx_mesh *mesh, size_t level, const ufbx_subdivide_opts *opts, ufbx_error *error);
 
+// Load the full geometry of a mesh loaded with `ufbx_load_opts.lazy_geometry`.
+// Returns a new mesh or `mesh` itself if it was loaded fully, free the result
+// with `ufbx_free_mesh()` in both cases. The scene is not modified so this can be
+// called concurrently from multiple threads, eg. one per mesh.
+ufbx_abi ufbx_mesh *ufbx_load_mesh_data(const ufbx_mesh *mesh, const ufbx_load_mesh_opts *opts, ufbx_error *error);
+
 ufbx_abi void ufbx_free_mesh(ufbx_mesh *mesh);
 ufbx_abi void ufbx_retain_mesh(ufbx_mesh *mesh);
 